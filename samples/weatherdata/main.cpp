@@ -36,6 +36,11 @@ int main(int argc, char *argv[])
 
     CLineReader lineReader(&a);
     CWeatherDataPrinter printer(&a);
+    if (qa.arguments().size() > 1)
+    {
+        // parse a stored GRIB file instead of downloading, e.g. to measure parsing time
+        printer.setGribFile(qa.arguments().at(1));
+    }
     QObject::connect(&lineReader, &CLineReader::weatherDataRequest, &printer, &CWeatherDataPrinter::fetchAndPrintWeatherData);
     QObject::connect(&lineReader, &CLineReader::wantsToQuit, &lineReader, &CLineReader::terminate);
     QObject::connect(&lineReader, &CLineReader::finished, &a, &QCoreApplication::quit);
@@ -43,6 +48,7 @@ int main(int argc, char *argv[])
     QTextStream qtout(stdout);
     qtout << "Usage: <lat> <lon>" << Qt::endl;
     qtout << "Example: 48.5 11.5" << Qt::endl;
+    qtout << "Start with a GRIB file as argument to use this file instead of downloading" << Qt::endl;
     qtout << "Type x to quit" << Qt::endl;
 
     lineReader.start();
@@ -52,13 +52,21 @@ void CWeatherDataPrinter::fetchAndPrintWeatherData(const CCoordinateGeodetic &po
     qtout << "Fetching weather data. This may take a while..." << Qt::endl;
 
     const CWeatherGrid weatherGrid { { "", position } };
-    m_weatherManger.requestWeatherGrid(weatherGrid, { this, &CWeatherDataPrinter::printWeatherData });
+    m_fetchTimer.start();
+    if (m_gribFile.isEmpty())
+    {
+        m_weatherManger.requestWeatherGrid(weatherGrid, { this, &CWeatherDataPrinter::printWeatherData });
+    }
+    else
+    {
+        m_weatherManger.requestWeatherGridFromFile(m_gribFile, weatherGrid, { this, &CWeatherDataPrinter::printWeatherData });
+    }
 }
 
 void CWeatherDataPrinter::printWeatherData(const CWeatherGrid &weatherGrid)
 {
     QTextStream qtout(stdout);
-    qtout << "... finished." << endl;
+    qtout << "... finished in " << m_fetchTimer.elapsed() << "ms." << endl;
     qtout << weatherGrid.getDescription();
     qtout << endl;
 }
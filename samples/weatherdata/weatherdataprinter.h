@@ -16,7 +16,9 @@
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/weather/weathergrid.h"
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QString>
 
 /*!
  * CWeatherDataPrinter fetches and prints weather data
@@ -32,11 +34,16 @@ public:
     //! Fetch new weather data for given position and print it once received
     void fetchAndPrintWeatherData(const BlackMisc::Geo::CCoordinateGeodetic &position);
 
+    //! Use a stored GRIB file instead of downloading weather data
+    void setGribFile(const QString &filePath) { m_gribFile = filePath; }
+
 private:
     //! Print weather data to stdout
     void printWeatherData(const BlackMisc::Weather::CWeatherGrid &weatherGrid);
 
     BlackCore::CWeatherManager m_weatherManger { this };
+    QString m_gribFile;
+    QElapsedTimer m_fetchTimer;
 };
 
 #endif // guard
@@ -0,0 +1,144 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/afv/audio/audiodecodepool.h"
+
+#include <QStringLiteral>
+#include <chrono>
+#include <functional>
+
+namespace BlackCore::Afv::Audio
+{
+    QString AudioDecodeStatistics::toQString() const
+    {
+        return QStringLiteral("frames: %1 decode avg/max: %2/%3us latency avg/max: %4/%5us playout avg/max: %6/%7us queued: %8").
+               arg(frames).
+               arg(averageDecodeUs(), 0, 'f', 1).arg(maxDecodeUs).
+               arg(averageLatencyUs(), 0, 'f', 1).arg(maxLatencyUs).
+               arg(averagePlayoutUs(), 0, 'f', 1).arg(maxPlayoutUs).
+               arg(queued);
+    }
+
+    CAudioDecodePool::CAudioDecodePool(int threads)
+    {
+        // a few threads are enough, the audio thread and the simulator need the cores
+        if (threads < 1) { threads = qBound(1, static_cast<int>(std::thread::hardware_concurrency()) / 4, 4); }
+        for (int i = 0; i < threads; i++)
+        {
+            m_workers.push_back(std::make_unique<Worker>());
+        }
+        for (const std::unique_ptr<Worker> &worker : m_workers)
+        {
+            Worker *w = worker.get();
+            w->thread = std::thread([this, w] { this->run(*w); });
+        }
+    }
+
+    CAudioDecodePool::~CAudioDecodePool()
+    {
+        for (const std::unique_ptr<Worker> &worker : m_workers)
+        {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->stop = true;
+            }
+            worker->condition.notify_one();
+        }
+        for (const std::unique_ptr<Worker> &worker : m_workers)
+        {
+            if (worker->thread.joinable()) { worker->thread.join(); }
+        }
+    }
+
+    void CAudioDecodePool::decode(const void *stream, std::function<void()> decodeFunction)
+    {
+        Q_ASSERT_X(decodeFunction, Q_FUNC_INFO, "Missing decode function");
+        const size_t index = std::hash<const void *>()(stream) % m_workers.size();
+        Worker &worker = *m_workers[index];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.jobs.push_back({ std::move(decodeFunction), nowUs() });
+        }
+        m_queued++;
+        worker.condition.notify_one();
+    }
+
+    AudioDecodeStatistics CAudioDecodePool::getStatistics() const
+    {
+        AudioDecodeStatistics statistics;
+        statistics.frames         = m_frames;
+        statistics.totalDecodeUs  = m_totalDecodeUs;
+        statistics.maxDecodeUs    = m_maxDecodeUs;
+        statistics.totalLatencyUs = m_totalLatencyUs;
+        statistics.maxLatencyUs   = m_maxLatencyUs;
+        statistics.playouts       = m_playouts;
+        statistics.totalPlayoutUs = m_totalPlayoutUs;
+        statistics.maxPlayoutUs   = m_maxPlayoutUs;
+        statistics.queued         = m_queued;
+        return statistics;
+    }
+
+    void CAudioDecodePool::resetStatistics()
+    {
+        m_frames = 0;
+        m_totalDecodeUs = 0;
+        m_maxDecodeUs = 0;
+        m_totalLatencyUs = 0;
+        m_maxLatencyUs = 0;
+        m_playouts = 0;
+        m_totalPlayoutUs = 0;
+        m_maxPlayoutUs = 0;
+    }
+
+    void CAudioDecodePool::addPlayoutLatency(qint64 latencyUs)
+    {
+        m_playouts++;
+        m_totalPlayoutUs += latencyUs;
+        updateMax(m_maxPlayoutUs, latencyUs);
+    }
+
+    void CAudioDecodePool::run(Worker &worker)
+    {
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(worker.mutex);
+                worker.condition.wait(lock, [&worker] { return worker.stop || !worker.jobs.empty(); });
+                if (worker.stop) { break; }
+                job = std::move(worker.jobs.front());
+                worker.jobs.pop_front();
+            }
+
+            const qint64 startUs = nowUs();
+            job.decodeFunction();
+            const qint64 endUs = nowUs();
+
+            const qint64 decodeUs  = endUs - startUs;
+            const qint64 latencyUs = endUs - job.queuedUs;
+            m_frames++;
+            m_totalDecodeUs  += decodeUs;
+            m_totalLatencyUs += latencyUs;
+            updateMax(m_maxDecodeUs, decodeUs);
+            updateMax(m_maxLatencyUs, latencyUs);
+            m_queued--;
+        }
+    }
+
+    qint64 CAudioDecodePool::nowUs()
+    {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void CAudioDecodePool::updateMax(std::atomic<qint64> &max, qint64 value)
+    {
+        qint64 current = max.load();
+        while (value > current && !max.compare_exchange_weak(current, value)) {}
+    }
+} // ns
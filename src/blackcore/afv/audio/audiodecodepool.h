@@ -0,0 +1,132 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_AUDIODECODEPOOL_H
+#define BLACKCORE_AFV_AUDIO_AUDIODECODEPOOL_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BlackCore::Afv::Audio
+{
+    //! Decode times and latencies of the pool
+    struct BLACKCORE_EXPORT AudioDecodeStatistics
+    {
+        qint64 frames = 0;            //!< decoded frames
+        qint64 totalDecodeUs = 0;     //!< sum of the decode times
+        qint64 maxDecodeUs = 0;       //!< longest decode
+        qint64 totalLatencyUs = 0;    //!< sum of the times from queuing until decoded
+        qint64 maxLatencyUs = 0;      //!< longest time from queuing until decoded
+        qint64 playouts = 0;          //!< received frames with a known arrival time
+        qint64 totalPlayoutUs = 0;    //!< sum of the times from the arrival of the packet until played out
+        qint64 maxPlayoutUs = 0;      //!< longest time from the arrival of the packet until played out
+        int queued = 0;               //!< frames waiting to be decoded
+
+        //! Average decode time
+        double averageDecodeUs() const { return frames > 0 ? static_cast<double>(totalDecodeUs) / frames : 0.0; }
+
+        //! Average latency
+        double averageLatencyUs() const { return frames > 0 ? static_cast<double>(totalLatencyUs) / frames : 0.0; }
+
+        //! Average end to end latency of the received audio
+        double averagePlayoutUs() const { return playouts > 0 ? static_cast<double>(totalPlayoutUs) / playouts : 0.0; }
+
+        //! As string
+        QString toQString() const;
+    };
+
+    //! Small pool of threads decoding the audio of the callsign streams
+    //! \remark all frames of one stream are decoded by the same thread, so in the order they were queued
+    class BLACKCORE_EXPORT CAudioDecodePool
+    {
+    public:
+        //! Ctor
+        //! \param threads number of decode threads, <1 for a number based on the cores
+        explicit CAudioDecodePool(int threads = -1);
+
+        //! Dtor, pending frames are discarded
+        ~CAudioDecodePool();
+
+        //! Not copyable
+        //! @{
+        CAudioDecodePool(const CAudioDecodePool &) = delete;
+        CAudioDecodePool &operator =(const CAudioDecodePool &) = delete;
+        //! @}
+
+        //! Queue decoding of a frame of the stream
+        //! \remark thread safe
+        void decode(const void *stream, std::function<void()> decodeFunction);
+
+        //! Number of threads
+        int threadCount() const { return static_cast<int>(m_workers.size()); }
+
+        //! Statistics
+        //! \remark thread safe
+        AudioDecodeStatistics getStatistics() const;
+
+        //! Reset the statistics
+        //! \remark thread safe
+        void resetStatistics();
+
+        //! Add the time from the arrival of a packet until its audio is played out
+        //! \remark thread safe
+        void addPlayoutLatency(qint64 latencyUs);
+
+        //! Steady clock in microseconds, same clock as the arrival times of the voice socket
+        static qint64 nowUs();
+
+    private:
+        //! Frame to decode
+        struct Job
+        {
+            std::function<void()> decodeFunction;
+            qint64 queuedUs = 0;
+        };
+
+        //! One thread with its queue
+        struct Worker
+        {
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::deque<Job> jobs;
+            bool stop = false;
+            std::thread thread;
+        };
+
+        //! Thread function
+        void run(Worker &worker);
+
+        //! Update a maximum
+        static void updateMax(std::atomic<qint64> &max, qint64 value);
+
+        std::vector<std::unique_ptr<Worker>> m_workers;
+        std::atomic<qint64> m_frames { 0 };
+        std::atomic<qint64> m_totalDecodeUs { 0 };
+        std::atomic<qint64> m_maxDecodeUs { 0 };
+        std::atomic<qint64> m_totalLatencyUs { 0 };
+        std::atomic<qint64> m_maxLatencyUs { 0 };
+        std::atomic<qint64> m_playouts { 0 };
+        std::atomic<qint64> m_totalPlayoutUs { 0 };
+        std::atomic<qint64> m_maxPlayoutUs { 0 };
+        std::atomic_int m_queued { 0 };
+    };
+} // ns
+
+#endif // guard
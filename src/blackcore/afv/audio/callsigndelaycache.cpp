@@ -8,61 +8,33 @@
 
 #include "blackcore/afv/audio/callsigndelaycache.h"
 
+#include <QMutexLocker>
+
 namespace BlackCore::Afv::Audio
 {
-    void CallsignDelayCache::initialise(const QString &callsign)
-    {
-        if (!m_delayCache.contains(callsign)) { m_delayCache[callsign] = delayDefault; }
-        if (!successfulTransmissionsCache.contains(callsign)) { successfulTransmissionsCache[callsign] = 0; }
-    }
-
-    int CallsignDelayCache::get(const QString &callsign)
+    JitterBufferStatistics CallsignDelayCache::get(const QString &callsign) const
     {
-        return m_delayCache[callsign];
+        QMutexLocker lock(&m_mutex);
+        return m_delayCache.value(callsign);
     }
 
-    void CallsignDelayCache::underflow(const QString &callsign)
+    void CallsignDelayCache::update(const QString &callsign, const JitterBufferStatistics &statistics)
     {
-        if (!successfulTransmissionsCache.contains(callsign)) return;
-
-        successfulTransmissionsCache[callsign] = 0;
-        increaseDelayMs(callsign);
+        if (callsign.isEmpty()) { return; }
+        QMutexLocker lock(&m_mutex);
+        m_delayCache[callsign] = statistics;
     }
 
-    void CallsignDelayCache::success(const QString &callsign)
+    QHash<QString, JitterBufferStatistics> CallsignDelayCache::getAll() const
     {
-        if (!successfulTransmissionsCache.contains(callsign)) return;
-
-        successfulTransmissionsCache[callsign]++;
-        if (successfulTransmissionsCache[callsign] > 5)
-        {
-            decreaseDelayMs(callsign);
-            successfulTransmissionsCache[callsign] = 0;
-        }
+        QMutexLocker lock(&m_mutex);
+        return m_delayCache;
     }
 
-    void CallsignDelayCache::increaseDelayMs(const QString &callsign)
+    void CallsignDelayCache::clear()
     {
-        if (!m_delayCache.contains(callsign))
-            return;
-
-        m_delayCache[callsign] += delayIncrement;
-        if (m_delayCache[callsign] > delayMax)
-        {
-            m_delayCache[callsign] = delayMax;
-        }
-    }
-
-    void CallsignDelayCache::decreaseDelayMs(const QString &callsign)
-    {
-        if (!m_delayCache.contains(callsign))
-            return;
-
-        m_delayCache[callsign] -= delayIncrement;
-        if (m_delayCache[callsign] < delayMin)
-        {
-            m_delayCache[callsign] = delayMin;
-        }
+        QMutexLocker lock(&m_mutex);
+        m_delayCache.clear();
     }
 
     CallsignDelayCache &CallsignDelayCache::instance()
@@ -11,32 +11,32 @@
 #ifndef BLACKORE_AFV_AUDIO_CALLSIGNDELAYCACHE_H
 #define BLACKORE_AFV_AUDIO_CALLSIGNDELAYCACHE_H
 
+#include "blackcore/afv/audio/jitterbuffer.h"
+
 #include <QHash>
+#include <QMutex>
 #include <QString>
 
 namespace BlackCore::Afv::Audio
 {
     //! Callsign delay cache
+    //! \remark keeps the delays learned by the jitter buffer and the statistics per callsign,
+    //!         a new transmission of the callsign starts with them
+    //! \threadsafe
     class CallsignDelayCache
     {
     public:
-        //! Initialize
-        void initialise(const QString &callsign);
-
-        //! Callsign index
-        int get(const QString &callsign);
+        //! Learned delays and statistics of the callsign, empty for an unknown callsign
+        JitterBufferStatistics get(const QString &callsign) const;
 
-        //! Underflow
-        void underflow(const QString &callsign);
+        //! Update with the statistics of the jitter buffer
+        void update(const QString &callsign, const JitterBufferStatistics &statistics);
 
-        //! Success
-        void success(const QString &callsign);
+        //! Statistics of all callsigns
+        QHash<QString, JitterBufferStatistics> getAll() const;
 
-        //! Delay plus/minus
-        //! @{
-        void increaseDelayMs(const QString &callsign);
-        void decreaseDelayMs(const QString &callsign);
-        //! @}
+        //! Forget all callsigns
+        void clear();
 
         //! Singleton
         static CallsignDelayCache &instance();
@@ -45,13 +45,8 @@ namespace BlackCore::Afv::Audio
         //! Ctor
         CallsignDelayCache() = default;
 
-        static constexpr int delayDefault = 60;
-        static constexpr int delayMin = 40;
-        static constexpr int delayIncrement = 20;
-        static constexpr int delayMax = 300;
-
-        QHash<QString, int> m_delayCache;
-        QHash<QString, int> successfulTransmissionsCache;
+        mutable QMutex m_mutex;
+        QHash<QString, JitterBufferStatistics> m_delayCache;
     };
 
 } // ns
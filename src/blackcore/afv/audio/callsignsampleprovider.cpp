@@ -20,6 +20,7 @@
 #include <QDebug>
 #include <QStringLiteral>
 #include <QStringBuilder>
+#include <utility>
 
 using namespace BlackMisc;
 using namespace BlackSound::SampleProvider;
@@ -27,10 +28,11 @@ using namespace BlackConfig;
 
 namespace BlackCore::Afv::Audio
 {
-    CCallsignSampleProvider::CCallsignSampleProvider(const QAudioFormat &audioFormat, const CReceiverSampleProvider *receiver, QObject *parent) :
+    CCallsignSampleProvider::CCallsignSampleProvider(const QAudioFormat &audioFormat, const CReceiverSampleProvider *receiver, CAudioDecodePool *decodePool, QObject *parent) :
         ISampleProvider(parent),
         m_audioFormat(audioFormat),
         m_receiver(receiver),
+        m_decodePool(decodePool),
         m_decoder(audioFormat.sampleRate(), 1)
     {
         Q_ASSERT(audioFormat.channelCount() == 1);
@@ -71,20 +73,20 @@ namespace BlackCore::Afv::Audio
         connect(m_timer, &QTimer::timeout, this, &CCallsignSampleProvider::timerElapsed);
     }
 
-    int CCallsignSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CCallsignSampleProvider::readSamples(CSampleSpan samples)
     {
-        const int noOfSamples = m_mixer->readSamples(samples, count);
+        const int noOfSamples = m_mixer->readSamples(samples);
 
-        if (m_inUse && m_lastPacketLatch && m_audioInput->getBufferedBytes() == 0)
+        if (m_inUse && m_lastPacketLatch && this->isBufferEmpty())
         {
             idle();
             m_lastPacketLatch = false;
         }
 
-        if (m_inUse && !m_underflow && m_audioInput->getBufferedBytes() == 0)
+        if (m_inUse && !m_underflow && this->isBufferEmpty())
         {
+            // the jitter buffer is only used by the receiving thread, it adapts with the next packet
             if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay++]") << m_callsign; }
-            CallsignDelayCache::instance().underflow(m_callsign);
             m_underflow = true;
         }
 
@@ -93,7 +95,17 @@ namespace BlackCore::Afv::Audio
 
     void CCallsignSampleProvider::timerElapsed()
     {
-        if (m_inUse && m_audioInput->getBufferedBytes() == 0 && m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc()) > m_idleTimeoutMs)
+        if (!m_inUse) { return; }
+        const qint64 sinceLastSamplesMs = m_lastSamplesAddedUtc.msecsTo(QDateTime::currentDateTimeUtc());
+        if (m_jitterBuffer.isPlaying() && sinceLastSamplesMs > m_jitterBuffer.getTargetDelayMs())
+        {
+            // last packet lost, play out what was received
+            m_jitterBuffer.flush();
+            this->decodeFrames();
+            CallsignDelayCache::instance().update(m_callsign, m_jitterBuffer.getStatistics());
+            m_lastPacketLatch = m_jitterBuffer.isEnded();
+        }
+        if (this->isBufferEmpty() && sinceLastSamplesMs > m_idleTimeoutMs)
         {
             idle();
         }
@@ -102,29 +114,25 @@ namespace BlackCore::Afv::Audio
     void CCallsignSampleProvider::active(const QString &callsign, const QString &aircraftType)
     {
         m_callsign = callsign;
-        CallsignDelayCache::instance().initialise(callsign);
+        m_jitterBuffer.restart(CallsignDelayCache::instance().get(callsign));
         m_aircraftType = aircraftType;
-        m_decoder.resetState();
+        m_resetDecoder = true;
         m_inUse = true;
         setEffects();
         m_underflow = false;
 
-        const int delayMs = CallsignDelayCache::instance().get(callsign);
+        // the silence is added by the decoder, which is the only one adding samples
+        const int delayMs = m_jitterBuffer.getTargetDelayMs();
         if (verbose()) { CLogMessage(this).debug(u"[%1] [Delay %2ms]") << m_callsign << delayMs; }
-        if (delayMs > 0)
-        {
-            const int phaseDelayLength = (m_audioFormat.sampleRate() / 1000) * delayMs;
-            const QVector<float> phaseDelay(phaseDelayLength * 2, 0);
-            m_audioInput->addSamples(phaseDelay);
-        }
+        m_phaseDelaySamples = this->samplesForMs(delayMs);
     }
 
     void CCallsignSampleProvider::activeSilent(const QString &callsign, const QString &aircraftType)
     {
         m_callsign = callsign;
-        CallsignDelayCache::instance().initialise(callsign);
+        m_jitterBuffer.restart(CallsignDelayCache::instance().get(callsign));
         m_aircraftType = aircraftType;
-        m_decoder.resetState();
+        m_resetDecoder = true;
         m_inUse = true;
         setEffects(true);
         m_underflow = true;
@@ -133,6 +141,8 @@ namespace BlackCore::Afv::Audio
     void CCallsignSampleProvider::clear()
     {
         idle();
+        m_jitterBuffer.restart();
+        m_generation++;
         m_audioInput->clearBuffer();
     }
 
@@ -141,10 +151,20 @@ namespace BlackCore::Afv::Audio
         m_distanceRatio = distanceRatio;
         setEffects();
 
-        const QVector<qint16> audio = decodeOpus(audioDto.audio);
-        m_audioInput->addSamples(BlackSound::convertFromShortToFloat(audio));
-        m_lastPacketLatch = audioDto.lastPacket;
-        if (audioDto.lastPacket && !m_underflow) { CallsignDelayCache::instance().success(m_callsign); }
+        if (m_underflow.exchange(false) && m_jitterBuffer.isPlaying())
+        {
+            // played out faster than received, buffer again with the increased delay
+            m_jitterBuffer.underflow();
+            m_phaseDelaySamples = this->samplesForMs(m_jitterBuffer.getTargetDelayMs());
+        }
+
+        // the arrival at the network thread is not delayed by the event loop of the receiving thread
+        const qint64 arrivalMs = audioDto.receivedUs > 0 ? audioDto.receivedUs / 1000 : QDateTime::currentMSecsSinceEpoch();
+        m_jitterBuffer.put(audioDto.sequenceCounter, audioDto.audio, audioDto.lastPacket, arrivalMs, audioDto.receivedUs);
+        this->decodeFrames();
+        CallsignDelayCache::instance().update(m_callsign, m_jitterBuffer.getStatistics());
+
+        m_lastPacketLatch = m_jitterBuffer.isEnded();
         m_lastSamplesAddedUtc = QDateTime::currentDateTimeUtc();
         if (!m_timer->isActive()) { m_timer->start(); }
     }
@@ -170,6 +190,61 @@ namespace BlackCore::Afv::Audio
         m_aircraftType.clear();
     }
 
+    void CCallsignSampleProvider::decodeFrames()
+    {
+        JitterBufferFrame frame;
+        while (m_jitterBuffer.takeFrame(frame))
+        {
+            const bool resetDecoder  = std::exchange(m_resetDecoder, false);
+            const int silenceSamples = std::exchange(m_phaseDelaySamples, 0);
+            const int generation     = m_generation;
+            if (m_decodePool)
+            {
+                m_pendingDecodes++;
+                m_decodePool->decode(this, [ = ]
+                {
+                    this->decodeIntoBuffer(frame, resetDecoder, silenceSamples, generation);
+                    m_pendingDecodes--;
+                });
+            }
+            else
+            {
+                this->decodeIntoBuffer(frame, resetDecoder, silenceSamples, generation);
+            }
+        }
+    }
+
+    void CCallsignSampleProvider::decodeIntoBuffer(const JitterBufferFrame &frame, bool resetDecoder, int silenceSamples, int generation)
+    {
+        if (resetDecoder) { m_decoder.resetState(); }
+
+        // lost frames are concealed by the decoder, so it continues smoothly with the next frame
+        QVector<qint16> audio;
+        switch (frame.type)
+        {
+        case JitterBufferFrame::Decode:     audio = decodeOpus(frame.opus); break;
+        case JitterBufferFrame::ConcealFec: audio = m_decoder.decodeFec(frame.opus, m_frameCount); break;
+        case JitterBufferFrame::ConcealPlc: audio = m_decoder.decodeLost(m_frameCount); break;
+        }
+        if (generation != m_generation) { return; } // cleared meanwhile
+
+        if (frame.receivedUs > 0 && m_decodePool)
+        {
+            // until the first sample of the frame leaves the buffer, the buffer of the audio device is not included
+            const qint64 queuedSamples = m_audioInput->getBufferedBytes() + silenceSamples;
+            const qint64 playoutUs = CAudioDecodePool::nowUs() + queuedSamples * 1000000 / m_audioFormat.sampleRate();
+            m_decodePool->addPlayoutLatency(playoutUs - frame.receivedUs);
+        }
+
+        if (silenceSamples > 0) { m_audioInput->addSamples(QVector<float>(silenceSamples, 0)); }
+        m_audioInput->addSamples(BlackSound::convertFromShortToFloat(audio));
+    }
+
+    bool CCallsignSampleProvider::isBufferEmpty() const
+    {
+        return m_pendingDecodes < 1 && m_audioInput->getBufferedBytes() == 0;
+    }
+
     QVector<qint16> CCallsignSampleProvider::decodeOpus(const QByteArray &opusData)
     {
         int decodedLength = 0;
@@ -232,7 +307,8 @@ namespace BlackCore::Afv::Audio
     {
         return QStringLiteral("In use: ") % boolToYesNo(m_inUse) %
                 QStringLiteral(" cs: ")    % m_callsign %
-                QStringLiteral(" type: ")  % m_aircraftType;
+                QStringLiteral(" type: ")  % m_aircraftType %
+                QStringLiteral(" delay: ") % QString::number(m_jitterBuffer.getTargetDelayMs()) % QStringLiteral("ms");
     }
 
 } // ns
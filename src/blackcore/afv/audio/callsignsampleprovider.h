@@ -11,6 +11,8 @@
 #ifndef BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 #define BLACKCORE_AFV_AUDIO_CALLSIGNSAMPLEPROVIDER_H
 
+#include "blackcore/afv/audio/audiodecodepool.h"
+#include "blackcore/afv/audio/jitterbuffer.h"
 #include "blackcore/afv/dto.h"
 #include "blacksound/sampleprovider/pinknoisegenerator.h"
 #include "blacksound/sampleprovider/bufferedwaveprovider.h"
@@ -26,6 +28,7 @@
 #include <QSharedPointer>
 #include <QTimer>
 #include <QDateTime>
+#include <atomic>
 
 namespace BlackCore::Afv::Audio
 {
@@ -38,10 +41,12 @@ namespace BlackCore::Afv::Audio
 
     public:
         //! Ctor
-        CCallsignSampleProvider(const QAudioFormat &audioFormat, const BlackCore::Afv::Audio::CReceiverSampleProvider *receiver, QObject *parent = nullptr);
+        //! \param decodePool decodes in the pool, or directly if nullptr
+        CCallsignSampleProvider(const QAudioFormat &audioFormat, const BlackCore::Afv::Audio::CReceiverSampleProvider *receiver,
+                                CAudioDecodePool *decodePool = nullptr, QObject *parent = nullptr);
 
         //! Read samples
-        int readSamples(QVector<float> &samples, qint64 count) override;
+        int readSamples(BlackSound::SampleProvider::CSampleSpan samples) override;
 
         //! The callsign
         const QString &callsign() const { return m_callsign; }
@@ -77,6 +82,18 @@ namespace BlackCore::Afv::Audio
         void timerElapsed();
         void idle();
         QVector<qint16> decodeOpus(const QByteArray &opusData);
+
+        //! Decode the frames played out by the jitter buffer
+        void decodeFrames();
+
+        //! Decode into the buffer, frames are decoded one after another in the order they are played out
+        void decodeIntoBuffer(const JitterBufferFrame &frame, bool resetDecoder, int silenceSamples, int generation);
+
+        //! Number of samples for the duration
+        int samplesForMs(int ms) const { return (m_audioFormat.sampleRate() / 1000) * ms; }
+
+        //! No samples buffered and none waiting to be decoded
+        bool isBufferEmpty() const;
         void setEffects(bool noEffects = false);
 
         QAudioFormat m_audioFormat;
@@ -104,10 +121,16 @@ namespace BlackCore::Afv::Audio
         BlackSound::SampleProvider::CBufferedWaveProvider        *m_audioInput             = nullptr;
         QTimer *m_timer = nullptr;
 
-        BlackSound::Codecs::COpusDecoder m_decoder;
+        CJitterBuffer m_jitterBuffer;               //!< only used by the receiving thread
+        CAudioDecodePool *m_decodePool = nullptr;
+        BlackSound::Codecs::COpusDecoder m_decoder; //!< only used by decodeIntoBuffer
+        bool m_resetDecoder = false;                //!< reset the decoder with the next frame
+        int m_phaseDelaySamples = 0;                //!< silence added before the next frame
+        std::atomic_int m_pendingDecodes { 0 };     //!< frames in the decode pool
+        std::atomic_int m_generation { 0 };         //!< incremented when cleared, frames of an older generation are dropped
         bool m_lastPacketLatch = false;
         QDateTime m_lastSamplesAddedUtc;
-        bool m_underflow = false;
+        std::atomic_bool m_underflow { false };     //!< ran empty while receiving, set by the audio thread
     };
 } // ns
 
@@ -73,6 +73,7 @@ namespace BlackCore::Afv::Audio
     {
         this->setObjectName("CInput");
         m_encoder.setBitRate(16 * 1024);
+        m_encoder.setInbandFec(true); // receivers recover single lost frames from the next packet
     }
 
     bool CInput::setGainRatio(double gainRatio)
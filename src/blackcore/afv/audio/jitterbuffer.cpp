@@ -0,0 +1,250 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/afv/audio/jitterbuffer.h"
+
+#include <QStringLiteral>
+#include <QtMath>
+
+namespace BlackCore::Afv::Audio
+{
+    double JitterBufferStatistics::lossRatio() const
+    {
+        const int frames = received - late - duplicates + lost;
+        return frames > 0 ? static_cast<double>(lost) / frames : 0.0;
+    }
+
+    QString JitterBufferStatistics::toQString() const
+    {
+        return QStringLiteral("received: %1 late: %2 duplicates: %3 reordered: %4 lost: %5 (FEC: %6 PLC: %7) underflows: %8 jitter: %9ms target delay: %10ms").
+               arg(received).arg(late).arg(duplicates).arg(reordered).
+               arg(lost).arg(concealedFec).arg(concealedPlc).arg(underflows).
+               arg(jitterMs, 0, 'f', 1).arg(targetDelayMs);
+    }
+
+    CJitterBuffer::CJitterBuffer()
+    {
+        this->restart();
+    }
+
+    void CJitterBuffer::restart(const JitterBufferStatistics &history)
+    {
+        this->clearSlots();
+        m_started = false;
+        m_ended = false;
+        m_lastReceived = false;
+        m_concealedRun = 0;
+        m_hasTransit = false;
+
+        m_statistics = history;
+        if (history.received < 1)
+        {
+            m_statistics.targetDelayMs = DefaultDelayMs;
+            return;
+        }
+
+        // conditions of the last transmission do not last forever
+        m_statistics.reorderFrames = qMax(0, history.reorderFrames - 1);
+        m_statistics.underflowDelayMs = qMax(0, history.underflowDelayMs - FrameMs);
+        this->updateTargetDelay();
+    }
+
+    void CJitterBuffer::put(uint sequence, const QByteArray &opus, bool lastPacket, qint64 arrivalMs, qint64 receivedUs)
+    {
+        m_statistics.received++;
+
+        // a new transmission starts after the last packet of the previous one
+        if (!m_started || (m_ended && distance(sequence, m_next) >= 0)) { this->startStream(sequence); }
+        this->updateJitter(sequence, arrivalMs);
+
+        const int offset = distance(sequence, m_next);
+        if (offset < 0)
+        {
+            // already played out or concealed, wait longer next time unless it is hopelessly late
+            m_statistics.late++;
+            m_statistics.reordered++;
+            const int behind = distance(m_highest, sequence);
+            if (behind * FrameMs <= MaxDelayMs)
+            {
+                m_statistics.reorderFrames = qMax(m_statistics.reorderFrames, behind);
+                this->updateTargetDelay();
+            }
+            return;
+        }
+
+        if (this->isBuffered(sequence))
+        {
+            m_statistics.duplicates++;
+            return;
+        }
+
+        if (offset >= Capacity)
+        {
+            // far ahead of the played out frames, the frames in between are gone
+            m_statistics.lost += offset;
+            this->clearSlots();
+            m_next = sequence;
+            m_highest = sequence;
+            m_concealedRun = 0;
+        }
+
+        const int behind = distance(m_highest, sequence);
+        if (behind > 0)
+        {
+            m_statistics.reordered++;
+            m_statistics.reorderFrames = qMax(m_statistics.reorderFrames, behind);
+        }
+        else
+        {
+            m_highest = sequence;
+        }
+
+        Slot &s = this->slot(sequence);
+        s.used = true;
+        s.sequence = sequence;
+        s.opus = opus;
+        s.lastPacket = lastPacket;
+        s.receivedUs = receivedUs;
+        if (lastPacket) { m_lastReceived = true; }
+
+        this->updateTargetDelay();
+    }
+
+    bool CJitterBuffer::takeFrame(JitterBufferFrame &frame)
+    {
+        if (!m_started || m_ended) { return false; }
+
+        Slot &s = this->slot(m_next);
+        if (s.used && s.sequence == m_next)
+        {
+            frame.type = JitterBufferFrame::Decode;
+            frame.sequence = m_next;
+            frame.opus = s.opus;
+            frame.lastPacket = s.lastPacket;
+            frame.receivedUs = s.receivedUs;
+
+            s.used = false;
+            s.opus = QByteArray();
+            m_next++;
+            m_concealedRun = 0;
+            if (frame.lastPacket) { m_ended = true; }
+            return true;
+        }
+
+        // frame missing, wait for it as long as newer frames are within the target delay
+        const int received = distance(m_highest, m_next) + 1;
+        if (received < 1)
+        {
+            if (m_lastReceived) { m_ended = true; } // flushed
+            return false;
+        }
+        if (!m_lastReceived && received <= this->getHoldFrames()) { return false; }
+
+        if (m_concealedRun >= MaxConcealFrames)
+        {
+            // long gap, concealing it would only sound strange, continue with the next received frame
+            int skip = 1;
+            while (!this->isBuffered(m_next + static_cast<uint>(skip))) { skip++; }
+            m_statistics.lost += skip;
+            m_next += static_cast<uint>(skip);
+            m_concealedRun = 0;
+            return this->takeFrame(frame);
+        }
+
+        m_statistics.lost++;
+        frame.sequence = m_next;
+        frame.lastPacket = false;
+        frame.receivedUs = 0;
+        if (this->isBuffered(m_next + 1))
+        {
+            frame.type = JitterBufferFrame::ConcealFec;
+            frame.opus = this->slot(m_next + 1).opus;
+            m_statistics.concealedFec++;
+        }
+        else
+        {
+            frame.type = JitterBufferFrame::ConcealPlc;
+            frame.opus = QByteArray();
+            m_statistics.concealedPlc++;
+        }
+        m_next++;
+        m_concealedRun++;
+        return true;
+    }
+
+    void CJitterBuffer::underflow()
+    {
+        m_statistics.underflows++;
+        m_statistics.underflowDelayMs = qMin(m_statistics.underflowDelayMs + FrameMs, MaxDelayMs);
+        this->updateTargetDelay();
+    }
+
+    void CJitterBuffer::flush()
+    {
+        if (m_started) { m_lastReceived = true; }
+    }
+
+    int CJitterBuffer::getBufferedPackets() const
+    {
+        int packets = 0;
+        for (const Slot &s : m_slots)
+        {
+            if (s.used) { packets++; }
+        }
+        return packets;
+    }
+
+    void CJitterBuffer::startStream(uint sequence)
+    {
+        this->clearSlots();
+        m_next = sequence;
+        m_highest = sequence;
+        m_first = sequence;
+        m_started = true;
+        m_ended = false;
+        m_lastReceived = false;
+        m_concealedRun = 0;
+        m_hasTransit = false;
+    }
+
+    void CJitterBuffer::clearSlots()
+    {
+        for (Slot &s : m_slots)
+        {
+            s.used = false;
+            s.opus = QByteArray();
+        }
+    }
+
+    void CJitterBuffer::updateJitter(uint sequence, qint64 arrivalMs)
+    {
+        // RFC 3550 inter-arrival jitter, the frames are sent every FrameMs
+        const qint64 transitMs = arrivalMs - static_cast<qint64>(distance(sequence, m_first)) * FrameMs;
+        if (m_hasTransit)
+        {
+            const double d = static_cast<double>(qAbs(transitMs - m_lastTransitMs));
+            m_statistics.jitterMs += (d - m_statistics.jitterMs) / 16.0;
+        }
+        m_lastTransitMs = transitMs;
+        m_hasTransit = true;
+    }
+
+    void CJitterBuffer::updateTargetDelay()
+    {
+        const double delayMs = FrameMs + JitterFactor * m_statistics.jitterMs + m_statistics.reorderFrames * FrameMs + m_statistics.underflowDelayMs;
+        int targetMs = qCeil(delayMs);
+        if (m_statistics.received < LearningPackets) { targetMs = qMax(targetMs, DefaultDelayMs); }
+        m_statistics.targetDelayMs = qBound(MinDelayMs, targetMs, MaxDelayMs);
+    }
+
+    bool CJitterBuffer::isBuffered(uint sequence) const
+    {
+        const Slot &s = this->slot(sequence);
+        return s.used && s.sequence == sequence;
+    }
+} // ns
@@ -0,0 +1,171 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+#define BLACKCORE_AFV_AUDIO_JITTERBUFFER_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <array>
+
+namespace BlackCore::Afv::Audio
+{
+    //! Latency and loss of the voice stream of one callsign
+    struct BLACKCORE_EXPORT JitterBufferStatistics
+    {
+        int received = 0;         //!< received packets
+        int late = 0;             //!< packets received after their frame was played out or concealed
+        int duplicates = 0;       //!< packets received more than once
+        int reordered = 0;        //!< packets received after a newer one
+        int lost = 0;             //!< frames never received in time
+        int concealedFec = 0;     //!< lost frames recovered from the forward error correction of the next packet
+        int concealedPlc = 0;     //!< lost frames concealed by the packet loss concealment of the decoder
+        int underflows = 0;       //!< played out faster than received
+        double jitterMs = 0.0;    //!< inter-arrival jitter
+        int reorderFrames = 0;    //!< how far packets arrived out of order
+        int underflowDelayMs = 0; //!< delay added after underflows
+        int targetDelayMs = 0;    //!< delay between receiving and playing out
+
+        //! Ratio of lost frames
+        double lossRatio() const;
+
+        //! As string
+        QString toQString() const;
+    };
+
+    //! Frame played out by the jitter buffer
+    struct JitterBufferFrame
+    {
+        //! How to decode the frame
+        enum Type
+        {
+            Decode,       //!< decode the received packet
+            ConcealFec,   //!< lost, decode the forward error correction of the next packet
+            ConcealPlc    //!< lost, use the packet loss concealment of the decoder
+        };
+
+        Type type = Decode;      //!< type
+        uint sequence = 0;       //!< AFV sequence number of the frame
+        QByteArray opus;         //!< received packet, or next packet for ConcealFec
+        bool lastPacket = false; //!< last packet of the transmission
+        qint64 receivedUs = 0;   //!< arrival of the received packet, 0 if concealed or unknown
+    };
+
+    //! Adaptive jitter buffer for the Opus frames of one callsign, keyed on the AFV sequence numbers
+    //! \details Packets are played out in sequence order. A missing frame is waited for as long as the
+    //!          target delay allows, then it is concealed. The target delay follows the inter-arrival jitter
+    //!          (RFC 3550), the reordering depth and the underflows of the stream.
+    //! \remark the arrival times are passed in, so the buffer is deterministic; not thread safe
+    class BLACKCORE_EXPORT CJitterBuffer
+    {
+    public:
+        static constexpr int FrameMs          = 20;  //!< duration of one AFV frame
+        static constexpr int MinDelayMs       = 40;  //!< min. target delay
+        static constexpr int DefaultDelayMs   = 60;  //!< target delay of an unknown stream
+        static constexpr int MaxDelayMs       = 300; //!< max. target delay
+        static constexpr int Capacity         = 32;  //!< max. number of buffered packets, larger than the max. delay
+        static constexpr int MaxConcealFrames = 5;   //!< longer gaps are skipped instead of concealed
+
+        //! Ctor
+        CJitterBuffer();
+
+        //! Start with the history of the stream, or an empty one for a new stream
+        //! \remark drops buffered packets, the delays learned before shrink a little
+        void restart(const JitterBufferStatistics &history = {});
+
+        //! Add a received packet
+        //! \param arrivalMs  for the jitter estimate, any clock
+        //! \param receivedUs passed on with the frame to measure the latency until playout
+        void put(uint sequence, const QByteArray &opus, bool lastPacket, qint64 arrivalMs, qint64 receivedUs = 0);
+
+        //! Next frame to play out
+        //! \return false if the next frame has to be waited for
+        bool takeFrame(JitterBufferFrame &frame);
+
+        //! The buffer ran empty while playing out, increases the target delay
+        void underflow();
+
+        //! Delay between receiving and playing out
+        int getTargetDelayMs() const { return m_statistics.targetDelayMs; }
+
+        //! Number of frames a missing frame is waited for
+        int getHoldFrames() const { return qMax(1, m_statistics.targetDelayMs / FrameMs); }
+
+        //! Number of buffered packets
+        int getBufferedPackets() const;
+
+        //! Last packet of the transmission played out?
+        bool isEnded() const { return m_ended; }
+
+        //! Transmission received and not yet ended?
+        bool isPlaying() const { return m_started && !m_ended; }
+
+        //! No more packets expected, the remaining frames are played out without waiting
+        void flush();
+
+        //! Statistics, including the learned delays
+        const JitterBufferStatistics &getStatistics() const { return m_statistics; }
+
+    private:
+        //! Buffered packet
+        struct Slot
+        {
+            bool used = false;
+            uint sequence = 0;
+            QByteArray opus;
+            bool lastPacket = false;
+            qint64 receivedUs = 0;
+        };
+
+        //! Start a stream with this sequence number
+        void startStream(uint sequence);
+
+        //! Drop all buffered packets
+        void clearSlots();
+
+        //! Update the jitter estimate
+        void updateJitter(uint sequence, qint64 arrivalMs);
+
+        //! Recalculate the target delay
+        void updateTargetDelay();
+
+        //! Slot of the sequence number
+        //! @{
+        Slot &slot(uint sequence) { return m_slots[sequence % Capacity]; }
+        const Slot &slot(uint sequence) const { return m_slots[sequence % Capacity]; }
+        //! @}
+
+        //! Packet buffered?
+        bool isBuffered(uint sequence) const;
+
+        //! Frames from b to a, handles the wrap around of the sequence numbers
+        static int distance(uint a, uint b) { return static_cast<qint32>(a - b); }
+
+        static constexpr int    LearningPackets = 16;  //!< packets until the jitter estimate is trusted
+        static constexpr double JitterFactor    = 4.0; //!< target delay in multiples of the jitter
+
+        std::array<Slot, Capacity> m_slots;
+        JitterBufferStatistics m_statistics;
+        uint m_next = 0;             //!< next sequence number to play out
+        uint m_highest = 0;          //!< highest received sequence number
+        uint m_first = 0;            //!< first sequence number of the stream
+        bool m_started = false;      //!< first packet received
+        bool m_ended = false;        //!< last packet played out
+        bool m_lastReceived = false; //!< last packet buffered, the remaining frames are played without waiting
+        int m_concealedRun = 0;      //!< consecutive concealed frames
+        bool m_hasTransit = false;   //!< m_lastTransitMs valid
+        qint64 m_lastTransitMs = 0;  //!< arrival time minus sending time of the previous packet
+    };
+} // ns
+
+#endif // guard
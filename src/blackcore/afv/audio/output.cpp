@@ -8,13 +8,16 @@
 
 #include "blackcore/afv/audio/output.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/dspkernels.h"
 #include "blackmisc/metadatautils.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 
 #include <QDebug>
 #include <QStringBuilder>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Audio;
@@ -36,17 +39,35 @@ namespace BlackCore::Afv::Audio
     {
         const int sampleBytes  = m_outputFormat.sampleSize() / 8;
         const int channelCount = m_outputFormat.channelCount();
-        const qint64 count     = maxlen / (sampleBytes * channelCount);
-        QVector<float> buffer;
-        m_sampleProvider->readSamples(buffer, count);
+        const int frameBytes   = sampleBytes * channelCount;
+        const qint64 count     = maxlen / frameBytes;
+        Q_ASSERT_X(sampleBytes == static_cast<int>(sizeof(float)), Q_FUNC_INFO, "Output format has to be float");
 
-        for (float sample : std::as_const(buffer))
+        // the graph reads blocks of max. ISampleProvider::MaxBlockSize into the preallocated buffer
+        for (qint64 offset = 0; offset < count;)
         {
-            const float absSample = qAbs(sample);
-            if (absSample > m_maxSampleOutput) { m_maxSampleOutput = absSample; }
+            const CSampleSpan block = m_buffer.span(static_cast<int>(qMin<qint64>(count - offset, m_buffer.capacity())));
+            const int samplesRead = m_sampleProvider->readSamples(block);
+            std::fill(block.begin() + samplesRead, block.end(), 0.0f);
+
+            m_maxSampleOutput = qMax(m_maxSampleOutput, Dsp::peak(block.data(), block.size()));
+            char *output = data + offset * frameBytes;
+            for (float sample : block)
+            {
+                for (int channel = 0; channel < channelCount; channel++)
+                {
+                    memcpy(output, &sample, sizeof(float));
+                    output += sizeof(float);
+                }
+            }
+            offset += block.size();
         }
 
-        m_sampleCount += buffer.size();
+        // incomplete frame
+        const qint64 written = count * frameBytes;
+        if (written < maxlen) { memset(data + written, 0, static_cast<size_t>(maxlen - written)); }
+
+        m_sampleCount += static_cast<int>(count);
         if (m_sampleCount >= SampleCountPerEvent)
         {
             OutputVolumeStreamArgs outputVolumeStreamArgs;
@@ -62,12 +83,6 @@ namespace BlackCore::Afv::Audio
             m_maxSampleOutput = 0;
         }
 
-        if (channelCount == 2)
-        {
-            buffer = convertFromMonoToStereo(buffer);
-        }
-
-        memcpy(data, buffer.constData(), static_cast<size_t>(maxlen));
         return maxlen;
     }
 
@@ -52,6 +52,7 @@ namespace BlackCore::Afv::Audio
 
     private:
         BlackSound::SampleProvider::ISampleProvider *m_sampleProvider = nullptr; //!< related provider
+        BlackSound::SampleProvider::CSampleBuffer m_buffer { BlackSound::SampleProvider::ISampleProvider::MaxBlockSize }; //!< block read from the provider, allocated once
 
         static constexpr int SampleCountPerEvent = 4800;
         QAudioFormat m_outputFormat;
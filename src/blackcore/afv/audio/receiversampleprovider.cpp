@@ -30,7 +30,7 @@ namespace BlackCore::Afv::Audio
         return cats;
     }
 
-    CReceiverSampleProvider::CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, QObject *parent) :
+    CReceiverSampleProvider::CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, CAudioDecodePool *decodePool, QObject *parent) :
         ISampleProvider(parent),
         m_id(id)
     {
@@ -40,13 +40,18 @@ namespace BlackCore::Afv::Audio
         m_mixer = new CMixingSampleProvider(this);
         for (int i = 0; i < voiceInputNumber; i++)
         {
-            const auto voiceInput = new CCallsignSampleProvider(audioFormat, this, m_mixer);
+            const auto voiceInput = new CCallsignSampleProvider(audioFormat, this, decodePool, m_mixer);
             m_voiceInputs.push_back(voiceInput);
             m_mixer->addMixerInput(voiceInput);
         }
 
         m_blockTone = new CSinusGenerator(180, this);
         m_mixer->addMixerInput(m_blockTone);
+
+        // created once and restarted, not owned by the mixer so it is kept when finished
+        m_click = new CResourceSoundSampleProvider(Samples::instance().click(), this);
+        m_click->stop();
+        m_mixer->addMixerInput(m_click);
         m_volume = new CVolumeSampleProvider(m_mixer);
     }
 
@@ -91,7 +96,7 @@ namespace BlackCore::Afv::Audio
         }
     }
 
-    int CReceiverSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CReceiverSampleProvider::readSamples(CSampleSpan samples)
     {
         int numberOfInUseInputs = activeCallsigns();
         if (numberOfInUseInputs > 1 && m_doBlockWhenAppropriate)
@@ -106,8 +111,7 @@ namespace BlackCore::Afv::Audio
 
         if (m_doClickWhenAppropriate && numberOfInUseInputs == 0)
         {
-            CResourceSoundSampleProvider *resourceSound = new CResourceSoundSampleProvider(Samples::instance().click(), m_mixer);
-            m_mixer->addMixerInput(resourceSound);
+            m_click->restart();
             m_doClickWhenAppropriate = false;
             // CLogMessage(this).debug(u"AFV Click...");
         }
@@ -131,7 +135,7 @@ namespace BlackCore::Afv::Audio
             emit receivingCallsignsChanged(args);
         }
         m_lastNumberOfInUseInputs = numberOfInUseInputs;
-        return m_volume->readSamples(samples, count);
+        return m_volume->readSamples(samples);
     }
 
     void CReceiverSampleProvider::addOpusSamples(const IAudioDto &audioDto, uint frequency, float distanceRatio)
@@ -12,8 +12,10 @@
 #define BLACKCORE_AFV_AUDIO_RECEIVERSAMPLEPROVIDER_H
 
 #include "blackcore/afv/audio/callsignsampleprovider.h"
+#include "blackcore/blackcoreexport.h"
 #include "blacksound/sampleprovider/sampleprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/resourcesoundsampleprovider.h"
 #include "blacksound/sampleprovider/sinusgenerator.h"
 #include "blacksound/sampleprovider/volumesampleprovider.h"
 
@@ -33,7 +35,7 @@ namespace BlackCore::Afv::Audio
     };
 
     //! A sample provider
-    class CReceiverSampleProvider : public BlackSound::SampleProvider::ISampleProvider
+    class BLACKCORE_EXPORT CReceiverSampleProvider : public BlackSound::SampleProvider::ISampleProvider
     {
         Q_OBJECT
 
@@ -42,7 +44,8 @@ namespace BlackCore::Afv::Audio
         static const QStringList &getLogCategories();
 
         //! Ctor
-        CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, QObject *parent = nullptr);
+        //! \param decodePool decodes the audio of the callsigns, directly if nullptr
+        CReceiverSampleProvider(const QAudioFormat &audioFormat, quint16 id, int voiceInputNumber, CAudioDecodePool *decodePool = nullptr, QObject *parent = nullptr);
 
         //! Bypass effects
         void setBypassEffects(bool value);
@@ -63,7 +66,7 @@ namespace BlackCore::Afv::Audio
         //! @}
 
         //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(BlackSound::SampleProvider::CSampleSpan samples) override;
 
         //! Add samples
         //! @{
@@ -108,6 +111,7 @@ namespace BlackCore::Afv::Audio
         BlackSound::SampleProvider::CVolumeSampleProvider *m_volume    = nullptr;
         BlackSound::SampleProvider::CMixingSampleProvider *m_mixer     = nullptr;
         BlackSound::SampleProvider::CSinusGenerator       *m_blockTone = nullptr;
+        BlackSound::SampleProvider::CResourceSoundSampleProvider *m_click = nullptr;
         QVector<CCallsignSampleProvider *> m_voiceInputs;
         qint64 m_lastLogMessage = -1;
 
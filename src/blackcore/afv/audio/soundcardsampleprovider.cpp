@@ -18,6 +18,7 @@ namespace BlackCore::Afv::Audio
 {
     CSoundcardSampleProvider::CSoundcardSampleProvider(int sampleRate, const QVector<quint16> &transceiverIDs, QObject *parent) :
         ISampleProvider(parent),
+        m_decodePool(new CAudioDecodePool()),
         m_mixer(new CMixingSampleProvider())
     {
         const QString on = QStringLiteral("%1 sample rate: %2, transceivers: %3").arg(classNameShort(this)).arg(sampleRate).arg(transceiverIDs.size());
@@ -36,7 +37,7 @@ namespace BlackCore::Afv::Audio
         constexpr int voiceInputNumber = 4; // number of CallsignSampleProviders
         for (quint16 transceiverID : transceiverIDs)
         {
-            CReceiverSampleProvider *transceiverInput = new CReceiverSampleProvider(m_waveFormat, transceiverID, voiceInputNumber, m_mixer);
+            CReceiverSampleProvider *transceiverInput = new CReceiverSampleProvider(m_waveFormat, transceiverID, voiceInputNumber, m_decodePool.get(), m_mixer);
             connect(transceiverInput, &CReceiverSampleProvider::receivingCallsignsChanged, this, &CSoundcardSampleProvider::receivingCallsignsChanged);
             m_receiverInputs.push_back(transceiverInput);
             m_receiverIDs.push_back(transceiverID);
@@ -87,9 +88,9 @@ namespace BlackCore::Afv::Audio
         }
     }
 
-    int CSoundcardSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CSoundcardSampleProvider::readSamples(CSampleSpan samples)
     {
-        return m_mixer->readSamples(samples, count);
+        return m_mixer->readSamples(samples);
     }
 
     void CSoundcardSampleProvider::addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers)
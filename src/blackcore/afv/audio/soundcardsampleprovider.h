@@ -13,11 +13,13 @@
 
 #include "blacksound/sampleprovider/sampleprovider.h"
 #include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blackcore/afv/audio/audiodecodepool.h"
 #include "blackcore/afv/audio/receiversampleprovider.h"
 #include "blackmisc/aviation/callsignset.h"
 
 #include <QAudioFormat>
 #include <QObject>
+#include <memory>
 
 namespace BlackCore::Afv::Audio
 {
@@ -40,7 +42,7 @@ namespace BlackCore::Afv::Audio
         void pttUpdate(bool active, const QVector<TxTransceiverDto> &txTransceivers);
 
         //! \copydoc BlackSound::SampleProvider::ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(BlackSound::SampleProvider::CSampleSpan samples) override;
 
         //! Add OPUS samples
         void addOpusSamples(const IAudioDto &audioDto, const QVector<RxTransceiverDto> &rxTransceivers);
@@ -57,11 +59,18 @@ namespace BlackCore::Afv::Audio
         //! Setting gain for specified receiver
         bool setGainRatioForTransceiver(quint16 transceiverID, double gainRatio);
 
+        //! Decode times and latencies
+        AudioDecodeStatistics getDecodeStatistics() const { return m_decodePool->getStatistics(); }
+
+        //! Reset decode times and latencies
+        void resetDecodeStatistics() { m_decodePool->resetStatistics(); }
+
     signals:
         //! Changed callsigns
         void receivingCallsignsChanged(const TransceiverReceivingCallsignsChangedArgs &args);
 
     private:
+        std::unique_ptr<CAudioDecodePool> m_decodePool; //!< destroyed before the receivers, which are children
         QAudioFormat m_waveFormat;
         BlackSound::SampleProvider::CMixingSampleProvider *m_mixer = nullptr;
         QVector<CReceiverSampleProvider *> m_receiverInputs;
@@ -7,6 +7,7 @@
  */
 
 #include "blackcore/afv/clients/afvclient.h"
+#include "blackcore/afv/audio/callsigndelaycache.h"
 #include "blackcore/context/contextownaircraft.h"
 #include "blackcore/context/contextnetwork.h"
 #include "blackcore/context/contextsimulator.h"
@@ -903,7 +904,7 @@ namespace BlackCore::Afv::Clients
             audioData.audio      = QByteArray(args.audio.data(), args.audio.size());
             audioData.callsign   = QStringLiteral("loopback");
             audioData.lastPacket = false;
-            audioData.sequenceCounter = 0;
+            audioData.sequenceCounter = args.sequenceCounter;
 
             const RxTransceiverDto com1 = { 0, transceivers.size() > 0 ?  transceivers[0].frequencyHz : UniCom, 1.0 };
             const RxTransceiverDto com2 = { 1, transceivers.size() > 1 ?  transceivers[1].frequencyHz : UniCom, 1.0 };
@@ -946,13 +947,14 @@ namespace BlackCore::Afv::Clients
         }
     }
 
-    void CAfvClient::audioOutDataAvailable(const AudioRxOnTransceiversDto &dto)
+    void CAfvClient::audioOutDataAvailable(const AudioRxOnTransceiversDto &dto, qint64 receivedUs)
     {
         IAudioDto audioData;
         audioData.audio           = QByteArray(dto.audio.data(), static_cast<int>(dto.audio.size()));
         audioData.callsign        = QString::fromStdString(dto.callsign);
         audioData.lastPacket      = dto.lastPacket;
         audioData.sequenceCounter = dto.sequenceCounter;
+        audioData.receivedUs      = receivedUs;
 
         QMutexLocker lock(&m_mutexSampleProviders);
         m_soundcardSampleProvider->addOpusSamples(audioData, QVector<RxTransceiverDto>(dto.transceivers.begin(), dto.transceivers.end()));
@@ -992,6 +994,35 @@ namespace BlackCore::Afv::Clients
         return m_soundcardSampleProvider->getReceivingCallsignsString(comUnitToTransceiverId(CComSystem::Com2));
     }
 
+    AudioDecodeStatistics CAfvClient::getDecodeStatistics() const
+    {
+        QMutexLocker lock(&m_mutexSampleProviders);
+        if (!m_soundcardSampleProvider) { return {}; }
+        return m_soundcardSampleProvider->getDecodeStatistics();
+    }
+
+    void CAfvClient::resetDecodeStatistics()
+    {
+        QMutexLocker lock(&m_mutexSampleProviders);
+        if (m_soundcardSampleProvider) { m_soundcardSampleProvider->resetDecodeStatistics(); }
+    }
+
+    QHash<QString, JitterBufferStatistics> CAfvClient::getJitterBufferStatistics() const
+    {
+        return CallsignDelayCache::instance().getAll();
+    }
+
+    JitterBufferStatistics CAfvClient::getJitterBufferStatistics(const QString &callsign) const
+    {
+        return CallsignDelayCache::instance().get(callsign);
+    }
+
+    VoiceSocketStatistics CAfvClient::getVoiceSocketStatistics() const
+    {
+        QMutexLocker lock(&m_mutexConnection);
+        return m_connection->getVoiceSocketStatistics();
+    }
+
     CCallsignSet CAfvClient::getReceivingCallsignsCom1() const
     {
         QMutexLocker lock(&m_mutexSampleProviders);
@@ -14,6 +14,7 @@
 #include "blackcore/context/contextownaircraft.h"
 #include "blackcore/afv/connection/clientconnection.h"
 #include "blackcore/afv/audio/input.h"
+#include "blackcore/afv/audio/jitterbuffer.h"
 #include "blackcore/afv/audio/output.h"
 #include "blackcore/afv/audio/soundcardsampleprovider.h"
 #include "blackcore/afv/dto.h"
@@ -30,6 +31,7 @@
 #include "blackmisc/worker.h"
 
 #include <QDateTime>
+#include <QHash>
 #include <QAudioInput>
 #include <QAudioOutput>
 #include <QObject>
@@ -274,6 +276,24 @@ namespace BlackCore::Afv::Clients
         QStringList getReceivingCallsignsStringCom1Com2() const;
         //! @}
 
+        //! Decode times and latencies of the received audio
+        //! \threadsafe
+        //! @{
+        Audio::AudioDecodeStatistics getDecodeStatistics() const;
+        void resetDecodeStatistics();
+        //! @}
+
+        //! Latency and loss of the received audio per callsign
+        //! \threadsafe
+        //! @{
+        QHash<QString, Audio::JitterBufferStatistics> getJitterBufferStatistics() const;
+        Audio::JitterBufferStatistics getJitterBufferStatistics(const QString &callsign) const;
+        //! @}
+
+        //! Datagrams received by the network thread of the voice connection
+        //! \threadsafe
+        Connection::VoiceSocketStatistics getVoiceSocketStatistics() const;
+
         //! Update the voice server URL
         bool updateVoiceServerUrl(const QString &url);
 
@@ -325,7 +345,7 @@ namespace BlackCore::Afv::Clients
 
     private:
         void opusDataAvailable(const Audio::OpusDataAvailableArgs &args);  // threadsafe
-        void audioOutDataAvailable(const AudioRxOnTransceiversDto &dto);   // threadsafe
+        void audioOutDataAvailable(const AudioRxOnTransceiversDto &dto, qint64 receivedUs); // threadsafe
         void inputVolumeStream(const Audio::InputVolumeStreamArgs &args);
         void outputVolumeStream(const Audio::OutputVolumeStreamArgs &args);
         void inputOpusDataAvailable();
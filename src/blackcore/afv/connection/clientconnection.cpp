@@ -10,7 +10,7 @@
 #include "blackmisc/logmessage.h"
 #include "blackconfig/buildconfig.h"
 
-#include <QNetworkDatagram>
+#include <algorithm>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -20,7 +20,6 @@ namespace BlackCore::Afv::Connection
 {
     CClientConnection::CClientConnection(const QString &apiServer, QObject *parent) :
         QObject(parent),
-        m_udpSocket(new QUdpSocket(this)),
         m_voiceServerTimer(new QTimer(this)),
         m_apiServerConnection(new CApiServerConnection(apiServer, this))
     {
@@ -31,8 +30,12 @@ namespace BlackCore::Afv::Connection
         // connect(&m_apiServerConnection, &ApiServerConnection::removeCallsignFinished, this, &ClientConnection::removeCallsignFinished);
 
         connect(m_voiceServerTimer, &QTimer::timeout, this, &CClientConnection::voiceServerHeartbeat); // sends heartbeat to server
-        connect(m_udpSocket, &QUdpSocket::readyRead,  this, &CClientConnection::readPendingDatagrams);
-        connect(m_udpSocket, qOverload<QAbstractSocket::SocketError>(&QUdpSocket::error), this, &CClientConnection::handleSocketError);
+
+        // called in the network thread, the datagrams are taken in the thread of this object
+        m_voiceSocket.setNotify([this]
+        {
+            QMetaObject::invokeMethod(this, &CClientConnection::readPendingDatagrams, Qt::QueuedConnection);
+        });
     }
 
     void CClientConnection::connectTo(const QString &userName, const QString &password, const QString &callsign, const QString &client, ConnectionCallback callback)
@@ -65,7 +68,7 @@ namespace BlackCore::Afv::Connection
                     this->connectToVoiceServer();
                     // taskServerConnectionCheck.Start();
 
-                    CLogMessage(this).info(u"Connected: '%1' to voice server, socket open: %2") << cs << boolToYesNo(m_udpSocket->isOpen());
+                    CLogMessage(this).info(u"Connected: '%1' to voice server, socket open: %2") << cs << boolToYesNo(m_voiceSocket.isOpen());
                 }
                 else
                 {
@@ -131,8 +134,12 @@ namespace BlackCore::Afv::Connection
 
     void CClientConnection::connectToVoiceServer()
     {
-        const QHostAddress localAddress(QHostAddress::AnyIPv4);
-        m_udpSocket->bind(localAddress);
+        const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
+        if (!m_voiceSocket.open(QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port())))
+        {
+            CLogMessage(this).warning(u"Cannot open UDP socket to voice server '%1': %2") << m_connection.getTokens().VoiceServer.addressIpV4 << m_voiceSocket.getLastError();
+            return;
+        }
         m_voiceServerTimer->start(3000);
 
         CLogMessage(this).info(u"Connected to voice server '%1'") << m_connection.getTokens().VoiceServer.addressIpV4;
@@ -141,20 +148,30 @@ namespace BlackCore::Afv::Connection
     void CClientConnection::disconnectFromVoiceServer()
     {
         m_voiceServerTimer->stop();
-        m_udpSocket->disconnectFromHost();
+        m_voiceSocket.close();
+        CLogMessage(this).debug(u"Voice socket: %1") << m_voiceSocket.getStatistics().toQString();
         CLogMessage(this).info(u"All TaskVoiceServer tasks stopped");
     }
 
     void CClientConnection::readPendingDatagrams()
     {
-        while (m_udpSocket->hasPendingDatagrams())
+        // all datagrams queued by the network thread, taken without locks
+        qint64 receivedUs = 0;
+        for (int size = m_voiceSocket.takeDatagram(m_receivePacket.receiveBuffer(), receivedUs); size >= 0;
+                size = m_voiceSocket.takeDatagram(m_receivePacket.receiveBuffer(), receivedUs))
         {
-            const QNetworkDatagram datagram = m_udpSocket->receiveDatagram();
-            this->processMessage(datagram.data());
+            this->processReceivedPacket(size, false, receivedUs);
         }
     }
 
     void CClientConnection::processMessage(const QByteArray &messageDdata, bool loopback)
+    {
+        if (messageDdata.size() > CCryptoDtoPacket::MaxSize) { return; }
+        std::copy(messageDdata.cbegin(), messageDdata.cend(), m_receivePacket.receiveBuffer());
+        this->processReceivedPacket(messageDdata.size(), loopback, CVoiceSocket::nowUs());
+    }
+
+    void CClientConnection::processReceivedPacket(int size, bool loopback, qint64 receivedUs)
     {
         if (!m_connection.m_voiceCryptoChannel)
         {
@@ -162,47 +179,43 @@ namespace BlackCore::Afv::Connection
             return;
         }
 
-        CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(*m_connection.m_voiceCryptoChannel, messageDdata, loopback);
-
-        if (deserializer.m_dtoNameBuffer == AudioRxOnTransceiversDto::getShortDtoName())
+        m_receivePacket.deserialize(*m_connection.m_voiceCryptoChannel, size, loopback);
+        if (m_receivePacket.isDto<AudioRxOnTransceiversDto>())
         {
             // qDebug() << "Received audio data";
-            const AudioRxOnTransceiversDto audioOnTransceiverDto = deserializer.getDto<AudioRxOnTransceiversDto>();
-            if (m_connection.isReceivingAudio() && m_connection.isConnected())
+            if (m_connection.isReceivingAudio() && m_connection.isConnected() && m_receivePacket.getDto(m_audioRxDto))
             {
-                emit audioReceived(audioOnTransceiverDto);
+                emit audioReceived(m_audioRxDto, receivedUs);
             }
         }
-        else if (deserializer.m_dtoNameBuffer == HeartbeatAckDto::getShortDtoName())
+        else if (m_receivePacket.isDto<HeartbeatAckDto>())
         {
             m_connection.setTsHeartbeatToNow();
             if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Received voice server heartbeat"); }
         }
         else
         {
-            CLogMessage(this).warning(u"Received unknown data: %1 %2") << QString(deserializer.m_dtoNameBuffer) << deserializer.m_dataLength;
+            const std::string_view dtoName = m_receivePacket.getDtoName();
+            CLogMessage(this).warning(u"Received unknown data: %1 %2") << QString::fromUtf8(dtoName.data(), static_cast<int>(dtoName.size())) << m_receivePacket.getDtoLength();
         }
     }
 
-    void CClientConnection::handleSocketError(QAbstractSocket::SocketError error)
-    {
-        Q_UNUSED(error)
-        CLogMessage(this).debug(u"UDP socket error: '%1'") << m_udpSocket->errorString();
-    }
-
     void CClientConnection::voiceServerHeartbeat()
     {
-        if (!m_connection.m_voiceCryptoChannel || !m_udpSocket)
+        if (!m_connection.m_voiceCryptoChannel || !m_voiceSocket.isOpen())
         {
             BLACK_VERIFY_X(false, Q_FUNC_INFO, "voiceServerHeartbeat used without crypto channel or socket");
             return;
         }
 
-        const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
-        if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Sending voice server heartbeat to '%1'") << voiceServerUrl.host(); }
+        if (CBuildConfig::isLocalDeveloperDebugBuild()) { CLogMessage(this).debug(u"Sending voice server heartbeat to '%1'") << m_connection.getTokens().VoiceServer.addressIpV4; }
         HeartbeatDto keepAlive;
         keepAlive.callsign = m_connection.getCallsign().toStdString();
-        const QByteArray dataBytes = CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, keepAlive);
-        m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+        QMutexLocker lock(&m_mutexSendPacket);
+        if (!m_sendPacket.serialize(*m_connection.m_voiceCryptoChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, keepAlive)) { return; }
+        if (!m_voiceSocket.send(m_sendPacket.data(), m_sendPacket.size()))
+        {
+            CLogMessage(this).debug(u"Sending voice server heartbeat failed");
+        }
     }
 } // ns
@@ -11,16 +11,18 @@
 #ifndef BLACKCORE_AFV_CONNECTION_CLIENTCONNECTION_H
 #define BLACKCORE_AFV_CONNECTION_CLIENTCONNECTION_H
 
+#include "blackcore/afv/crypto/cryptodtopacket.h"
 #include "blackcore/afv/crypto/cryptodtoserializer.h"
 #include "blackcore/afv/connection/clientconnectiondata.h"
 #include "blackcore/afv/connection/apiserverconnection.h"
+#include "blackcore/afv/connection/voicesocket.h"
 #include "blackcore/afv/dto.h"
 #include "blackmisc/verify.h"
 
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QTimer>
-#include <QUdpSocket>
 
 namespace BlackCore::Afv::Connection
 {
@@ -66,17 +68,19 @@ namespace BlackCore::Afv::Connection
         //! @}
 
         //! Send voice DTO to server
+        //! \threadsafe
         template<typename T>
         void sendToVoiceServer(const T &dto)
         {
-            if (!m_connection.m_voiceCryptoChannel || !m_udpSocket)
+            if (!m_connection.m_voiceCryptoChannel)
             {
-                BLACK_VERIFY_X(false, Q_FUNC_INFO, "sendVoice used without crypto channel or socket");
+                BLACK_VERIFY_X(false, Q_FUNC_INFO, "sendVoice used without crypto channel");
                 return;
             }
-            const QUrl voiceServerUrl("udp://" + m_connection.getTokens().VoiceServer.addressIpV4);
-            const QByteArray dataBytes = Crypto::CryptoDtoSerializer::serialize(*m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
-            m_udpSocket->writeDatagram(dataBytes, QHostAddress(voiceServerUrl.host()), static_cast<quint16>(voiceServerUrl.port()));
+            if (!m_voiceSocket.isOpen()) { return; }
+            QMutexLocker lock(&m_mutexSendPacket);
+            if (!m_sendPacket.serialize(*m_connection.m_voiceCryptoChannel, Crypto::CryptoDtoMode::AEAD_ChaCha20Poly1305, dto)) { return; }
+            m_voiceSocket.send(m_sendPacket.data(), m_sendPacket.size());
         }
 
         //! Update transceivers
@@ -94,6 +98,10 @@ namespace BlackCore::Afv::Connection
         //! Authenticated since when
         qint64 secondsSinceAuthentication() const { return m_connection.secondsSinceAuthentication(); }
 
+        //! Datagrams received by the network thread
+        //! \threadsafe
+        VoiceSocketStatistics getVoiceSocketStatistics() const { return m_voiceSocket.getStatistics(); }
+
         //! User data
         //! @{
         const QString &getUserName() const { return m_connection.getUserName(); }
@@ -105,7 +113,8 @@ namespace BlackCore::Afv::Connection
 
     signals:
         //! Audio has been received
-        void audioReceived(const AudioRxOnTransceiversDto &dto);
+        //! \param receivedUs arrival of the datagram at the network thread, CVoiceSocket::nowUs
+        void audioReceived(const AudioRxOnTransceiversDto &dto, qint64 receivedUs);
 
     private:
         void connectToVoiceServer();
@@ -113,7 +122,7 @@ namespace BlackCore::Afv::Connection
 
         void readPendingDatagrams();
         void processMessage(const QByteArray &messageDdata, bool loopback = false);
-        void handleSocketError(QAbstractSocket::SocketError error);
+        void processReceivedPacket(int size, bool loopback, qint64 receivedUs);
 
         void voiceServerHeartbeat();
 
@@ -122,13 +131,19 @@ namespace BlackCore::Afv::Connection
         // Data
         CClientConnectionData m_connection;
 
-        // Voice server
-        QUdpSocket *m_udpSocket        = nullptr;
-        QTimer     *m_voiceServerTimer = nullptr;
+        // Voice server, received in the network thread of the socket
+        CVoiceSocket m_voiceSocket;
+        QTimer *m_voiceServerTimer = nullptr;
 
         // API server
         CApiServerConnection *m_apiServerConnection = nullptr;
 
+        // Packets, serialized and deserialized in place
+        Crypto::CCryptoDtoPacket m_sendPacket; //!< guarded by m_mutexSendPacket
+        Crypto::CCryptoDtoPacket m_receivePacket;
+        AudioRxOnTransceiversDto m_audioRxDto; //!< reused for every received packet
+        QMutex m_mutexSendPacket;
+
         // Properties
         bool m_receiveAudioDto = true;
     };
@@ -0,0 +1,302 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/afv/connection/voicesocket.h"
+
+#include <QStringLiteral>
+#include <chrono>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <arpa/inet.h>
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <netinet/in.h>
+#   include <poll.h>
+#   include <sys/socket.h>
+#   include <unistd.h>
+#endif
+
+namespace BlackCore::Afv::Connection
+{
+    namespace
+    {
+#ifdef Q_OS_WIN
+        using NativeSocket = SOCKET;
+        NativeSocket native(qintptr socket) { return static_cast<NativeSocket>(socket); }
+        void closeNative(qintptr socket) { closesocket(native(socket)); }
+        QString lastSocketError() { return QStringLiteral("socket error %1").arg(WSAGetLastError()); }
+        bool wouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+        bool setNonBlocking(qintptr socket) { u_long on = 1; return ioctlsocket(native(socket), FIONBIO, &on) == 0; }
+        int sendNative(qintptr socket, const char *data, int size) { return ::send(native(socket), data, size, 0); }
+        int recvNative(qintptr socket, char *data, int size) { return ::recv(native(socket), data, size, 0); }
+
+        bool waitReadable(qintptr socket, int timeoutMs)
+        {
+            fd_set readSet;
+            FD_ZERO(&readSet);
+            FD_SET(native(socket), &readSet);
+            timeval timeout { timeoutMs / 1000, (timeoutMs % 1000) * 1000 };
+            return select(0, &readSet, nullptr, nullptr, &timeout) > 0;
+        }
+#else
+        using NativeSocket = int;
+        NativeSocket native(qintptr socket) { return static_cast<NativeSocket>(socket); }
+        void closeNative(qintptr socket) { ::close(native(socket)); }
+        QString lastSocketError() { return QString::fromLocal8Bit(std::strerror(errno)); }
+        bool wouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+        bool setNonBlocking(qintptr socket) { return fcntl(native(socket), F_SETFL, fcntl(native(socket), F_GETFL, 0) | O_NONBLOCK) == 0; }
+        int sendNative(qintptr socket, const char *data, int size) { return static_cast<int>(::send(native(socket), data, static_cast<std::size_t>(size), 0)); }
+        int recvNative(qintptr socket, char *data, int size) { return static_cast<int>(::recv(native(socket), data, static_cast<std::size_t>(size), 0)); }
+
+        bool waitReadable(qintptr socket, int timeoutMs)
+        {
+            pollfd fd { native(socket), POLLIN, 0 };
+            return poll(&fd, 1, timeoutMs) > 0;
+        }
+#endif
+
+        //! IPv4 address for the native functions
+        sockaddr_in toSockAddr(const QHostAddress &address, quint16 port)
+        {
+            sockaddr_in sa {};
+            sa.sin_family = AF_INET;
+            sa.sin_port = htons(port);
+            sa.sin_addr.s_addr = htonl(address.toIPv4Address());
+            return sa;
+        }
+
+        //! The network thread checks this often whether to stop
+        constexpr int WaitTimeoutMs = 50;
+
+        //! Socket receive buffer, room for bursts while the thread is not scheduled
+        constexpr int ReceiveBufferSize = 256 * 1024;
+    }
+
+    QString VoiceSocketStatistics::toQString() const
+    {
+        return QStringLiteral("datagrams: %1 batches: %2 avg/max batch: %3/%4 dropped: %5 send errors: %6 queued: %7").
+               arg(datagrams).arg(batches).
+               arg(averageBatch(), 0, 'f', 2).arg(maxBatch).
+               arg(dropped).arg(sendErrors).arg(queued);
+    }
+
+    CVoiceSocket::CVoiceSocket() : m_queueData(static_cast<std::size_t>(QueueSize) * MaxDatagramSize, 0)
+    {
+#ifdef Q_OS_WIN
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+    }
+
+    CVoiceSocket::~CVoiceSocket()
+    {
+        this->close();
+#ifdef Q_OS_WIN
+        WSACleanup();
+#endif
+    }
+
+    bool CVoiceSocket::open(const QHostAddress &server, quint16 port)
+    {
+        this->close();
+        m_lastError.clear();
+        if (server.protocol() != QAbstractSocket::IPv4Protocol)
+        {
+            m_lastError = QStringLiteral("No IPv4 address: '%1'").arg(server.toString());
+            return false;
+        }
+
+        const NativeSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#ifdef Q_OS_WIN
+        if (s == INVALID_SOCKET)
+#else
+        if (s < 0)
+#endif
+        {
+            m_lastError = lastSocketError();
+            return false;
+        }
+        m_socket = static_cast<SocketHandle>(s);
+
+        const int receiveBufferSize = ReceiveBufferSize;
+        setsockopt(s, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char *>(&receiveBufferSize), sizeof(receiveBufferSize));
+
+        // connected, so only datagrams of the voice server are received and send needs no address
+        const sockaddr_in local = toSockAddr(QHostAddress(QHostAddress::AnyIPv4), 0);
+        const sockaddr_in remote = toSockAddr(server, port);
+        if (!setNonBlocking(m_socket) ||
+                bind(s, reinterpret_cast<const sockaddr *>(&local), sizeof(local)) != 0 ||
+                ::connect(s, reinterpret_cast<const sockaddr *>(&remote), sizeof(remote)) != 0)
+        {
+            m_lastError = lastSocketError();
+            this->close();
+            return false;
+        }
+
+        sockaddr_in bound {};
+        socklen_t boundSize = sizeof(bound);
+        getsockname(s, reinterpret_cast<sockaddr *>(&bound), &boundSize);
+        m_localPort = ntohs(bound.sin_port);
+
+        m_writeIndex = 0;
+        m_readIndex = 0;
+        m_notified = false;
+        m_stop = false;
+        m_thread.reset(QThread::create([this] { this->run(); }));
+        m_thread->setObjectName(QStringLiteral("AFV voice socket"));
+        m_thread->start(QThread::TimeCriticalPriority); // ignored by some systems, e.g. Linux without realtime scheduling
+        return true;
+    }
+
+    void CVoiceSocket::close()
+    {
+        if (m_thread)
+        {
+            m_stop = true;
+            m_thread->wait();
+            m_thread.reset();
+        }
+        if (m_socket != InvalidSocket)
+        {
+            closeNative(m_socket);
+            m_socket = InvalidSocket;
+        }
+        m_localPort = 0;
+    }
+
+    bool CVoiceSocket::send(const char *data, int size)
+    {
+        if (m_socket == InvalidSocket || size < 1) { return false; }
+        if (sendNative(m_socket, data, size) != size)
+        {
+            m_sendErrors++;
+            return false;
+        }
+        return true;
+    }
+
+    int CVoiceSocket::takeDatagram(char *buffer, qint64 &receivedUs)
+    {
+        const quint32 read = m_readIndex.load(std::memory_order_relaxed);
+        if (m_writeIndex.load(std::memory_order_acquire) == read)
+        {
+            // drained, the next batch notifies again; check once more so no datagram is left without notification
+            m_notified = false;
+            if (m_writeIndex.load() == read) { return -1; }
+        }
+
+        const Slot &slot = m_slots[read % QueueSize];
+        std::memcpy(buffer, this->slotData(read), static_cast<std::size_t>(slot.size));
+        receivedUs = slot.receivedUs;
+        const int size = slot.size;
+        m_readIndex.store(read + 1, std::memory_order_release);
+        return size;
+    }
+
+    VoiceSocketStatistics CVoiceSocket::getStatistics() const
+    {
+        VoiceSocketStatistics statistics;
+        statistics.datagrams  = m_datagrams;
+        statistics.batches    = m_batches;
+        statistics.maxBatch   = m_maxBatch;
+        statistics.dropped    = m_dropped;
+        statistics.sendErrors = m_sendErrors;
+        statistics.queued     = static_cast<int>(m_writeIndex.load() - m_readIndex.load());
+        return statistics;
+    }
+
+    qint64 CVoiceSocket::nowUs()
+    {
+        using namespace std::chrono;
+        return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void CVoiceSocket::run()
+    {
+        while (!m_stop)
+        {
+            if (!waitReadable(m_socket, WaitTimeoutMs)) { continue; }
+            const int received = this->receiveBatch();
+            if (received < 1) { continue; }
+
+            m_datagrams += received;
+            m_batches++;
+            updateMax(m_maxBatch, received);
+            if (!m_notified.exchange(true) && m_notify) { m_notify(); }
+        }
+    }
+
+    int CVoiceSocket::receiveBatch()
+    {
+        const quint32 write = m_writeIndex.load(std::memory_order_relaxed);
+        const int free = QueueSize - static_cast<int>(write - m_readIndex.load(std::memory_order_acquire));
+        if (free < 1)
+        {
+            // consumer too slow, drop the oldest datagram waiting in the socket
+            char discard[MaxDatagramSize];
+            if (recvNative(m_socket, discard, MaxDatagramSize) >= 0) { m_dropped++; }
+            return 0;
+        }
+        const int batch = qMin(free, BatchSize);
+
+#ifdef Q_OS_LINUX
+        // all pending datagrams with one call
+        std::array<mmsghdr, BatchSize> messages {};
+        std::array<iovec, BatchSize> vectors {};
+        for (int i = 0; i < batch; i++)
+        {
+            vectors[i].iov_base = this->slotData(write + static_cast<quint32>(i));
+            vectors[i].iov_len = MaxDatagramSize;
+            messages[i].msg_hdr.msg_iov = &vectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        const int received = recvmmsg(native(m_socket), messages.data(), static_cast<unsigned int>(batch), MSG_DONTWAIT, nullptr);
+        if (received < 1) { return 0; }
+        const qint64 receivedUs = nowUs();
+        for (int i = 0; i < received; i++)
+        {
+            this->commit(write + static_cast<quint32>(i), static_cast<int>(messages[i].msg_len), receivedUs);
+        }
+#else
+        int received = 0;
+        for (int attempt = 0; attempt < batch; attempt++)
+        {
+            const quint32 index = write + static_cast<quint32>(received);
+            const int size = recvNative(m_socket, this->slotData(index), MaxDatagramSize);
+            if (size < 0)
+            {
+                if (wouldBlock()) { break; }
+                continue; // e.g. ICMP port unreachable reported by the socket, try the next one
+            }
+            this->commit(index, size, nowUs());
+            received++;
+        }
+        if (received < 1) { return 0; }
+#endif
+
+        m_writeIndex.store(write + static_cast<quint32>(received), std::memory_order_release);
+        return received;
+    }
+
+    void CVoiceSocket::commit(quint32 write, int size, qint64 receivedUs)
+    {
+        Slot &slot = m_slots[write % QueueSize];
+        slot.size = size;
+        slot.receivedUs = receivedUs;
+    }
+
+    void CVoiceSocket::updateMax(std::atomic_int &max, int value)
+    {
+        int current = max.load();
+        while (value > current && !max.compare_exchange_weak(current, value)) {}
+    }
+} // ns
@@ -0,0 +1,157 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_CONNECTION_VOICESOCKET_H
+#define BLACKCORE_AFV_CONNECTION_VOICESOCKET_H
+
+#include "blackcore/afv/crypto/cryptodtopacket.h"
+#include "blackcore/blackcoreexport.h"
+
+#include <QHostAddress>
+#include <QString>
+#include <QThread>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace BlackCore::Afv::Connection
+{
+    //! Datagrams received by the network thread
+    struct BLACKCORE_EXPORT VoiceSocketStatistics
+    {
+        qint64 datagrams = 0;  //!< received datagrams
+        qint64 batches = 0;    //!< receive calls returning datagrams
+        int maxBatch = 0;      //!< most datagrams received by one call
+        qint64 dropped = 0;    //!< datagrams dropped because the queue was full
+        qint64 sendErrors = 0; //!< datagrams which could not be sent
+        int queued = 0;        //!< datagrams waiting to be taken
+
+        //! Average datagrams per receive call
+        double averageBatch() const { return batches > 0 ? static_cast<double>(datagrams) / batches : 0.0; }
+
+        //! As string
+        QString toQString() const;
+    };
+
+    //! UDP socket of the voice server connection with its own high priority receive thread
+    //! \details The network thread waits for datagrams and receives them in batches (recvmmsg on Linux)
+    //!          directly into a preallocated single producer, single consumer queue. The consumer is
+    //!          notified once per batch and takes the datagrams without locks. Every datagram is stamped
+    //!          with its arrival time, so the latency until playout can be measured.
+    //! \remark IPv4 only, like the voice server addresses
+    class BLACKCORE_EXPORT CVoiceSocket
+    {
+    public:
+        static constexpr int MaxDatagramSize = Crypto::CCryptoDtoPacket::MaxSize; //!< larger datagrams are truncated
+        static constexpr int QueueSize = 128; //!< datagrams, 2.5s of audio of 20 callsigns
+        static constexpr int BatchSize = 16;  //!< max. datagrams received by one call
+
+        //! Ctor
+        CVoiceSocket();
+
+        //! Dtor, stops the network thread
+        ~CVoiceSocket();
+
+        //! Not copyable
+        //! @{
+        CVoiceSocket(const CVoiceSocket &) = delete;
+        CVoiceSocket &operator =(const CVoiceSocket &) = delete;
+        //! @}
+
+        //! Called by the network thread when datagrams were queued and the queue was drained before
+        //! \remark set before opening, the function has to be thread safe and should just schedule the draining
+        void setNotify(std::function<void()> notify) { m_notify = std::move(notify); }
+
+        //! Open the socket to the voice server and start the network thread
+        bool open(const QHostAddress &server, quint16 port);
+
+        //! Stop the network thread and close the socket
+        void close();
+
+        //! Socket open?
+        bool isOpen() const { return m_socket != InvalidSocket; }
+
+        //! Local port, useful when bound to any port
+        quint16 getLocalPort() const { return m_localPort; }
+
+        //! Send a datagram to the voice server
+        //! \remark thread safe
+        bool send(const char *data, int size);
+
+        //! Take the next received datagram
+        //! \param buffer    of at least MaxDatagramSize
+        //! \param receivedUs arrival at the network thread, see nowUs
+        //! \return size, or -1 if no datagram is queued
+        //! \remark single consumer, call until -1 is returned after being notified
+        int takeDatagram(char *buffer, qint64 &receivedUs);
+
+        //! Statistics
+        //! \remark thread safe
+        VoiceSocketStatistics getStatistics() const;
+
+        //! Last error
+        const QString &getLastError() const { return m_lastError; }
+
+        //! Steady clock in microseconds, the clock of the arrival times
+        static qint64 nowUs();
+
+    private:
+        //! Native socket handle
+        using SocketHandle = qintptr;
+
+        //! Received datagram, the data is in m_queueData
+        struct Slot
+        {
+            int size = 0;
+            qint64 receivedUs = 0;
+        };
+
+        //! Network thread
+        void run();
+
+        //! Receive what is pending, returns the number of datagrams
+        int receiveBatch();
+
+        //! Datagram received into the slot at the write index
+        void commit(quint32 write, int size, qint64 receivedUs);
+
+        //! Data of the slot
+        char *slotData(quint32 index) { return m_queueData.data() + static_cast<std::size_t>(index % QueueSize) * MaxDatagramSize; }
+
+        //! Update a maximum
+        static void updateMax(std::atomic_int &max, int value);
+
+        static constexpr SocketHandle InvalidSocket = -1;
+
+        SocketHandle m_socket = InvalidSocket;
+        quint16 m_localPort = 0;
+        QString m_lastError;
+        std::function<void()> m_notify;
+        std::unique_ptr<QThread> m_thread;
+        std::atomic_bool m_stop { false };
+
+        std::vector<char> m_queueData;            //!< QueueSize datagrams, allocated once
+        std::array<Slot, QueueSize> m_slots;
+        std::atomic<quint32> m_writeIndex { 0 };  //!< only written by the network thread
+        std::atomic<quint32> m_readIndex { 0 };   //!< only written by the consumer
+        std::atomic_bool m_notified { false };    //!< consumer notified and not yet drained
+
+        std::atomic<qint64> m_datagrams { 0 };
+        std::atomic<qint64> m_batches { 0 };
+        std::atomic_int m_maxBatch { 0 };
+        std::atomic<qint64> m_dropped { 0 };
+        std::atomic<qint64> m_sendErrors { 0 };
+    };
+} // ns
+
+#endif // guard
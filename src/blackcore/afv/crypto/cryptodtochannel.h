@@ -13,6 +13,7 @@
 
 #include "blackcore/afv/dto.h"
 #include "blackcore/afv/crypto/cryptodtomode.h"
+#include "blackcore/blackcoreexport.h"
 
 #include <QDateTime>
 #include <QByteArray>
@@ -23,7 +24,7 @@
 namespace BlackCore::Afv::Crypto
 {
     //! Crypto channel
-    class CCryptoDtoChannel
+    class BLACKCORE_EXPORT CCryptoDtoChannel
     {
     public:
         //! Ctor
@@ -41,6 +42,9 @@ namespace BlackCore::Afv::Crypto
         //! Channel tag
         QString getChannelTag() const;
 
+        //! Channel tag as UTF-8, as used in the packets
+        const QByteArray &getChannelTagUtf8() const { return m_channelTagUtf8; }
+
         //! Receiver key
         QByteArray getReceiveKey(CryptoDtoMode mode);
 
@@ -61,6 +65,7 @@ namespace BlackCore::Afv::Crypto
 
         QByteArray m_hmacKey;
         QString    m_channelTag;
+        QByteArray m_channelTagUtf8;
         QDateTime  m_LastTransmitUtc;
         QDateTime  m_lastReceiveUtc;
     };
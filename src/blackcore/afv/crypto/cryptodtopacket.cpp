@@ -0,0 +1,195 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/afv/crypto/cryptodtopacket.h"
+#include "sodium.h"
+
+#include <array>
+#include <cstdint>
+
+namespace BlackCore::Afv::Crypto
+{
+    namespace
+    {
+        using Nonce = std::array<unsigned char, crypto_aead_chacha20poly1305_IETF_NPUBBYTES>;
+
+        //! Nonce of the packet, id 0 followed by the sequence number
+        Nonce nonceForSequence(quint64 sequence)
+        {
+            Nonce nonce {};
+            static_assert(sizeof(std::uint32_t) + sizeof(sequence) <= sizeof(Nonce), "Nonce too small");
+            std::memcpy(nonce.data() + sizeof(std::uint32_t), &sequence, sizeof(sequence));
+            return nonce;
+        }
+
+        //! Key usable for the AEAD functions?
+        bool isValidKey(const QByteArray &key)
+        {
+            return key.size() == static_cast<int>(crypto_aead_chacha20poly1305_IETF_KEYBYTES);
+        }
+    }
+
+    CCryptoDtoPacket::CCryptoDtoPacket() : m_buffer(static_cast<std::size_t>(MaxSize), 0)
+    { }
+
+    bool CCryptoDtoPacket::deserialize(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback)
+    {
+        this->clear();
+        if (bytes.size() > MaxSize) { return false; }
+        std::memcpy(m_buffer.data(), bytes.constData(), static_cast<std::size_t>(bytes.size()));
+        return this->deserialize(channel, bytes.size(), loopback);
+    }
+
+    bool CCryptoDtoPacket::deserialize(CCryptoDtoChannel &channel, int receivedSize, bool loopback)
+    {
+        this->clear();
+        if (receivedSize < static_cast<int>(sizeof(quint16)) || receivedSize > MaxSize) { return false; }
+        m_size = receivedSize;
+
+        quint16 headerLength = 0;
+        std::memcpy(&headerLength, m_buffer.data(), sizeof(headerLength));
+        const int payloadStart = static_cast<int>(sizeof(headerLength)) + headerLength;
+        const int macStart = m_size - static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES);
+        if (payloadStart > macStart) { return false; }
+
+        CryptoDtoMode mode = CryptoDtoMode::Undefined;
+        try
+        {
+            m_zone.clear();
+            const msgpack::object header = msgpack::unpack(m_zone, m_buffer.data() + sizeof(headerLength), headerLength, &CCryptoDtoPacket::referenceAll);
+            if (header.type != msgpack::type::ARRAY || header.via.array.size != 3) { return false; }
+            m_sequence = header.via.array.ptr[1].as<quint64>();
+            mode = header.via.array.ptr[2].as<CryptoDtoMode>();
+        }
+        catch (const std::exception &)
+        {
+            return false;
+        }
+        if (mode != CryptoDtoMode::AEAD_ChaCha20Poly1305) { return false; }
+
+        const QByteArray key = loopback ? channel.getTransmitKey(mode) : channel.getReceiveKey(mode);
+        if (!isValidKey(key)) { return false; }
+
+        const Nonce nonce = nonceForSequence(m_sequence);
+        unsigned char *payload = reinterpret_cast<unsigned char *>(m_buffer.data() + payloadStart);
+        const int result = crypto_aead_chacha20poly1305_ietf_decrypt_detached(payload, nullptr,
+                           payload, static_cast<unsigned long long>(macStart - payloadStart),
+                           reinterpret_cast<const unsigned char *>(m_buffer.data() + macStart),
+                           reinterpret_cast<const unsigned char *>(m_buffer.data()), static_cast<unsigned long long>(payloadStart),
+                           nonce.data(),
+                           reinterpret_cast<const unsigned char *>(key.constData()));
+        if (result != 0) { return false; }
+
+        // name and data, both with their length in front
+        int at = payloadStart;
+        quint16 length = 0;
+        if (at + static_cast<int>(sizeof(length)) > macStart) { return false; }
+        std::memcpy(&length, m_buffer.data() + at, sizeof(length));
+        at += static_cast<int>(sizeof(length));
+        if (at + length > macStart) { return false; }
+        m_dtoName = std::string_view(m_buffer.data() + at, length);
+        at += length;
+
+        if (at + static_cast<int>(sizeof(length)) > macStart) { return false; }
+        std::memcpy(&length, m_buffer.data() + at, sizeof(length));
+        at += static_cast<int>(sizeof(length));
+        if (at + length > macStart) { return false; }
+        m_dtoOffset = at;
+        m_dtoLength = length;
+
+        m_verified = true;
+        return true;
+    }
+
+    void CCryptoDtoPacket::clear()
+    {
+        m_size = 0;
+        m_overflow = false;
+        m_verified = false;
+        m_sequence = 0;
+        m_dtoName = {};
+        m_dtoOffset = 0;
+        m_dtoLength = 0;
+    }
+
+    void CCryptoDtoPacket::write(const char *data, std::size_t size)
+    {
+        if (m_overflow || size > static_cast<std::size_t>(MaxSize - m_size))
+        {
+            m_overflow = true;
+            return;
+        }
+        std::memcpy(m_buffer.data() + m_size, data, size);
+        m_size += static_cast<int>(size);
+    }
+
+    void CCryptoDtoPacket::writeLength(int length)
+    {
+        const quint16 l = static_cast<quint16>(length);
+        this->write(reinterpret_cast<const char *>(&l), sizeof(l));
+    }
+
+    void CCryptoDtoPacket::patchLength(int at, int length)
+    {
+        if (m_overflow) { return; }
+        const quint16 l = static_cast<quint16>(length);
+        std::memcpy(m_buffer.data() + at, &l, sizeof(l));
+    }
+
+    int CCryptoDtoPacket::writeHeader(const QByteArray &channelTag, quint64 sequence, CryptoDtoMode mode)
+    {
+        // same as packing a CryptoDtoHeaderDto, without creating a std::string for the tag
+        this->clear();
+        this->writeLength(0);
+        Writer writer { *this };
+        msgpack::packer<Writer> packer(writer);
+        packer.pack_array(3);
+        packer.pack_str(static_cast<uint32_t>(channelTag.size()));
+        packer.pack_str_body(channelTag.constData(), static_cast<uint32_t>(channelTag.size()));
+        packer.pack(sequence);
+        packer.pack(mode);
+        this->patchLength(0, m_size - static_cast<int>(sizeof(quint16)));
+        return m_size;
+    }
+
+    bool CCryptoDtoPacket::encrypt(int payloadStart, quint64 sequence, const QByteArray &key)
+    {
+        const int macStart = m_size;
+        const int macSize = static_cast<int>(crypto_aead_chacha20poly1305_IETF_ABYTES);
+        if (m_overflow || !isValidKey(key) || MaxSize - macStart < macSize)
+        {
+            this->clear();
+            return false;
+        }
+
+        const Nonce nonce = nonceForSequence(sequence);
+        unsigned char *payload = reinterpret_cast<unsigned char *>(m_buffer.data() + payloadStart);
+        const int result = crypto_aead_chacha20poly1305_ietf_encrypt_detached(payload,
+                           reinterpret_cast<unsigned char *>(m_buffer.data() + macStart), nullptr,
+                           payload, static_cast<unsigned long long>(macStart - payloadStart),
+                           reinterpret_cast<const unsigned char *>(m_buffer.data()), static_cast<unsigned long long>(payloadStart),
+                           nullptr,
+                           nonce.data(),
+                           reinterpret_cast<const unsigned char *>(key.constData()));
+        if (result != 0)
+        {
+            this->clear();
+            return false;
+        }
+        m_size += macSize;
+        return true;
+    }
+
+    bool CCryptoDtoPacket::referenceAll(msgpack::type::object_type type, std::size_t size, void *userData)
+    {
+        Q_UNUSED(type)
+        Q_UNUSED(size)
+        Q_UNUSED(userData)
+        return true;
+    }
+} // ns
@@ -0,0 +1,172 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_AFV_CRYPTO_CRYPTODTOPACKET_H
+#define BLACKCORE_AFV_CRYPTO_CRYPTODTOPACKET_H
+
+#include "blackcore/afv/crypto/cryptodtochannel.h"
+#include "blackcore/afv/crypto/cryptodtomode.h"
+#include "blackcore/blackcoreexport.h"
+#include "msgpack.hpp"
+
+#include <QByteArray>
+#include <QtGlobal>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <vector>
+
+namespace BlackCore::Afv::Crypto
+{
+    //! UDP packet of the voice server, serialized and encrypted or decrypted and deserialized in place
+    //! \details The buffer is allocated once and reused for every packet. The DTO is packed right behind the
+    //!          header and encrypted in place with the detached AEAD functions of libsodium, the MAC is appended.
+    //!          Received packets are decrypted in place, DTO name and data are views into the buffer.
+    //! \remark same wire format as CryptoDtoSerializer, not thread safe
+    class BLACKCORE_EXPORT CCryptoDtoPacket
+    {
+    public:
+        //! Max. size of a packet, far more than any voice packet
+        static constexpr int MaxSize = 4096;
+
+        //! Ctor, allocates the buffer
+        CCryptoDtoPacket();
+
+        //! Not copyable, views point into the buffer
+        //! @{
+        CCryptoDtoPacket(const CCryptoDtoPacket &) = delete;
+        CCryptoDtoPacket &operator =(const CCryptoDtoPacket &) = delete;
+        //! @}
+
+        //! Serialize and encrypt, sequence number and key are taken from the channel
+        template <typename T>
+        bool serialize(CCryptoDtoChannel &channel, CryptoDtoMode mode, const T &dto)
+        {
+            uint sequenceToSend = 0;
+            const QByteArray transmitKey = channel.getTransmitKey(mode, sequenceToSend);
+            return this->serialize(channel.getChannelTagUtf8(), mode, transmitKey, sequenceToSend, dto);
+        }
+
+        //! Serialize and encrypt
+        template <typename T>
+        bool serialize(const QByteArray &channelTag, CryptoDtoMode mode, const QByteArray &transmitKey, uint sequenceToSend, const T &dto)
+        {
+            if (mode != CryptoDtoMode::AEAD_ChaCha20Poly1305) { this->clear(); return false; }
+            const int payloadStart = this->writeHeader(channelTag, sequenceToSend, mode);
+
+            this->writeLength(static_cast<int>(T::ShortDtoName.size()));
+            this->write(T::ShortDtoName.data(), T::ShortDtoName.size());
+
+            const int dtoLengthAt = m_size;
+            this->writeLength(0);
+            Writer writer { *this };
+            msgpack::pack(writer, dto);
+            this->patchLength(dtoLengthAt, m_size - dtoLengthAt - static_cast<int>(sizeof(quint16)));
+
+            return this->encrypt(payloadStart, sequenceToSend, transmitKey);
+        }
+
+        //! Packet
+        //! @{
+        const char *data() const { return m_buffer.data(); }
+        int size() const { return m_size; }
+        //! @}
+
+        //! Buffer to receive a datagram into, then call deserialize with the received size
+        char *receiveBuffer() { return m_buffer.data(); }
+
+        //! Decrypt and deserialize a packet received into the buffer
+        bool deserialize(CCryptoDtoChannel &channel, int receivedSize, bool loopback);
+
+        //! Copy into the buffer, decrypt and deserialize
+        bool deserialize(CCryptoDtoChannel &channel, const QByteArray &bytes, bool loopback);
+
+        //! Decrypted and verified?
+        bool isVerified() const { return m_verified; }
+
+        //! Sequence number of the received packet
+        quint64 getSequence() const { return m_sequence; }
+
+        //! Name of the received DTO, short or long name
+        std::string_view getDtoName() const { return m_dtoName; }
+
+        //! Is the received DTO of this type?
+        template <typename T>
+        bool isDto() const
+        {
+            return m_verified && (m_dtoName == T::ShortDtoName || m_dtoName == T::DtoName);
+        }
+
+        //! Length of the DTO data
+        int getDtoLength() const { return m_dtoLength; }
+
+        //! Deserialize the received DTO
+        //! \remark reusing the DTO keeps the capacity of its strings and vectors
+        template <typename T>
+        bool getDto(T &dto)
+        {
+            if (!this->isDto<T>()) { return false; }
+            try
+            {
+                m_zone.clear();
+                const msgpack::object object = msgpack::unpack(m_zone, m_buffer.data() + m_dtoOffset, static_cast<std::size_t>(m_dtoLength), &CCryptoDtoPacket::referenceAll);
+                object.convert(dto);
+                return true;
+            }
+            catch (const std::exception &)
+            {
+                return false;
+            }
+        }
+
+    private:
+        //! msgpack stream writing into the buffer
+        struct Writer
+        {
+            CCryptoDtoPacket &packet; //!< packet written
+
+            //! \private msgpack stream
+            void write(const char *data, std::size_t size) { packet.write(data, size); }
+        };
+
+        //! Empty packet
+        void clear();
+
+        //! Append, an overflow invalidates the packet
+        void write(const char *data, std::size_t size);
+
+        //! Append a length
+        void writeLength(int length);
+
+        //! Overwrite a length
+        void patchLength(int at, int length);
+
+        //! Write the header, returns where the encrypted payload starts
+        int writeHeader(const QByteArray &channelTag, quint64 sequence, CryptoDtoMode mode);
+
+        //! Encrypt the payload in place and append the MAC
+        bool encrypt(int payloadStart, quint64 sequence, const QByteArray &key);
+
+        //! Strings and binaries of the received packet are not copied
+        static bool referenceAll(msgpack::type::object_type type, std::size_t size, void *userData);
+
+        std::vector<char> m_buffer;    //!< packet, allocated once
+        int m_size = 0;                //!< used bytes of the buffer
+        bool m_overflow = false;       //!< written beyond the buffer
+        bool m_verified = false;       //!< received packet decrypted and verified
+        quint64 m_sequence = 0;        //!< sequence number of the received packet
+        std::string_view m_dtoName;    //!< name of the received DTO, points into the buffer
+        int m_dtoOffset = 0;           //!< received DTO data in the buffer
+        int m_dtoLength = 0;           //!< length of the received DTO data
+        msgpack::zone m_zone;          //!< reused for unpacking
+    };
+} // ns
+
+#endif // guard
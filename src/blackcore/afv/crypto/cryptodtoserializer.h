@@ -14,6 +14,7 @@
 #include "blackcore/afv/crypto/cryptodtochannel.h"
 #include "blackcore/afv/crypto/cryptodtomode.h"
 #include "blackcore/afv/crypto/cryptodtoheaderdto.h"
+#include "blackcore/blackcoreexport.h"
 #include "sodium.h"
 
 #include <QByteArray>
@@ -27,11 +28,9 @@
 
 namespace BlackCore::Afv::Crypto
 {
-    //! Hash of AFV short dto names
-    extern QHash<QByteArray, QByteArray> gShortDtoNames;
-
     //! Crypto serializer
-    class CryptoDtoSerializer
+    //! \sa CCryptoDtoPacket for serializing and deserializing in a reused buffer
+    class BLACKCORE_EXPORT CryptoDtoSerializer
     {
     public:
         CryptoDtoSerializer();
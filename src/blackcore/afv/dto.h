@@ -17,6 +17,7 @@
 #include <QJsonObject>
 #include <QString>
 #include <QUuid>
+#include <string_view>
 
 namespace BlackCore::Afv
 {
@@ -187,8 +188,10 @@ namespace BlackCore::Afv
     {
         //! Name
         //! @{
-        static QByteArray getDtoName() { return "HeartbeatDto"; }
-        static QByteArray getShortDtoName() { return "H"; }
+        static constexpr std::string_view DtoName      = "HeartbeatDto";
+        static constexpr std::string_view ShortDtoName = "H";
+        static QByteArray getDtoName() { return QByteArray(DtoName.data(), static_cast<int>(DtoName.size())); }
+        static QByteArray getShortDtoName() { return QByteArray(ShortDtoName.data(), static_cast<int>(ShortDtoName.size())); }
         //! @}
 
         std::string callsign; //!< callsign
@@ -200,8 +203,10 @@ namespace BlackCore::Afv
     {
         //! Name
         //! @{
-        static QByteArray getDtoName() { return "HeartbeatAckDto"; }
-        static QByteArray getShortDtoName() { return "HA"; }
+        static constexpr std::string_view DtoName      = "HeartbeatAckDto";
+        static constexpr std::string_view ShortDtoName = "HA";
+        static QByteArray getDtoName() { return QByteArray(DtoName.data(), static_cast<int>(DtoName.size())); }
+        static QByteArray getShortDtoName() { return QByteArray(ShortDtoName.data(), static_cast<int>(ShortDtoName.size())); }
         //! @}
 
         MSGPACK_DEFINE()
@@ -248,8 +253,10 @@ namespace BlackCore::Afv
     {
         //! Names
         //! @{
-        static QByteArray getDtoName() { return "AudioTxOnTransceiversDto"; }
-        static QByteArray getShortDtoName() { return "AT"; }
+        static constexpr std::string_view DtoName      = "AudioTxOnTransceiversDto";
+        static constexpr std::string_view ShortDtoName = "AT";
+        static QByteArray getDtoName() { return QByteArray(DtoName.data(), static_cast<int>(DtoName.size())); }
+        static QByteArray getShortDtoName() { return QByteArray(ShortDtoName.data(), static_cast<int>(ShortDtoName.size())); }
         //! @}
 
         //! Properties
@@ -268,8 +275,10 @@ namespace BlackCore::Afv
     {
         //! Names
         //! @{
-        static QByteArray getDtoName() { return "AudioRxOnTransceiversDto"; }
-        static QByteArray getShortDtoName() { return "AR"; }
+        static constexpr std::string_view DtoName      = "AudioRxOnTransceiversDto";
+        static constexpr std::string_view ShortDtoName = "AR";
+        static QByteArray getDtoName() { return QByteArray(DtoName.data(), static_cast<int>(DtoName.size())); }
+        static QByteArray getShortDtoName() { return QByteArray(ShortDtoName.data(), static_cast<int>(ShortDtoName.size())); }
         //! @}
 
         //! Properties
@@ -290,6 +299,7 @@ namespace BlackCore::Afv
         uint sequenceCounter;  //!< Receiver optionally uses this in reordering algorithm/gap detection
         QByteArray audio;      //!< Opus compressed audio
         bool lastPacket;       //!< Used to indicate to receiver that the sender has stopped sending
+        qint64 receivedUs = 0; //!< Arrival at the network thread, steady clock, 0 if unknown
     };
 } // ns
 
@@ -8,8 +8,10 @@
 
 #include "blackcore/aircraftmatcher.h"
 #include "blackcore/application.h"
+#include "blackcore/matchingscriptruntime.h"
 #include "blackcore/webdataservices.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/simulation/matchingscript.h"
 #include "blackmisc/simulation/matchingutils.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
@@ -21,20 +23,28 @@
 #include "blackmisc/logmessage.h"
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/swiftdirectories.h"
+#include "blackmisc/threadutils.h"
 #include "blackmisc/directoryutils.h"
+#include "blackmisc/worker.h"
 
 #include <QList>
 #include <QStringList>
 #include <QtGlobal>
 #include <QPair>
+#include <QMutexLocker>
+#include <QPointer>
 #include <QStringBuilder>
-#include <QJSEngine>
+#include <QJSValue>
+#include <QThread>
+#include <memory>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Network;
 using namespace BlackMisc::Simulation;
 
+using ModelIds = BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds;
+
 namespace BlackCore
 {
     const QStringList &CAircraftMatcher::getLogCategories()
@@ -58,6 +68,7 @@ namespace BlackCore
 
     CAircraftMatcher::~CAircraftMatcher()
     {
+        this->stopMatchingWorkers();
         this->saveDisabledForMatchingModels();
     }
 
@@ -65,6 +76,7 @@ namespace BlackCore
     {
         if (m_setup == setup) { return false; }
         m_setup = setup;
+        if (!m_setup.doRunMsReverseLookupScript() && !m_setup.doRunMsMatchingStageScript()) { this->releaseMatchingScriptRuntimes(); }
         emit this->setupChanged();
         return true;
     }
@@ -252,8 +264,119 @@ namespace BlackCore
 
     CAircraftModel CAircraftMatcher::getClosestMatch(const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript) const
     {
-        CAircraftModelList modelSet(m_modelSet); // Models for this matching
-        const CAircraftMatcherSetup setup = m_setup;
+        const MatchingScriptStatistics before = CMatchingScriptRuntime::getThreadStatistics();
+        const CAircraftModel matchedModel = CAircraftMatcher::getClosestMatchImplementation(this->getMatchingSnapshot(), remoteAircraft, whatToLog, log, useMatchingScript);
+        this->addMatchingScriptStatistics(before, CMatchingScriptRuntime::getThreadStatistics());
+        return matchedModel;
+    }
+
+    void CAircraftMatcher::getClosestMatchesConcurrently(const CSimulatedAircraftList &remoteAircraft, MatchingLog whatToLog, bool useMatchingScript, QObject *context, const std::function<void(const MatchingResults &)> &callback)
+    {
+        Q_ASSERT_X(context, Q_FUNC_INFO, "Need context");
+        if (remoteAircraft.isEmpty() || !context) { return; }
+
+        // all matchings of the batch use the same immutable snapshot, the containers are implicitly shared
+        const auto snapshot = std::make_shared<const MatchingSnapshot>(this->getMatchingSnapshot());
+        CSimulatedAircraftList sorted(remoteAircraft);
+        sorted.sortByCallsign();
+
+        // each worker matches a contiguous range of the sorted aircraft, so the results are in callsign order
+        const auto results = std::make_shared<MatchingResults>(sorted.size());
+        // the workers are stopped before the matcher is destroyed, so they can use this
+        const auto matchRange = [this, snapshot, sorted, results, whatToLog, useMatchingScript](int begin, int end)
+        {
+            for (int i = begin; i < end; ++i)
+            {
+                // only this worker writes to the elements of its range
+                MatchingResult &result = (*results)[static_cast<size_t>(i)];
+                result.remoteAircraft = sorted[i];
+                CStatusMessageList *log = whatToLog > 0 ? &result.matchingMessages : nullptr;
+                const MatchingScriptStatistics before = CMatchingScriptRuntime::getThreadStatistics();
+                result.matchedModel = CAircraftMatcher::getClosestMatchImplementation(*snapshot, result.remoteAircraft, whatToLog, log, useMatchingScript);
+                this->addMatchingScriptStatistics(before, CMatchingScriptRuntime::getThreadStatistics());
+            }
+        };
+
+        QPointer<QObject> myContext(context);
+        if (m_matchingWorkers.isEmpty())
+        {
+            matchRange(0, sorted.sizeInt());
+            QMetaObject::invokeMethod(context, [results, callback] { callback(*results); }, Qt::QueuedConnection);
+            return;
+        }
+
+        const int chunks = qBound(1, m_matchingWorkers.size(), sorted.sizeInt());
+        const int chunkSize = (sorted.sizeInt() + chunks - 1) / chunks;
+        auto pending = std::make_shared<int>(0);
+        for (int begin = 0, w = 0; begin < sorted.sizeInt(); begin += chunkSize, ++w)
+        {
+            const int end = qMin(begin + chunkSize, sorted.sizeInt());
+            CContinuousWorker *worker = m_matchingWorkers[w].data();
+            Q_ASSERT_X(worker, Q_FUNC_INFO, "Missing matching worker");
+            (*pending)++;
+            QMetaObject::invokeMethod(worker, [matchRange, begin, end, results, pending, myContext, callback]
+            {
+                matchRange(begin, end);
+
+                // all workers report to the context thread, so the counter needs no synchronization
+                if (!myContext) { return; }
+                QMetaObject::invokeMethod(myContext.data(), [results, pending, callback]
+                {
+                    if (--(*pending) > 0) { return; }
+                    callback(*results);
+                }, Qt::QueuedConnection);
+            }, Qt::QueuedConnection);
+        }
+    }
+
+    void CAircraftMatcher::startMatchingWorkers(int count)
+    {
+        Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Needs to be started in matcher thread");
+        if (!m_matchingWorkers.isEmpty()) { return; }
+        if (count < 1) { count = qMax(1, QThread::idealThreadCount()); }
+        for (int i = 0; i < count; ++i)
+        {
+            CContinuousWorker *worker = new CContinuousWorker(this, QStringLiteral("matching %1").arg(i));
+            worker->start();
+            m_matchingWorkers.push_back(worker);
+        }
+    }
+
+    void CAircraftMatcher::stopMatchingWorkers()
+    {
+        // the workers delete themselves when their thread finished
+        for (const QPointer<CContinuousWorker> &worker : std::as_const(m_matchingWorkers))
+        {
+            if (worker) { worker->quitAndWait(); }
+        }
+        m_matchingWorkers.clear();
+    }
+
+    void CAircraftMatcher::releaseMatchingScriptRuntimes()
+    {
+        CMatchingScriptRuntime::releaseForCurrentThread();
+        for (const QPointer<CContinuousWorker> &worker : std::as_const(m_matchingWorkers))
+        {
+            if (!worker) { continue; }
+            QMetaObject::invokeMethod(worker.data(), [] { CMatchingScriptRuntime::releaseForCurrentThread(); }, Qt::QueuedConnection);
+        }
+    }
+
+    CAircraftMatcher::MatchingSnapshot CAircraftMatcher::getMatchingSnapshot() const
+    {
+        MatchingSnapshot snapshot;
+        snapshot.setup = m_setup;
+        snapshot.defaultModel = m_defaultModel;
+        snapshot.modelSet = m_modelSet;
+        snapshot.modelSetIndex = m_modelSetIndex;
+        snapshot.categoryMatcher = m_categoryMatcher;
+        return snapshot;
+    }
+
+    CAircraftModel CAircraftMatcher::getClosestMatchImplementation(const MatchingSnapshot &snapshot, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log, bool useMatchingScript)
+    {
+        const CAircraftModelList &modelSet = snapshot.modelSet; // Models for this matching
+        const CAircraftMatcherSetup &setup = snapshot.setup;
 
         static const QString format("hh:mm:ss.zzz");
         static const QString m1("--- Start matching: UTC %1 ---");
@@ -299,7 +422,7 @@ namespace BlackCore
         else if (modelSet.isEmpty())
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("No models for matching, using default"), getLogCategories(), CStatusMessage::SeverityError);
-            matchedModel = this->getDefaultModel();
+            matchedModel = snapshot.defaultModel;
             resolvedInPrephase = true;
         }
         else if (remoteAircraft.hasModelString())
@@ -322,50 +445,59 @@ namespace BlackCore
 
         if (!resolvedInPrephase)
         {
+            // the reduction steps work on the ids of the indexed model set
+            const CAircraftModelSetIndex &index = snapshot.modelSetIndex;
+            Q_ASSERT_X(index.size() == modelSet.size(), Q_FUNC_INFO, "Model set index out of sync");
+
             // sanity
-            const int noString = modelSet.removeAllWithoutModelString();
+            ModelIds modelSetIds = index.findWithModelString(index.allIds());
+            const int noString = index.size() - modelSetIds.size();
             static const QString noModelStr("Excluded %1 models without model string");
             if (noString > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, noModelStr.arg(noString)); }
 
             // exclusion
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoDbData))
             {
-                const int noDbKey = modelSet.removeObjectsWithoutDbKey();
+                const int s = modelSetIds.size();
+                modelSetIds = index.findWithValidDbKey(modelSetIds);
+                const int noDbKey = s - modelSetIds.size();
                 static const QString excludedStr("Excluded %1 models without DB key");
                 if (noDbKey > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(noDbKey)); }
             }
 
             if (setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ExcludeNoExcluded))
             {
-                const int excluded = modelSet.removeIfExcluded();
+                const int s = modelSetIds.size();
+                modelSetIds = index.findNotExcluded(modelSetIds);
+                const int excluded = s - modelSetIds.size();
                 static const QString excludedStr("Excluded %1 models marked 'Excluded'");
                 if (excluded > 0 && log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, excludedStr.arg(excluded)); }
             }
 
             // Reduce by ICAO if the flag is set
             static const QString msInfo("Using '%1' with model set with %2 models");
-            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, msInfo.arg(setup.getMatchingAlgorithmAsString()).arg(modelSet.size()), getLogCategories());
+            CMatchingUtils::addLogDetailsToList(log, remoteAircraft, msInfo.arg(setup.getMatchingAlgorithmAsString()).arg(modelSetIds.size()), getLogCategories());
             CAircraftModelList candidates;
             int maxScore = -1;
 
             switch (setup.getMatchingAlgorithm())
             {
             case CAircraftMatcherSetup::MatchingStepwiseReduce:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = index.toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(index, modelSetIds, setup, snapshot.categoryMatcher, remoteAircraft, whatToLog, log));
                 break;
             case CAircraftMatcherSetup::MatchingScoreBased:
-                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(modelSet, setup, remoteAircraft, maxScore, whatToLog, log);
+                candidates = CAircraftMatcher::getClosestMatchScoreImplementation(index.toModels(modelSetIds), setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             case CAircraftMatcherSetup::MatchingStepwiseReducePlusScoreBased:
             default:
-                candidates = CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(modelSet, setup, m_categoryMatcher, remoteAircraft, whatToLog, log);
+                candidates = index.toModels(CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(index, modelSetIds, setup, snapshot.categoryMatcher, remoteAircraft, whatToLog, log));
                 candidates = CAircraftMatcher::getClosestMatchScoreImplementation(candidates, setup, remoteAircraft, maxScore, whatToLog, log);
                 break;
             }
 
             if (candidates.isEmpty())
             {
-                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(modelSet, remoteAircraft, this->getDefaultModel(), whatToLog, log);
+                matchedModel = CAircraftMatcher::getCombinedTypeDefaultModel(index.toModels(modelSetIds), remoteAircraft, snapshot.defaultModel, whatToLog, log);
             }
             else
             {
@@ -419,7 +551,7 @@ namespace BlackCore
                 CSimulatedAircraft rerunAircraft(remoteAircraft);
                 rerunAircraft.setModel(matchedModelMs);
                 CStatusMessageList log2ndRun;
-                matchedModelMs = CAircraftMatcher::getClosestMatch(rerunAircraft, whatToLog, log ? &log2ndRun : nullptr, false);
+                matchedModelMs = CAircraftMatcher::getClosestMatchImplementation(snapshot, rerunAircraft, whatToLog, log ? &log2ndRun : nullptr, false);
                 if (log) { log->push_back(log2ndRun); }
 
                 // the script can fuckup the model, leading to an empty model string or such
@@ -447,7 +579,7 @@ namespace BlackCore
         if (!matchedModel.hasModelString())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("All matching yielded no result, VERY odd...")); }
-            CAircraftModel defaultModel = this->getDefaultModel();
+            CAircraftModel defaultModel = snapshot.defaultModel;
             if (defaultModel.hasModelString())
             {
                 matchedModel = defaultModel;
@@ -506,88 +638,43 @@ namespace BlackCore
     MatchingScriptReturnValues CAircraftMatcher::reverseLookupScript(const CAircraftModel &inModel, const CAircraftMatcherSetup &setup, const CAircraftModelList &modelSet, CStatusMessageList *log)
     {
         if (!setup.doRunMsReverseLookupScript()) { return MatchingScriptReturnValues(inModel); }
-        if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsReverseLookupFile());
-        const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, inModel, setup, modelSet, ReverseLookup, log);
+        if (sApp && sApp->isShuttingDown()) { return inModel; }
+        const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(setup.getMsReverseLookupFile(), inModel, inModel, modelSet, ReverseLookup, log);
         return rv;
     }
 
     MatchingScriptReturnValues CAircraftMatcher::matchingStageScript(const CAircraftModel &inModel, const CAircraftModel &matchedModel, const CAircraftMatcherSetup &setup, const CAircraftModelList &modelSet, CStatusMessageList *log)
     {
         if (!setup.doRunMsMatchingStageScript()) { return MatchingScriptReturnValues(inModel); }
-        if (!sApp || sApp->isShuttingDown() || !sApp->hasWebDataServices()) { return inModel; }
-        const QString js = CFileUtils::readFileToString(setup.getMsMatchingStageFile());
-        const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(js, inModel, matchedModel, setup, modelSet, MatchingStage, log);
+        if (sApp && sApp->isShuttingDown()) { return inModel; }
+        const MatchingScriptReturnValues rv = CAircraftMatcher::matchingScript(setup.getMsMatchingStageFile(), inModel, matchedModel, modelSet, MatchingStage, log);
         return rv;
     }
 
-    MatchingScriptReturnValues CAircraftMatcher::matchingScript(const QString &js, const CAircraftModel &inModel, const CAircraftModel &matchedModel, const CAircraftMatcherSetup &setup, const CAircraftModelList &modelSet, MatchingScript script, CStatusMessageList *log)
+    MatchingScriptReturnValues CAircraftMatcher::matchingScript(const QString &scriptFile, const CAircraftModel &inModel, const CAircraftModel &matchedModel, const CAircraftModelList &modelSet, MatchingScript script, CStatusMessageList *log)
     {
         MatchingScriptReturnValues rv(inModel);
         QString logMessage;
         const CCallsign callsign = inModel.getCallsign();
 
-        if (js.isEmpty() && log) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script is empty")); }
+        // the runtime of this thread only evaluates the script again if the file changed
+        CMatchingScriptRuntime &runtime = CMatchingScriptRuntime::forCurrentThread(script);
+        if (!runtime.load(scriptFile) && log) { CCallsign::addLogDetailsToList(log, callsign, runtime.getErrorString()); }
 
-        while (!js.isEmpty() && sApp && sApp->hasWebDataServices())
+        // the script itself does not need the web services, only resolving the changed values by DB keys
+        CWebDataServices *webServices = (sApp && sApp->hasWebDataServices()) ? sApp->getWebDataServices() : nullptr;
+        while (runtime.isLoaded())
         {
             rv.runScript = true;
 
-            // matching script
-            const bool msReverse = (script == ReverseLookup);
-            const QString lf = msReverse ? setup.getMsReverseLookupFile() : setup.getMsMatchingStageFile();
-            static const QString logFileR = CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), "logMatchingScriptReverseLookup.log");
-            static const QString logFileM = CFileUtils::appendFilePaths(CSwiftDirectories::logDirectory(), "logMatchingScriptMatchingStage.log");
-
             if (log)
             {
-                CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script (%1): '%2'").arg(msToString(script), lf));
+                CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script (%1): '%2'").arg(msToString(script), scriptFile));
                 CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script input model (%1): '%2'").arg(inModel.toQString(true)));
                 CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script models: %1").arg(modelSet.coverageSummary()));
             }
 
-            QJSEngine engine;
-            // engine.installExtensions(QJSEngine::ConsoleExtension);
-
-            // Meta objects to create new JS objects, here causing JSValue can't be reassigned to another engine.
-            // static const QJSValue jsInOutMetaObject = engine.newQMetaObject(&MSInOutValues::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftInOutObject", jsInOutMetaObject); // JS: new SwiftInOutObject();
-            // static const QJSValue jsSetMetaObject = engine.newQMetaObject(&MSModelSet::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftModelSet", jsSetMetaObject); // JS: new SwiftModelSet
-            // static const QJSValue jsWebServicesMetaObject = engine.newQMetaObject(&MSWebServices::staticMetaObject);
-            // engine.globalObject().setProperty("SwiftWebServices", jsWebServicesMetaObject); // JS: new SwiftWebServices
-
-            // init models and set
-            MSInOutValues inObject(inModel);
-            MSInOutValues matchedObject(matchedModel); // same as inModel for reverse lookup
-            matchedObject.evaluateChanges(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
-            MSInOutValues outObject(matchedModel);     // set default values for out object
-            MSModelSet modelSetObject(modelSet);       // as passed
-            modelSetObject.initByAircraftAndAirline(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
-            MSWebServices webServices; // web services encapsulated
-
-            // object as from network
-            const QJSValue jsInObject = engine.newQObject(&inObject);
-            engine.globalObject().setProperty("inObject", jsInObject);
-
-            // object that will be returned
-            const QJSValue jsOutObject = engine.newQObject(&outObject);
-            engine.globalObject().setProperty("outObject", jsOutObject);
-
-            // object as matched so far, same as inObject in reverse lookup
-            const QJSValue jsMatchedObject = engine.newQObject(&matchedObject);
-            engine.globalObject().setProperty("matchedObject", jsMatchedObject);
-
-            // wrapper for model set
-            const QJSValue jsModelSetObject = engine.newQObject(&modelSetObject);
-            engine.globalObject().setProperty("modelSet", jsModelSetObject);
-
-            // wrapper for web services
-            const QJSValue jsWebServices = engine.newQObject(&webServices);
-            engine.globalObject().setProperty("webServices", jsWebServices);
-
-            QJSValue ms = engine.evaluate(js, msReverse ? logFileR : logFileM);
-            ms = ms.call();
+            const QJSValue ms = runtime.run(inModel, matchedModel, modelSet);
             if (ms.isError())
             {
                 const QString msg = QStringLiteral("Matching script error: %1 '%2'").arg(ms.property("lineNumber").toInt()).arg(ms.toString());
@@ -606,9 +693,9 @@ namespace BlackCore
                     rv.rerun = reverseModelProcessed->isRerun();
 
                     // changed model by model id?
-                    if (reverseModelProcessed->hasChangedModelId(inModel))
+                    if (webServices && reverseModelProcessed->hasChangedModelId(inModel))
                     {
-                        const CAircraftModel model = sApp->getWebDataServices()->getModelForDbKey(reverseModelProcessed->getDbModelId());
+                        const CAircraftModel model = webServices->getModelForDbKey(reverseModelProcessed->getDbModelId());
                         if (model.hasValidDbKey())
                         {
                             // found full model from DB
@@ -622,7 +709,7 @@ namespace BlackCore
                     if (reverseModelProcessed->hasChangedModelString(inModel.getModelString()))
                     {
                         const QString modelString = reverseModelProcessed->getModelString();
-                        const CAircraftModel model = sApp->getWebDataServices()->getModelForModelString(modelString);
+                        const CAircraftModel model = webServices ? webServices->getModelForModelString(modelString) : CAircraftModel();
                         if (model.hasValidDbKey())
                         {
                             // found full model from DB
@@ -648,33 +735,33 @@ namespace BlackCore
                     if (reverseModelProcessed->hasChangedAircraftIcao(matchedModel.getAircraftIcaoCode()))
                     {
                         CAircraftIcaoCode icao(reverseModelProcessed->getAircraftIcao());
-                        if (reverseModelProcessed->hasChangedAircraftIcaoId(matchedModel.getAircraftIcaoCode()))
+                        if (webServices && reverseModelProcessed->hasChangedAircraftIcaoId(matchedModel.getAircraftIcaoCode()))
                         {
-                            icao = sApp->getWebDataServices()->getAircraftIcaoCodeForDbKey(reverseModelProcessed->getDbAircraftIcaoId());
+                            icao = webServices->getAircraftIcaoCodeForDbKey(reverseModelProcessed->getDbAircraftIcaoId());
                         }
                         rv.modified = true;
                         rv.model.setAircraftIcaoCode(icao);
                     }
 
-                    if (reverseModelProcessed->hasChangedLiveryId(matchedModel.getLivery()))
+                    if (webServices && reverseModelProcessed->hasChangedLiveryId(matchedModel.getLivery()))
                     {
-                        const CLivery livery(sApp->getWebDataServices()->getLiveryForDbKey(reverseModelProcessed->getDbLiveryId()));
+                        const CLivery livery(webServices->getLiveryForDbKey(reverseModelProcessed->getDbLiveryId()));
                         rv.model.setLivery(livery);
                         rv.modified = true;
                     }
-                    else if (reverseModelProcessed->hasChangedAirlineIcao(matchedModel.getAirlineIcaoCode()))
+                    else if (webServices && reverseModelProcessed->hasChangedAirlineIcao(matchedModel.getAirlineIcaoCode()))
                     {
                         CAirlineIcaoCode icao;
                         if (reverseModelProcessed->hasChangedAirlineIcaoId(matchedModel.getAirlineIcaoCode()))
                         {
-                            icao = sApp->getWebDataServices()->getAirlineIcaoCodeForDbKey(reverseModelProcessed->getDbAirlineIcaoId());
+                            icao = webServices->getAirlineIcaoCodeForDbKey(reverseModelProcessed->getDbAirlineIcaoId());
                         }
                         else
                         {
-                            icao = sApp->getWebDataServices()->getAirlineIcaoCodeForUniqueDesignatorOrDefault(reverseModelProcessed->getAirlineIcao(), true);
+                            icao = webServices->getAirlineIcaoCodeForUniqueDesignatorOrDefault(reverseModelProcessed->getAirlineIcao(), true);
                         }
 
-                        const CLivery livery(sApp->getWebDataServices()->getStdLiveryForAirlineCode(icao));
+                        const CLivery livery(webServices->getStdLiveryForAirlineCode(icao));
                         rv.model.setLivery(livery);
                         if (log) { CCallsign::addLogDetailsToList(log, callsign, QStringLiteral("Matching script, changed airline ICAO: '%1' -> '%2'").arg(matchedModel.getAirlineIcaoCode().toQString(true), icao.toQString(true))); }
                         rv.modified = true;
@@ -1292,6 +1379,7 @@ namespace BlackCore
 
         // set values
         m_modelSet  = modelsCleaned;
+        m_modelSetIndex = CAircraftModelSetIndex(m_modelSet);
         m_simulator = simulator;
         m_modelSetInfo = QStringLiteral("Set: '%1' entries: %2").arg(simulator.toQString()).arg(modelsCleaned.size());
         return models.size();
@@ -1310,11 +1398,13 @@ namespace BlackCore
             m_disabledModels = removedModels;
             m_modelSet.removeModelsWithString(removedModels, Qt::CaseInsensitive);
         }
+        m_modelSetIndex = CAircraftModelSetIndex(m_modelSet);
     }
 
     void CAircraftMatcher::restoreDisabledModels()
     {
         m_modelSet.replaceOrAddModelsWithString(m_disabledModels, Qt::CaseInsensitive);
+        m_modelSetIndex = CAircraftModelSetIndex(m_modelSet);
     }
 
     void CAircraftMatcher::setDefaultModel(const CAircraftModel &defaultModel)
@@ -1323,6 +1413,25 @@ namespace BlackCore
         m_defaultModel.setModelType(CAircraftModel::TypeModelMatchingDefaultModel);
     }
 
+    MatchingScriptStatistics CAircraftMatcher::getMatchingScriptStatistics() const
+    {
+        QMutexLocker lock(&m_scriptStatisticsMutex);
+        return m_scriptStatistics;
+    }
+
+    void CAircraftMatcher::addMatchingScriptStatistics(const MatchingScriptStatistics &before, const MatchingScriptStatistics &after) const
+    {
+        QMutexLocker lock(&m_scriptStatisticsMutex);
+        m_scriptStatistics.addMatching(before, after);
+    }
+
+    void CAircraftMatcher::clearMatchingStatistics()
+    {
+        m_statistics.clear();
+        QMutexLocker lock(&m_scriptStatisticsMutex);
+        m_scriptStatistics = MatchingScriptStatistics();
+    }
+
     void CAircraftMatcher::evaluateStatisticsEntry(const QString &sessionId, const CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery)
     {
         Q_UNUSED(livery)
@@ -1391,9 +1500,9 @@ namespace BlackCore
         return CFileUtils::writeStringToFile(json, CFileUtils::appendFilePathsAndFixUnc(CSwiftDirectories::logDirectory(), QStringLiteral("removed models %1.json").arg(ts)));
     }
 
-    CAircraftModelList CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelList &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::getClosestMatchStepwiseReduceImplementation(const CAircraftModelSetIndex &index, const ModelIds &modelSet, const CAircraftMatcherSetup &setup, const CCategoryMatcher &categoryMatcher, const CSimulatedAircraft &remoteAircraft, MatchingLog whatToLog, CStatusMessageList *log)
     {
-        CAircraftModelList matchedModels(modelSet);
+        ModelIds matchedModels(modelSet);
         CAircraftModel matchedModel(remoteAircraft.getModel());
         Q_UNUSED(whatToLog)
 
@@ -1405,7 +1514,7 @@ namespace BlackCore
             // by livery, then by ICAO
             if (mode.testFlag(CAircraftMatcherSetup::ByLivery))
             {
-                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, matchedModels, reduced, log);
+                matchedModels = ifPossibleReduceByLiveryAndAircraftIcaoCode(remoteAircraft, index, matchedModels, reduced, log);
                 if (reduced) { break; } // almost perfect, we stop here (we have ICAO + livery match)
             }
             else if (reduceLog)
@@ -1417,7 +1526,7 @@ namespace BlackCore
             {
                 // by airline/aircraft or by aircraft/airline depending on setup
                 // family is also considered
-                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, matchedModels, setup, reduced, log);
+                matchedModels = ifPossibleReduceByIcaoData(remoteAircraft, index, matchedModels, setup, reduced, log);
             }
             else if (reduceLog)
             {
@@ -1427,7 +1536,7 @@ namespace BlackCore
                 if (mode.testFlag(CAircraftMatcherSetup::ByFamily))
                 {
                     QString usedFamily;
-                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, matchedModels, reduced, usedFamily, log);
+                    matchedModels = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, matchedModels, reduced, usedFamily, log);
                     if (reduced) { break; }
                 }
                 else if (reduceLog)
@@ -1438,7 +1547,9 @@ namespace BlackCore
 
             if (setup.useCategoryMatching())
             {
-                matchedModels = categoryMatcher.reduceByCategories(matchedModels, modelSet, setup, remoteAircraft, reduced, whatToLog, log);
+                // the category matcher works on model lists
+                const CAircraftModelList byCategories = categoryMatcher.reduceByCategories(index.toModels(matchedModels), index.toModels(modelSet), setup, remoteAircraft, reduced, whatToLog, log);
+                matchedModels = index.toIds(byCategories);
                 // ?? break here ??
             }
             else if (reduceLog)
@@ -1447,9 +1558,9 @@ namespace BlackCore
             }
 
             // if not yet reduced, reduce to VTOL
-            if (!reduced && remoteAircraft.isVtol() && matchedModels.containsVtol() && mode.testFlag(CAircraftMatcherSetup::ByVtol))
+            if (!reduced && remoteAircraft.isVtol() && index.containsVtol(matchedModels) && mode.testFlag(CAircraftMatcherSetup::ByVtol))
             {
-                matchedModels = matchedModels.findByVtolFlag(true);
+                matchedModels = index.findByVtolFlag(matchedModels, true);
                 CMatchingUtils::addLogDetailsToList(log, remoteAircraft, QStringLiteral("Aircraft is VTOL, reduced to VTOL"), getLogCategories());
             }
 
@@ -1457,20 +1568,20 @@ namespace BlackCore
             bool milFlagReduced = false;
             if (mode.testFlag(CAircraftMatcherSetup::ByMilitary) && remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedModels, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             if (!milFlagReduced && mode.testFlag(CAircraftMatcherSetup::ByCivilian) && !remoteAircraft.isMilitary())
             {
-                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, matchedModels, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByMilitaryFlag(remoteAircraft, index, matchedModels, reduced, reduceLog);
                 milFlagReduced = true;
             }
 
             // combined code
             if (mode.testFlag(CAircraftMatcherSetup::ByCombinedType))
             {
-                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, matchedModels, setup, reduced, reduceLog);
+                matchedModels = ifPossibleReduceByCombinedType(remoteAircraft, index, matchedModels, setup, reduced, reduceLog);
                 if (reduced) { break; }
             }
             else if (log)
@@ -1483,7 +1594,7 @@ namespace BlackCore
         // here we have a list of possible models, we reduce/refine further
         if (matchedModels.size() > 1 && mode.testFlag(CAircraftMatcherSetup::ByManufacturer))
         {
-            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
+            matchedModels = ifPossibleReduceByManufacturer(remoteAircraft, index, matchedModels, QStringLiteral("2nd trial to reduce by manufacturer. "), reduced, reduceLog);
         }
 
         return matchedModels;
@@ -1573,7 +1684,7 @@ namespace BlackCore
         return model;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByLiveryAndAircraftIcaoCode(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getLivery().hasCombinedCode())
@@ -1582,8 +1693,9 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList byLivery(
-            inList.findByAircraftDesignatorAndLiveryCombinedCode(
+        const ModelIds byLivery(
+            index.findByAircraftDesignatorAndLiveryCombinedCode(
+                inList,
                 remoteAircraft.getLivery().getCombinedCode(),
                 remoteAircraft.getAircraftIcaoCodeDesignator()
             ));
@@ -1597,7 +1709,7 @@ namespace BlackCore
         return byLivery;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByIcaoData(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         const CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
         if (inList.isEmpty())
@@ -1611,8 +1723,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAirline(remoteAircraft, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
-            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
+            ModelIds models = ifPossibleReduceByAirline(remoteAircraft, index, inList, setup, QStringLiteral("Reduce by airline first."), r1, log);
+            models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, models, setup, QStringLiteral("Reduce by aircraft ICAO second."), r2, log);
             reduced = r1 || r2;
             if (reduced) { return models; }
         }
@@ -1620,8 +1732,8 @@ namespace BlackCore
         {
             bool r1 = false;
             bool r2 = false;
-            CAircraftModelList models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
-            models = ifPossibleReduceByAirline(remoteAircraft, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
+            ModelIds models = ifPossibleReduceByAircraftOrFamily(remoteAircraft, UsePseudoFamily, index, inList, setup, QStringLiteral("Reduce by aircraft ICAO first."), r1, log);
+            models = ifPossibleReduceByAirline(remoteAircraft, index, models, setup, QStringLiteral("Reduce aircraft ICAO by airline second."), r2, log);
 
             // not finding anything so far means we have no valid aircraft/airline ICAO combination
             // but it can happen we found B738, and for DLH there is no B738 but B737, so we search again
@@ -1635,12 +1747,12 @@ namespace BlackCore
 
                 bool r3 = false;
                 QString usedFamily;
-                CAircraftModelList models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, inList, r3, usedFamily, log);
-                models2nd = ifPossibleReduceByAirline(remoteAircraft, models2nd, setup, "Reduce family by airline second.", r3, log);
+                ModelIds models2nd = ifPossibleReduceByFamily(remoteAircraft, UsePseudoFamily, index, inList, r3, usedFamily, log);
+                models2nd = ifPossibleReduceByAirline(remoteAircraft, index, models2nd, setup, "Reduce family by airline second.", r3, log);
                 if (r3)
                 {
                     // we found family / airline combination
-                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(models2nd.sizeInt()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
+                    if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found " % QString::number(models2nd.size()) % " aircraft family/airline '" % usedFamily % u"' combination", getLogCategories()); }
                     return models2nd;
                 }
             }
@@ -1657,22 +1769,22 @@ namespace BlackCore
         return inList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inList, bool &reduced, QString &usedFamily, CStatusMessageList *log)
     {
         reduced = false;
         usedFamily = remoteAircraft.getAircraftIcaoCode().getFamily();
         if (!usedFamily.isEmpty())
         {
-            CAircraftModelList matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("real family from ICAO"), reduced, log);
+            ModelIds matchedModels = ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inList, QStringLiteral("real family from ICAO"), reduced, log);
             if (reduced) { return matchedModels; }
         }
 
         // scenario: the ICAO actually is the family
         usedFamily = remoteAircraft.getAircraftIcaoCodeDesignator();
-        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, inList, QStringLiteral("ICAO treated as family"), reduced, log);
+        return ifPossibleReduceByFamily(remoteAircraft, usedFamily, allowPseudoFamily, index, inList, QStringLiteral("ICAO treated as family"), reduced, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelList &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByFamily(const CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inList, const QString &hint, bool &reduced, CStatusMessageList *log)
     {
         // Use an algorithm to find the best match
         reduced = false;
@@ -1688,7 +1800,7 @@ namespace BlackCore
             return inList;
         }
 
-        CAircraftModelList foundByFamily(inList.findByFamily(family));
+        ModelIds foundByFamily(index.findByFamily(inList, family));
         if (foundByFamily.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by family '" % family % u"' (" % hint % ")"); }
@@ -1697,13 +1809,13 @@ namespace BlackCore
         }
         else
         {
-            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
+            if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.size()), getLogCategories()); }
         }
 
-        CAircraftModelList foundByCM;
+        ModelIds foundByCM;
         if (allowPseudoFamily)
         {
-            foundByCM = inList.findByCombinedAndManufacturer(remoteAircraft.getAircraftIcaoCode());
+            foundByCM = index.findByCombinedAndManufacturer(inList, remoteAircraft.getAircraftIcaoCode());
             const QString pseudo = remoteAircraft.getAircraftIcaoCode().getCombinedType() % "/" % remoteAircraft.getAircraftIcaoCode().getManufacturer();
             if (foundByCM.isEmpty())
             {
@@ -1711,7 +1823,7 @@ namespace BlackCore
             }
             else
             {
-                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.sizeInt()), getLogCategories()); }
+                if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by pseudo family '" % pseudo % u"' (" % hint % u") size " % QString::number(foundByCM.size()), getLogCategories()); }
             }
         }
 
@@ -1719,14 +1831,13 @@ namespace BlackCore
         reduced = true;
 
         // avoid dpulicates, then add
-        if (!foundByFamily.isEmpty()) { foundByCM.removeModelsWithString(foundByFamily.getModelStringList(), Qt::CaseInsensitive); }
-        foundByFamily.push_back(foundByCM);
+        foundByFamily = CAircraftModelSetIndex::unite(foundByFamily, foundByCM);
 
-        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.sizeInt()), getLogCategories()); }
+        if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by family (totally) '" % family % u"' (" % hint % u") size " % QString::number(foundByFamily.size()), getLogCategories()); }
         return foundByFamily;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByManufacturer(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1742,7 +1853,7 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByManufacturer(m));
+        const ModelIds outList(index.findByManufacturer(inList, m));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Not found '" % m % u"', cannot reduce", getLogCategories()); }
@@ -1782,7 +1893,7 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const QString &info, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByAircraft(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1797,7 +1908,7 @@ namespace BlackCore
             return inList;
         }
 
-        const CAircraftModelList outList(inList.findByIcaoDesignators(remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
+        const ModelIds outList(index.findByIcaoDesignators(inList, remoteAircraft.getAircraftIcaoCode(), CAirlineIcaoCode::null()));
         if (outList.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, info % u" Cannot reduce by '" % remoteAircraft.getAircraftIcaoCodeDesignator() % u"' results: " % QString::number(outList.size()), getLogCategories()); }
@@ -1809,16 +1920,16 @@ namespace BlackCore
         return outList;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelList &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByAircraftOrFamily(const CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const CAircraftModelSetIndex &index, const ModelIds &inList,  const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        const CAircraftModelList outList = ifPossibleReduceByAircraft(remoteAircraft, inList, info, reduced, log);
+        const ModelIds outList = ifPossibleReduceByAircraft(remoteAircraft, index, inList, info, reduced, log);
         if (reduced || !setup.getMatchingMode().testFlag(CAircraftMatcherSetup::ByFamily)) { return outList; }
         QString family;
-        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, inList, reduced, family, log);
+        return ifPossibleReduceByFamily(remoteAircraft, allowPseudoFamily, index, inList, reduced, family, log);
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByAirline(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, const CAircraftMatcherSetup &setup, const QString &info, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (inList.isEmpty())
@@ -1834,21 +1945,21 @@ namespace BlackCore
         }
 
         CAircraftMatcherSetup::MatchingMode mode = setup.getMatchingMode();
-        CAircraftModelList outList(inList.findByIcaoDesignators(CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
+        ModelIds outList(index.findByIcaoDesignators(inList, CAircraftIcaoCode::null(), remoteAircraft.getAirlineIcaoCode()));
         if (
             mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupSameAsAirline) ||
             (outList.isEmpty() || mode.testFlag(CAircraftMatcherSetup::ByAirlineGroupIfNoAirline)))
         {
             if (remoteAircraft.getAirlineIcaoCode().hasGroupMembership())
             {
-                const CAircraftModelList groupModels = inList.findByAirlineGroup(remoteAircraft.getAirlineIcaoCode());
-                outList.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
+                const ModelIds groupModels = index.findByAirlineGroup(inList, remoteAircraft.getAirlineIcaoCode());
+                outList = CAircraftModelSetIndex::replaceOrAdd(outList, groupModels);
                 if (log)
                 {
                     CMatchingUtils::addLogDetailsToList(log, remoteAircraft,
                                                         groupModels.isEmpty() ?
                                                         QStringLiteral("No group models found by using airline group '%1'").arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator()) :
-                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.sizeInt()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(groupModels.getAirlineVDesignators(), ", ")),
+                                                        QStringLiteral("Added %1 model(s) by using airline group '%2', all members: '%3'").arg(groupModels.size()).arg(remoteAircraft.getAirlineIcaoCode().getGroupDesignator(), joinStringSet(index.toModels(groupModels).getAirlineVDesignators(), ", ")),
                                                         getLogCategories());
                 }
             } // group membership
@@ -1919,7 +2030,7 @@ namespace BlackCore
         **/
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByCombinedType(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, const CAircraftMatcherSetup &setup, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         if (!remoteAircraft.getAircraftIcaoCode().hasValidCombinedType())
@@ -1929,7 +2040,7 @@ namespace BlackCore
         }
 
         const QString cc = remoteAircraft.getAircraftIcaoCode().getCombinedType();
-        CAircraftModelList modelsByCombinedCode(inList.findByCombinedType(cc));
+        ModelIds modelsByCombinedCode(index.findByCombinedType(inList, cc));
         if (modelsByCombinedCode.isEmpty())
         {
             if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Not found by combined code " % cc, getLogCategories()); }
@@ -1939,18 +2050,18 @@ namespace BlackCore
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Found by combined code " % cc % u", possible " % QString::number(modelsByCombinedCode.size()), getLogCategories()); }
         if (modelsByCombinedCode.size() > 1)
         {
-            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
-            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByAirline(remoteAircraft, index, modelsByCombinedCode, setup, QStringLiteral("Combined code airline reduction. "), reduced, log);
+            modelsByCombinedCode = ifPossibleReduceByManufacturer(remoteAircraft, index, modelsByCombinedCode, QStringLiteral("Combined code manufacturer reduction. "), reduced, log);
             reduced = true;
         }
         return modelsByCombinedCode;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByMilitaryFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
         const bool military = remoteAircraft.getModel().isMilitary();
-        const CAircraftModelList byMilitaryFlag(inList.findByMilitaryFlag(military));
+        const ModelIds byMilitaryFlag(index.findByMilitaryFlag(inList, military));
         const QString mil(military ? "military" : "civilian");
         if (byMilitaryFlag.isEmpty())
         {
@@ -1962,15 +2073,15 @@ namespace BlackCore
         return byMilitaryFlag;
     }
 
-    CAircraftModelList CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelList &inList, bool &reduced, CStatusMessageList *log)
+    ModelIds CAircraftMatcher::ifPossibleReduceByVTOLFlag(const CSimulatedAircraft &remoteAircraft, const CAircraftModelSetIndex &index, const ModelIds &inList, bool &reduced, CStatusMessageList *log)
     {
         reduced = false;
-        if (!inList.containsVtol())
+        if (!index.containsVtol(inList))
         {
             CMatchingUtils::addLogDetailsToList(log, remoteAircraft, "Cannot reduce to VTOL aircraft", getLogCategories());
             return inList;
         }
-        CAircraftModelList vtolModels = inList.findByVtolFlag(true);
+        ModelIds vtolModels = index.findByVtolFlag(inList, true);
         if (log) { CMatchingUtils::addLogDetailsToList(log, remoteAircraft, u"Models reduced to " % QString::number(vtolModels.size()) % u" VTOL aircraft", getLogCategories()); }
         return vtolModels;
     }
@@ -12,30 +12,40 @@
 #define BLACKCORE_AIRCRAFTMATCHER_H
 
 #include "blackcore/webdataservicesms.h"
+#include "blackcore/matchingscriptstatistics.h"
 #include "blackcore/blackcoreexport.h"
 #include "blackmisc/simulation/aircraftmodelsetprovider.h"
 #include "blackmisc/simulation/aircraftmatchersetup.h"
 #include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
 #include "blackmisc/simulation/matchingscriptmisc.h"
 #include "blackmisc/simulation/matchingstatistics.h"
 #include "blackmisc/simulation/matchinglog.h"
 #include "blackmisc/simulation/categorymatcher.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
 #include "blackmisc/statusmessage.h"
+#include "blackmisc/statusmessagelist.h"
 #include "blackmisc/valueobject.h"
 #include "blackmisc/variant.h"
 
 #include <QFlags>
 #include <QObject>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
 #include <QString>
 #include <QPair>
 #include <QSet>
+#include <functional>
+#include <vector>
 
 namespace BlackMisc
 {
+    class CContinuousWorker;
     class CLogCategoryList;
     class CStatusMessageList;
     namespace Aviation   { class CCallsign; }
-    namespace Simulation { class CSimulatedAircraft; }
+    namespace Simulation { class CSimulatedAircraft; class CSimulatedAircraftList; }
 }
 
 namespace BlackCore
@@ -86,6 +96,39 @@ namespace BlackCore
             BlackMisc::CStatusMessageList *log,
             bool useMatchingScript) const;
 
+        //! Result of a matching
+        struct MatchingResult
+        {
+            BlackMisc::Simulation::CSimulatedAircraft remoteAircraft; //!< the aircraft to be matched
+            BlackMisc::Simulation::CAircraftModel     matchedModel;   //!< the matched model
+            BlackMisc::CStatusMessageList             matchingMessages; //!< matching log, empty if not logged
+        };
+
+        //! Results of several matchings
+        using MatchingResults = std::vector<MatchingResult>;
+
+        //! Get the closest matching aircraft models for several aircraft, the matchings run concurrently in the matching workers.
+        //! \remark all matchings use a snapshot of the current model set and setup, taken when called
+        //! \remark without started matching workers all matchings run in the calling thread
+        //! \remark the callback is called in the thread of context with the results sorted by callsign
+        //! \sa getClosestMatch
+        //! \sa startMatchingWorkers
+        void getClosestMatchesConcurrently(
+            const BlackMisc::Simulation::CSimulatedAircraftList &remoteAircraft,
+            BlackMisc::Simulation::MatchingLog whatToLog, bool useMatchingScript,
+            QObject *context, const std::function<void(const MatchingResults &)> &callback);
+
+        //! Start the worker threads of the concurrent matchings, the threads are owned by this matcher
+        //! \remark count < 1 means QThread::idealThreadCount
+        //! \remark to be called in the thread of the matcher
+        void startMatchingWorkers(int count = -1);
+
+        //! Stop the worker threads of the concurrent matchings
+        void stopMatchingWorkers();
+
+        //! Number of started matching workers
+        int getMatchingWorkersCount() const { return m_matchingWorkers.size(); }
+
         //! Return an valid airline ICAO code
         //! \threadsafe
         static BlackMisc::Aviation::CAirlineIcaoCode failoverValidAirlineIcaoDesignator(
@@ -123,10 +166,11 @@ namespace BlackCore
         //! \threadsafe
         static BlackMisc::Simulation::MatchingScriptReturnValues matchingStageScript(const BlackMisc::Simulation::CAircraftModel &inModel, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const BlackMisc::Simulation::CAircraftModelList &modelSet, BlackMisc::CStatusMessageList *log);
 
-        //! Run the matching script
+        //! Run the matching script file
+        //! \remark uses the script runtime of the current thread, the file is only evaluated again if it changed
         //! \threadsafe
-        static BlackMisc::Simulation::MatchingScriptReturnValues matchingScript(const QString &js,
-                const BlackMisc::Simulation::CAircraftModel &inModel, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+        static BlackMisc::Simulation::MatchingScriptReturnValues matchingScript(const QString &scriptFile,
+                const BlackMisc::Simulation::CAircraftModel &inModel, const BlackMisc::Simulation::CAircraftModel &matchedModel,
                 const BlackMisc::Simulation::CAircraftModelList &modelSet, BlackMisc::Simulation::MatchingScript ms,
                 BlackMisc::CStatusMessageList *log);
 
@@ -296,8 +340,12 @@ namespace BlackCore
         //! The current statistics
         const BlackMisc::Simulation::CMatchingStatistics &getCurrentStatistics() const { return m_statistics; }
 
+        //! Script loads, runs and run time of the matchings since the statistics were cleared
+        //! \threadsafe
+        MatchingScriptStatistics getMatchingScriptStatistics() const;
+
         //! Clear the statistics
-        void clearMatchingStatistics() { m_statistics.clear(); }
+        void clearMatchingStatistics();
 
         //! Evaluate if a statistics entry makes sense and add it
         void evaluateStatisticsEntry(const QString &sessionId, const BlackMisc::Aviation::CCallsign &callsign, const QString &aircraftIcao, const QString &airlineIcao, const QString &livery);
@@ -310,12 +358,41 @@ namespace BlackCore
         void setupChanged();
 
     private:
+        //! Everything a matching depends on, copied so a matching can run in any thread
+        struct MatchingSnapshot
+        {
+            BlackMisc::Simulation::CAircraftMatcherSetup  setup;           //!< setup
+            BlackMisc::Simulation::CAircraftModel         defaultModel;    //!< default model
+            BlackMisc::Simulation::CAircraftModelList     modelSet;        //!< model set
+            BlackMisc::Simulation::CAircraftModelSetIndex modelSetIndex;   //!< index of the model set
+            BlackMisc::Simulation::CCategoryMatcher       categoryMatcher; //!< category matcher
+        };
+
+        //! Snapshot of the current matching state
+        MatchingSnapshot getMatchingSnapshot() const;
+
+        //! Get the closest matching aircraft model using the snapshot
+        //! \threadsafe
+        static BlackMisc::Simulation::CAircraftModel getClosestMatchImplementation(
+            const MatchingSnapshot &snapshot,
+            const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
+            BlackMisc::Simulation::MatchingLog whatToLog,
+            BlackMisc::CStatusMessageList *log,
+            bool useMatchingScript);
+
+        //! Add the script runs of one matching
+        //! \threadsafe
+        void addMatchingScriptStatistics(const MatchingScriptStatistics &before, const MatchingScriptStatistics &after) const;
+
+        //! Delete the matching script runtimes of this thread and of the matching workers
+        void releaseMatchingScriptRuntimes();
+
         //! Save the disabled models if any
         bool saveDisabledForMatchingModels();
 
         //! The search based implementation
-        static BlackMisc::Simulation::CAircraftModelList getClosestMatchStepwiseReduceImplementation(
-            const BlackMisc::Simulation::CAircraftModelList &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds getClosestMatchStepwiseReduceImplementation(
+            const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &modelSet, const BlackMisc::Simulation::CAircraftMatcherSetup &setup,
             const BlackMisc::Simulation::CCategoryMatcher &categoryMatcher, const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft,
             BlackMisc::Simulation::MatchingLog whatToLog, BlackMisc::CStatusMessageList *log = nullptr);
 
@@ -333,24 +410,24 @@ namespace BlackCore
 
         //! Installed models by ICAO data
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByIcaoData(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &models, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, bool &reduced, QString &usedFamily, BlackMisc::CStatusMessageList *log);
 
         //! Find model by aircraft family
         //! \remark pseudo family searches for same combined type and manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const QString &family, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const QString &hint, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Search for exact livery and aircraft ICAO code
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByLiveryAndAircraftIcaoCode(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByManufacturer(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by manufacturer
         //! \threadsafe
@@ -358,15 +435,15 @@ namespace BlackCore
 
         //! Reduce by aircraft ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByAircraft(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by aircraft ICAO or family
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByAircraftOrFamily(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, bool allowPseudoFamily, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline ICAO
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByAirline(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, const QString &info, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Reduce by airline name/telephone designator
         //! \threadsafe
@@ -374,15 +451,15 @@ namespace BlackCore
 
         //! Installed models by combined code (ie L2J, L1P, ...)
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByCombinedType(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, const BlackMisc::Simulation::CAircraftMatcherSetup &setup, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By military flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByMilitaryFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! By VTOL flag
         //! \threadsafe
-        static BlackMisc::Simulation::CAircraftModelList ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelList &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
+        static BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds ifPossibleReduceByVTOLFlag(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModelSetIndex &index, const BlackMisc::Simulation::CAircraftModelSetIndex::ModelIds &inList, bool &reduced, BlackMisc::CStatusMessageList *log);
 
         //! Scores to string for debugging
         //! \threadsafe
@@ -402,11 +479,15 @@ namespace BlackCore
         BlackMisc::Simulation::CAircraftMatcherSetup m_setup;           //!< setup
         BlackMisc::Simulation::CAircraftModel        m_defaultModel;    //!< model to be used as default model
         BlackMisc::Simulation::CAircraftModelList    m_modelSet;        //!< models used for model matching
+        BlackMisc::Simulation::CAircraftModelSetIndex m_modelSetIndex;  //!< index of m_modelSet, rebuilt whenever the set changes
         BlackMisc::Simulation::CAircraftModelList    m_disabledModels;  //!< disabled models for matching
         BlackMisc::Simulation::CSimulatorInfo        m_simulator;       //!< simulator (optional)
         BlackMisc::Simulation::CMatchingStatistics   m_statistics;      //!< matching statistics
         BlackMisc::Simulation::CCategoryMatcher      m_categoryMatcher; //!< the category matcher
         QString                                      m_modelSetInfo;    //!< info string
+        QList<QPointer<BlackMisc::CContinuousWorker>> m_matchingWorkers; //!< worker threads of the concurrent matchings
+        mutable QMutex m_scriptStatisticsMutex; //!< guards m_scriptStatistics
+        mutable MatchingScriptStatistics m_scriptStatistics; //!< script cost of the matchings
     };
 } // namespace
 
@@ -18,10 +18,12 @@
 
 #include <QDateTime>
 #include <QMetaObject>
+#include <QPointer>
 #include <QReadLocker>
 #include <QString>
 #include <QThread>
 #include <QWriteLocker>
+#include <limits>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -65,9 +67,13 @@ namespace BlackCore
         Q_ASSERT(c);
 
         // Monitor
-        c = connect(airspaceMonitorParent, &CAirspaceMonitor::addedAircraftSituation, this, &CAirspaceAnalyzer::watchdogTouchAircraftCallsign);
+        c = connect(airspaceMonitorParent, &CAirspaceMonitor::addedAircraft, this, &CAirspaceAnalyzer::onAddedAircraft);
         Q_ASSERT(c);
-        c = connect(airspaceMonitorParent, &CAirspaceMonitor::removedAircraft, this, &CAirspaceAnalyzer::watchdogRemoveAircraftCallsign);
+        c = connect(airspaceMonitorParent, &CAirspaceMonitor::addedAircraftSituation, this, &CAirspaceAnalyzer::onAddedAircraftSituation);
+        Q_ASSERT(c);
+        c = connect(airspaceMonitorParent, &CAirspaceMonitor::changedAircraftRenderingValues, this, &CAirspaceAnalyzer::onChangedAircraftRenderingValues);
+        Q_ASSERT(c);
+        c = connect(airspaceMonitorParent, &CAirspaceMonitor::removedAircraft, this, &CAirspaceAnalyzer::onRemovedAircraft);
         Q_ASSERT(c);
         c = connect(airspaceMonitorParent, &CAirspaceMonitor::changedAtcStationOnlineConnectionStatus, this, &CAirspaceAnalyzer::onChangedAtcStationOnlineConnectionStatus);
         Q_ASSERT(c);
@@ -92,6 +98,17 @@ namespace BlackCore
         m_simulatorRenderingEnabled = enabled;
         m_simulatorMaxRenderedAircraft = maxAircraft;
         m_simulatorMaxRenderedDistance = maxRenderedDistance;
+        m_snapshotOutdated = true;
+    }
+
+    void CAirspaceAnalyzer::reEmitLatestSnapshot()
+    {
+        QPointer<CAirspaceAnalyzer> myself(this);
+        QMetaObject::invokeMethod(this, [ = ]
+        {
+            if (!myself || !myself->isEnabled()) { return; }
+            myself->analyzeAirspace(true);
+        }, Qt::QueuedConnection);
     }
 
     CAirspaceAnalyzer::~CAirspaceAnalyzer()
@@ -108,7 +125,7 @@ namespace BlackCore
         const CCallsign cs = station.getCallsign();
         if (isConnected)
         {
-            m_atcCallsignTimestamps[cs] = QDateTime::currentMSecsSinceEpoch();
+            m_atcTimeouts.touch(cs, QDateTime::currentMSecsSinceEpoch());
         }
         else
         {
@@ -120,7 +137,68 @@ namespace BlackCore
     {
         const CCallsign cs = situation.getCallsign();
         Q_ASSERT_X(!cs.isEmpty(), Q_FUNC_INFO, "No callsign in situaton");
-        m_aircraftCallsignTimestamps[cs] = QDateTime::currentMSecsSinceEpoch();
+        m_aircraftTimeouts.touch(cs, QDateTime::currentMSecsSinceEpoch());
+    }
+
+    void CAirspaceAnalyzer::onAddedAircraft(const CSimulatedAircraft &aircraft)
+    {
+        const CCallsign cs = aircraft.getCallsign();
+        if (cs.isEmpty()) { return; }
+        int index = m_aircraftIndex.value(cs, -1);
+        if (index < 0)
+        {
+            index = m_aircraftByDistance.size();
+            m_aircraftByDistance.push_back(CAirspaceAircraftSnapshot::AircraftByDistance::fromAircraft(aircraft));
+            m_aircraftIndex.insert(cs, index);
+        }
+        else
+        {
+            m_aircraftByDistance[index] = CAirspaceAircraftSnapshot::AircraftByDistance::fromAircraft(aircraft);
+        }
+        this->sortAircraftByDistance(index);
+        m_snapshotOutdated = true;
+    }
+
+    void CAirspaceAnalyzer::onAddedAircraftSituation(const CAircraftSituation &situation)
+    {
+        this->watchdogTouchAircraftCallsign(situation);
+
+        const int index = m_aircraftIndex.value(situation.getCallsign(), -1);
+        if (index < 0) { return; }
+
+        // same distance as calculated by the airspace monitor
+        const CLength distance = this->getOwnAircraftPosition().calculateGreatCircleDistance(situation);
+        const double distanceM = distance.isNull() ? std::numeric_limits<double>::infinity() : distance.value(CLengthUnit::m());
+        double &aircraftDistanceM = m_aircraftByDistance[index].distanceM;
+        const bool crossedMaxDistance = (aircraftDistanceM >= m_snapshotMaxDistanceM) != (distanceM >= m_snapshotMaxDistanceM);
+        aircraftDistanceM = distanceM;
+
+        // only a change of the order or the rendered range changes the snapshot
+        if (this->sortAircraftByDistance(index) || crossedMaxDistance) { m_snapshotOutdated = true; }
+    }
+
+    void CAirspaceAnalyzer::onChangedAircraftRenderingValues(const CSimulatedAircraft &aircraft)
+    {
+        const int index = m_aircraftIndex.value(aircraft.getCallsign(), -1);
+        if (index < 0) { return; } // already removed
+        CAirspaceAircraftSnapshot::AircraftByDistance &a = m_aircraftByDistance[index];
+        a.enabled = aircraft.isEnabled();
+        a.rendered = aircraft.isRendered();
+        a.vtol = aircraft.isVtol();
+        this->sortAircraftByDistance(index); // rendered aircraft first for the same distance
+        m_snapshotOutdated = true;
+    }
+
+    void CAirspaceAnalyzer::onRemovedAircraft(const CCallsign &callsign)
+    {
+        this->watchdogRemoveAircraftCallsign(callsign);
+
+        const int index = m_aircraftIndex.value(callsign, -1);
+        if (index < 0) { return; }
+        m_aircraftByDistance.remove(index);
+        m_aircraftIndex.remove(callsign);
+        for (int i = index; i < m_aircraftByDistance.size(); ++i) { m_aircraftIndex[m_aircraftByDistance[i].callsign] = i; }
+        m_snapshotOutdated = true;
     }
 
     void CAirspaceAnalyzer::watchdogTouchAtcCallsign(const CCallsign &callsign, const CFrequency &frequency, const CCoordinateGeodetic &position, const CLength &range)
@@ -128,7 +206,7 @@ namespace BlackCore
         Q_UNUSED(frequency)
         Q_UNUSED(position)
         Q_UNUSED(range)
-        m_atcCallsignTimestamps[callsign] = QDateTime::currentMSecsSinceEpoch();
+        m_atcTimeouts.touch(callsign, QDateTime::currentMSecsSinceEpoch());
     }
 
     void CAirspaceAnalyzer::onConnectionStatusChanged(CConnectionStatus oldStatus, CConnectionStatus newStatus)
@@ -154,8 +232,11 @@ namespace BlackCore
 
     void CAirspaceAnalyzer::clear()
     {
-        m_aircraftCallsignTimestamps.clear();
-        m_atcCallsignTimestamps.clear();
+        m_aircraftTimeouts.clear();
+        m_atcTimeouts.clear();
+        m_aircraftByDistance.clear();
+        m_aircraftIndex.clear();
+        m_snapshotOutdated = true;
 
         QWriteLocker l(&m_lockSnapshot);
         m_latestAircraftSnapshot = CAirspaceAircraftSnapshot();
@@ -163,12 +244,12 @@ namespace BlackCore
 
     void CAirspaceAnalyzer::watchdogRemoveAircraftCallsign(const CCallsign &callsign)
     {
-        m_aircraftCallsignTimestamps.remove(callsign);
+        m_aircraftTimeouts.remove(callsign);
     }
 
     void CAirspaceAnalyzer::watchdogRemoveAtcCallsign(const CCallsign &callsign)
     {
-        m_atcCallsignTimestamps.remove(callsign);
+        m_atcTimeouts.remove(callsign);
     }
 
     void CAirspaceAnalyzer::watchdogCheckTimeouts()
@@ -194,34 +275,44 @@ namespace BlackCore
         const qint64 timeoutAtcEpochMs      = currentTimeMsEpoch - atcTimeoutMs;
         const bool enabled                  = m_enabledWatchdog;
 
-        const QList<CCallsign> callsignsAircraft = m_aircraftCallsignTimestamps.keys();
-        for (const CCallsign &callsign : callsignsAircraft) // clazy:exclude=container-anti-pattern,range-loop
+        // only the activities older than the timeout are visited
+        QList<qint64> lastActivitiesMs;
+        const QList<CCallsign> timedOutAircraft = this->watchdogTakeTimedOut(m_aircraftTimeouts, timeoutAircraftEpochMs, currentTimeMsEpoch, enabled, lastActivitiesMs);
+        for (int i = 0; i < timedOutAircraft.size(); ++i)
         {
-            if (!enabled) { m_aircraftCallsignTimestamps[callsign] = timeoutAircraftEpochMs + 1000; } // fake value so it can be re-enabled
-            const qint64 tsv = m_aircraftCallsignTimestamps.value(callsign);
-            if (tsv > timeoutAircraftEpochMs) { continue; }
-            CLogMessage(this).debug() << QStringLiteral("Aircraft '%1' timed out after %2ms").arg(callsign.toQString()).arg(currentTimeMsEpoch - tsv);
-            m_aircraftCallsignTimestamps.remove(callsign);
+            const CCallsign &callsign = timedOutAircraft[i];
+            CLogMessage(this).debug() << QStringLiteral("Aircraft '%1' timed out after %2ms").arg(callsign.toQString()).arg(currentTimeMsEpoch - lastActivitiesMs[i]);
             emit this->timeoutAircraft(callsign);
         }
 
-        const QList<CCallsign> callsignsAtc = m_atcCallsignTimestamps.keys();
-        for (const CCallsign &callsign : callsignsAtc) // clazy:exclude=container-anti-pattern,range-loop
+        const QList<CCallsign> timedOutAtc = this->watchdogTakeTimedOut(m_atcTimeouts, timeoutAtcEpochMs, currentTimeMsEpoch, enabled, lastActivitiesMs);
+        for (int i = 0; i < timedOutAtc.size(); ++i)
         {
-            if (!enabled) { m_aircraftCallsignTimestamps[callsign] = timeoutAtcEpochMs + 1000; } // fake value so it can be re-enabled
-            const qint64 tsv = m_atcCallsignTimestamps.value(callsign);
-            if (tsv > timeoutAtcEpochMs) { continue; }
-            CLogMessage(this).debug() << QStringLiteral("ATC '%1' timed out after %2ms").arg(callsign.toQString()).arg(currentTimeMsEpoch - tsv);
-            m_atcCallsignTimestamps.remove(callsign);
+            const CCallsign &callsign = timedOutAtc[i];
+            CLogMessage(this).debug() << QStringLiteral("ATC '%1' timed out after %2ms").arg(callsign.toQString()).arg(currentTimeMsEpoch - lastActivitiesMs[i]);
             emit this->timeoutAtc(callsign);
         }
     }
 
-    void CAirspaceAnalyzer::analyzeAirspace()
+    QList<CCallsign> CAirspaceAnalyzer::watchdogTakeTimedOut(CCallsignTimeouts &timeouts, qint64 timeoutEpochMs, qint64 currentTimeMsEpoch, bool enabled, QList<qint64> &lastActivitiesMs)
+    {
+        const QList<CCallsign> timedOut = timeouts.takeTimedOut(timeoutEpochMs, &lastActivitiesMs);
+        if (enabled) { return timedOut; }
+
+        // fake activity so it can be re-enabled
+        for (const CCallsign &callsign : timedOut) { timeouts.touch(callsign, currentTimeMsEpoch); }
+        return {};
+    }
+
+    void CAirspaceAnalyzer::analyzeAirspace(bool forceEmit)
     {
         Q_ASSERT_X(!CThreadUtils::thisIsMainThread(), Q_FUNC_INFO, "Expect to run in background thread");
         Q_ASSERT_X(thread() != qApp->thread(), Q_FUNC_INFO, "Expect to run in background thread affinity");
 
+        // only distances changed, the last snapshot is still valid
+        if (!m_snapshotOutdated && !forceEmit) { return; }
+        m_snapshotOutdated = false;
+
         bool restricted, enabled;
         int maxAircraft;
         CLength maxRenderedDistance;
@@ -232,13 +323,13 @@ namespace BlackCore
             maxAircraft = m_simulatorMaxRenderedAircraft;
             maxRenderedDistance = m_simulatorMaxRenderedDistance;
         }
+        m_snapshotMaxDistanceM = (restricted && enabled && !maxRenderedDistance.isNull()) ? maxRenderedDistance.value(CLengthUnit::m()) : std::numeric_limits<double>::infinity();
 
         // remark for simulation snapshot is used when there are restrictions
         // nevertheless we calculate all the time as the snapshot could be used in other scenarios
 
-        CSimulatedAircraftList aircraftInRange(this->getAircraftInRange()); // thread safe copy from provider
         CAirspaceAircraftSnapshot snapshot(
-            aircraftInRange,
+            m_aircraftByDistance,
             restricted, enabled,
             maxAircraft, maxRenderedDistance
         );
@@ -247,14 +338,45 @@ namespace BlackCore
         {
             QWriteLocker l(&m_lockSnapshot);
             bool wasValid = m_latestAircraftSnapshot.isValidSnapshot();
+            bool changed = true;
             if (wasValid)
             {
                 snapshot.setRestrictionChanged(m_latestAircraftSnapshot);
+                changed = snapshot.isRestrictionChanged() || !snapshot.hasSameAircraft(m_latestAircraftSnapshot);
             }
             m_latestAircraftSnapshot = snapshot;
-            if (!wasValid) { return; } // ignore the 1st snapshot
+            if (!forceEmit)
+            {
+                if (!wasValid) { return; } // ignore the 1st snapshot
+                if (!changed)  { return; } // nothing to do for the simulator
+            }
         }
 
         emit this->airspaceAircraftSnapshot(snapshot);
     }
+
+    bool CAirspaceAnalyzer::sortAircraftByDistance(int index)
+    {
+        // aircraft only move a little between position updates, so this is about constant
+        using AircraftByDistance = CAirspaceAircraftSnapshot::AircraftByDistance;
+        const AircraftByDistance aircraft = m_aircraftByDistance[index];
+        int i = index;
+        for (; i > 0 && AircraftByDistance::lessByDistance(aircraft, m_aircraftByDistance[i - 1]); --i)
+        {
+            m_aircraftByDistance[i] = m_aircraftByDistance[i - 1];
+            m_aircraftIndex[m_aircraftByDistance[i].callsign] = i;
+        }
+        if (i == index)
+        {
+            for (; i < m_aircraftByDistance.size() - 1 && AircraftByDistance::lessByDistance(m_aircraftByDistance[i + 1], aircraft); ++i)
+            {
+                m_aircraftByDistance[i] = m_aircraftByDistance[i + 1];
+                m_aircraftIndex[m_aircraftByDistance[i].callsign] = i;
+            }
+        }
+        if (i == index) { return false; }
+        m_aircraftByDistance[i] = aircraft;
+        m_aircraftIndex[aircraft.callsign] = i;
+        return true;
+    }
 } // ns
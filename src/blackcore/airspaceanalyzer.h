@@ -18,6 +18,8 @@
 #include "blackmisc/simulation/ownaircraftprovider.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
 #include "blackmisc/aviation/atcstation.h"
+#include "blackmisc/aviation/callsigntimeouts.h"
+#include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/pq/frequency.h"
 #include "blackmisc/pq/length.h"
@@ -25,12 +27,14 @@
 #include "blackmisc/pq/units.h"
 #include "blackmisc/worker.h"
 
-#include <QHash>
+#include <QList>
 #include <QObject>
 #include <QReadWriteLock>
 #include <QTimer>
+#include <QVector>
 #include <QtGlobal>
 #include <atomic>
+#include <limits>
 
 namespace BlackMisc::Aviation
 {
@@ -50,6 +54,11 @@ namespace BlackCore
     //!          clients nearby. The server does not take care of that. When a client crashes, no delete packet is ever sent. This class therefore monitors callsigns and emits a timeout signal if it
     //!          wasn't resetted during the specified timeout value.
     //!
+    //! \details Both parts work incrementally: the watchdog only visits the activities older than the timeout (CCallsignTimeouts),
+    //!          the aircraft are kept sorted by distance from the airspace monitor signals, an aircraft only moves by a few places
+    //!          per position update. A snapshot is only built if the aircraft or restrictions changed, and only emitted if
+    //!          the snapshot differs from the last one, or it is explicitly requested (reEmitLatestSnapshot).
+    //!
     class BLACKCORE_EXPORT CAirspaceAnalyzer :
         public BlackMisc::CContinuousWorker,
         public BlackMisc::Simulation::COwnAircraftAware,
@@ -58,9 +67,6 @@ namespace BlackCore
         Q_OBJECT
 
     public:
-        //! List of callsigns and their last activity
-        using CCallsignTimestampSet = QHash<BlackMisc::Aviation::CCallsign, qint64>;
-
         //! Constructor
         CAirspaceAnalyzer(BlackMisc::Simulation::IOwnAircraftProvider *ownAircraftProvider,
                           Fsd::CFSDClient *fsdClient,
@@ -76,6 +82,11 @@ namespace BlackCore
         //! Render restrictions in simulator
         void setSimulatorRenderRestrictionsChanged(bool restricted, bool enabled, int maxAircraft, const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance);
 
+        //! Emit the latest snapshot again, even if nothing changed
+        //! \remark for a (re)connected simulator, which has missed the earlier snapshots
+        //! \threadsafe
+        void reEmitLatestSnapshot();
+
         //! Enable/disable watchdog
         //! \remark primarily for debugging, where stopping at a breakpoint can cause multiple timeouts
         void setEnabledWatchdog(bool enabled) { m_enabledWatchdog = enabled; }
@@ -103,6 +114,18 @@ namespace BlackCore
         //! Reset timestamp for callsign
         void watchdogTouchAircraftCallsign(const BlackMisc::Aviation::CAircraftSituation &situation);
 
+        //! Aircraft added by the airspace monitor
+        void onAddedAircraft(const BlackMisc::Simulation::CSimulatedAircraft &aircraft);
+
+        //! Situation added by the airspace monitor, watchdog and distance
+        void onAddedAircraftSituation(const BlackMisc::Aviation::CAircraftSituation &situation);
+
+        //! Enabled or rendered flag or model of an aircraft changed
+        void onChangedAircraftRenderingValues(const BlackMisc::Simulation::CSimulatedAircraft &aircraft);
+
+        //! Aircraft removed by the airspace monitor
+        void onRemovedAircraft(const BlackMisc::Aviation::CCallsign &callsign);
+
         //! Reset timestamp for callsign
         void watchdogTouchAtcCallsign(const BlackMisc::Aviation::CCallsign &callsign, const BlackMisc::PhysicalQuantities::CFrequency &frequency,
                                       const BlackMisc::Geo::CCoordinateGeodetic &position, const BlackMisc::PhysicalQuantities::CLength &range);
@@ -122,12 +145,21 @@ namespace BlackCore
         //! Check for time outs
         void watchdogCheckTimeouts();
 
+        //! Check for time outs of aircraft or ATC
+        //! \remark with disabled watchdog the timed out callsigns are touched again, so they do not time out when it is enabled again
+        QList<BlackMisc::Aviation::CCallsign> watchdogTakeTimedOut(BlackMisc::Aviation::CCallsignTimeouts &timeouts, qint64 timeoutEpochMs, qint64 currentTimeMsEpoch, bool enabled, QList<qint64> &lastActivitiesMs);
+
         //! Analyze the airspace
-        void analyzeAirspace();
+        //! \param forceEmit emit the snapshot even if it did not change
+        void analyzeAirspace(bool forceEmit = false);
+
+        //! Move the aircraft at index to its place in the distance order
+        //! \return true if the order changed
+        bool sortAircraftByDistance(int index);
 
         // watchdog
-        CCallsignTimestampSet m_aircraftCallsignTimestamps; //!< for watchdog (pilots)
-        CCallsignTimestampSet m_atcCallsignTimestamps;      //!< for watchdog (ATC)
+        BlackMisc::Aviation::CCallsignTimeouts m_aircraftTimeouts; //!< for watchdog (pilots)
+        BlackMisc::Aviation::CCallsignTimeouts m_atcTimeouts;      //!< for watchdog (ATC)
         BlackMisc::PhysicalQuantities::CTime m_timeoutAircraft = { 15, BlackMisc::PhysicalQuantities::CTimeUnit::s() }; //!< Timeout value for watchdog functionality
         BlackMisc::PhysicalQuantities::CTime m_timeoutAtc      = { 50, BlackMisc::PhysicalQuantities::CTimeUnit::s() }; //!< Timeout value for watchdog functionality
         qint64 m_lastWatchdogCallMsSinceEpoch;       //!< when last called
@@ -136,6 +168,10 @@ namespace BlackCore
 
         // snapshot
         BlackMisc::Simulation::CAirspaceAircraftSnapshot m_latestAircraftSnapshot;
+        QVector<BlackMisc::Simulation::CAirspaceAircraftSnapshot::AircraftByDistance> m_aircraftByDistance; //!< aircraft in range sorted by distance, only used in analyzer thread
+        BlackMisc::Aviation::CPerCallsign<int> m_aircraftIndex; //!< index in m_aircraftByDistance, only used in analyzer thread
+        double m_snapshotMaxDistanceM = std::numeric_limits<double>::infinity(); //!< max. rendered distance of the last snapshot, infinity if not restricted, only used in analyzer thread
+        std::atomic_bool m_snapshotOutdated { true }; //!< aircraft or restrictions changed since the last snapshot
         bool m_simulatorRenderedAircraftRestricted = false;
         bool m_simulatorRenderingEnabled = true;
         int m_simulatorMaxRenderedAircraft = -1;
@@ -87,6 +87,7 @@ namespace BlackCore
         connect(m_fsdClient, &CFSDClient::pilotDataUpdateReceived,         this, &CAirspaceMonitor::onAircraftUpdateReceived);
         connect(m_fsdClient, &CFSDClient::interimPilotDataUpdatedReceived, this, &CAirspaceMonitor::onAircraftInterimUpdateReceived);
         connect(m_fsdClient, &CFSDClient::visualPilotDataUpdateReceived,   this, &CAirspaceMonitor::onAircraftVisualUpdateReceived);
+        connect(m_fsdClient, &CFSDClient::batchedPositionUpdatesReceived,  this, &CAirspaceMonitor::onAircraftPositionUpdatesReceived);
         connect(m_fsdClient, &CFSDClient::euroscopeSimDataUpdatedReceived, this, &CAirspaceMonitor::onAircraftSimDataUpdateReceived);
         connect(m_fsdClient, &CFSDClient::com1FrequencyResponseReceived,   this, &CAirspaceMonitor::onFrequencyReceived);
         connect(m_fsdClient, &CFSDClient::capabilityResponseReceived,      this, &CAirspaceMonitor::onCapabilitiesReplyReceived);
@@ -1347,6 +1348,61 @@ namespace BlackCore
         );
     }
 
+    void CAirspaceMonitor::onAircraftPositionUpdatesReceived(const CAircraftSituationList &situations)
+    {
+        Q_ASSERT_X(CThreadUtils::isInThisThread(this), Q_FUNC_INFO, "Called in different thread");
+        if (!this->isConnectedAndNotShuttingDown()) { return; }
+
+        // group per callsign, in order of reception
+        CAircraftSituationListPerCallsign situationsPerCallsign;
+        for (const CAircraftSituation &situation : situations)
+        {
+            Q_ASSERT_X(!situation.getCallsign().isEmpty(), Q_FUNC_INFO, "Empty callsign");
+            situationsPerCallsign[situation.getCallsign()].push_back(situation);
+        }
+
+        for (auto it = situationsPerCallsign.cbegin(); it != situationsPerCallsign.cend(); ++it)
+        {
+            const CCallsign &callsign = it.key();
+            if (isCopilotAircraft(callsign))        { continue; }
+            if (!this->isAircraftInRange(callsign)) { continue; }
+
+            // Visual and interim packets do not have groundspeed, hence set the last known value.
+            // If there is no full position available yet, throw these positions away.
+            const CAircraftSituation lastSituation = this->remoteAircraftSituation(callsign, 0);
+            if (lastSituation.isNull()) { continue; } // we need one full situation at least
+
+            // re-stamped like the single updates, strictly increasing in order of reception,
+            // so the interpolator never gets a situation older than the ones already stored
+            qint64 timestamp = qMax(QDateTime::currentMSecsSinceEpoch(), lastSituation.getMSecsSinceEpoch() + 1);
+            CAircraftSituation latestSituation;
+            for (const CAircraftSituation &situation : it.value())
+            {
+                if (CBuildConfig::isLocalDeveloperDebugBuild())
+                {
+                    Q_ASSERT_X(!situation.isNaNVectorDouble(), Q_FUNC_INFO, "Detected NaN");
+                    Q_ASSERT_X(!situation.isInfVectorDouble(), Q_FUNC_INFO, "Detected inf");
+                    Q_ASSERT_X(situation.isValidVectorRange(), Q_FUNC_INFO, "out of range [-1,1]");
+                }
+
+                latestSituation = situation;
+                latestSituation.setMSecsSinceEpoch(timestamp++);
+                latestSituation.setGroundSpeed(lastSituation.getGroundSpeed());
+                this->storeAircraftSituation(latestSituation);
+            }
+
+            const bool samePosition = lastSituation.equalNormalVectorDouble(latestSituation);
+            if (samePosition) { continue; } // nothing to update
+
+            // update aircraft once per batch
+            this->updateAircraftInRangeDistanceBearing(
+                callsign, latestSituation,
+                this->calculateDistanceToOwnAircraft(latestSituation),
+                this->calculateBearingToOwnAircraft(latestSituation)
+            );
+        }
+    }
+
     void CAirspaceMonitor::onAircraftVisualUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation)
     {
         //! \fixme This method is almost identical to onAircraftInterimUpdateReceived. Refactor common parts?
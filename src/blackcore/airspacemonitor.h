@@ -32,6 +32,7 @@
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/callsignset.h"
 #include "blackmisc/aviation/flightplan.h"
+#include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/geo/coordinategeodetic.h"
 #include "blackmisc/pq/frequency.h"
 #include "blackmisc/pq/length.h"
@@ -41,7 +42,6 @@
 
 #include <QJsonObject>
 #include <QList>
-#include <QHash>
 #include <QMetaObject>
 #include <QObject>
 #include <QReadWriteLock>
@@ -283,9 +283,9 @@ namespace BlackCore
 
         BlackMisc::Aviation::CAtcStationList m_atcStationsOnline; //!< online ATC stations
         BlackMisc::Aviation::CAtcStationList m_atcStationsBooked; //!< booked ATC stations
-        QHash<BlackMisc::Aviation::CCallsign, FsInnPacket>                      m_tempFsInnPackets; //!< unhandled FsInn packets
-        QHash<BlackMisc::Aviation::CCallsign, BlackMisc::Aviation::CFlightPlan> m_flightPlanCache;  //!< flight plan information retrieved from network and cached
-        QHash<BlackMisc::Aviation::CCallsign, Readiness>                        m_readiness;        //!< readiness
+        BlackMisc::Aviation::CPerCallsign<FsInnPacket>                      m_tempFsInnPackets; //!< unhandled FsInn packets
+        BlackMisc::Aviation::CPerCallsign<BlackMisc::Aviation::CFlightPlan> m_flightPlanCache;  //!< flight plan information retrieved from network and cached
+        BlackMisc::Aviation::CPerCallsign<Readiness>                        m_readiness;        //!< readiness
         BlackMisc::CSettingReadOnly<BlackMisc::Simulation::Settings::TModelMatching> m_matchingSettings { this }; //!< settings
         QQueue<BlackMisc::Aviation::CCallsign> m_queryAtis;  //!< query the ATIS
         QQueue<BlackMisc::Aviation::CCallsign> m_queryPilot; //!< query the pilot data
@@ -455,6 +455,7 @@ namespace BlackCore
         void onAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QJsonObject &jsonObject, qint64 currentOffsetMs);
         void onAircraftInterimUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
         void onAircraftVisualUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
+        void onAircraftPositionUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations);
         void onAircraftSimDataUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CAircraftParts &parts, qint64 currentOffsetMs, const QString &aircraftIcao, const QString &airlineIcao);
         void onConnectionStatusChanged(BlackMisc::Network::CConnectionStatus oldStatus, BlackMisc::Network::CConnectionStatus newStatus);
         void onRevBAircraftConfigReceived(const BlackMisc::Aviation::CCallsign &callsign, const QString &config, qint64 currentOffsetMs);
@@ -49,6 +49,7 @@ SOURCES += $$files($$PWD/afv/model/*.cpp)
 
 LIBS *= -lvatsimauth
 LIBS *= -lsodium
+win32: LIBS *= -lws2_32
 
 DESTDIR = $$DestRoot/lib
 DLLDESTDIR = $$DestRoot/bin
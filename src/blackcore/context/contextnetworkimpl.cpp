@@ -137,6 +137,12 @@ namespace BlackCore::Context
         return m_airspace->remoteAircraftSituations(callsign);
     }
 
+    CCompactAircraftSituationList CContextNetwork::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        if (!this->canUseAirspaceMonitor()) { return {}; }
+        return m_airspace->remoteAircraftSituationsCompact(callsign);
+    }
+
     CAircraftSituation CContextNetwork::remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const
     {
         if (!this->canUseAirspaceMonitor()) { return {}; }
@@ -736,6 +742,9 @@ namespace BlackCore::Context
 
             m_simulatorConnected++;
             m_lastConnectedSim = simInfo;
+
+            // the simulator has missed the snapshots emitted while it was not connected
+            if (m_airspace && m_airspace->analyzer()) { m_airspace->analyzer()->reEmitLatestSnapshot(); }
         }
         else
         {
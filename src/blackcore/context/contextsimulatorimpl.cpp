@@ -75,6 +75,7 @@ namespace BlackCore::Context
 
         connect(&m_weatherManager,  &CWeatherManager::weatherGridReceived, this, &CContextSimulator::onWeatherGridReceived, Qt::QueuedConnection);
         connect(&m_aircraftMatcher, &CAircraftMatcher::setupChanged,       this, &CContextSimulator::matchingSetupChanged);
+        m_aircraftMatcher.startMatchingWorkers();
         connect(&CCentralMultiSimulatorModelSetCachesProvider::modelCachesInstance(), &CCentralMultiSimulatorModelSetCachesProvider::cacheChanged, this, &CContextSimulator::modelSetChanged);
 
         // deferred init of last model set, if no other data are set in meantime
@@ -139,6 +140,7 @@ namespace BlackCore::Context
             m_validator->deleteLater();
             m_validator = nullptr;
         }
+        m_aircraftMatcher.stopMatchingWorkers();
         this->stopSimulatorListeners();
         this->disconnect();
         this->unloadSimulatorPlugin();
@@ -684,14 +686,59 @@ namespace BlackCore::Context
         BLACK_VERIFY_X(!callsign.isEmpty(), Q_FUNC_INFO, "Remote aircraft with empty callsign");
         if (callsign.isEmpty()) { return; }
 
+        // aircraft arriving together (e.g. after login) are matched together
+        m_pendingMatchings.replaceOrAddObjectByCallsign(remoteAircraft);
+        if (m_pendingMatchings.size() > 1) { return; } // already scheduled
+
+        QPointer<CContextSimulator> myself(this);
+        QTimer::singleShot(0, this, [ = ]
+        {
+            if (!myself) { return; }
+            myself->matchPendingAircraft();
+        });
+    }
+
+    void CContextSimulator::matchPendingAircraft()
+    {
+        const CSimulatedAircraftList pending = m_pendingMatchings;
+        m_pendingMatchings.clear();
+        if (pending.isEmpty() || !this->isSimulatorPluginAvailable()) { return; }
+
         // here we find the best simulator model for a resolved model
         // in the first step we already tried to find accurate ICAO codes etc.
         // coming from CAirspaceMonitor::sendReadyForModelMatching
-        MatchingLog whatToLog = m_logMatchingMessages;
-        CStatusMessageList matchingMessages;
+        const MatchingLog whatToLog = m_logMatchingMessages;
+        if (pending.size() == 1)
+        {
+            // no need for a thread
+            const CSimulatedAircraft &remoteAircraft = pending.front();
+            CStatusMessageList matchingMessages;
+            CStatusMessageList *pMatchingMessages = whatToLog > 0 ? &matchingMessages : nullptr;
+            const CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
+            this->applyMatchedModel(remoteAircraft, aircraftModel, matchingMessages);
+            return;
+        }
+
+        // independent matchings run concurrently, results are applied in callsign order
+        m_aircraftMatcher.getClosestMatchesConcurrently(pending, whatToLog, true, this, [ = ](const CAircraftMatcher::MatchingResults &results)
+        {
+            for (const CAircraftMatcher::MatchingResult &result : results)
+            {
+                this->applyMatchedModel(result.remoteAircraft, result.matchedModel, result.matchingMessages);
+            }
+        });
+    }
+
+    void CContextSimulator::applyMatchedModel(const CSimulatedAircraft &remoteAircraft, const CAircraftModel &matchedModel, const CStatusMessageList &messages)
+    {
+        // plugin could have been unloaded while matching
+        if (!this->isSimulatorPluginAvailable()) { return; }
+
+        const CCallsign callsign = remoteAircraft.getCallsign();
+        CAircraftModel aircraftModel(matchedModel);
+        CStatusMessageList matchingMessages(messages);
         CStatusMessageList *pMatchingMessages = m_logMatchingMessages > 0 ? &matchingMessages : nullptr;
-        CAircraftModel aircraftModel = m_aircraftMatcher.getClosestMatch(remoteAircraft, whatToLog, pMatchingMessages, true);
-        Q_ASSERT_X(remoteAircraft.getCallsign() == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
+        Q_ASSERT_X(callsign == aircraftModel.getCallsign(), Q_FUNC_INFO, "Mismatching callsigns");
 
         // decide CG
         const CLength cgModel = aircraftModel.getCG();
@@ -749,6 +796,7 @@ namespace BlackCore::Context
 
     void CContextSimulator::xCtxRemovedRemoteAircraft(const CCallsign &callsign)
     {
+        m_pendingMatchings.removeByCallsign(callsign);
         if (!this->isSimulatorAvailable()) { return; }
         m_simulatorPlugin.second->logicallyRemoveRemoteAircraft(callsign);
         m_failoverAddingCounts.remove(callsign);
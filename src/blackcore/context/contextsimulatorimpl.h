@@ -28,6 +28,7 @@
 #include "blackmisc/simulation/aircraftmodellist.h"
 #include "blackmisc/simulation/interpolationsetuplist.h"
 #include "blackmisc/simulation/remoteaircraftprovider.h"
+#include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/simulation/simulatorplugininfolist.h"
 #include "blackmisc/simulation/simulatorinternals.h"
 #include "blackmisc/aviation/airportlist.h"
@@ -275,12 +276,19 @@ namespace BlackCore
             //! Load the last know model set
             void initByLastUsedModelSet();
 
+            //! Match all aircraft waiting for model matching
+            void matchPendingAircraft();
+
+            //! Apply the matched model and add the aircraft to the simulator
+            void applyMatchedModel(const BlackMisc::Simulation::CSimulatedAircraft &remoteAircraft, const BlackMisc::Simulation::CAircraftModel &matchedModel, const BlackMisc::CStatusMessageList &messages);
+
             //! Init and set validator
             void setValidator(const BlackMisc::Simulation::CSimulatorInfo &simulator);
 
             QPair<BlackMisc::Simulation::CSimulatorPluginInfo, QPointer<ISimulator>> m_simulatorPlugin; //!< Currently loaded simulator plugin
             QMap<BlackMisc::Aviation::CCallsign, BlackMisc::CStatusMessageList> m_matchingMessages;     //!< all matching log messages per callsign
             QMap<BlackMisc::Aviation::CCallsign, int> m_failoverAddingCounts;
+            BlackMisc::Simulation::CSimulatedAircraftList m_pendingMatchings; //!< aircraft waiting for model matching
             CPluginManagerSimulator  *m_plugins = nullptr; //!< plugin manager
             BlackMisc::CRegularThread m_listenersThread;   //!< waiting for plugin
             CWeatherManager  m_weatherManager  { this };   //!< weather management
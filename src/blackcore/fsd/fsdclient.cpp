@@ -40,6 +40,7 @@
 #include "blackcore/fsd/planeinformationfsinn.h"
 #include "blackcore/fsd/revbclientparts.h"
 #include "blackcore/fsd/rehost.h"
+#include "blackcore/fsd/tokenview.h"
 
 #include "blackmisc/aviation/flightplan.h"
 #include "blackmisc/network/rawfsdmessage.h"
@@ -1233,7 +1234,11 @@ namespace BlackCore::Fsd
 
     void CFSDClient::handlePilotDataUpdate(const QStringList &tokens)
     {
-        const PilotDataUpdate dataUpdate = PilotDataUpdate::fromTokens(tokens);
+        this->handlePilotDataUpdate(PilotDataUpdate::fromTokens(tokens));
+    }
+
+    void CFSDClient::handlePilotDataUpdate(const PilotDataUpdate &dataUpdate)
+    {
         const CCallsign callsign(dataUpdate.sender(), CCallsign::Aircraft);
 
         CAircraftSituation situation(
@@ -1268,7 +1273,8 @@ namespace BlackCore::Fsd
             // I set a default: IFR standby is a reasonable default
             transponder = CTransponder(2000, CTransponder::StateStandby);
         }
-        emit pilotDataUpdateReceived(situation, transponder);
+        if (m_batchPositions) { this->batchPilotDataUpdate(situation, transponder); }
+        else { emit pilotDataUpdateReceived(situation, transponder); }
     }
 
     void CFSDClient::handleEuroscopeSimData(const QStringList &tokens)
@@ -1308,6 +1314,11 @@ namespace BlackCore::Fsd
             case MessageType::VisualPilotDataStopped:   dataUpdate = VisualPilotDataStopped::fromTokens(tokens).toUpdate();     break;
             default: qFatal("Precondition violated");   break;
         }
+        this->handleVisualPilotDataUpdate(dataUpdate);
+    }
+
+    void CFSDClient::handleVisualPilotDataUpdate(const VisualPilotDataUpdate &dataUpdate)
+    {
         const CCallsign callsign(dataUpdate.sender(), CCallsign::Aircraft);
 
         CAircraftSituation situation(
@@ -1327,7 +1338,8 @@ namespace BlackCore::Fsd
         const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
         situation.setTimeOffsetMs(offsetTimeMs);
 
-        emit visualPilotDataUpdateReceived(situation);
+        if (m_batchPositions) { this->batchPositionUpdate(situation); }
+        else { emit visualPilotDataUpdateReceived(situation); }
     }
 
     void CFSDClient::handleVisualPilotDataToggle(const QStringList& tokens)
@@ -1344,7 +1356,11 @@ namespace BlackCore::Fsd
 
     void CFSDClient::handlePong(const QStringList &tokens)
     {
-        const Pong pong = Pong::fromTokens(tokens);
+        this->handlePong(Pong::fromTokens(tokens));
+    }
+
+    void CFSDClient::handlePong(const Pong &pong)
+    {
         const qint64 msecSinceEpoch = QDateTime::currentMSecsSinceEpoch();
         const qint64 elapsedTime    = msecSinceEpoch - pong.m_timestamp.toLongLong();
         emit pongReceived(pong.sender(), elapsedTime);
@@ -1633,6 +1649,28 @@ namespace BlackCore::Fsd
         if (serverError.isFatalError()) { disconnectFromServer(); }
     }
 
+    void CFSDClient::handleInterimPilotDataUpdate(const InterimPilotDataUpdate &interimPilotDataUpdate)
+    {
+        const CCallsign callsign(interimPilotDataUpdate.sender(), CCallsign::Aircraft);
+
+        CAircraftSituation situation(
+            callsign,
+            CCoordinateGeodetic(interimPilotDataUpdate.m_latitude, interimPilotDataUpdate.m_longitude, interimPilotDataUpdate.m_altitudeTrue),
+            CHeading(interimPilotDataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
+            CAngle(interimPilotDataUpdate.m_pitch, CAngleUnit::deg()),
+            CAngle(interimPilotDataUpdate.m_bank, CAngleUnit::deg()),
+            CSpeed(interimPilotDataUpdate.m_groundSpeed, CSpeedUnit::kts()));
+        situation.setOnGround(interimPilotDataUpdate.m_onGround);
+
+        // Ref T297, default offset time
+        situation.setCurrentUtcTime();
+        const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
+        situation.setTimeOffsetMs(offsetTimeMs);
+
+        if (m_batchPositions) { this->batchPositionUpdate(situation); }
+        else { emit interimPilotDataUpdatedReceived(situation); }
+    }
+
     void CFSDClient::handleRevBClientPartsPacket(const QStringList &tokens)
     {
         CLogMessage(this).debug(u"handleRevBClientPartsPacket");
@@ -1714,25 +1752,7 @@ namespace BlackCore::Fsd
         {
             // swift's updated interim pilot update.
             if (!isInterimPositionReceivingEnabledForServer()) { return; }
-
-            const InterimPilotDataUpdate interimPilotDataUpdate = InterimPilotDataUpdate::fromTokens(tokens);
-            const CCallsign callsign(interimPilotDataUpdate.sender(), CCallsign::Aircraft);
-
-            CAircraftSituation situation(
-                callsign,
-                CCoordinateGeodetic(interimPilotDataUpdate.m_latitude, interimPilotDataUpdate.m_longitude, interimPilotDataUpdate.m_altitudeTrue),
-                CHeading(interimPilotDataUpdate.m_heading, CHeading::True, CAngleUnit::deg()),
-                CAngle(interimPilotDataUpdate.m_pitch, CAngleUnit::deg()),
-                CAngle(interimPilotDataUpdate.m_bank, CAngleUnit::deg()),
-                CSpeed(interimPilotDataUpdate.m_groundSpeed, CSpeedUnit::kts()));
-            situation.setOnGround(interimPilotDataUpdate.m_onGround);
-
-            // Ref T297, default offset time
-            situation.setCurrentUtcTime();
-            const qint64 offsetTimeMs = receivedPositionFixTsAndGetOffsetTime(situation.getCallsign(), situation.getMSecsSinceEpoch());
-            situation.setTimeOffsetMs(offsetTimeMs);
-
-            emit interimPilotDataUpdatedReceived(situation);
+            this->handleInterimPilotDataUpdate(InterimPilotDataUpdate::fromTokens(tokens));
         }
         else if (subType == "FSIPI")
         {
@@ -2176,6 +2196,8 @@ namespace BlackCore::Fsd
     {
         if (m_socket->bytesAvailable() < 1) { return; }
 
+        // positions are emitted once all available lines are read
+        m_batchPositions = true;
         int lines = 0;
 
         // reads at least one line if available
@@ -2183,8 +2205,11 @@ namespace BlackCore::Fsd
         {
             const QByteArray dataEncoded = m_socket->readLine();
             if (dataEncoded.isEmpty()) { continue; }
-            const QString data = m_fsdTextCodec->toUnicode(dataEncoded);
-            this->parseMessage(data);
+            if (!this->parseMessageFastPath(dataEncoded))
+            {
+                const QString data = m_fsdTextCodec->toUnicode(dataEncoded);
+                this->parseMessage(data);
+            }
             lines++;
 
             static constexpr int MaxLines = 75 - 1;
@@ -2204,8 +2229,64 @@ namespace BlackCore::Fsd
                 });
                 break;
             }
+        }
 
+        m_batchPositions = false;
+        this->emitBatchedPositions();
+    }
+
+    void CFSDClient::batchPilotDataUpdate(const CAircraftSituation &situation, const CTransponder &transponder)
+    {
+        m_batchedPositions.push_back({ situation, transponder, true });
+    }
+
+    void CFSDClient::batchPositionUpdate(const CAircraftSituation &situation)
+    {
+        m_batchedPositions.push_back({ situation, {}, false });
+    }
+
+    void CFSDClient::emitBatchedPositions()
+    {
+        if (m_batchedPositions.isEmpty()) { return; }
+
+        // newest first: keep the latest full update and the latest N visual/interim updates per callsign
+        const int maxPerCallsign = m_maxBatchedSituationsPerCallsign;
+        QHash<CCallsign, int> fullUpdates;
+        QHash<CCallsign, int> positionUpdates;
+        QVector<bool> keep(m_batchedPositions.size(), false);
+        for (int i = m_batchedPositions.size() - 1; i >= 0; --i)
+        {
+            const BatchedPosition &position = m_batchedPositions.at(i);
+            int &count = position.m_isFullUpdate ? fullUpdates[position.m_situation.getCallsign()] : positionUpdates[position.m_situation.getCallsign()];
+            const int max = position.m_isFullUpdate ? 1 : maxPerCallsign;
+            keep[i] = count < max;
+            count++;
+        }
+
+        // in order of reception: the visual/interim updates received before a full update are emitted before it
+        const QVector<BatchedPosition> positions = std::move(m_batchedPositions);
+        m_batchedPositions.clear();
+        CAircraftSituationList situations;
+        for (int i = 0; i < positions.size(); ++i)
+        {
+            if (!keep.at(i)) { continue; }
+            const BatchedPosition &position = positions.at(i);
+            if (position.m_isFullUpdate)
+            {
+                if (!situations.isEmpty())
+                {
+                    emit batchedPositionUpdatesReceived(situations);
+                    situations.clear();
+                }
+                emit pilotDataUpdateReceived(position.m_situation, position.m_transponder);
+            }
+            else
+            {
+                situations.push_back(position.m_situation);
+            }
         }
+
+        if (!situations.isEmpty()) { emit batchedPositionUpdatesReceived(situations); }
     }
 
     QString CFSDClient::socketErrorString(QAbstractSocket::SocketError error) const
@@ -2309,6 +2390,54 @@ namespace BlackCore::Fsd
         }
     }
 
+    bool CFSDClient::parseMessageFastPath(const QByteArray &lineRaw)
+    {
+        // PDUs and payload of those messages are plain ASCII, which all FSD text codecs map 1:1
+        const QLatin1String line = QLatin1String(lineRaw.constData(), lineRaw.size()).trimmed();
+
+        MessageType messageType = MessageType::Unknown;
+        int pduLength = 1;
+        if      (line.startsWith(QLatin1Char('@')))   { messageType = MessageType::PilotDataUpdate; }
+        else if (line.startsWith(QLatin1Char('^')))   { messageType = MessageType::VisualPilotDataUpdate; }
+        else if (line.startsWith(QLatin1String("#SB"))) { messageType = MessageType::PilotClientCom; pduLength = 3; }
+        else if (line.startsWith(QLatin1String("$PO"))) { messageType = MessageType::Pong; pduLength = 3; }
+        else { return false; }
+
+        const QLatin1String payload = line.mid(pduLength).trimmed();
+        const TokenView tokens(payload);
+
+        // only the interim positions are frequent, all other custom pilot packets use the normal path
+        if (messageType == MessageType::PilotClientCom && tokens.value(2) != QLatin1String("VI")) { return false; }
+
+        if (m_printToConsole || m_rawFsdMessagesEnabled || m_unitTestMode)
+        {
+            const QString lineDecoded = m_fsdTextCodec->toUnicode(lineRaw).trimmed();
+            if (m_printToConsole) { qDebug() << "FSD Recv=>" << lineDecoded; }
+            emitRawFsdMessage(lineDecoded, false);
+        }
+
+        // statistics
+        if (m_statistics)
+        {
+            increaseStatisticsValue(QStringLiteral("parseMessage"), this->messageTypeToString(messageType));
+        }
+
+        // We expected a payload, but there is nothing
+        if (payload.isEmpty()) { return true; }
+
+        switch (messageType)
+        {
+        case MessageType::PilotDataUpdate:       handlePilotDataUpdate(PilotDataUpdate::fromTokens(tokens)); break;
+        case MessageType::VisualPilotDataUpdate: handleVisualPilotDataUpdate(VisualPilotDataUpdate::fromTokens(tokens)); break;
+        case MessageType::Pong:                  handlePong(Pong::fromTokens(tokens)); break;
+        case MessageType::PilotClientCom:
+            if (isInterimPositionReceivingEnabledForServer()) { handleInterimPilotDataUpdate(InterimPilotDataUpdate::fromTokens(tokens)); }
+            break;
+        default: Q_UNREACHABLE(); break;
+        }
+        return true;
+    }
+
     void CFSDClient::emitRawFsdMessage(const QString &fsdMessage, bool isSent)
     {
         if (!m_unitTestMode && !m_rawFsdMessagesEnabled) { return; }
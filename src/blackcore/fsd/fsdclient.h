@@ -21,6 +21,7 @@
 #include "blackmisc/simulation/simulationenvironmentprovider.h"
 #include "blackmisc/aviation/atcstationlist.h"
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/aviation/flightplan.h"
 #include "blackmisc/aviation/informationmessage.h"
 #include "blackmisc/aviation/aircrafticaocode.h"
@@ -61,6 +62,11 @@
 namespace BlackFsdTest { class CTestFSDClient; }
 namespace BlackCore::Fsd
 {
+    class PilotDataUpdate;
+    class VisualPilotDataUpdate;
+    class InterimPilotDataUpdate;
+    class Pong;
+
     //! Message groups
     enum class TextMessageGroups
     {
@@ -202,6 +208,13 @@ namespace BlackCore::Fsd
         //! Debugging and UNIT tests
         void printToConsole(bool on)  { m_printToConsole = on; }
 
+        //! Max. visual/interim situations per callsign kept when several lines are read from the socket at once
+        //! \see batchedPositionUpdatesReceived
+        //! @{
+        int getMaxBatchedSituationsPerCallsign() const { return m_maxBatchedSituationsPerCallsign; }
+        void setMaxBatchedSituationsPerCallsign(int max) { m_maxBatchedSituationsPerCallsign = qMax(1, max); }
+        //! @}
+
         //! Gracefully shut down FSD client
         void gracefulShutdown();
 
@@ -226,6 +239,7 @@ namespace BlackCore::Fsd
         void customPilotPacketReceived(const QString &sender, const QStringList &data);
         void interimPilotDataUpdatedReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
         void visualPilotDataUpdateReceived(const BlackMisc::Aviation::CAircraftSituation &situation);
+        void batchedPositionUpdatesReceived(const BlackMisc::Aviation::CAircraftSituationList &situations);
         void euroscopeSimDataUpdatedReceived(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CAircraftParts &parts, qint64 currentOffsetTimeMs, const QString &model, const QString &livery);
         void rawFsdMessage(const BlackMisc::Network::CRawFsdMessage &rawFsdMessage);
         void planeInformationFsinnReceived(const BlackMisc::Aviation::CCallsign &callsign, const QString &airlineIcaoDesignator, const QString &aircraftDesignator, const QString &combinedAircraftType, const QString &modelString);
@@ -349,6 +363,18 @@ namespace BlackCore::Fsd
         void readDataFromSocketMaxLines(int maxLines = -1);
         void parseMessage(const QString &lineRaw);
 
+        //! Positions are batched while reading the socket and emitted afterwards
+        //! @{
+        void batchPilotDataUpdate(const BlackMisc::Aviation::CAircraftSituation &situation, const BlackMisc::Aviation::CTransponder &transponder);
+        void batchPositionUpdate(const BlackMisc::Aviation::CAircraftSituation &situation);
+        void emitBatchedPositions();
+        //! @}
+
+        //! Parse the high frequency messages (positions, pong) directly from the socket data,
+        //! without QString decoding and token lists
+        //! \return true if the line was handled, false if it needs to go through parseMessage
+        bool parseMessageFastPath(const QByteArray &lineRaw);
+
         QString socketErrorString(QAbstractSocket::SocketError error) const;
         static QString socketErrorToQString(QAbstractSocket::SocketError error);
 
@@ -367,11 +393,15 @@ namespace BlackCore::Fsd
         void handleDeletePilot(const QStringList &tokens);
         void handleTextMessage(const QStringList &tokens);
         void handlePilotDataUpdate(const QStringList &tokens);
+        void handlePilotDataUpdate(const PilotDataUpdate &dataUpdate);
         void handleVisualPilotDataUpdate(const QStringList &tokens, MessageType messageType);
+        void handleVisualPilotDataUpdate(const VisualPilotDataUpdate &dataUpdate);
+        void handleInterimPilotDataUpdate(const InterimPilotDataUpdate &interimPilotDataUpdate);
         void handleVisualPilotDataToggle(const QStringList &tokens);
         void handleEuroscopeSimData(const QStringList &tokens);
         void handlePing(const QStringList &tokens);
         void handlePong(const QStringList &tokens);
+        void handlePong(const Pong &pong);
         void handleKillRequest(const QStringList &tokens);
         void handleFlightPlan(const QStringList &tokens);
         void handleClientQuery(const QStringList &tokens);
@@ -482,6 +512,18 @@ namespace BlackCore::Fsd
         std::atomic_bool m_unitTestMode   { false };
         std::atomic_bool m_printToConsole { false };
 
+        //! Position received while reading the socket
+        struct BatchedPosition
+        {
+            BlackMisc::Aviation::CAircraftSituation m_situation;
+            BlackMisc::Aviation::CTransponder m_transponder;
+            bool m_isFullUpdate = false; //!< full pilot data update with transponder
+        };
+
+        bool m_batchPositions = false;                  //!< batch positions instead of emitting them one by one
+        QVector<BatchedPosition> m_batchedPositions;    //!< in order of reception
+        std::atomic_int m_maxBatchedSituationsPerCallsign { 2 };
+
         BlackMisc::Network::CConnectionStatus m_connectionStatus;
         mutable QReadWriteLock m_lockConnectionStatus { QReadWriteLock::Recursive };
 
@@ -509,10 +551,10 @@ namespace BlackCore::Fsd
             QStringList m_atisMessage;
         };
 
-        QHash<BlackMisc::Aviation::CCallsign, PendingAtisQuery> m_pendingAtisQueries;
-        QHash<BlackMisc::Aviation::CCallsign, qint64> m_lastPositionUpdate;
-        QHash<BlackMisc::Aviation::CCallsign, QList<qint64>> m_lastOffsetTimes; //!< latest offset first
-        QHash<BlackMisc::Aviation::CCallsign, qint64> m_interpolatedOffsetTime;
+        BlackMisc::Aviation::CPerCallsign<PendingAtisQuery> m_pendingAtisQueries;
+        BlackMisc::Aviation::CTimestampPerCallsign m_lastPositionUpdate;
+        BlackMisc::Aviation::CPerCallsign<QList<qint64>> m_lastOffsetTimes; //!< latest offset first
+        BlackMisc::Aviation::CTimestampPerCallsign m_interpolatedOffsetTime;
         static const int c_offsetTimeInterpolationInverseRate = 4;
 
         BlackMisc::Aviation::CAtcStationList m_atcStations;
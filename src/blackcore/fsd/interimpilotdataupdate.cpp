@@ -67,4 +67,22 @@ namespace BlackCore::Fsd
         return InterimPilotDataUpdate(tokens[0], tokens[1], tokens[3].toDouble(), tokens[4].toDouble(), tokens[5].toInt(), tokens[6].toInt(),
                 pitch, bank, heading, onGround);
     }
+
+    InterimPilotDataUpdate InterimPilotDataUpdate::fromTokens(const TokenView &tokens)
+    {
+        if (tokens.size() < 8)
+        {
+            BlackMisc::CLogMessage(static_cast<InterimPilotDataUpdate *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+
+        double pitch = 0.0;
+        double bank = 0.0;
+        double heading = 0.0;
+        bool onGround = false;
+        unpackPBH(tokens.toUInt(7), pitch, bank, heading, onGround);
+
+        return InterimPilotDataUpdate(tokens.toQString(0), tokens.toQString(1), tokens.toDouble(3), tokens.toDouble(4), tokens.toInt(5), tokens.toInt(6),
+                pitch, bank, heading, onGround);
+    }
 }
@@ -12,6 +12,7 @@
 #define BLACKCORE_FSD_INTERIMPILOTDATAUPDATE_H
 
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/tokenview.h"
 
 namespace BlackCore::Fsd
 {
@@ -30,6 +31,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static InterimPilotDataUpdate fromTokens(const QStringList &tokens);
 
+        //! Construct from tokens, allocation free parsing
+        static InterimPilotDataUpdate fromTokens(const TokenView &tokens);
+
         //! PDU identifier
         static QString pdu() { return "#SB"; }
 
@@ -12,6 +12,7 @@
 #define BLACKCORE_FSD_PILOTDATAUPDATE_H
 
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/tokenview.h"
 #include "blackcore/fsd/enums.h"
 #include "blackmisc/aviation/transponder.h"
 
@@ -32,6 +33,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static PilotDataUpdate fromTokens(const QStringList &tokens);
 
+        //! Construct from tokens, allocation free parsing
+        static PilotDataUpdate fromTokens(const TokenView &tokens);
+
         //! PDU identifier
         static QString pdu() { return "@"; }
 
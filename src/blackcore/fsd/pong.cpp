@@ -38,4 +38,14 @@ namespace BlackCore::Fsd
         };
         return Pong(tokens[0], tokens[1], tokens[2]);
     }
+
+    Pong Pong::fromTokens(const TokenView &tokens)
+    {
+        if (tokens.size() < 3)
+        {
+            BlackMisc::CLogMessage(static_cast<Pong *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+        return Pong(tokens.toQString(0), tokens.toQString(1), tokens.toQString(2));
+    }
 }
@@ -12,6 +12,7 @@
 #define BLACKCORE_FSD_PONG_H
 
 #include "blackcore/fsd/messagebase.h"
+#include "blackcore/fsd/tokenview.h"
 
 namespace BlackCore::Fsd
 {
@@ -28,6 +29,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static Pong fromTokens(const QStringList &tokens);
 
+        //! Construct from tokens, allocation free parsing
+        static Pong fromTokens(const TokenView &tokens);
+
         //! PDU identifier
         static QString pdu() { return "$PO"; }
 
@@ -139,6 +139,27 @@ namespace BlackCore::Fsd
         return PilotRating::Unknown;
     }
 
+    template<>
+    PilotRating fromLatin1(QLatin1String str)
+    {
+        if (str.size() == 1)
+        {
+            switch (str.at(0).toLatin1())
+            {
+            case '0': return PilotRating::Unknown;
+            case '1': return PilotRating::Student;
+            case '2': return PilotRating::VFR;
+            case '3': return PilotRating::IFR;
+            case '4': return PilotRating::Instructor;
+            case '5': return PilotRating::Supervisor;
+            default:  break;
+            }
+        }
+
+        // empty or unknown, logged in the QString version
+        return fromQString<PilotRating>(QString(str));
+    }
+
     template<>
     QString toQString(const SimType &value)
     {
@@ -396,6 +417,19 @@ namespace BlackCore::Fsd
         return CTransponder::StateStandby;
     }
 
+    template<>
+    CTransponder::TransponderMode fromLatin1(QLatin1String str)
+    {
+        if (str.size() != 1) return CTransponder::StateStandby;
+        switch (str.at(0).toLatin1())
+        {
+        case 'N': return CTransponder::ModeC;
+        case 'Y': return CTransponder::StateIdent;
+        default:  break;
+        }
+        return CTransponder::StateStandby;
+    }
+
     template<>
     QString toQString(const Capabilities &value)
     {
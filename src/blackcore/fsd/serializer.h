@@ -17,6 +17,7 @@
 
 #include <QtGlobal>
 #include <QString>
+#include <QLatin1String>
 
 namespace BlackCore::Fsd
 {
@@ -77,6 +78,15 @@ namespace BlackCore::Fsd
 
     template<>
     AtisLineType fromQString(const QString &str);
+
+    template<typename T>
+    T fromLatin1(QLatin1String str);
+
+    template<>
+    PilotRating fromLatin1(QLatin1String str);
+
+    template<>
+    BlackMisc::Aviation::CTransponder::TransponderMode fromLatin1(QLatin1String str);
     //! \endcond
 }
 
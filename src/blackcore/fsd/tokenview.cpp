@@ -0,0 +1,118 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/fsd/tokenview.h"
+
+#include <QByteArray>
+#include <limits>
+
+namespace BlackCore::Fsd
+{
+    namespace Private
+    {
+        //! Slow path, same rules as QString
+        QByteArray rawBytes(QLatin1String token)
+        {
+            return QByteArray::fromRawData(token.data(), token.size());
+        }
+
+        //! Parse optional sign and decimal digits, false if anything else is found
+        bool parseInteger(QLatin1String token, qint64 &value)
+        {
+            const char *p = token.data();
+            const char *end = p + token.size();
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+')) { negative = (*p == '-'); ++p; }
+            if (p == end || end - p > 18) { return false; } // 18 digits never overflow qint64
+
+            qint64 v = 0;
+            for (; p < end; ++p)
+            {
+                if (*p < '0' || *p > '9') { return false; }
+                v = v * 10 + (*p - '0');
+            }
+            value = negative ? -v : v;
+            return true;
+        }
+    }
+
+    TokenView::TokenView(QLatin1String payload)
+    {
+        const char *p = payload.data();
+        const char *end = p + payload.size();
+        const char *tokenBegin = p;
+        for (;; ++p)
+        {
+            if (p != end && *p != ':') { continue; }
+            if (m_size >= MaxTokens) { m_truncated = true; break; }
+            m_tokens[m_size++] = QLatin1String(tokenBegin, static_cast<int>(p - tokenBegin));
+            if (p == end) { break; }
+            tokenBegin = p + 1;
+        }
+    }
+
+    int TokenView::toInt(QLatin1String token, bool *ok)
+    {
+        qint64 v = 0;
+        if (!Private::parseInteger(token, v)) { return Private::rawBytes(token).toInt(ok); }
+        const bool valid = v >= std::numeric_limits<int>::min() && v <= std::numeric_limits<int>::max();
+        if (ok) { *ok = valid; }
+        return valid ? static_cast<int>(v) : 0;
+    }
+
+    uint TokenView::toUInt(QLatin1String token, bool *ok)
+    {
+        qint64 v = 0;
+        if (!Private::parseInteger(token, v)) { return Private::rawBytes(token).toUInt(ok); }
+        const bool valid = v >= 0 && v <= std::numeric_limits<uint>::max();
+        if (ok) { *ok = valid; }
+        return valid ? static_cast<uint>(v) : 0;
+    }
+
+    double TokenView::toDouble(QLatin1String token, bool *ok)
+    {
+        // exact powers of 10 in double
+        static constexpr double Pow10[] =
+        {
+            1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        static constexpr quint64 MaxExactMantissa = Q_UINT64_C(1) << 53;
+
+        const char *p = token.data();
+        const char *end = p + token.size();
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) { negative = (*p == '-'); ++p; }
+
+        quint64 mantissa = 0;
+        int digits = 0;
+        int fractionDigits = 0;
+        bool dot = false;
+        for (; p < end; ++p)
+        {
+            const char c = *p;
+            if (c >= '0' && c <= '9')
+            {
+                if (++digits > 18) { return Private::rawBytes(token).toDouble(ok); }
+                mantissa = mantissa * 10 + static_cast<quint64>(c - '0');
+                if (dot) { fractionDigits++; }
+            }
+            else if (c == '.' && !dot) { dot = true; }
+            else { return Private::rawBytes(token).toDouble(ok); } // exponent, whitespace, garbage
+        }
+
+        if (digits < 1) { if (ok) { *ok = false; } return 0.0; }
+
+        // both values are exact, so the division is correctly rounded
+        // and yields the same value as a full string to double conversion
+        if (mantissa > MaxExactMantissa) { return Private::rawBytes(token).toDouble(ok); }
+        const double v = static_cast<double>(mantissa) / Pow10[fractionDigits];
+        if (ok) { *ok = true; }
+        return negative ? -v : v;
+    }
+} // ns
@@ -0,0 +1,80 @@
+/* Copyright (C) 2019
+ * swift project community / contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_FSD_TOKENVIEW_H
+#define BLACKCORE_FSD_TOKENVIEW_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QLatin1String>
+#include <QString>
+#include <array>
+
+namespace BlackCore::Fsd
+{
+    //! Allocation free view of the ':' separated tokens of a FSD payload.
+    //! Used for the high frequency messages (positions, pongs), which would otherwise
+    //! go through QString decoding and a QStringList per line.
+    //! \remark the viewed data (normally the line read from the socket) must outlive the view
+    class BLACKCORE_EXPORT TokenView
+    {
+    public:
+        //! Max. number of tokens, more tokens are ignored
+        static constexpr int MaxTokens = 32;
+
+        //! Default constructor
+        TokenView() = default;
+
+        //! Split payload into tokens
+        explicit TokenView(QLatin1String payload);
+
+        //! Number of tokens
+        int size() const { return m_size; }
+
+        //! No tokens?
+        bool isEmpty() const { return m_size < 1; }
+
+        //! More than MaxTokens tokens and the rest has been ignored?
+        bool isTruncated() const { return m_truncated; }
+
+        //! Token at index
+        //! \remark index has to be valid
+        QLatin1String at(int index) const { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "index out of range"); return m_tokens[index]; }
+
+        //! Token at index, empty if out of range
+        QLatin1String value(int index) const { return (index >= 0 && index < m_size) ? m_tokens[index] : QLatin1String(); }
+
+        //! Token as QString
+        //! \remark this allocates, only use it for values really needed as string, e.g. callsigns
+        QString toQString(int index) const { return QString(this->value(index)); }
+
+        //! Token converted to number, same results as the QString counterparts
+        //! @{
+        int toInt(int index, bool *ok = nullptr) const { return TokenView::toInt(this->value(index), ok); }
+        uint toUInt(int index, bool *ok = nullptr) const { return TokenView::toUInt(this->value(index), ok); }
+        double toDouble(int index, bool *ok = nullptr) const { return TokenView::toDouble(this->value(index), ok); }
+        //! @}
+
+        //! Number conversions without allocation for the common FSD formats, 0 and ok=false if not a valid number
+        //! \remark uncommon formats (exponents, whitespace, many digits) use the QByteArray based conversion
+        //! @{
+        static int toInt(QLatin1String token, bool *ok = nullptr);
+        static uint toUInt(QLatin1String token, bool *ok = nullptr);
+        static double toDouble(QLatin1String token, bool *ok = nullptr);
+        //! @}
+
+    private:
+        std::array<QLatin1String, MaxTokens> m_tokens;
+        int  m_size = 0;
+        bool m_truncated = false;
+    };
+} // ns
+
+#endif // guard
@@ -83,6 +83,25 @@ namespace BlackCore::Fsd
                 tokens[11].toDouble(), tokens[10].toDouble(), tokens.value(12, QStringLiteral("0")).toDouble());
     }
 
+    VisualPilotDataUpdate VisualPilotDataUpdate::fromTokens(const TokenView &tokens)
+    {
+        if (tokens.size() < 12)
+        {
+            CLogMessage(static_cast<VisualPilotDataUpdate *>(nullptr)).debug(u"Wrong number of arguments.");
+            return {};
+        }
+
+        double pitch = 0.0;
+        double bank  = 0.0;
+        double heading = 0.0;
+        bool unused = false; //! \todo check if needed?
+        unpackPBH(tokens.toUInt(5), pitch, bank, heading, unused);
+
+        return VisualPilotDataUpdate(tokens.toQString(0), tokens.toDouble(1), tokens.toDouble(2), tokens.toDouble(3), tokens.toDouble(4),
+                pitch, bank, heading, tokens.toDouble(6), tokens.toDouble(7), tokens.toDouble(8), tokens.toDouble(9),
+                tokens.toDouble(11), tokens.toDouble(10), tokens.size() > 12 ? tokens.toDouble(12) : 0.0);
+    }
+
     VisualPilotDataPeriodic VisualPilotDataUpdate::toPeriodic() const
     {
         return VisualPilotDataPeriodic(m_sender, m_latitude, m_longitude, m_altitudeTrue, m_heightAgl, m_pitch, m_bank, m_heading,
@@ -12,6 +12,7 @@
 #define BLACKCORE_FSD_VISUALPILOTDATAUPDATE_H
 
 #include "messagebase.h"
+#include "tokenview.h"
 #include "enums.h"
 
 namespace BlackCore::Fsd
@@ -34,6 +35,9 @@ namespace BlackCore::Fsd
         //! Construct from tokens
         static VisualPilotDataUpdate fromTokens(const QStringList &tokens);
 
+        //! Construct from tokens, allocation free parsing
+        static VisualPilotDataUpdate fromTokens(const TokenView &tokens);
+
         //! PDU identifier
         static QString pdu() { return "^"; }
 
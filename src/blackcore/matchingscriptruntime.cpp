@@ -0,0 +1,159 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/matchingscriptruntime.h"
+#include "blackmisc/fileutils.h"
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QThreadStorage>
+#include <atomic>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Simulation;
+
+namespace BlackCore
+{
+    namespace
+    {
+        std::atomic<qint64> g_runs { 0 };
+        std::atomic<qint64> g_loads { 0 };
+        std::atomic<qint64> g_totalNs { 0 };
+        std::atomic<qint64> g_maxNs { 0 };
+        thread_local CMatchingScriptRuntime::Statistics t_statistics;
+
+        QThreadStorage<CMatchingScriptRuntime *> &runtimesForScript(MatchingScript script)
+        {
+            static QThreadStorage<CMatchingScriptRuntime *> reverseLookupRuntimes;
+            static QThreadStorage<CMatchingScriptRuntime *> matchingStageRuntimes;
+            return (script == ReverseLookup) ? reverseLookupRuntimes : matchingStageRuntimes;
+        }
+    }
+
+    CMatchingScriptRuntime::CMatchingScriptRuntime()
+    {
+        this->bindObject("inObject", &m_inObject);             // object as from network
+        this->bindObject("outObject", &m_outObject);           // object that will be returned
+        this->bindObject("matchedObject", &m_matchedObject);   // object as matched so far, same as inObject in reverse lookup
+        this->bindObject("modelSet", &m_modelSetObject);       // wrapper for model set
+        this->bindObject("webServices", &m_webServices);       // wrapper for web services
+    }
+
+    CMatchingScriptRuntime &CMatchingScriptRuntime::forCurrentThread(MatchingScript script)
+    {
+        QThreadStorage<CMatchingScriptRuntime *> &runtimes = runtimesForScript(script);
+        if (!runtimes.hasLocalData() || !runtimes.localData()) { runtimes.setLocalData(new CMatchingScriptRuntime()); }
+        return *runtimes.localData();
+    }
+
+    void CMatchingScriptRuntime::releaseForCurrentThread()
+    {
+        // setting the local data deletes the previous runtime
+        for (MatchingScript script : { ReverseLookup, MatchingStage })
+        {
+            QThreadStorage<CMatchingScriptRuntime *> &runtimes = runtimesForScript(script);
+            if (runtimes.hasLocalData()) { runtimes.setLocalData(nullptr); }
+        }
+    }
+
+    bool CMatchingScriptRuntime::load(const QString &fileName)
+    {
+        const QFileInfo fi(fileName);
+        const qint64 size = fi.exists() ? fi.size() : -1;
+        const QDateTime modified = fi.exists() ? fi.lastModified() : QDateTime();
+        if (fileName == m_fileName && size == m_fileSize && modified == m_fileModified) { return this->isLoaded(); }
+
+        m_fileName = fileName;
+        m_fileSize = size;
+        m_fileModified = modified;
+        m_function = QJSValue();
+        m_errorString.clear();
+        g_loads++;
+        t_statistics.loads++;
+
+        const QString js = CFileUtils::readFileToString(fileName);
+        if (js.isEmpty())
+        {
+            m_errorString = QStringLiteral("Matching script is empty");
+            return false;
+        }
+
+        const QJSValue function = m_engine.evaluate(js, fileName);
+        if (function.isError())
+        {
+            m_errorString = QStringLiteral("Matching script error: %1 '%2'").arg(function.property("lineNumber").toInt()).arg(function.toString());
+            return false;
+        }
+        if (!function.isCallable())
+        {
+            m_errorString = QStringLiteral("Matching script does not evaluate to a function: '%1'").arg(fileName);
+            return false;
+        }
+        m_function = function;
+        return true;
+    }
+
+    QJSValue CMatchingScriptRuntime::run(const CAircraftModel &inModel, const CAircraftModel &matchedModel, const CAircraftModelList &modelSet)
+    {
+        if (!this->isLoaded()) { return QJSValue(); }
+
+        // init models and set
+        m_inObject.initByModel(inModel);
+        m_matchedObject.initByModel(matchedModel); // same as inModel for reverse lookup
+        m_matchedObject.evaluateChanges(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
+        m_outObject.initByModel(matchedModel);     // set default values for out object
+        m_modelSetObject.setSimulator({});
+        m_modelSetObject.initByModelSet(modelSet); // as passed
+        m_modelSetObject.initByAircraftAndAirline(inModel.getAircraftIcaoCode(), inModel.getAirlineIcaoCode());
+
+        QElapsedTimer time;
+        time.start();
+        const QJSValue result = m_function.call();
+        const qint64 ns = time.nsecsElapsed();
+
+        g_runs++;
+        g_totalNs += ns;
+        qint64 maxNs = g_maxNs.load();
+        while (ns > maxNs && !g_maxNs.compare_exchange_weak(maxNs, ns)) {}
+
+        t_statistics.runs++;
+        t_statistics.totalNs += ns;
+        t_statistics.maxNs = qMax(t_statistics.maxNs, ns);
+        return result;
+    }
+
+    CMatchingScriptRuntime::Statistics CMatchingScriptRuntime::getStatistics()
+    {
+        Statistics statistics;
+        statistics.runs = g_runs;
+        statistics.loads = g_loads;
+        statistics.totalNs = g_totalNs;
+        statistics.maxNs = g_maxNs;
+        return statistics;
+    }
+
+    CMatchingScriptRuntime::Statistics CMatchingScriptRuntime::getThreadStatistics()
+    {
+        return t_statistics;
+    }
+
+    void CMatchingScriptRuntime::resetStatistics()
+    {
+        g_runs = 0;
+        g_loads = 0;
+        g_totalNs = 0;
+        g_maxNs = 0;
+    }
+
+    void CMatchingScriptRuntime::bindObject(const QString &name, QObject *object)
+    {
+        // the objects live as long as the runtime, the engine must not garbage collect them
+        QJSEngine::setObjectOwnership(object, QJSEngine::CppOwnership);
+        m_engine.globalObject().setProperty(name, m_engine.newQObject(object));
+    }
+} // namespace
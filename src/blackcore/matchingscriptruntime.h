@@ -0,0 +1,105 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_MATCHINGSCRIPTRUNTIME_H
+#define BLACKCORE_MATCHINGSCRIPTRUNTIME_H
+
+#include "blackcore/blackcoreexport.h"
+#include "blackcore/matchingscriptstatistics.h"
+#include "blackcore/webdataservicesms.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/matchingscript.h"
+#include "blackmisc/simulation/matchingscriptmisc.h"
+
+#include <QDateTime>
+#include <QJSEngine>
+#include <QJSValue>
+#include <QString>
+#include <QtGlobal>
+
+namespace BlackCore
+{
+    /*!
+     * Long living runtime of a matching script, one per thread and script.
+     *
+     * The script file is evaluated once to the script function, and only evaluated again if the file changes.
+     * The objects bound to the script ("inObject", "outObject", "matchedObject", "modelSet", "webServices")
+     * are created once and initialized for every run.
+     * \remark a QJSEngine can only be used in the thread it was created in, so use CMatchingScriptRuntime::forCurrentThread
+     * \remark the concurrent matchings of CAircraftMatcher run in its matching workers, so their runtimes are reused
+     * \remark global variables of the script now keep their values between runs
+     */
+    class BLACKCORE_EXPORT CMatchingScriptRuntime
+    {
+    public:
+        //! Statistics of the runs of runtimes
+        using Statistics = MatchingScriptStatistics;
+
+        //! Constructor
+        CMatchingScriptRuntime();
+
+        //! Not copyable
+        //! @{
+        CMatchingScriptRuntime(const CMatchingScriptRuntime &) = delete;
+        CMatchingScriptRuntime &operator =(const CMatchingScriptRuntime &) = delete;
+        //! @}
+
+        //! Runtime of the current thread for the script, deleted when the thread finishes
+        static CMatchingScriptRuntime &forCurrentThread(BlackMisc::Simulation::MatchingScript script);
+
+        //! Delete the runtimes of the current thread, e.g. if no script is configured anymore
+        static void releaseForCurrentThread();
+
+        //! Load the script file, only evaluated again if the file name, size or modification time changed
+        //! \return false if there is no script function, see getErrorString
+        bool load(const QString &fileName);
+
+        //! Script function available?
+        bool isLoaded() const { return m_function.isCallable(); }
+
+        //! Why loading failed
+        const QString &getErrorString() const { return m_errorString; }
+
+        //! Run the loaded script function
+        //! \remark objects returned by the script are only valid until the next run
+        QJSValue run(const BlackMisc::Simulation::CAircraftModel &inModel, const BlackMisc::Simulation::CAircraftModel &matchedModel,
+                     const BlackMisc::Simulation::CAircraftModelList &modelSet);
+
+        //! Statistics of all runtimes
+        //! \threadsafe
+        static Statistics getStatistics();
+
+        //! Statistics of the runtimes of the current thread
+        static Statistics getThreadStatistics();
+
+        //! Reset the statistics
+        //! \threadsafe
+        static void resetStatistics();
+
+    private:
+        //! Bind an object to the script as global
+        void bindObject(const QString &name, QObject *object);
+
+        QJSEngine m_engine;
+        QJSValue  m_function;       //!< script evaluated to a function
+        QString   m_fileName;       //!< file of m_function
+        QDateTime m_fileModified;   //!< modification time of m_fileName when loaded
+        qint64    m_fileSize = -1;  //!< size of m_fileName when loaded
+        QString   m_errorString;
+        BlackMisc::Simulation::MSInOutValues m_inObject;      //!< values as from network
+        BlackMisc::Simulation::MSInOutValues m_matchedObject; //!< values as matched so far
+        BlackMisc::Simulation::MSInOutValues m_outObject;     //!< values returned
+        BlackMisc::Simulation::MSModelSet    m_modelSetObject; //!< wrapper for model set
+        MSWebServices m_webServices;                          //!< wrapper for web services
+    };
+} // namespace
+
+#endif // guard
@@ -0,0 +1,29 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackcore/matchingscriptstatistics.h"
+
+namespace BlackCore
+{
+    void MatchingScriptStatistics::addMatching(const MatchingScriptStatistics &before, const MatchingScriptStatistics &after)
+    {
+        const qint64 ns = after.totalNs - before.totalNs;
+        matchings++;
+        runs    += after.runs - before.runs;
+        loads   += after.loads - before.loads;
+        totalNs += ns;
+        maxNs    = qMax(maxNs, ns);
+    }
+
+    QString MatchingScriptStatistics::toQString() const
+    {
+        QString s = QStringLiteral("runs: %1 loads: %2 avg: %3ms max: %4ms").arg(runs).arg(loads).arg(this->averageMs(), 0, 'f', 3).arg(maxNs / 1.0e6, 0, 'f', 3);
+        if (matchings > 0) { s += QStringLiteral(" matchings: %1 avg/matching: %2ms").arg(matchings).arg(this->averageMsPerMatching(), 0, 'f', 3); }
+        return s;
+    }
+} // namespace
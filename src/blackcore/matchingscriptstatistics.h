@@ -0,0 +1,44 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKCORE_MATCHINGSCRIPTSTATISTICS_H
+#define BLACKCORE_MATCHINGSCRIPTSTATISTICS_H
+
+#include "blackcore/blackcoreexport.h"
+
+#include <QString>
+#include <QtGlobal>
+
+namespace BlackCore
+{
+    //! Cost of the matching script runs
+    struct BLACKCORE_EXPORT MatchingScriptStatistics
+    {
+        qint64 matchings = 0; //!< matchings, only counted by CAircraftMatcher
+        qint64 runs      = 0; //!< script calls
+        qint64 loads     = 0; //!< script evaluations (file loaded or changed)
+        qint64 totalNs   = 0; //!< time of all script calls
+        qint64 maxNs     = 0; //!< time of the slowest script call, for CAircraftMatcher the script time of the slowest matching
+
+        //! Average time of a call in ms
+        double averageMs() const { return runs > 0 ? static_cast<double>(totalNs) / runs / 1.0e6 : 0.0; }
+
+        //! Average script time of a matching in ms
+        double averageMsPerMatching() const { return matchings > 0 ? static_cast<double>(totalNs) / matchings / 1.0e6 : 0.0; }
+
+        //! Add the script runs of one matching, the difference of the statistics before and after the matching
+        void addMatching(const MatchingScriptStatistics &before, const MatchingScriptStatistics &after);
+
+        //! As string
+        QString toQString() const;
+    };
+} // namespace
+
+#endif // guard
@@ -27,6 +27,7 @@
 #include "blackmisc/simulation/autopublishdata.h"
 #include "blackmisc/aviation/airportlist.h"
 #include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/network/clientprovider.h"
 #include "blackmisc/weather/weathergridprovider.h"
 #include "blackmisc/geo/elevationplane.h"
@@ -613,8 +614,8 @@ namespace BlackCore
         BlackMisc::Simulation::CSimulatorInternals  m_simulatorInternals;  //!< setup read from the sim
         BlackMisc::Simulation::CInterpolationLogger m_interpolationLogger; //!< log.interpolation
         BlackMisc::Simulation::CAutoPublishData     m_autoPublishing;      //!< for the DB
-        BlackMisc::Aviation::CAircraftSituationPerCallsign m_lastSentSituations; //!< last situations sent to simulator
-        BlackMisc::Aviation::CAircraftPartsPerCallsign     m_lastSentParts;      //!< last parts sent to simulator
+        BlackMisc::Aviation::CPerCallsign<BlackMisc::Aviation::CAircraftSituation> m_lastSentSituations; //!< last situations sent to simulator
+        BlackMisc::Aviation::CPerCallsign<BlackMisc::Aviation::CAircraftParts>     m_lastSentParts;      //!< last parts sent to simulator
 
         // some optional functionality which can be used by the simulators as needed
         BlackMisc::Simulation::CSimulatedAircraftList m_addAgainAircraftWhenRemoved; //!< add this model again when removed, normally used to change model
@@ -74,4 +74,37 @@ namespace BlackGui::Models
         }
         return outContainer;
     }
+
+    bool CAircraftIcaoFilter::isNarrowing(const IModelFilter<CAircraftIcaoCodeList> &previous) const
+    {
+        const auto *p = dynamic_cast<const CAircraftIcaoFilter *>(&previous);
+        if (!p || !this->isValid() || !p->isValid()) { return false; }
+        if (m_id != p->m_id || m_combinedType != p->m_combinedType) { return false; }
+        return CFilterStringIndex::isNarrowingExpression(m_designator, p->m_designator) &&
+               CFilterStringIndex::isNarrowingExpression(m_family, p->m_family) &&
+               CFilterStringIndex::isNarrowingExpression(m_manufacturer, p->m_manufacturer) &&
+               CFilterStringIndex::isNarrowingExpression(m_description, p->m_description);
+    }
+
+    bool CAircraftIcaoFilter::candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const
+    {
+        if (!this->isValid() || m_id >= 0) { return false; }
+        return index.candidateRows(
+        {
+            { IndexDesignator, m_designator }, { IndexFamily, m_family },
+            { IndexManufacturer, m_manufacturer }, { IndexDescription, m_description }
+        }, rows);
+    }
+
+    void CAircraftIcaoFilter::indexStrings(CFilterStringIndex &index, int row, const CAircraftIcaoCode &icao) const
+    {
+        index.addValue(row, IndexDesignator, icao.getDesignator());
+        index.addValue(row, IndexFamily, icao.getFamily());
+        index.addValue(row, IndexManufacturer, icao.getManufacturer());
+
+        // description matches any of them
+        index.addValue(row, IndexDescription, icao.getModelDescription());
+        index.addValue(row, IndexDescription, icao.getModelSwiftDescription());
+        index.addValue(row, IndexDescription, icao.getModelIataDescription());
+    }
 } // namespace
@@ -35,7 +35,29 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Aviation::CAircraftIcaoCodeList filter(const BlackMisc::Aviation::CAircraftIcaoCodeList &inContainer) const override;
 
+        //! \copydoc IModelFilter::isNarrowing
+        virtual bool isNarrowing(const IModelFilter<BlackMisc::Aviation::CAircraftIcaoCodeList> &previous) const override;
+
+        //! \copydoc IModelFilter::candidateRows
+        virtual bool candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const override;
+
+    protected:
+        //! \copydoc IModelFilter::usesIndex
+        virtual bool usesIndex() const override { return true; }
+
+        //! \copydoc IModelFilter::indexStrings
+        virtual void indexStrings(CFilterStringIndex &index, int row, const BlackMisc::Aviation::CAircraftIcaoCode &icao) const override;
+
     private:
+        //! Indexed strings
+        enum IndexedField
+        {
+            IndexDesignator,
+            IndexFamily,
+            IndexManufacturer,
+            IndexDescription
+        };
+
         int m_id = -1;
         QString m_designator;
         QString m_family;
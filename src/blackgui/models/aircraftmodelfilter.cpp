@@ -154,6 +154,46 @@ namespace BlackGui::Models
         return outContainer;
     }
 
+    bool CAircraftModelFilter::isNarrowing(const IModelFilter<CAircraftModelList> &previous) const
+    {
+        const auto *p = dynamic_cast<const CAircraftModelFilter *>(&previous);
+        if (!p || !this->isEnabled() || !p->isEnabled()) { return false; }
+        if (m_id != p->m_id || m_modelMode != p->m_modelMode || m_dbKeyFilter != p->m_dbKeyFilter) { return false; }
+        if (m_military != p->m_military || m_colorLiveries != p->m_colorLiveries) { return false; }
+        if (m_simulatorInfo != p->m_simulatorInfo || m_distributor != p->m_distributor || m_combinedType != p->m_combinedType) { return false; }
+        return CFilterStringIndex::isNarrowingExpression(m_modelKey, p->m_modelKey) &&
+               CFilterStringIndex::isNarrowingExpression(m_description, p->m_description) &&
+               CFilterStringIndex::isNarrowingExpression(m_fileName, p->m_fileName) &&
+               CFilterStringIndex::isNarrowingExpression(m_aircraftIcao, p->m_aircraftIcao) &&
+               CFilterStringIndex::isNarrowingExpression(m_aircraftManufacturer, p->m_aircraftManufacturer) &&
+               CFilterStringIndex::isNarrowingExpression(m_airlineIcao, p->m_airlineIcao) &&
+               CFilterStringIndex::isNarrowingExpression(m_airlineName, p->m_airlineName) &&
+               CFilterStringIndex::isNarrowingExpression(m_liveryCode, p->m_liveryCode);
+    }
+
+    bool CAircraftModelFilter::candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const
+    {
+        if (!this->isEnabled() || m_id >= 0) { return false; }
+        return index.candidateRows(
+        {
+            { IndexModelString, m_modelKey }, { IndexDescription, m_description }, { IndexFileName, m_fileName },
+            { IndexAircraftIcao, m_aircraftIcao }, { IndexAircraftManufacturer, m_aircraftManufacturer },
+            { IndexAirlineIcao, m_airlineIcao }, { IndexAirlineName, m_airlineName }, { IndexLiveryCode, m_liveryCode }
+        }, rows);
+    }
+
+    void CAircraftModelFilter::indexStrings(CFilterStringIndex &index, int row, const CAircraftModel &model) const
+    {
+        index.addValue(row, IndexModelString, model.getModelString());
+        index.addValue(row, IndexDescription, model.getDescription());
+        index.addValue(row, IndexFileName, model.getFileName());
+        index.addValue(row, IndexAircraftIcao, model.getAircraftIcaoCodeDesignator());
+        index.addValue(row, IndexAircraftManufacturer, model.getAircraftIcaoCode().getManufacturer());
+        index.addValue(row, IndexAirlineIcao, model.getAirlineIcaoCodeDesignator());
+        index.addValue(row, IndexAirlineName, model.getAirlineIcaoCode().getName());
+        index.addValue(row, IndexLiveryCode, model.getLivery().getCombinedCode());
+    }
+
     bool CAircraftModelFilter::valid() const
     {
         const bool allEmpty =
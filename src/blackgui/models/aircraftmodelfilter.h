@@ -44,7 +44,33 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Simulation::CAircraftModelList filter(const BlackMisc::Simulation::CAircraftModelList &inContainer) const override;
 
+        //! \copydoc IModelFilter::isNarrowing
+        virtual bool isNarrowing(const IModelFilter<BlackMisc::Simulation::CAircraftModelList> &previous) const override;
+
+        //! \copydoc IModelFilter::candidateRows
+        virtual bool candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const override;
+
+    protected:
+        //! \copydoc IModelFilter::usesIndex
+        virtual bool usesIndex() const override { return true; }
+
+        //! \copydoc IModelFilter::indexStrings
+        virtual void indexStrings(CFilterStringIndex &index, int row, const BlackMisc::Simulation::CAircraftModel &model) const override;
+
     private:
+        //! Indexed strings
+        enum IndexedField
+        {
+            IndexModelString,
+            IndexDescription,
+            IndexFileName,
+            IndexAircraftIcao,
+            IndexAircraftManufacturer,
+            IndexAirlineIcao,
+            IndexAirlineName,
+            IndexLiveryCode
+        };
+
         int m_id = -1;
         QString m_modelKey;
         QString m_description;
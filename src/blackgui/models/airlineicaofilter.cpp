@@ -76,4 +76,32 @@ namespace BlackGui::Models
         }
         return outContainer;
     }
+
+    bool CAirlineIcaoFilter::isNarrowing(const IModelFilter<CAirlineIcaoCodeList> &previous) const
+    {
+        const auto *p = dynamic_cast<const CAirlineIcaoFilter *>(&previous);
+        if (!p || !this->isValid() || !p->isValid()) { return false; }
+        if (m_id != p->m_id || m_countryIso != p->m_countryIso || m_real != p->m_real || m_va != p->m_va) { return false; }
+
+        // the designator is compared with the virtual designator for 4 characters
+        const bool vDesignator = m_vDesignator.length() == 4;
+        const bool previousVDesignator = p->m_vDesignator.length() == 4;
+        if (!p->m_vDesignator.isEmpty() && vDesignator != previousVDesignator) { return false; }
+        return CFilterStringIndex::isNarrowingExpression(m_vDesignator, p->m_vDesignator) &&
+               CFilterStringIndex::isNarrowingExpression(m_name, p->m_name);
+    }
+
+    bool CAirlineIcaoFilter::candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const
+    {
+        if (!this->isValid() || m_id >= 0) { return false; }
+        const IndexedField designatorField = m_vDesignator.length() == 4 ? IndexVDesignator : IndexDesignator;
+        return index.candidateRows({ { designatorField, m_vDesignator }, { IndexName, m_name } }, rows);
+    }
+
+    void CAirlineIcaoFilter::indexStrings(CFilterStringIndex &index, int row, const CAirlineIcaoCode &icao) const
+    {
+        index.addValue(row, IndexDesignator, icao.getDesignator());
+        index.addValue(row, IndexVDesignator, icao.getVDesignator());
+        index.addValue(row, IndexName, icao.getName());
+    }
 } // namespace
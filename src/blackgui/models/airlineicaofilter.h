@@ -29,7 +29,28 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Aviation::CAirlineIcaoCodeList filter(const BlackMisc::Aviation::CAirlineIcaoCodeList &inContainer) const override;
 
+        //! \copydoc IModelFilter::isNarrowing
+        virtual bool isNarrowing(const IModelFilter<BlackMisc::Aviation::CAirlineIcaoCodeList> &previous) const override;
+
+        //! \copydoc IModelFilter::candidateRows
+        virtual bool candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const override;
+
+    protected:
+        //! \copydoc IModelFilter::usesIndex
+        virtual bool usesIndex() const override { return true; }
+
+        //! \copydoc IModelFilter::indexStrings
+        virtual void indexStrings(CFilterStringIndex &index, int row, const BlackMisc::Aviation::CAirlineIcaoCode &icao) const override;
+
     private:
+        //! Indexed strings
+        enum IndexedField
+        {
+            IndexDesignator,
+            IndexVDesignator,
+            IndexName
+        };
+
         int m_id = -1;
         QString m_vDesignator;
         QString m_name;
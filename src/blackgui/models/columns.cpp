@@ -107,6 +107,7 @@ namespace BlackGui::Models
         CColumn copy(column);
         copy.setTranslationContext(m_translationContext);
         m_columns.push_back(copy);
+        m_generation++;
     }
 
     void CColumns::addColumnIncognito(const CColumn &column)
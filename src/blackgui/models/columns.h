@@ -215,14 +215,17 @@ namespace BlackGui::Models
         const CColumn &at(int columnNumber) const { return m_columns.at(columnNumber); }
 
         //! Clear
-        void clear() { m_columns.clear(); }
+        void clear() { m_columns.clear(); m_generation++; }
 
         //! Set columns
         //! @{
-        void setColumns(const QList<CColumn> &columns) { m_columns = columns; }
-        void setColumns(const CColumns &columns) { m_columns = columns.m_columns; }
+        void setColumns(const QList<CColumn> &columns) { m_columns = columns; m_generation++; }
+        void setColumns(const CColumns &columns) { m_columns = columns.m_columns; m_generation++; }
         //! @}
 
+        //! Changes with every change of the columns, e.g. to invalidate cached cell data
+        int getGeneration() const { return m_generation; }
+
         //! Columns
         const QList<CColumn> &columns() const { return m_columns; }
 
@@ -244,6 +247,7 @@ namespace BlackGui::Models
     private:
         QList<CColumn> m_columns;     //!< all columns
         QString m_translationContext; //!< for future usage
+        int m_generation = 0;         //!< \sa getGeneration
     };
 } // ns
 
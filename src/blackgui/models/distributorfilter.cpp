@@ -38,4 +38,10 @@ namespace BlackGui::Models
     {
         return (m_simulator.isNoSimulator() || m_simulator.isAllSimulators());
     }
+
+    bool CDistributorFilter::isNarrowing(const IModelFilter<CDistributorList> &previous) const
+    {
+        const auto *p = dynamic_cast<const CDistributorFilter *>(&previous);
+        return p && p->m_simulator == m_simulator;
+    }
 } // namespace
@@ -30,6 +30,9 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Simulation::CDistributorList filter(const BlackMisc::Simulation::CDistributorList &inDistributors) const override;
 
+        //! \copydoc IModelFilter::isNarrowing
+        virtual bool isNarrowing(const IModelFilter<BlackMisc::Simulation::CDistributorList> &previous) const override;
+
     private:
         //! Ignore simulator filtering?
         bool ignoreSimulator() const;
@@ -0,0 +1,133 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackgui/models/filterstringindex.h"
+
+#include <QPair>
+#include <algorithm>
+#include <iterator>
+
+namespace BlackGui::Models
+{
+    namespace
+    {
+        //! Literal part of a filter expression, case folded
+        QString foldedLiteral(const QString &filterExpression)
+        {
+            QString literal = filterExpression.trimmed();
+            literal.remove('*');
+            return literal.toCaseFolded();
+        }
+    }
+
+    void CFilterStringIndex::addValue(int row, int field, const QString &value)
+    {
+        Q_ASSERT_X(row >= m_rows - 1, Q_FUNC_INFO, "Rows have to be added in ascending order");
+        m_rows = qMax(m_rows, row + 1);
+        const QString folded = value.trimmed().toCaseFolded();
+        for (int i = 0; i + 3 <= folded.length(); ++i)
+        {
+            QVector<int> &rows = m_trigrams[trigramKey(field, folded, i)];
+            if (rows.isEmpty() || rows.back() != row) { rows.push_back(row); }
+        }
+    }
+
+    bool CFilterStringIndex::candidateRows(int field, const QString &filterExpression, QVector<int> &rows) const
+    {
+        if (expressionType(filterExpression) == Other) { return false; }
+        const QString literal = foldedLiteral(filterExpression);
+        if (literal.length() < 3) { return false; }
+
+        QVector<const QVector<int> *> trigramRows;
+        for (int i = 0; i + 3 <= literal.length(); ++i)
+        {
+            const auto it = m_trigrams.constFind(trigramKey(field, literal, i));
+            if (it == m_trigrams.constEnd())
+            {
+                rows.clear(); // no value contains this trigram
+                return true;
+            }
+            trigramRows.push_back(&it.value());
+        }
+
+        // smallest first, so the intersections stay small
+        std::sort(trigramRows.begin(), trigramRows.end(), [](const QVector<int> *a, const QVector<int> *b) { return a->size() < b->size(); });
+        rows = *trigramRows.front();
+        for (int i = 1; i < trigramRows.size() && !rows.isEmpty(); ++i)
+        {
+            rows = intersect(rows, *trigramRows[i]);
+        }
+        return true;
+    }
+
+    bool CFilterStringIndex::candidateRows(const QVector<QPair<int, QString>> &fieldExpressions, QVector<int> &rows) const
+    {
+        bool indexed = false;
+        QVector<int> fieldRows;
+        for (const QPair<int, QString> &fieldExpression : fieldExpressions)
+        {
+            if (fieldExpression.second.trimmed().isEmpty()) { continue; }
+            if (!this->candidateRows(fieldExpression.first, fieldExpression.second, fieldRows)) { continue; }
+            rows = indexed ? intersect(rows, fieldRows) : fieldRows;
+            indexed = true;
+            if (rows.isEmpty()) { break; }
+        }
+        return indexed;
+    }
+
+    CFilterStringIndex::ExpressionType CFilterStringIndex::expressionType(const QString &filterExpression)
+    {
+        const QString f = filterExpression.trimmed();
+        if (!f.contains('*')) { return Exact; }
+        if (f.startsWith('*') && f.endsWith('*')) { return Contains; }
+        if (f.endsWith('*')) { return StartsWith; }
+        if (f.startsWith('*')) { return EndsWith; }
+        return Other;
+    }
+
+    bool CFilterStringIndex::isNarrowingExpression(const QString &filterExpression, const QString &previousExpression)
+    {
+        if (previousExpression.trimmed().isEmpty()) { return true; }
+        if (filterExpression.trimmed().isEmpty()) { return false; }
+
+        const ExpressionType type = expressionType(filterExpression);
+        const ExpressionType previousType = expressionType(previousExpression);
+        if (type == Other || previousType == Other)
+        {
+            return filterExpression.trimmed().compare(previousExpression.trimmed(), Qt::CaseInsensitive) == 0;
+        }
+
+        const QString literal = foldedLiteral(filterExpression);
+        const QString previousLiteral = foldedLiteral(previousExpression);
+        switch (previousType)
+        {
+        case Exact:      return type == Exact && literal == previousLiteral;
+        case StartsWith: return (type == Exact || type == StartsWith) && literal.startsWith(previousLiteral);
+        case EndsWith:   return (type == Exact || type == EndsWith) && literal.endsWith(previousLiteral);
+        case Contains:   return literal.contains(previousLiteral);
+        default: break;
+        }
+        return false;
+    }
+
+    quint64 CFilterStringIndex::trigramKey(int field, const QString &folded, int position)
+    {
+        return (static_cast<quint64>(static_cast<quint16>(field)) << 48) |
+               (static_cast<quint64>(folded.at(position).unicode()) << 32) |
+               (static_cast<quint64>(folded.at(position + 1).unicode()) << 16) |
+               static_cast<quint64>(folded.at(position + 2).unicode());
+    }
+
+    QVector<int> CFilterStringIndex::intersect(const QVector<int> &a, const QVector<int> &b)
+    {
+        QVector<int> result;
+        result.reserve(qMin(a.size(), b.size()));
+        std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+        return result;
+    }
+} // namespace
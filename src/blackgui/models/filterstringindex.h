@@ -0,0 +1,76 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_FILTERSTRINGINDEX_H
+#define BLACKGUI_MODELS_FILTERSTRINGINDEX_H
+
+#include "blackgui/blackguiexport.h"
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+namespace BlackGui::Models
+{
+    //! Trigram index over the filterable string fields of the objects of a container.
+    //! \details For each field the rows containing a sequence of 3 characters (case insensitive) are kept,
+    //!          so the rows which can match a filter expression are found without looking at all objects.
+    //!          The rows are only candidates, the filter itself decides.
+    //! \remark built once per container, read only afterwards, so it can be shared between threads
+    class BLACKGUI_EXPORT CFilterStringIndex
+    {
+    public:
+        //! Kind of a filter expression, like IModelFilter::stringMatchesFilterExpression
+        enum ExpressionType
+        {
+            Exact,      //!< "abc"
+            StartsWith, //!< "abc*"
+            EndsWith,   //!< "*abc"
+            Contains,   //!< "*abc*"
+            Other       //!< wildcard in the middle, not indexed
+        };
+
+        //! Add a value of a field of an object
+        //! \remark rows have to be added in ascending order, a field can have several values per row
+        void addValue(int row, int field, const QString &value);
+
+        //! Number of indexed rows
+        int rows() const { return m_rows; }
+
+        //! Rows which can match the filter expression for the field
+        //! \return false if the index does not help (e.g. expression too short), all rows can match
+        bool candidateRows(int field, const QString &filterExpression, QVector<int> &rows) const;
+
+        //! Rows which can match all filter expressions, expressions for the fields can be empty
+        //! \return false if the index does not help, all rows can match
+        bool candidateRows(const QVector<QPair<int, QString>> &fieldExpressions, QVector<int> &rows) const;
+
+        //! Type of a filter expression
+        static ExpressionType expressionType(const QString &filterExpression);
+
+        //! Every value matching the filter expression also matches the previous expression,
+        //! like IModelFilter::stringMatchesFilterExpression. An empty previous expression matches everything.
+        static bool isNarrowingExpression(const QString &filterExpression, const QString &previousExpression);
+
+    private:
+        //! Key of a trigram of a field
+        static quint64 trigramKey(int field, const QString &folded, int position);
+
+        //! Intersection of sorted rows
+        static QVector<int> intersect(const QVector<int> &a, const QVector<int> &b);
+
+        QHash<quint64, QVector<int>> m_trigrams; //!< rows by trigram, ascending
+        int m_rows = 0;
+    };
+} // namespace
+
+#endif // guard
@@ -11,6 +11,7 @@
 
 #include "blackgui/models/listmodelbase.h"
 #include "blackgui/models/allmodelcontainers.h"
+#include "blackgui/models/listmodelsortkeys.h"
 #include "blackgui/guiutility.h"
 #include "blackmisc/variant.h"
 #include "blackmisc/worker.h"
@@ -19,6 +20,11 @@
 #include <QJsonDocument>
 #include <QList>
 #include <QMimeData>
+#include <QVector>
+#include <algorithm>
+#include <memory>
+#include <typeinfo>
+#include <utility>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -110,9 +116,13 @@ namespace BlackGui::Models
         default: break; // continue here
         }
 
-        // Formatted data
-        const ObjectType obj = this->containerOrFilteredContainer()[row];
-        return formatter->data(role, obj.propertyByIndex(propertyIndex)).getQVariant();
+        // Formatted data, cached as the same cells are painted again and again
+        m_displayCache.setColumnsGeneration(m_columns.getGeneration());
+        if (const QVariant *cached = m_displayCache.find(row, col, role)) { return *cached; }
+        const ObjectType &obj = this->containerOrFilteredContainer()[row];
+        const QVariant formatted = formatter->data(role, obj.propertyByIndex(propertyIndex)).getQVariant();
+        m_displayCache.insert(row, col, role, formatted);
+        return formatted;
     }
 
     template <typename T, bool UseCompare>
@@ -154,6 +164,7 @@ namespace BlackGui::Models
         const int row = index.row();
         if (row < 0 || row >= this->container().size()) { return false; }
         m_container[row] = obj;
+        m_displayCache.invalidateRows(row, row); // no signal here, see emitDataChanged
         return true;
     }
 
@@ -259,12 +270,9 @@ namespace BlackGui::Models
     template <typename T, bool UseCompare>
     void CListModelBase<T, UseCompare>::removeFilter()
     {
+        m_filterRequest++; // discard pending asynchronous results
         if (!this->hasFilter()) { return; }
-        m_filter.reset(nullptr);
-        this->beginResetModel();
-        this->updateFilteredContainer();
-        this->endResetModel();
-        this->emitModelDataChanged();
+        this->setFilteredContainer(ContainerType(), nullptr);
     }
 
     template <typename T, bool UseCompare>
@@ -283,6 +291,13 @@ namespace BlackGui::Models
         }
         if (filter->isValid())
         {
+            if (m_container.size() >= asyncFilterThreshold)
+            {
+                // larger container, reselected when filtered
+                this->updateFilteredContainerAsync(std::move(filter), selection);
+                return;
+            }
+            m_filterRequest++; // discard pending asynchronous results
             m_filter = std::move(filter);
             this->beginResetModel();
             this->updateFilteredContainer();
@@ -461,6 +476,72 @@ namespace BlackGui::Models
         }
     }
 
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::updateFilteredContainerAsync(const std::shared_ptr<const IModelFilter<ContainerType>> &filter, const ContainerType &selection)
+    {
+        if (m_modelDestroyed) { return; }
+        const int request = ++m_filterRequest;
+        const int generation = m_containerGeneration;
+        const ContainerType container = m_container;
+
+        // a narrowing filter only needs to filter the current result
+        const bool narrowing = this->hasFilter() && filter->isNarrowing(*m_filter);
+        const ContainerType filtered = narrowing ? m_containerFiltered : ContainerType();
+
+        // index of the container, created in background if missing or outdated
+        const bool indexValid = m_filterIndex && m_filterIndexGeneration == generation && *m_filterIndexType == typeid(*filter);
+        const auto index = std::make_shared<std::shared_ptr<const CFilterStringIndex>>(indexValid ? m_filterIndex : nullptr);
+
+        CWorker *worker = CWorker::fromTask(this, "ModelFilter", [filter, container, narrowing, filtered, index]()
+        {
+            if (narrowing) { return filter->filter(filtered); }
+            if (!*index || (*index)->rows() != container.size()) { *index = filter->createIndex(container); }
+
+            QVector<int> rows;
+            if (!*index || !filter->candidateRows(**index, rows)) { return filter->filter(container); }
+            ContainerType candidates;
+            for (int row : std::as_const(rows)) { candidates.push_back(container[row]); }
+            return filter->filter(candidates);
+        });
+        worker->thenWithResult<ContainerType>(this, [ = ](const ContainerType &result)
+        {
+            if (m_modelDestroyed) { return; }
+            if (request != m_filterRequest) { return; } // newer filter or filter removed
+            if (generation != m_containerGeneration)
+            {
+                // container changed meanwhile, filter again
+                this->updateFilteredContainerAsync(filter, selection);
+                return;
+            }
+            if (*index)
+            {
+                m_filterIndex = *index;
+                m_filterIndexType = &typeid(*filter);
+                m_filterIndexGeneration = generation;
+            }
+            this->setFilteredContainer(result, filter);
+
+            // reselect if implemented in specialized views
+            if (!selection.isEmpty() && m_selectionModel)
+            {
+                m_selectionModel->selectObjects(selection);
+            }
+        });
+    }
+
+    template <typename T, bool UseCompare>
+    void CListModelBase<T, UseCompare>::setFilteredContainer(const ContainerType &filtered, const std::shared_ptr<const IModelFilter<ContainerType>> &filter)
+    {
+        // the reset changes the generation, but the container and its index stay the same
+        const bool indexValid = m_filterIndex && m_filterIndexGeneration == m_containerGeneration;
+        this->beginResetModel();
+        m_filter = filter;
+        m_containerFiltered = filtered;
+        this->endResetModel();
+        if (indexValid) { m_filterIndexGeneration = m_containerGeneration; }
+        this->emitModelDataChanged();
+    }
+
     template <typename T, bool UseCompare>
     void CListModelBase<T, UseCompare>::emitModelDataChanged()
     {
@@ -555,15 +636,30 @@ namespace BlackGui::Models
             return container;    // at release build do nothing
         }
 
-        // sort the values
-        const auto tieBreakersCopy = m_sortTieBreakers; //! \todo workaround T579 still not thread-safe, but less likely to crash
-        const std::integral_constant<bool, UseCompare> marker {};
-        const auto p = [ = ](const ObjectType & a, const ObjectType & b) -> bool
+        // keys of the sort column and the tie breakers, extracted once per row
+        CPropertyIndexList indexes { propertyIndex };
+        indexes.push_back(m_sortTieBreakers); //! \todo workaround T579 still not thread-safe, but less likely to crash
+        const CListModelSortKeys keys = CListModelSortKeys::fromContainer(container, indexes, UseCompare);
+        QVector<int> rows = keys.sortedRows(order);
+
+        if constexpr (UseCompare)
         {
-            return Private::compareForModelSort<ObjectType>(a, b, order, propertyIndex, tieBreakersCopy, marker);
-        };
+            // the keys are the values of propertyByIndex, comparePropertyByIndex decides
+            // usually the order is the same and only checked, otherwise sort with the compare function
+            const auto less = [&](int a, int b)
+            {
+                const int c = Private::compareForModelSort<ObjectType>(container[a], container[b], indexes);
+                return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
+            };
+            if (!std::is_sorted(rows.cbegin(), rows.cend(), less))
+            {
+                std::stable_sort(rows.begin(), rows.end(), less);
+            }
+        }
 
-        return container.sorted(p);
+        ContainerType sorted;
+        for (int row : rows) { sorted.push_back(container[row]); }
+        return sorted;
     }
 
     template <typename T, bool UseCompare>
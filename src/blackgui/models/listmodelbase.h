@@ -23,6 +23,7 @@
 #include <QVariant>
 #include <QVector>
 #include <memory>
+#include <typeinfo>
 
 class QMimeData;
 class QModelIndex;
@@ -140,6 +141,7 @@ namespace BlackGui::Models
         int removeIf(K0 k0, V0 v0, KeysValues... keysValues)
         {
             int c = m_container.removeIf(BlackMisc::Predicates::MemberEqual(k0, v0, keysValues...));
+            if (c > 0) { m_containerGeneration++; } // no signal for the removed rows
             this->updateFilteredContainer();
             if (c > 0) { this->emitModelDataChanged();}
             return c;
@@ -176,44 +178,40 @@ namespace BlackGui::Models
         //! Update filtered container
         void updateFilteredContainer();
 
+        //! Filter in background, the filtered container is replaced when the result is available
+        //! \remark the current filter stays in place until then
+        void updateFilteredContainerAsync(const std::shared_ptr<const IModelFilter<ContainerType>> &filter, const ContainerType &selection);
+
+        //! Replace the filtered container, only the filter has changed
+        void setFilteredContainer(const ContainerType &filtered, const std::shared_ptr<const IModelFilter<ContainerType>> &filter);
+
         //! Model changed
         void emitModelDataChanged();
 
         ContainerType m_container;         //!< used container
         ContainerType m_containerFiltered; //!< cache for filtered container data
-        std::unique_ptr<IModelFilter<ContainerType> > m_filter;     //!< used filter
-        ISelectionModel<ContainerType> *m_selectionModel = nullptr; //!< selection model
+        std::shared_ptr<const IModelFilter<ContainerType> > m_filter; //!< used filter, m_containerFiltered is its result
+        ISelectionModel<ContainerType> *m_selectionModel = nullptr;   //!< selection model
+
+    private:
+        std::shared_ptr<const CFilterStringIndex> m_filterIndex;   //!< index of m_container for asynchronous filtering
+        const std::type_info *m_filterIndexType = nullptr;         //!< filter class which created the index
+        int m_filterIndexGeneration = -1;                          //!< container generation of the index
+        int m_filterRequest = 0;                                   //!< latest filter request, older asynchronous results are discarded
     };
 
     namespace Private
     {
-        //! Sort with compare function
-        template<class ObjectType>
-        bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::true_type)
-        {
-            const int c = a.comparePropertyByIndex(index, b);
-            if (c == 0)
-            {
-                if (!tieBreakers.isEmpty())
-                {
-                    return compareForModelSort<ObjectType>(a, b, order, tieBreakers.front(), tieBreakers.copyFrontRemoved(), std::true_type());
-                }
-                return false;
-            }
-            return (order == Qt::AscendingOrder) ? (c < 0) : (c > 0);
-        }
-
-        //! Sort without compare function
-        template <typename ObjectType>
-        bool compareForModelSort(const ObjectType &a, const ObjectType &b, Qt::SortOrder order, const BlackMisc::CPropertyIndex &index, const BlackMisc::CPropertyIndexList &tieBreakers, std::false_type)
+        //! Compare by property indexes with compare function, ties are resolved by the next index
+        template <class ObjectType>
+        int compareForModelSort(const ObjectType &a, const ObjectType &b, const BlackMisc::CPropertyIndexList &indexes)
         {
-            const BlackMisc::CVariant aQv = a.propertyByIndex(index);
-            const BlackMisc::CVariant bQv = b.propertyByIndex(index);
-            if (!tieBreakers.isEmpty() && aQv == bQv)
+            for (const BlackMisc::CPropertyIndex &index : indexes)
             {
-                return compareForModelSort<ObjectType>(a, b, order, tieBreakers.front(), tieBreakers.copyFrontRemoved(), std::false_type());
+                const int c = a.comparePropertyByIndex(index, b);
+                if (c != 0) { return c; }
             }
-            return (order == Qt::AscendingOrder) ? (aQv < bQv) : (bQv < aQv);
+            return 0;
         }
     } // namespace
 } // namespace
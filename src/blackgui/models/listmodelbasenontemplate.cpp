@@ -184,6 +184,18 @@ namespace BlackGui::Models
 
         // connect
         connect(this, &CListModelBaseNonTemplate::dataChanged, this, &CListModelBaseNonTemplate::onDataChanged);
+
+        // cached cell data and generation, connected before any view
+        connect(this, &CListModelBaseNonTemplate::dataChanged, this, [ = ](const QModelIndex &topLeft, const QModelIndex &bottomRight)
+        {
+            m_containerGeneration++;
+            m_displayCache.invalidateRows(topLeft.row(), bottomRight.row());
+        });
+        connect(this, &CListModelBaseNonTemplate::rowsInserted, this, [ = ](const QModelIndex &, int first) { m_containerGeneration++; m_displayCache.invalidateFromRow(first); });
+        connect(this, &CListModelBaseNonTemplate::rowsRemoved,  this, [ = ](const QModelIndex &, int first) { m_containerGeneration++; m_displayCache.invalidateFromRow(first); });
+        connect(this, &CListModelBaseNonTemplate::rowsMoved,     this, [ = ] { m_containerGeneration++; m_displayCache.invalidate(); });
+        connect(this, &CListModelBaseNonTemplate::modelReset,    this, [ = ] { m_containerGeneration++; m_displayCache.invalidate(); });
+        connect(this, &CListModelBaseNonTemplate::layoutChanged, this, [ = ] { m_containerGeneration++; m_displayCache.invalidate(); });
     }
 
 } // namespace
@@ -12,6 +12,7 @@
 #define BLACKGUI_MODELS_LISTMODELBASENONTEMPLATE_H
 
 #include "blackgui/models/columns.h"
+#include "blackgui/models/listmodeldisplaycache.h"
 #include "blackgui/dropbase.h"
 #include "blackgui/blackguiexport.h"
 #include "blackmisc/propertyindexlist.h"
@@ -45,6 +46,9 @@ namespace BlackGui::Models
         //! Number of elements when to use asynchronous updates
         static constexpr int asyncThreshold = 50;
 
+        //! Number of elements when to filter asynchronously
+        static constexpr int asyncFilterThreshold = 1000;
+
         //! Destructor
         virtual ~CListModelBaseNonTemplate() override {}
 
@@ -131,6 +135,13 @@ namespace BlackGui::Models
         //! Using void column at the end?
         bool endsWithEmptyColumn() const { return m_columns.endsWithEmptyColumn(); }
 
+        //! Max. number of rows with cached cell data, 0 disables caching
+        //! \sa CListModelDisplayCache
+        void setDisplayCacheMaxRows(int maxRows) { m_displayCache.setMaxRows(maxRows); }
+
+        //! Number of rows with cached cell data
+        int getDisplayCacheRows() const { return m_displayCache.cachedRows(); }
+
     signals:
         //! Asynchronous update finished
         void asyncUpdateFinished();
@@ -171,6 +182,8 @@ namespace BlackGui::Models
         Qt::SortOrder   m_sortOrder;                       //!< sort order (asc/desc)
         Qt::DropActions m_dropActions = Qt::IgnoreAction;  //!< drop actions
         BlackMisc::CPropertyIndexList m_sortTieBreakers;   //!< how column values are sorted if equal, if no value is given this is random
+        mutable CListModelDisplayCache m_displayCache;     //!< formatted cell data of the visible rows
+        int             m_containerGeneration = 0;         //!< changed with every change of the rows, e.g. for asynchronous results
 
     private:
         BlackMisc::CDigestSignal m_dsModelsChanged { this, &CListModelBaseNonTemplate::changed, &CListModelBaseNonTemplate::onChangedDigest, 500, 10 };
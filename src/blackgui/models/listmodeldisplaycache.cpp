@@ -0,0 +1,92 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackgui/models/listmodeldisplaycache.h"
+
+#include <QVector>
+#include <algorithm>
+#include <utility>
+
+namespace BlackGui::Models
+{
+    const QVariant *CListModelDisplayCache::find(int row, int column, int role)
+    {
+        const auto rowIt = m_rows.find(row);
+        if (rowIt == m_rows.end()) { return nullptr; }
+        const auto cellIt = rowIt->cells.constFind(cellKey(column, role));
+        if (cellIt == rowIt->cells.constEnd()) { return nullptr; }
+        rowIt->lastUsed = ++m_useCounter;
+        return &cellIt.value();
+    }
+
+    void CListModelDisplayCache::insert(int row, int column, int role, const QVariant &value)
+    {
+        if (!this->isEnabled()) { return; }
+        auto rowIt = m_rows.find(row);
+        if (rowIt == m_rows.end())
+        {
+            if (m_rows.size() >= m_maxRows) { this->evict(); }
+            rowIt = m_rows.insert(row, Row());
+        }
+        rowIt->cells.insert(cellKey(column, role), value);
+        rowIt->lastUsed = ++m_useCounter;
+    }
+
+    void CListModelDisplayCache::invalidateRows(int firstRow, int lastRow)
+    {
+        if (m_rows.isEmpty() || lastRow < firstRow) { return; }
+        if (lastRow - firstRow >= m_rows.size())
+        {
+            for (auto it = m_rows.begin(); it != m_rows.end();)
+            {
+                if (it.key() >= firstRow && it.key() <= lastRow) { it = m_rows.erase(it); }
+                else { ++it; }
+            }
+            return;
+        }
+        for (int row = firstRow; row <= lastRow; ++row) { m_rows.remove(row); }
+    }
+
+    void CListModelDisplayCache::invalidateFromRow(int firstRow)
+    {
+        for (auto it = m_rows.begin(); it != m_rows.end();)
+        {
+            if (it.key() >= firstRow) { it = m_rows.erase(it); }
+            else { ++it; }
+        }
+    }
+
+    void CListModelDisplayCache::setColumnsGeneration(int generation)
+    {
+        if (generation == m_columnsGeneration) { return; }
+        m_columnsGeneration = generation;
+        this->invalidate();
+    }
+
+    void CListModelDisplayCache::setMaxRows(int maxRows)
+    {
+        m_maxRows = qMax(0, maxRows);
+        if (m_rows.size() > m_maxRows) { this->invalidate(); }
+    }
+
+    void CListModelDisplayCache::evict()
+    {
+        // remove the older half, so this is only done now and then
+        QVector<quint64> used;
+        used.reserve(m_rows.size());
+        for (const Row &row : std::as_const(m_rows)) { used.push_back(row.lastUsed); }
+        const auto median = used.begin() + used.size() / 2;
+        std::nth_element(used.begin(), median, used.end());
+        const quint64 limit = *median;
+        for (auto it = m_rows.begin(); it != m_rows.end();)
+        {
+            if (it->lastUsed <= limit) { it = m_rows.erase(it); }
+            else { ++it; }
+        }
+    }
+} // namespace
@@ -0,0 +1,86 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_LISTMODELDISPLAYCACHE_H
+#define BLACKGUI_MODELS_LISTMODELDISPLAYCACHE_H
+
+#include "blackgui/blackguiexport.h"
+
+#include <QHash>
+#include <QVariant>
+#include <QtGlobal>
+
+namespace BlackGui::Models
+{
+    //! Formatted cell data of the rows of a list model, so a cell is only formatted once and not with every paint.
+    //! \details Rows are cached when the view asks for them, so only visible rows are formatted.
+    //!          Changed rows are removed (dataChanged), inserted or removed rows only remove the rows behind them
+    //!          and a reset or layout change clears all. The number of cached rows is limited, the least recently
+    //!          used rows are removed first.
+    //! \remark GUI thread only
+    class BLACKGUI_EXPORT CListModelDisplayCache
+    {
+    public:
+        //! Default limit of cached rows
+        static constexpr int DefaultMaxRows = 1000;
+
+        //! Cached value of a cell or nullptr
+        const QVariant *find(int row, int column, int role);
+
+        //! Cache the value of a cell
+        void insert(int row, int column, int role, const QVariant &value);
+
+        //! Rows have been changed
+        void invalidateRows(int firstRow, int lastRow);
+
+        //! Rows have been inserted or removed, rows from the first row on are moved
+        void invalidateFromRow(int firstRow);
+
+        //! Columns changed, invalidates all rows if the generation changed
+        //! \sa CColumns::getGeneration
+        void setColumnsGeneration(int generation);
+
+        //! Remove all
+        void invalidate() { m_rows.clear(); }
+
+        //! Number of cached rows
+        int cachedRows() const { return m_rows.size(); }
+
+        //! Max. number of cached rows, 0 disables the cache
+        int getMaxRows() const { return m_maxRows; }
+
+        //! Max. number of cached rows, 0 disables the cache
+        void setMaxRows(int maxRows);
+
+        //! Enabled?
+        bool isEnabled() const { return m_maxRows > 0; }
+
+    private:
+        //! Cells of a row
+        struct Row
+        {
+            QHash<quint32, QVariant> cells; //!< by column and role
+            quint64 lastUsed = 0;           //!< for eviction
+        };
+
+        //! Key of a cell in a row
+        static quint32 cellKey(int column, int role) { return (static_cast<quint32>(column) << 16) | static_cast<quint16>(role); }
+
+        //! Remove the least recently used rows, so there is space for new ones
+        void evict();
+
+        QHash<int, Row> m_rows;
+        quint64 m_useCounter = 0;
+        int m_maxRows = DefaultMaxRows;
+        int m_columnsGeneration = -1;
+    };
+} // namespace
+
+#endif // guard
@@ -0,0 +1,120 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackgui/models/listmodelsortkeys.h"
+#include "blackmisc/comparefunctions.h"
+
+#include <QMetaType>
+#include <algorithm>
+#include <numeric>
+
+using namespace BlackMisc;
+
+namespace BlackGui::Models
+{
+    namespace
+    {
+        //! Compare two CVariants, hidden friend of CVariant
+        int compareVariants(const CVariant &a, const CVariant &b)
+        {
+            return compare(a, b);
+        }
+    }
+
+    CListModelSortKeys::Column::Type CListModelSortKeys::columnType(int userType)
+    {
+        switch (userType)
+        {
+        case QMetaType::Bool:
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::Short:
+        case QMetaType::UShort:
+        case QMetaType::Char:
+        case QMetaType::UChar:
+            return Column::Integer;
+        case QMetaType::Double:
+        case QMetaType::Float:
+            return Column::Double;
+        case QMetaType::QString:
+            return Column::String;
+        default: break;
+        }
+        return Column::Variant;
+    }
+
+    void CListModelSortKeys::addColumn(const QVector<CVariant> &values, bool caseInsensitive)
+    {
+        Column column;
+        const int userType = values.isEmpty() ? QMetaType::UnknownType : values.front().userType();
+        const bool sameType = std::all_of(values.cbegin(), values.cend(), [userType](const CVariant &v) { return v.userType() == userType; });
+        column.type = sameType ? columnType(userType) : Column::Variant;
+        switch (column.type)
+        {
+        case Column::Integer:
+            column.integers.reserve(values.size());
+            for (const CVariant &v : values) { column.integers.push_back(v.toLongLong()); }
+            break;
+        case Column::Double:
+            column.doubles.reserve(values.size());
+            for (const CVariant &v : values) { column.doubles.push_back(v.toDouble()); }
+            break;
+        case Column::String:
+            column.strings.reserve(values.size());
+            for (const CVariant &v : values)
+            {
+                const QString s = v.getQVariant().toString();
+                column.strings.push_back(caseInsensitive ? s.toCaseFolded() : s);
+            }
+            break;
+        default:
+            column.variants = values;
+            break;
+        }
+        m_columns.push_back(std::move(column));
+    }
+
+    int CListModelSortKeys::compareColumn(const Column &column, int rowA, int rowB)
+    {
+        switch (column.type)
+        {
+        case Column::Integer: return Compare::compare(column.integers[rowA], column.integers[rowB]);
+        case Column::Double:  return Compare::compare(column.doubles[rowA], column.doubles[rowB]);
+        case Column::String:  return column.strings[rowA].compare(column.strings[rowB]);
+        default: break;
+        }
+        return compareVariants(column.variants[rowA], column.variants[rowB]);
+    }
+
+    int CListModelSortKeys::compare(int rowA, int rowB) const
+    {
+        for (const Column &column : m_columns)
+        {
+            const int c = compareColumn(column, rowA, rowB);
+            if (c != 0) { return c; }
+        }
+        return 0;
+    }
+
+    QVector<int> CListModelSortKeys::sortedRows(Qt::SortOrder order) const
+    {
+        QVector<int> rows(m_rows);
+        std::iota(rows.begin(), rows.end(), 0);
+        if (m_columns.isEmpty()) { return rows; }
+        if (order == Qt::AscendingOrder)
+        {
+            std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) { return this->compare(a, b) < 0; });
+        }
+        else
+        {
+            std::stable_sort(rows.begin(), rows.end(), [this](int a, int b) { return this->compare(a, b) > 0; });
+        }
+        return rows;
+    }
+} // namespace
@@ -0,0 +1,95 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKGUI_MODELS_LISTMODELSORTKEYS_H
+#define BLACKGUI_MODELS_LISTMODELSORTKEYS_H
+
+#include "blackgui/blackguiexport.h"
+#include "blackmisc/propertyindexlist.h"
+#include "blackmisc/variant.h"
+
+#include <QString>
+#include <QVector>
+#include <Qt>
+#include <QtGlobal>
+
+namespace BlackGui::Models
+{
+    //! Sort keys of the rows of a list model, one key column per property index.
+    //! \details The values are extracted once per row by propertyByIndex and kept as typed arrays
+    //!          (integers, doubles, strings), so sorting compares plain values instead of CVariants.
+    //!          Values of other types are kept as CVariant and compared as such.
+    //! \remark sorting is done on a permutation of the rows, the objects are not moved
+    class BLACKGUI_EXPORT CListModelSortKeys
+    {
+    public:
+        //! Keys of the objects in the container
+        //! \param container the objects
+        //! \param indexes primary property index followed by the tie breakers
+        //! \param caseInsensitive compare strings case insensitive, like most comparePropertyByIndex implementations
+        template <class ContainerType>
+        static CListModelSortKeys fromContainer(const ContainerType &container, const BlackMisc::CPropertyIndexList &indexes, bool caseInsensitive)
+        {
+            CListModelSortKeys keys(container.size());
+            QVector<BlackMisc::CVariant> values(keys.m_rows);
+            for (const BlackMisc::CPropertyIndex &index : indexes)
+            {
+                int row = 0;
+                for (const auto &object : container) { values[row++] = object.propertyByIndex(index); }
+                keys.addColumn(values, caseInsensitive);
+            }
+            return keys;
+        }
+
+        //! Number of rows
+        int rows() const { return m_rows; }
+
+        //! Number of key columns
+        int columns() const { return m_columns.size(); }
+
+        //! Compare two rows by all key columns, ties are resolved by the next column
+        int compare(int rowA, int rowB) const;
+
+        //! Rows in sorted order
+        //! \remark stable, rows with equal keys keep their order
+        QVector<int> sortedRows(Qt::SortOrder order) const;
+
+    private:
+        //! Key column
+        struct Column
+        {
+            //! Type of the keys
+            enum Type { Integer, Double, String, Variant };
+
+            Type type = Variant;                     //!< used array
+            QVector<qint64> integers;                //!< integer keys
+            QVector<double> doubles;                 //!< double keys
+            QVector<QString> strings;                //!< string keys, case folded if case insensitive
+            QVector<BlackMisc::CVariant> variants;   //!< keys of other types
+        };
+
+        //! Constructor
+        explicit CListModelSortKeys(int rows) : m_rows(rows) {}
+
+        //! Key type for the type of the values
+        static Column::Type columnType(int userType);
+
+        //! Add a column, the type is taken from the values
+        void addColumn(const QVector<BlackMisc::CVariant> &values, bool caseInsensitive);
+
+        //! Compare two rows by one column
+        static int compareColumn(const Column &column, int rowA, int rowB);
+
+        int m_rows = 0;
+        QVector<Column> m_columns;
+    };
+} // namespace
+
+#endif // guard
@@ -86,4 +86,30 @@ namespace BlackGui::Models
         return (m_colorLiveries && !m_airlineLiveries) || (!m_colorLiveries && m_airlineLiveries);
     }
 
+    bool CLiveryFilter::isNarrowing(const IModelFilter<CLiveryList> &previous) const
+    {
+        const auto *p = dynamic_cast<const CLiveryFilter *>(&previous);
+        if (!p || !this->isEnabled() || !p->isEnabled()) { return false; }
+        if (m_id != p->m_id || m_colorLiveries != p->m_colorLiveries || m_airlineLiveries != p->m_airlineLiveries) { return false; }
+        if (m_fuselageColor != p->m_fuselageColor || m_tailColor != p->m_tailColor || m_maxColorDistance != p->m_maxColorDistance) { return false; }
+        return CFilterStringIndex::isNarrowingExpression(m_combinedCode, p->m_combinedCode) &&
+               CFilterStringIndex::isNarrowingExpression(m_description, p->m_description) &&
+               CFilterStringIndex::isNarrowingExpression(m_airlineIcaoDesignator, p->m_airlineIcaoDesignator);
+    }
+
+    bool CLiveryFilter::candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const
+    {
+        if (!this->isEnabled() || m_id >= 0) { return false; }
+        return index.candidateRows(
+        {
+            { IndexCombinedCode, m_combinedCode }, { IndexDescription, m_description }, { IndexAirlineDesignator, m_airlineIcaoDesignator }
+        }, rows);
+    }
+
+    void CLiveryFilter::indexStrings(CFilterStringIndex &index, int row, const CLivery &livery) const
+    {
+        index.addValue(row, IndexCombinedCode, livery.getCombinedCode());
+        index.addValue(row, IndexDescription, livery.getDescription());
+        index.addValue(row, IndexAirlineDesignator, livery.getAirlineIcaoCode().getVDesignator());
+    }
 } // namespace
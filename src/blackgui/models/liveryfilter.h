@@ -40,7 +40,28 @@ namespace BlackGui::Models
         //! \copydoc IModelFilter::filter
         virtual BlackMisc::Aviation::CLiveryList filter(const BlackMisc::Aviation::CLiveryList &inContainer) const override;
 
+        //! \copydoc IModelFilter::isNarrowing
+        virtual bool isNarrowing(const IModelFilter<BlackMisc::Aviation::CLiveryList> &previous) const override;
+
+        //! \copydoc IModelFilter::candidateRows
+        virtual bool candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const override;
+
+    protected:
+        //! \copydoc IModelFilter::usesIndex
+        virtual bool usesIndex() const override { return true; }
+
+        //! \copydoc IModelFilter::indexStrings
+        virtual void indexStrings(CFilterStringIndex &index, int row, const BlackMisc::Aviation::CLivery &livery) const override;
+
     private:
+        //! Indexed strings
+        enum IndexedField
+        {
+            IndexCombinedCode,
+            IndexDescription,
+            IndexAirlineDesignator
+        };
+
         int m_id = -1;
         QString m_combinedCode;
         QString m_description;
@@ -70,6 +70,16 @@ namespace BlackGui::Models
         return sw.remove('*');
     }
 
+    template<class ContainerType>
+    std::shared_ptr<const CFilterStringIndex> IModelFilter<ContainerType>::createIndex(const ContainerType &container) const
+    {
+        if (!this->usesIndex()) { return nullptr; }
+        auto index = std::make_shared<CFilterStringIndex>();
+        int row = 0;
+        for (const ObjectType &object : container) { this->indexStrings(*index, row++, object); }
+        return index;
+    }
+
     // Forward instantiations
     template class IModelFilter<BlackMisc::CStatusMessageList>;
     template class IModelFilter<BlackMisc::CNameVariantPairList>;
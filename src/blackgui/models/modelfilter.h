@@ -11,6 +11,7 @@
 #ifndef BLACKGUI_MODELS_LISTMODELFILTER_H
 #define BLACKGUI_MODELS_LISTMODELFILTER_H
 
+#include "blackgui/models/filterstringindex.h"
 #include "blackmisc/aviation/aircrafticaocodelist.h"
 #include "blackmisc/aviation/airlineicaocodelist.h"
 #include "blackmisc/aviation/airportlist.h"
@@ -29,7 +30,9 @@
 #include "blackmisc/statusmessagelist.h"
 #include "blackmisc/variant.h"
 
+#include <QPair>
 #include <QString>
+#include <QVector>
 #include <Qt>
 #include <memory>
 
@@ -39,6 +42,9 @@ namespace BlackGui::Models
     template<class ContainerType> class IModelFilter
     {
     public:
+        //! Container element type
+        using ObjectType = typename ContainerType::value_type;
+
         //! Constructor
         IModelFilter(bool enabled = true) : m_enabled(enabled) {}
 
@@ -48,6 +54,19 @@ namespace BlackGui::Models
         //! Used container data
         virtual ContainerType filter(const ContainerType &container) const = 0;
 
+        //! Every object passing this filter also passes the previous filter,
+        //! so only the result of the previous filter needs to be filtered
+        virtual bool isNarrowing(const IModelFilter<ContainerType> &previous) const { Q_UNUSED(previous) return false; }
+
+        //! Index of the filterable strings of the objects, nullptr if the filter does not use an index
+        //! \remark can be used with all filters of the same class
+        //! \sa indexStrings
+        std::shared_ptr<const CFilterStringIndex> createIndex(const ContainerType &container) const;
+
+        //! Rows of the indexed container which can pass this filter
+        //! \return false if all rows can pass
+        virtual bool candidateRows(const CFilterStringIndex &index, QVector<int> &rows) const { Q_UNUSED(index) Q_UNUSED(rows) return false; }
+
         //! Anything to do?
         bool isValid() const { return m_valid; }
 
@@ -67,6 +86,12 @@ namespace BlackGui::Models
         //! Remove the * wildcards
         QString stripWildcard(const QString &value) const;
 
+        //! Filter uses an index of the strings of the objects?
+        virtual bool usesIndex() const { return false; }
+
+        //! Add the filterable strings of an object to the index
+        virtual void indexStrings(CFilterStringIndex &index, int row, const ObjectType &object) const { Q_UNUSED(index) Q_UNUSED(row) Q_UNUSED(object) }
+
         bool m_valid = false;  //!< is filter valid?
 
     private:
@@ -298,16 +298,20 @@ namespace BlackGui::Views
         if (!hasSelection()) { return 0; }
         int c = 0;
 
-        int lastUpdatedRow  = -1;
+        int lastRow = -1;
         int firstUpdatedRow = -1;
+        int lastUpdatedRow  = -1;
         const CPropertyIndexList propertyIndexes(vm.indexes());
         const QModelIndexList indexes = this->selectedRows();
 
         for (const QModelIndex &i : indexes)
         {
-            if (i.row() == lastUpdatedRow) { continue; }
-            lastUpdatedRow = i.row();
-            if (firstUpdatedRow < 0 || lastUpdatedRow < firstUpdatedRow) { firstUpdatedRow = lastUpdatedRow; }
+            if (i.row() == lastRow) { continue; }
+            lastRow = i.row();
+
+            // the changed range has to cover all rows, whatever order the selection has
+            if (firstUpdatedRow < 0 || lastRow < firstUpdatedRow) { firstUpdatedRow = lastRow; }
+            if (lastUpdatedRow  < 0 || lastRow > lastUpdatedRow)  { lastUpdatedRow  = lastRow; }
             ObjectType obj(this->at(i));
 
             // update all properties in map
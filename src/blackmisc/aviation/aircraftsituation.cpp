@@ -10,6 +10,7 @@
 #include "blackmisc/aviation/aircraftpartslist.h"
 #include "blackmisc/aviation/aircraftlights.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/units.h"
 #include "blackmisc/propertyindexref.h"
@@ -788,6 +789,15 @@ namespace BlackMisc::Aviation
         return ag;
     }
 
+    CFixedLength<Fixed::ft> CAircraftSituation::getHeightAboveGroundFt() const
+    {
+        using FixedFt = CFixedLength<Fixed::ft>;
+        const FixedFt altitude = FixedFt::fromQuantity(this->getAltitude());
+        if (this->getAltitude().getReferenceDatum() == CAltitude::AboveGround) { return altitude; }
+        if (!this->hasGroundElevation()) { return FixedFt(); }
+        return altitude - FixedFt::fromQuantity(this->getGroundElevation()); // null if the altitude is null
+    }
+
     void CAircraftSituation::setHeading(const CHeading &heading)
     {
         m_heading = heading.normalizedToPlusMinus180Degrees();
@@ -806,11 +816,26 @@ namespace BlackMisc::Aviation
 
     CAltitude CAircraftSituation::getCorrectedAltitude(const CLength &centerOfGravity, bool enableDragToGround, AltitudeCorrection *correction) const
     {
+        const CFixedLength<Fixed::ft> altitude = CFixedLength<Fixed::ft>::fromQuantity(this->getAltitude());
+        const CFixedLength<Fixed::ft> corrected = this->getCorrectedAltitudeFt(CFixedLength<Fixed::ft>::fromQuantity(centerOfGravity), enableDragToGround, correction);
+        if (corrected == altitude || corrected.isNull()) { return this->getAltitude(); }
+        return CAltitude(corrected.toQuantity(), CAltitude::MeanSeaLevel).switchedUnit(this->getAltitudeOrDefaultUnit());
+    }
+
+    CFixedLength<Fixed::ft> CAircraftSituation::getCorrectedAltitudeFt(bool enableDragToGround, AltitudeCorrection *correction) const
+    {
+        return this->getCorrectedAltitudeFt(CFixedLength<Fixed::ft>::fromQuantity(m_cg), enableDragToGround, correction);
+    }
+
+    CFixedLength<Fixed::ft> CAircraftSituation::getCorrectedAltitudeFt(CFixedLength<Fixed::ft> centerOfGravity, bool enableDragToGround, AltitudeCorrection *correction) const
+    {
+        using FixedFt = CFixedLength<Fixed::ft>;
         if (correction) { *correction = UnknownCorrection; }
+        const FixedFt altitude = FixedFt::fromQuantity(this->getAltitude());
         if (!this->hasGroundElevation())
         {
             if (correction) { *correction = NoElevation; }
-            return this->getAltitude();
+            return altitude;
         }
 
         // above ground
@@ -818,39 +843,42 @@ namespace BlackMisc::Aviation
         {
             BLACK_VERIFY_X(false, Q_FUNC_INFO, "Unsupported");
             if (correction) { *correction = AGL; }
-            return this->getAltitude();
+            return altitude;
         }
-        else
+
+        // like CAltitude::withOffset a null CG is no offset
+        FixedFt groundPlusCG = FixedFt::fromQuantity(this->getGroundElevation());
+        if (!centerOfGravity.isNull()) { groundPlusCG += centerOfGravity; }
+        if (groundPlusCG.isNull())
         {
-            const CAltitude groundPlusCG = this->getGroundElevation().withOffset(centerOfGravity).switchedUnit(this->getAltitudeOrDefaultUnit());
-            if (groundPlusCG.isNull())
-            {
-                if (correction) { *correction = NoElevation; }
-                return this->getAltitude();
-            }
-            const CLength groundDistance = this->getAltitude() - groundPlusCG;
-            const bool underflow = groundDistance.isNegativeWithEpsilonConsidered();
-            if (underflow)
-            {
-                if (correction) { *correction = Underflow; }
-                return groundPlusCG;
-            }
-            const bool nearGround =  groundDistance.abs() < deltaNearGround();
-            if (nearGround)
-            {
-                if (correction) { *correction = NoCorrection; }
-                return groundPlusCG;
-            }
-            const bool forceDragToGround = (enableDragToGround && this->getOnGround() == OnGround) && (this->hasInboundGroundDetails() || this->getOnGroundDetails() == OnGroundByGuessing);
-            if (forceDragToGround)
-            {
-                if (correction) { *correction = DraggedToGround; }
-                return groundPlusCG;
-            }
+            if (correction) { *correction = NoElevation; }
+            return altitude;
+        }
 
+        const FixedFt groundDistance = altitude - groundPlusCG;
+        const bool underflow = groundDistance.isNegativeWithEpsilonConsidered();
+        if (underflow)
+        {
+            if (correction) { *correction = Underflow; }
+            return groundPlusCG;
+        }
+
+        static const FixedFt nearGroundDelta = FixedFt::fromQuantity(deltaNearGround());
+        const bool nearGround = groundDistance.abs() < nearGroundDelta;
+        if (nearGround)
+        {
             if (correction) { *correction = NoCorrection; }
-            return this->getAltitude();
+            return groundPlusCG;
         }
+        const bool forceDragToGround = (enableDragToGround && this->getOnGround() == OnGround) && (this->hasInboundGroundDetails() || this->getOnGroundDetails() == OnGroundByGuessing);
+        if (forceDragToGround)
+        {
+            if (correction) { *correction = DraggedToGround; }
+            return groundPlusCG;
+        }
+
+        if (correction) { *correction = NoCorrection; }
+        return altitude;
     }
 
     CAircraftSituation::AltitudeCorrection CAircraftSituation::correctAltitude(bool enableDragToGround)
@@ -929,8 +957,7 @@ namespace BlackMisc::Aviation
 
     bool CAircraftSituation::isMoving() const
     {
-        const double gsKmh = this->getGroundSpeed().value(CSpeedUnit::km_h());
-        return gsKmh >= 2.5;
+        return CFixedSpeed<Fixed::km_h>::fromQuantity(this->getGroundSpeed()) >= CFixedSpeed<Fixed::km_h>(2.5); // false if null
     }
 
     bool CAircraftSituation::canLikelySkipNearGroundInterpolation() const
@@ -943,13 +970,12 @@ namespace BlackMisc::Aviation
         // cases where we can skip
         // Concorde had a take-off speed of 220 knots (250 mph) and
         // landing speed was 187 mph
-        if (this->getGroundSpeed().value(CSpeedUnit::kts()) > 225.0) { return true; }
+        if (CFixedSpeed<Fixed::kts>::fromQuantity(this->getGroundSpeed()) > CFixedSpeed<Fixed::kts>(225.0)) { return true; }
 
         if (this->hasGroundElevation())
         {
-            static const CLength threshold(400, CLengthUnit::m());
-            const CLength aboveGround = this->getHeightAboveGround();
-            if (!aboveGround.isNull() && aboveGround >= threshold) { return true; } // too high for ground
+            static constexpr CFixedLength<Fixed::ft> threshold = CFixedLength<Fixed::m>(400.0).to<Fixed::ft>();
+            if (this->getHeightAboveGroundFt() >= threshold) { return true; } // too high for ground, false if unknown
         }
         return false;
     }
@@ -973,7 +999,7 @@ namespace BlackMisc::Aviation
             return CLength(0, CLengthUnit::nullUnit());
         }
         const double seconds = milliseconds / 1000.0;
-        const double gsMeterSecond = this->getGroundSpeed().value(CSpeedUnit::m_s());
+        const double gsMeterSecond = CFixedSpeed<Fixed::m_s>::fromQuantity(this->getGroundSpeed()).value();
         const CLength d(seconds * gsMeterSecond, CLengthUnit::m());
         if (!min.isNull() && d < min) { return min; }
         return d;
@@ -22,6 +22,7 @@
 #include "blackmisc/geo/longitude.h"
 #include "blackmisc/metaclass.h"
 #include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/speed.h"
 #include "blackmisc/pq/time.h"
@@ -353,6 +354,9 @@ namespace BlackMisc
             //! Height above ground.
             PhysicalQuantities::CLength getHeightAboveGround() const;
 
+            //! Height above ground in ft, null if unknown
+            PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> getHeightAboveGroundFt() const;
+
             //! Get heading
             const CHeading &getHeading() const { return m_heading; }
 
@@ -375,6 +379,13 @@ namespace BlackMisc
             CAltitude getCorrectedAltitude(const PhysicalQuantities::CLength &centerOfGravity, bool enableDragToGround = true, AltitudeCorrection *correction = nullptr) const;
             //! @}
 
+            //! Corrected altitude in ft without runtime unit conversions, getCorrectedAltitude is based on it
+            //! \remark used by the interpolators, null if the altitude is null
+            //! @{
+            PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> getCorrectedAltitudeFt(bool enableDragToGround = true, AltitudeCorrection *correction = nullptr) const;
+            PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> getCorrectedAltitudeFt(PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> centerOfGravity, bool enableDragToGround = true, AltitudeCorrection *correction = nullptr) const;
+            //! @}
+
             //! Set the corrected altitude from CAircraftSituation::getCorrectedAltitude
             //! @{
             AltitudeCorrection correctAltitude(bool enableDragToGround = true);
@@ -566,6 +577,8 @@ namespace BlackMisc
             static void registerMetadata();
 
         private:
+            friend struct CCompactAircraftSituation; //!< converts from and to all members
+
             CCallsign m_correspondingCallsign;
             Geo::CCoordinateGeodetic m_position; //!< NULL position as default
             Geo::CElevationPlane m_groundElevationPlane; //!< NULL elevation as default
@@ -8,6 +8,7 @@
 
 #include "blackmisc/aviation/aircraftsituationchange.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituationringbuffer.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/simulation/aircraftmodel.h"
 #include "blackmisc/pq/length.h"
@@ -88,6 +89,102 @@ namespace BlackMisc::Aviation
         }
     }
 
+    CAircraftSituationChange::CAircraftSituationChange(const CAircraftSituationRingBuffer &situations, const CLength &cg, bool isVtol, bool calcStdDeviations)
+    {
+        const int size = situations.size();
+        if (size < 2) { return; }
+
+        if (CBuildConfig::isLocalDeveloperDebugBuild())
+        {
+            Q_ASSERT_X(situations.isSortedAdjustedLatestFirst(), Q_FUNC_INFO, "Wrong sort order");
+        }
+
+        const CCompactAircraftSituation &latest = situations.compact(0);
+        const CCompactAircraftSituation &oldest = situations.compact(size - 1);
+
+        m_situationsCount = size;
+        m_correspondingCallsign = latest.getCallsign();
+        m_timestampMSecsSinceEpoch = latest.msSinceEpoch;
+        m_timeOffsetMs = latest.timeOffsetMs;
+        m_oldestTimestampMSecsSinceEpoch = oldest.msSinceEpoch;
+        m_latestAdjustedTimestampMSecsSinceEpoch = latest.getAdjustedMSecsSinceEpoch();
+        m_oldestAdjustedTimestampMSecsSinceEpoch = oldest.getAdjustedMSecsSinceEpoch();
+
+        // one pass latest first, same results as the CAircraftSituationList functions used with a list
+        bool nullPosition = false;      // all situations
+        bool nullPositionOlder = false; // without the latest situation
+        bool ascending = true;
+        bool descending = true;
+        bool accelerating = true;
+        bool decelerating = true;
+        bool pushBack = false;
+        int onGroundOlder = 0;
+        int notOnGroundOlder = 0;
+        QList<double> gsKts;
+        QList<double> pitchDeg;
+        QList<double> altValues;
+        QList<double> elvValues;
+        for (int i = 0; i < size; ++i)
+        {
+            const CCompactAircraftSituation &situation = situations.compact(i);
+            if (situation.groundSpeed.isNegativeWithEpsilonConsidered()) { pushBack = true; }
+            if (!situation.groundSpeed.isNull()) { gsKts.push_back(situation.groundSpeed.value()); }
+            pitchDeg.push_back(situation.pitch.value());
+            if (!situation.altitude.isNull()) { altValues.push_back(situation.altitude.value()); }
+            if (!situation.elevation.isNull()) { elvValues.push_back(situation.elevation.value()); }
+            if (situation.isPositionNull())
+            {
+                nullPosition = true;
+                if (i > 0) { nullPositionOlder = true; }
+            }
+            if (i < 1) { continue; }
+
+            const CAircraftSituation::IsOnGround og = static_cast<CAircraftSituation::IsOnGround>(situation.onGround);
+            if (og == CAircraftSituation::OnGround) { onGroundOlder++; }
+            else if (og == CAircraftSituation::NotOnGround) { notOnGroundOlder++; }
+
+            const CCompactAircraftSituation &newer = situations.compact(i - 1);
+            const auto deltaAlt = newer.altitude - situation.altitude;
+            if (!deltaAlt.isPositiveWithEpsilonConsidered()) { ascending = false; }
+            if (!deltaAlt.isNegativeWithEpsilonConsidered()) { descending = false; }
+            if (!newer.groundSpeed.isNull())
+            {
+                const auto deltaGs = newer.groundSpeed - situation.groundSpeed;
+                if (!deltaGs.isPositiveWithEpsilonConsidered()) { accelerating = false; }
+                if (!deltaGs.isNegativeWithEpsilonConsidered()) { decelerating = false; }
+            }
+        }
+
+        const CAircraftSituation::IsOnGround latestOg = static_cast<CAircraftSituation::IsOnGround>(latest.onGround);
+        const int older = size - 1;
+        m_constAscending = !nullPosition && ascending;
+        m_constDescending = !nullPosition && descending;
+        m_constOnGround = !nullPosition && latestOg == CAircraftSituation::OnGround && onGroundOlder == older;
+        m_constNotOnGround = !nullPosition && latestOg == CAircraftSituation::NotOnGround && notOnGroundOlder == older;
+        m_justTakeoff = latestOg == CAircraftSituation::NotOnGround && onGroundOlder == older;
+        m_justTouchdown = latestOg == CAircraftSituation::OnGround && notOnGroundOlder == older;
+        m_constAccelerating = !nullPosition && accelerating;
+        m_constDecelerating = !nullPosition && decelerating;
+        m_containsPushBack = !isVtol && pushBack;
+
+        if (size >= 3)
+        {
+            m_wasNotOnGround = !nullPositionOlder && notOnGroundOlder == older;
+            m_wasOnGround = !nullPositionOlder && onGroundOlder == older;
+        }
+
+        if (calcStdDeviations)
+        {
+            this->calculateStdDeviations(size, gsKts, pitchDeg, altValues, elvValues, cg);
+            m_rotateUp = latest.pitch.toQuantity() > (m_pitchMean + m_pitchStdDev);
+        }
+        else
+        {
+            const QPair<double, double> stdDevAndMean = CMathUtils::standardDeviationAndMean(pitchDeg);
+            m_rotateUp = pitchDeg.front() > stdDevAndMean.first + stdDevAndMean.second;
+        }
+    }
+
     bool CAircraftSituationChange::guessOnGround(CAircraftSituation &situation, const Simulation::CAircraftModel &model) const
     {
         if (!situation.shouldGuessOnGround()) { return false; }
@@ -327,31 +424,51 @@ namespace BlackMisc::Aviation
     bool CAircraftSituationChange::calculateStdDeviations(const CAircraftSituationList &situations, const CLength &cg)
     {
         if (situations.isEmpty()) { return false; }
+        this->calculateStdDeviations(situations.size(), situations.groundSpeedValues(CSpeedUnit::kts()), situations.pitchValues(CAngleUnit::deg()),
+                                     situations.altitudeValues(CAltitude::defaultUnit()), situations.elevationValues(CAltitude::defaultUnit()), cg);
+        return true;
+    }
 
-        const QPair<CSpeed, CSpeed> gsStdDevMean = situations.groundSpeedStandardDeviationAndMean();
-        m_gsStdDev = gsStdDevMean.first;
-        m_gsMean = gsStdDevMean.second;
+    void CAircraftSituationChange::calculateStdDeviations(int situationsCount, const QList<double> &gsKts, const QList<double> &pitchDeg, const QList<double> &altValues, const QList<double> &elvValues, const CLength &cg)
+    {
+        if (gsKts.size() == situationsCount)
+        {
+            const QPair<double, double> gsStdDevMean = CMathUtils::standardDeviationAndMean(gsKts);
+            m_gsStdDev = CSpeed(gsStdDevMean.first, CSpeedUnit::kts());
+            m_gsMean = CSpeed(gsStdDevMean.second, CSpeedUnit::kts());
+        }
+        else
+        {
+            m_gsStdDev = CSpeed::null();
+            m_gsMean = CSpeed::null();
+        }
 
-        const QPair<CAngle, CAngle> pitchStdDevMean = situations.pitchStandardDeviationAndMean();
-        m_pitchStdDev = pitchStdDevMean.first;
-        m_pitchMean = pitchStdDevMean.second;
+        if (pitchDeg.size() == situationsCount)
+        {
+            const QPair<double, double> pitchStdDevMean = CMathUtils::standardDeviationAndMean(pitchDeg);
+            m_pitchStdDev = CAngle(pitchStdDevMean.first, CAngleUnit::deg());
+            m_pitchMean = CAngle(pitchStdDevMean.second, CAngleUnit::deg());
+        }
+        else
+        {
+            m_pitchStdDev = CAngle::null();
+            m_pitchMean = CAngle::null();
+        }
 
-        const QList<double> altValues = situations.altitudeValues(CAltitude::defaultUnit());
-        if (altValues.size() == situations.size())
+        if (altValues.size() == situationsCount)
         {
             const QPair<double, double> altDevMean = CMathUtils::standardDeviationAndMean(altValues);
             m_altStdDev = CAltitude(altDevMean.first, CAltitude::MeanSeaLevel, CAltitude::defaultUnit());
             m_altMean = CAltitude(altDevMean.second, CAltitude::MeanSeaLevel, CAltitude::defaultUnit());
         }
 
-        const QList<double> elvValues = situations.elevationValues(CAltitude::defaultUnit());
-        if (elvValues.size() == situations.size())
+        if (elvValues.size() == situationsCount)
         {
             const QPair<double, double> elvDevMean = CMathUtils::standardDeviationAndMean(elvValues);
             m_elvStdDev = CAltitude(elvDevMean.first, CAltitude::MeanSeaLevel, CAltitude::defaultUnit());
             m_elvMean = CAltitude(elvDevMean.second, CAltitude::MeanSeaLevel, CAltitude::defaultUnit());
 
-            if (altValues.size() == situations.size())
+            if (altValues.size() == situationsCount)
             {
                 QList<double> gndDistance;
                 for (int i = 0; i < altValues.size(); i++)
@@ -371,7 +488,6 @@ namespace BlackMisc::Aviation
                 this->guessSceneryDeviation(cg);
             }
         }
-        return true;
     }
 
     const CAircraftSituationChange &CAircraftSituationChange::null()
@@ -21,6 +21,8 @@
 #include "blackmisc/propertyindexref.h"
 #include "blackmisc/blackmiscexport.h"
 
+#include <QList>
+
 BLACK_DECLARE_VALUEOBJECT_MIXINS(BlackMisc::Aviation, CAircraftSituationChange)
 
 namespace BlackMisc
@@ -33,6 +35,7 @@ namespace BlackMisc
     {
         class CAircraftSituation;
         class CAircraftSituationList;
+        class CAircraftSituationRingBuffer;
 
         //! Value object about changes in situations
         class BLACKMISC_EXPORT CAircraftSituationChange :
@@ -76,6 +79,10 @@ namespace BlackMisc
             //! \remark the timestamps of the latest situation will be used
             CAircraftSituationChange(const CAircraftSituationList &situations, const PhysicalQuantities::CLength &cg, bool isVtol, bool alreadySortedLatestFirst = false, bool calcStdDeviations = false);
 
+            //! Ctor with the situation history of an aircraft
+            //! \remark same values as with the situations as list, but evaluated on the compact situations without creating the list
+            CAircraftSituationChange(const CAircraftSituationRingBuffer &situations, const PhysicalQuantities::CLength &cg, bool isVtol, bool calcStdDeviations = false);
+
             //! Get callsign
             const CCallsign &getCallsign() const { return m_correspondingCallsign; }
 
@@ -199,6 +206,10 @@ namespace BlackMisc
             //! Guess scenery deviation
             void guessSceneryDeviation(const PhysicalQuantities::CLength &cg);
 
+            //! Calculate the standard deviations from the values of n situations
+            //! \remark values like the value functions of CAircraftSituationList, e.g. CAircraftSituationList::altitudeValues
+            void calculateStdDeviations(int situationsCount, const QList<double> &gsKts, const QList<double> &pitchDeg, const QList<double> &altValues, const QList<double> &elvValues, const PhysicalQuantities::CLength &cg);
+
             int m_situationsCount = -1;
             CCallsign m_correspondingCallsign;
             // latest -> m_timestampMSecsSinceEpoch
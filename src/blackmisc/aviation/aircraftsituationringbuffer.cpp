@@ -0,0 +1,251 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/aircraftsituationringbuffer.h"
+#include "blackmisc/aviation/aircraftparts.h"
+#include "blackmisc/verify.h"
+#include "blackconfig/buildconfig.h"
+
+#include <limits>
+
+using namespace BlackConfig;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Aviation
+{
+    CAircraftSituationRingBuffer::CAircraftSituationRingBuffer(int capacity) : m_buffer(static_cast<size_t>(qMax(2, capacity)))
+    {
+        Q_ASSERT_X(capacity > 1, Q_FUNC_INFO, "Capacity wrong range");
+    }
+
+    void CAircraftSituationRingBuffer::clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+
+    CAircraftSituation CAircraftSituationRingBuffer::frontOrNull() const
+    {
+        return this->indexOrNull(0);
+    }
+
+    CAircraftSituation CAircraftSituationRingBuffer::indexOrNull(int index) const
+    {
+        if (index < 0 || index >= m_size) { return CAircraftSituation::null(); }
+        return (*this)[index];
+    }
+
+    void CAircraftSituationRingBuffer::set(int index, const CAircraftSituation &situation)
+    {
+        this->compactRef(index) = CCompactAircraftSituation::fromSituation(situation);
+    }
+
+    void CAircraftSituationRingBuffer::push_frontKeepLatestFirstAdjustOffset(const CAircraftSituation &situation, bool replaceSameTimestamp)
+    {
+        const CCompactAircraftSituation newSituation = CCompactAircraftSituation::fromSituation(situation);
+        if (replaceSameTimestamp && !this->isEmpty() && this->compact(0).msSinceEpoch == newSituation.msSinceEpoch)
+        {
+            this->compactRef(0) = newSituation;
+        }
+        else if (this->isEmpty() || newSituation.msSinceEpoch >= this->compact(0).msSinceEpoch)
+        {
+            // normal case, the slot in front of the head is the oldest situation if full
+            m_head = this->slotBeforeHead();
+            m_buffer[static_cast<size_t>(m_head)] = newSituation;
+            if (!this->isFull()) { m_size++; }
+        }
+        else
+        {
+            // out of order, drop the oldest and insert at the sorted position
+            if (this->isFull()) { m_size--; }
+            int index = 1;
+            while (index < m_size && newSituation.msSinceEpoch < this->compact(index).msSinceEpoch) { index++; }
+            this->insert(index, newSituation);
+        }
+
+        // same offset adjustment as ITimestampWithOffsetObjectList::push_frontKeepLatestFirstAdjustOffset
+        if (m_size < 2) { return; }
+        CCompactAircraftSituation &front = this->compactRef(0);
+        const CCompactAircraftSituation &second = this->compact(1);
+        if (front.getAdjustedMSecsSinceEpoch() <= second.getAdjustedMSecsSinceEpoch())
+        {
+            const qint64 minReqOs = second.getAdjustedMSecsSinceEpoch() - front.msSinceEpoch; // minimal required
+            const qint64 avgOs = (front.timeOffsetMs + second.timeOffsetMs) / 2;
+            const qint64 os = qMax(minReqOs + 1, avgOs); // at least +1, as value must be > (greater)
+            front.timeOffsetMs = os;
+        }
+
+        if (CBuildConfig::isLocalDeveloperDebugBuild())
+        {
+            BLACK_VERIFY_X(this->isSortedLatestFirst(), Q_FUNC_INFO, "Wrong sort order");
+            BLACK_VERIFY_X(front.getAdjustedMSecsSinceEpoch() > second.getAdjustedMSecsSinceEpoch(), Q_FUNC_INFO, "Front/second timestamp");
+        }
+    }
+
+    void CAircraftSituationRingBuffer::prefillLatestAdjustedFirst(const CAircraftSituation &situation, int elements, qint64 deltaTimeMs)
+    {
+        this->clear();
+        const qint64 osTime = situation.getTimeOffsetMs();
+        const qint64 os = -1 * qAbs(deltaTimeMs < 0 ? osTime : deltaTimeMs);
+        if (CBuildConfig::isLocalDeveloperDebugBuild())
+        {
+            BLACK_VERIFY_X(os < 0, Q_FUNC_INFO, "Need negative offset time to prefill time");
+        }
+
+        const CCompactAircraftSituation prefill = CCompactAircraftSituation::fromSituation(situation);
+        const int n = qMin(elements, this->capacity());
+        for (int i = 0; i < n; i++)
+        {
+            CCompactAircraftSituation &s = m_buffer[static_cast<size_t>(i)];
+            s = prefill;
+            s.msSinceEpoch += os * i;
+        }
+        m_size = qMax(n, 0);
+    }
+
+    void CAircraftSituationRingBuffer::assignLatestFirst(const CAircraftSituationList &situations)
+    {
+        this->clear();
+        for (const CAircraftSituation &situation : situations)
+        {
+            if (this->isFull()) { break; }
+            m_buffer[static_cast<size_t>(m_size++)] = CCompactAircraftSituation::fromSituation(situation);
+        }
+    }
+
+    CAircraftSituationList CAircraftSituationRingBuffer::toList() const
+    {
+        CAircraftSituationList situations;
+        for (const CCompactAircraftSituation &situation : *this) { situations.push_back(situation.toSituation()); }
+        situations.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
+        return situations;
+    }
+
+    CCompactAircraftSituationList CAircraftSituationRingBuffer::toCompactList() const
+    {
+        CCompactAircraftSituationList situations;
+        situations.reserve(m_size);
+        for (const CCompactAircraftSituation &situation : *this) { situations.push_back(situation); }
+        return situations;
+    }
+
+    CAircraftSituation CAircraftSituationRingBuffer::findObjectBeforeAdjustedOrDefault(qint64 msSinceEpoch) const
+    {
+        const CCompactAircraftSituation *found = nullptr;
+        for (const CCompactAircraftSituation &situation : *this)
+        {
+            if (situation.getAdjustedMSecsSinceEpoch() >= msSinceEpoch) { continue; }
+            if (!found || situation.getAdjustedMSecsSinceEpoch() > found->getAdjustedMSecsSinceEpoch()) { found = &situation; }
+        }
+        return found ? found->toSituation() : CAircraftSituation();
+    }
+
+    CAircraftSituation CAircraftSituationRingBuffer::findObjectAfterAdjustedOrDefault(qint64 msSinceEpoch) const
+    {
+        const CCompactAircraftSituation *found = nullptr;
+        for (const CCompactAircraftSituation &situation : *this)
+        {
+            if (situation.getAdjustedMSecsSinceEpoch() <= msSinceEpoch) { continue; }
+            if (!found || situation.getAdjustedMSecsSinceEpoch() < found->getAdjustedMSecsSinceEpoch()) { found = &situation; }
+        }
+        return found ? found->toSituation() : CAircraftSituation();
+    }
+
+    bool CAircraftSituationRingBuffer::isSortedLatestFirst() const
+    {
+        if (m_size < 2) { return true; }
+        qint64 min = std::numeric_limits<qint64>::max();
+        for (const CCompactAircraftSituation &situation : *this)
+        {
+            if (!situation.hasValidTimestamp()) { return false; }
+            if (situation.msSinceEpoch > min) { return false; }
+            min = situation.msSinceEpoch;
+        }
+        return true;
+    }
+
+    bool CAircraftSituationRingBuffer::isSortedAdjustedLatestFirst() const
+    {
+        if (m_size < 2) { return true; }
+        qint64 min = std::numeric_limits<qint64>::max();
+        for (const CCompactAircraftSituation &situation : *this)
+        {
+            if (!situation.hasValidTimestamp()) { return false; }
+            if (situation.getAdjustedMSecsSinceEpoch() > min) { return false; }
+            min = situation.getAdjustedMSecsSinceEpoch();
+        }
+        return true;
+    }
+
+    int CAircraftSituationRingBuffer::transferElevationForward(const CLength &radius)
+    {
+        // each situation is the source once and the target in the next step, so it is decoded once
+        int c = 0;
+        CAircraftSituation decoded;
+        int decodedIndex = -1;
+        for (int i = 1; i < m_size; ++i)
+        {
+            const CCompactAircraftSituation &oldCompact = this->compact(i);
+            const CCompactAircraftSituation &newCompact = this->compact(i - 1);
+
+            // same preconditions as CAircraftSituation::canTransferGroundElevation, without decoding
+            const bool skip = oldCompact.elevation.isNull() ||
+                              newCompact.elvInfo == CAircraftSituation::FromProvider ||
+                              (oldCompact.elvInfo != CAircraftSituation::FromProvider && newCompact.elvInfo == CAircraftSituation::FromCache);
+            if (skip) { continue; }
+
+            CAircraftSituation newSituation = (decodedIndex == i - 1) ? decoded : newCompact.toSituation();
+            const CAircraftSituation oldSituation = oldCompact.toSituation();
+            if (oldSituation.transferGroundElevationFromMe(newSituation, radius))
+            {
+                this->set(i - 1, newSituation);
+                c++;
+            }
+            decoded = oldSituation;
+            decodedIndex = i;
+        }
+        return c;
+    }
+
+    int CAircraftSituationRingBuffer::setOnGroundDetails(CAircraftSituation::OnGroundDetails details)
+    {
+        int c = 0;
+        for (int i = 0; i < m_size; ++i)
+        {
+            CCompactAircraftSituation &situation = this->compactRef(i);
+            if (situation.onGroundDetails == static_cast<quint32>(details)) { continue; }
+            situation.onGroundDetails = static_cast<quint32>(details);
+            c++;
+        }
+        return c;
+    }
+
+    int CAircraftSituationRingBuffer::adjustGroundFlag(const CAircraftParts &parts, double timeDeviationFactor)
+    {
+        int c = 0;
+        for (int i = 0; i < m_size; ++i)
+        {
+            CCompactAircraftSituation &stored = this->compactRef(i);
+            stored.onGroundDetails = CAircraftSituation::InFromParts;
+
+            CAircraftSituation situation = stored.toSituation();
+            if (!situation.adjustGroundFlag(parts, true, timeDeviationFactor)) { continue; }
+            stored = CCompactAircraftSituation::fromSituation(situation);
+            c++;
+        }
+        return c;
+    }
+
+    void CAircraftSituationRingBuffer::insert(int index, const CCompactAircraftSituation &situation)
+    {
+        Q_ASSERT_X(index > 0 && index <= m_size && !this->isFull(), Q_FUNC_INFO, "Wrong index");
+        m_size++;
+        for (int i = m_size - 1; i > index; --i) { this->compactRef(i) = this->compact(i - 1); }
+        this->compactRef(index) = situation;
+    }
+} // namespace
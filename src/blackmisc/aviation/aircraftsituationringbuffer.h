@@ -0,0 +1,195 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_AIRCRAFTSITUATIONRINGBUFFER_H
+#define BLACKMISC_AVIATION_AIRCRAFTSITUATIONRINGBUFFER_H
+
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/compactaircraftsituation.h"
+#include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QtGlobal>
+#include <iterator>
+#include <vector>
+
+namespace BlackMisc::Aviation
+{
+    class CAircraftParts;
+
+    //! History of the latest situations of one aircraft with a fixed capacity.
+    //! \details Situations are kept latest first, like in a CAircraftSituationList sorted by
+    //!          CAircraftSituationList::AdjustedTimestampLatestFirst. The storage is allocated once,
+    //!          adding the latest situation overwrites the oldest one in O(1).
+    //!          Situations are stored as CCompactAircraftSituation, the value objects are created on access.
+    //! \remark not thread safe, and no value object, use toList() or toCompactList() to pass situations on
+    class BLACKMISC_EXPORT CAircraftSituationRingBuffer
+    {
+    public:
+        //! Const iterator over the compact situations, latest first
+        class const_iterator
+        {
+        public:
+            //! \cond PRIVATE
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = CCompactAircraftSituation;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const CCompactAircraftSituation *;
+            using reference = const CCompactAircraftSituation &;
+
+            const_iterator() = default;
+            const_iterator(const CAircraftSituationRingBuffer *buffer, int index) : m_buffer(buffer), m_index(index) {}
+
+            reference operator *() const { return m_buffer->compact(m_index); }
+            pointer operator ->() const { return &m_buffer->compact(m_index); }
+            reference operator [](difference_type n) const { return m_buffer->compact(m_index + static_cast<int>(n)); }
+
+            const_iterator &operator ++() { ++m_index; return *this; }
+            const_iterator operator ++(int) { const_iterator copy(*this); ++m_index; return copy; }
+            const_iterator &operator --() { --m_index; return *this; }
+            const_iterator operator --(int) { const_iterator copy(*this); --m_index; return copy; }
+            const_iterator &operator +=(difference_type n) { m_index += static_cast<int>(n); return *this; }
+            const_iterator &operator -=(difference_type n) { m_index -= static_cast<int>(n); return *this; }
+            friend const_iterator operator +(const_iterator it, difference_type n) { return it += n; }
+            friend const_iterator operator +(difference_type n, const_iterator it) { return it += n; }
+            friend const_iterator operator -(const_iterator it, difference_type n) { return it -= n; }
+            friend difference_type operator -(const const_iterator &a, const const_iterator &b) { return a.m_index - b.m_index; }
+
+            friend bool operator ==(const const_iterator &a, const const_iterator &b) { return a.m_index == b.m_index; }
+            friend bool operator !=(const const_iterator &a, const const_iterator &b) { return a.m_index != b.m_index; }
+            friend bool operator <(const const_iterator &a, const const_iterator &b)  { return a.m_index <  b.m_index; }
+            friend bool operator >(const const_iterator &a, const const_iterator &b)  { return a.m_index >  b.m_index; }
+            friend bool operator <=(const const_iterator &a, const const_iterator &b) { return a.m_index <= b.m_index; }
+            friend bool operator >=(const const_iterator &a, const const_iterator &b) { return a.m_index >= b.m_index; }
+            //! \endcond
+
+        private:
+            const CAircraftSituationRingBuffer *m_buffer = nullptr;
+            int m_index = 0;
+        };
+
+        //! Constructor, the capacity is allocated once
+        explicit CAircraftSituationRingBuffer(int capacity);
+
+        //! Max. number of situations
+        int capacity() const { return static_cast<int>(m_buffer.size()); }
+
+        //! Number of situations
+        int size() const { return m_size; }
+
+        //! No situations?
+        bool isEmpty() const { return m_size < 1; }
+
+        //! Capacity reached?
+        bool isFull() const { return m_size >= this->capacity(); }
+
+        //! Remove all situations, the storage is kept
+        void clear();
+
+        //! Compact situation by index
+        //! \param index 0..latest, 1..next older, ...
+        const CCompactAircraftSituation &compact(int index) const { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "Index out of range"); return m_buffer[this->slot(index)]; }
+
+        //! Situation by index
+        //! \param index 0..latest, 1..next older, ...
+        CAircraftSituation operator [](int index) const { return this->compact(index).toSituation(); }
+
+        //! Replace the situation at index, the timestamp has to keep the sort order
+        void set(int index, const CAircraftSituation &situation);
+
+        //! Latest situation
+        CAircraftSituation front() const { return (*this)[0]; }
+
+        //! Replace the latest situation
+        void setFront(const CAircraftSituation &situation) { this->set(0, situation); }
+
+        //! Oldest situation
+        CAircraftSituation back() const { return (*this)[m_size - 1]; }
+
+        //! Latest situation or NULL
+        CAircraftSituation frontOrNull() const;
+
+        //! Situation by index or NULL
+        CAircraftSituation indexOrNull(int index) const;
+
+        //! Iterators over the compact situations, latest first
+        //! @{
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end() const { return { this, m_size }; }
+        const_iterator cbegin() const { return { this, 0 }; }
+        const_iterator cend() const { return { this, m_size }; }
+        //! @}
+
+        //! Insert by keeping the latest first, the oldest situation is dropped if the capacity is reached
+        //! \remark O(1) for the normal case of a situation newer than all others
+        //! \remark adjusts the offset so adjusted values are sorted
+        //! \sa ITimestampWithOffsetObjectList::push_frontKeepLatestFirstAdjustOffset
+        void push_frontKeepLatestFirstAdjustOffset(const CAircraftSituation &situation, bool replaceSameTimestamp = true);
+
+        //! Prefill with elements in the past
+        //! \sa ITimestampWithOffsetObjectList::prefillLatestAdjustedFirst
+        void prefillLatestAdjustedFirst(const CAircraftSituation &situation, int elements, qint64 deltaTimeMs = -1);
+
+        //! Replace all situations, situations have to be sorted latest first
+        void assignLatestFirst(const CAircraftSituationList &situations);
+
+        //! Situations as list, latest first
+        //! \remark sort hint of the list is set to CAircraftSituationList::AdjustedTimestampLatestFirst
+        CAircraftSituationList toList() const;
+
+        //! Compact situations, latest first
+        CCompactAircraftSituationList toCompactList() const;
+
+        //! Latest situation older than the adjusted time, or default
+        CAircraftSituation findObjectBeforeAdjustedOrDefault(qint64 msSinceEpoch) const;
+
+        //! Oldest situation newer than the adjusted time, or default
+        CAircraftSituation findObjectAfterAdjustedOrDefault(qint64 msSinceEpoch) const;
+
+        //! Sorted by timestamp, latest first?
+        bool isSortedLatestFirst() const;
+
+        //! Sorted by adjusted timestamp, latest first?
+        bool isSortedAdjustedLatestFirst() const;
+
+        //! \copydoc CAircraftSituationList::transferElevationForward
+        int transferElevationForward(const PhysicalQuantities::CLength &radius = Geo::CElevationPlane::singlePointRadius());
+
+        //! \copydoc CAircraftSituationList::setOnGroundDetails
+        int setOnGroundDetails(CAircraftSituation::OnGroundDetails details);
+
+        //! \copydoc CAircraftSituationList::adjustGroundFlag
+        int adjustGroundFlag(const CAircraftParts &parts, double timeDeviationFactor = 0.1);
+
+    private:
+        //! Storage slot for index
+        int slot(int index) const
+        {
+            const int s = m_head + index;
+            return s >= this->capacity() ? s - this->capacity() : s;
+        }
+
+        //! Slot in front of the latest situation
+        int slotBeforeHead() const { return m_head > 0 ? m_head - 1 : this->capacity() - 1; }
+
+        //! Compact situation by index
+        CCompactAircraftSituation &compactRef(int index) { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "Index out of range"); return m_buffer[this->slot(index)]; }
+
+        //! Insert at index, the index has to be valid for the new size
+        void insert(int index, const CCompactAircraftSituation &situation);
+
+        std::vector<CCompactAircraftSituation> m_buffer; //!< storage, allocated once
+        int m_head = 0; //!< slot of the latest situation
+        int m_size = 0; //!< number of situations
+    };
+} // namespace
+
+#endif // guard
@@ -7,6 +7,7 @@
  */
 
 #include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/internedcallsigns.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/stringutils.h"
 #include "blackmisc/statusmessagelist.h"
@@ -23,15 +24,21 @@ namespace BlackMisc::Aviation
 {
     CCallsign::CCallsign(const QString &callsign, CCallsign::TypeHint hint)
         : m_callsignAsSet(callsign.trimmed()), m_callsign(CCallsign::unifyCallsign(callsign, hint)), m_typeHint(hint)
-    {}
+    {
+        this->updateHandle();
+    }
 
     CCallsign::CCallsign(const QString &callsign, const QString &telephonyDesignator, CCallsign::TypeHint hint)
         : m_callsignAsSet(callsign.trimmed()), m_callsign(CCallsign::unifyCallsign(callsign, hint)), m_telephonyDesignator(telephonyDesignator.trimmed()), m_typeHint(hint)
-    {}
+    {
+        this->updateHandle();
+    }
 
     CCallsign::CCallsign(const char *callsign, CCallsign::TypeHint hint)
         : m_callsignAsSet(callsign), m_callsign(CCallsign::unifyCallsign(callsign, hint)), m_typeHint(hint)
-    {}
+    {
+        this->updateHandle();
+    }
 
     void CCallsign::registerMetadata()
     {
@@ -50,6 +57,36 @@ namespace BlackMisc::Aviation
         *this = CCallsign();
     }
 
+    void CCallsign::unmarshallFromDbus(const QDBusArgument &argument)
+    {
+        CValueObject::unmarshallFromDbus(argument);
+        this->updateHandle();
+    }
+
+    void CCallsign::unmarshalFromDataStream(QDataStream &stream)
+    {
+        CValueObject::unmarshalFromDataStream(stream);
+        this->updateHandle();
+    }
+
+    void CCallsign::convertFromJson(const QJsonObject &json)
+    {
+        CValueObject::convertFromJson(json);
+        this->updateHandle();
+    }
+
+    void CCallsign::convertFromJson(const QString &jsonString, bool acceptCacheFormat)
+    {
+        CValueObject::convertFromJson(jsonString, acceptCacheFormat);
+        this->updateHandle();
+    }
+
+    void CCallsign::updateHandle()
+    {
+        m_handle = CInternedCallsigns::InvalidHandle; // otherwise the old handle would be returned
+        m_handle = CInternedCallsigns::handle(*this);
+    }
+
     int CCallsign::suffixToSortOrder(const QString &suffix)
     {
         if (QStringView(u"FSS")  == suffix) { return 1; }
@@ -159,12 +196,14 @@ namespace BlackMisc::Aviation
     {
         m_callsignAsSet = "BROADCAST";
         m_callsign = "BROADCAST";
+        this->updateHandle();
     }
 
     void CCallsign::markAsWallopCallsign()
     {
         m_callsignAsSet = "SUP";
         m_callsign = "SUP";
+        this->updateHandle();
     }
 
     bool CCallsign::isMaybeCopilotCallsign(const CCallsign &pilotCallsign) const
@@ -346,7 +385,7 @@ namespace BlackMisc::Aviation
         const ColumnIndex i = index.frontCasted<ColumnIndex>();
         switch (i)
         {
-        case IndexCallsignString:      m_callsign = unifyCallsign(variant.toString()); break;
+        case IndexCallsignString:      m_callsign = unifyCallsign(variant.toString()); this->updateHandle(); break;
         case IndexCallsignStringAsSet: m_callsignAsSet = variant.toString(); break;
         case IndexTelephonyDesignator: m_telephonyDesignator = variant.toString(); break;
         default:
@@ -30,6 +30,8 @@ namespace BlackMisc
 
     namespace Aviation
     {
+        class CInternedCallsigns;
+
         //! Value object encapsulating information of a callsign.
         class BLACKMISC_EXPORT CCallsign : public CValueObject<CCallsign>
         {
@@ -103,6 +105,11 @@ namespace BlackMisc
             //! Get callsign.
             const QString &getStringAsSet() const { return m_callsignAsSet; }
 
+            //! Handle of the interned callsign, 0 for an empty callsign
+            //! \remark the handle is assigned whenever the callsign string is set, so it can be used as array index
+            //! \sa CInternedCallsigns
+            quint32 getHandle() const { return m_handle; }
+
             //! The callsign string used with FSD
             QString getFsdCallsignString() const;
 
@@ -173,6 +180,18 @@ namespace BlackMisc
             //! \copydoc BlackMisc::Mixin::String::toQString()
             QString convertToQString(bool i18n = false) const;
 
+            //! \copydoc BlackMisc::Mixin::DBusByMetaClass::unmarshallFromDbus
+            void unmarshallFromDbus(const QDBusArgument &argument);
+
+            //! \copydoc BlackMisc::Mixin::DataStreamByMetaClass::unmarshalFromDataStream
+            void unmarshalFromDataStream(QDataStream &stream);
+
+            //! \copydoc BlackMisc::Mixin::JsonByMetaClass::convertFromJson
+            //! @{
+            void convertFromJson(const QJsonObject &json);
+            void convertFromJson(const QString &jsonString, bool acceptCacheFormat = false);
+            //! @}
+
             //! Clear this callsign
             void clear();
 
@@ -226,10 +245,16 @@ namespace BlackMisc
             static void registerMetadata();
 
         private:
+            friend class CInternedCallsigns;
+
+            //! Intern the callsign string, needed whenever m_callsign changes
+            void updateHandle();
+
             QString  m_callsignAsSet;
             QString  m_callsign;
             QString  m_telephonyDesignator;
             TypeHint m_typeHint = NoHint;
+            quint32  m_handle = 0; //!< interned callsign, not part of the metaclass
 
             BLACK_METACLASS(
                 CCallsign,
@@ -0,0 +1,46 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/callsigntimeouts.h"
+
+namespace BlackMisc::Aviation
+{
+    void CCallsignTimeouts::touch(const CCallsign &callsign, qint64 timestampMs)
+    {
+        if (m_timestamps.value(callsign, -1) == timestampMs) { return; } // already queued
+        m_timestamps.insert(callsign, timestampMs);
+        m_queue.enqueue({ callsign, timestampMs });
+    }
+
+    int CCallsignTimeouts::remove(const CCallsign &callsign)
+    {
+        // the queued activities are skipped when reached
+        return m_timestamps.remove(callsign);
+    }
+
+    void CCallsignTimeouts::clear()
+    {
+        m_timestamps.clear();
+        m_queue.clear();
+    }
+
+    QList<CCallsign> CCallsignTimeouts::takeTimedOut(qint64 timeoutMsSinceEpoch, QList<qint64> *lastActivitiesMs)
+    {
+        QList<CCallsign> timedOut;
+        if (lastActivitiesMs) { lastActivitiesMs->clear(); }
+        while (!m_queue.isEmpty() && m_queue.head().timestampMs <= timeoutMsSinceEpoch)
+        {
+            const Activity activity = m_queue.dequeue();
+            if (m_timestamps.value(activity.callsign, -1) != activity.timestampMs) { continue; } // superseded or removed
+            m_timestamps.remove(activity.callsign);
+            timedOut.push_back(activity.callsign);
+            if (lastActivitiesMs) { lastActivitiesMs->push_back(activity.timestampMs); }
+        }
+        return timedOut;
+    }
+} // namespace
@@ -0,0 +1,72 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_CALLSIGNTIMEOUTS_H
+#define BLACKMISC_AVIATION_CALLSIGNTIMEOUTS_H
+
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/percallsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QList>
+#include <QQueue>
+#include <QtGlobal>
+
+namespace BlackMisc::Aviation
+{
+    //! Last activity per callsign, used to find callsigns which timed out.
+    //! \details Each activity is also queued, the queue is in the order of the timestamps. Finding the timed out
+    //!          callsigns only visits the queued activities older than the timeout, not all callsigns.
+    //!          An activity superseded by a newer activity of the same callsign is skipped when it is reached.
+    //! \remark timestamps are expected in ascending order, as with the current time
+    class BLACKMISC_EXPORT CCallsignTimeouts
+    {
+    public:
+        //! Activity of the callsign
+        void touch(const CCallsign &callsign, qint64 timestampMs);
+
+        //! Remove the callsign
+        //! \return number of removed callsigns
+        int remove(const CCallsign &callsign);
+
+        //! Remove all callsigns
+        void clear();
+
+        //! Known callsign?
+        bool contains(const CCallsign &callsign) const { return m_timestamps.contains(callsign); }
+
+        //! Last activity of the callsign, -1 if unknown
+        qint64 lastActivity(const CCallsign &callsign) const { return m_timestamps.value(callsign, -1); }
+
+        //! Number of callsigns
+        int size() const { return m_timestamps.size(); }
+
+        //! Number of queued activities, including superseded ones
+        int queuedActivities() const { return m_queue.size(); }
+
+        //! Remove and return the callsigns without activity since the timestamp
+        //! \param timeoutMsSinceEpoch callsigns with an older last activity have timed out
+        //! \param lastActivitiesMs if given, the last activities of the returned callsigns in the same order
+        QList<CCallsign> takeTimedOut(qint64 timeoutMsSinceEpoch, QList<qint64> *lastActivitiesMs = nullptr);
+
+    private:
+        //! Queued activity
+        struct Activity
+        {
+            CCallsign callsign;
+            qint64 timestampMs = -1;
+        };
+
+        CTimestampPerCallsign m_timestamps; //!< last activity per callsign
+        QQueue<Activity> m_queue;           //!< activities, oldest first
+    };
+} // namespace
+
+#endif // guard
@@ -0,0 +1,184 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/compactaircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituation.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+
+#include <limits>
+
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Aviation
+{
+    namespace
+    {
+        //! Altitude with datum and type, also for NULL altitudes
+        CAltitude toAltitude(CFixedLength<Fixed::ft> altitude, quint32 datum, quint32 type)
+        {
+            return CAltitude(altitude.isNull() ? 0.0 : altitude.value(), static_cast<CAltitude::ReferenceDatum>(datum), static_cast<CAltitude::AltitudeType>(type),
+                             altitude.isNull() ? CLengthUnit::nullUnit() : Fixed::ft::unit());
+        }
+    }
+
+    CCompactAircraftSituation::CCompactAircraftSituation() :
+        altitudeDatum(CAltitude::MeanSeaLevel), altitudeType(CAltitude::TrueAltitude),
+        pressureAltitudeDatum(CAltitude::MeanSeaLevel), pressureAltitudeType(CAltitude::TrueAltitude),
+        elevationDatum(CAltitude::MeanSeaLevel), elevationType(CAltitude::TrueAltitude),
+        headingNorth(CHeading::True),
+        onGround(CAircraftSituation::OnGroundSituationUnknown), onGroundDetails(CAircraftSituation::NotSetGroundDetails), elvInfo(CAircraftSituation::NoElevationInfo),
+        hasVelocity(false), isInterim(false), isElvInfoTransferred(false)
+    { }
+
+    CCompactAircraftSituation CCompactAircraftSituation::fromSituation(const CAircraftSituation &situation)
+    {
+        CCompactAircraftSituation c;
+        c.callsign = CInternedCallsigns::handle(situation.m_correspondingCallsign);
+
+        const std::array<double, 3> normal = situation.m_position.normalVectorDouble();
+        const CAltitude &altitude = situation.m_position.geodeticHeight();
+        c.normalX = normal[0];
+        c.normalY = normal[1];
+        c.normalZ = normal[2];
+        c.altitude = CFixedLength<Fixed::ft>::fromQuantity(altitude);
+        c.altitudeDatum = altitude.getReferenceDatum();
+        c.altitudeType = altitude.getAltitudeType();
+
+        c.pressureAltitude = CFixedLength<Fixed::ft>::fromQuantity(situation.m_pressureAltitude);
+        c.pressureAltitudeDatum = situation.m_pressureAltitude.getReferenceDatum();
+        c.pressureAltitudeType = situation.m_pressureAltitude.getAltitudeType();
+
+        c.heading = CFixedAngle<Fixed::deg>::fromQuantity(situation.m_heading);
+        c.headingNorth = situation.m_heading.getReferenceNorth();
+        c.pitch = CFixedAngle<Fixed::deg>::fromQuantity(situation.m_pitch);
+        c.bank = CFixedAngle<Fixed::deg>::fromQuantity(situation.m_bank);
+        c.groundSpeed = CFixedSpeed<Fixed::kts>::fromQuantity(situation.m_groundSpeed);
+        c.cg = CFixedLength<Fixed::ft>::fromQuantity(situation.m_cg);
+        c.sceneryOffset = CFixedLength<Fixed::ft>::fromQuantity(situation.m_sceneryOffset);
+
+        const CElevationPlane &plane = situation.m_groundElevationPlane;
+        const std::array<double, 3> elvNormal = plane.normalVectorDouble();
+        c.elevationNormalX = elvNormal[0];
+        c.elevationNormalY = elvNormal[1];
+        c.elevationNormalZ = elvNormal[2];
+        c.elevation = CFixedLength<Fixed::ft>::fromQuantity(plane.geodeticHeight());
+        c.elevationDatum = plane.geodeticHeight().getReferenceDatum();
+        c.elevationType = plane.geodeticHeight().getAltitudeType();
+        c.elevationRadius = CFixedLength<Fixed::m>::fromQuantity(plane.getRadius());
+
+        // in the units of CAircraftVelocity, so no conversion takes place
+        const CAircraftVelocity &velocity = situation.m_velocity;
+        c.hasVelocity = situation.m_hasVelocity;
+        c.velocityX = velocity.getVelocityX(CAircraftVelocity::c_xyzSpeedUnit);
+        c.velocityY = velocity.getVelocityY(CAircraftVelocity::c_xyzSpeedUnit);
+        c.velocityZ = velocity.getVelocityZ(CAircraftVelocity::c_xyzSpeedUnit);
+        c.velocityPitch = velocity.getPitchVelocity(CAircraftVelocity::c_pbhAngleUnit, CAircraftVelocity::c_timeUnit);
+        c.velocityRoll = velocity.getRollVelocity(CAircraftVelocity::c_pbhAngleUnit, CAircraftVelocity::c_timeUnit);
+        c.velocityHeading = velocity.getHeadingVelocity(CAircraftVelocity::c_pbhAngleUnit, CAircraftVelocity::c_timeUnit);
+
+        c.onGround = static_cast<quint32>(situation.m_onGround);
+        c.onGroundDetails = static_cast<quint32>(situation.m_onGroundDetails);
+        c.elvInfo = static_cast<quint32>(situation.m_elvInfo);
+        c.isElvInfoTransferred = situation.m_isElvInfoTransferred;
+        c.isInterim = situation.m_isInterim;
+        c.onGroundFactor = situation.m_onGroundFactor;
+        c.msSinceEpoch = situation.getMSecsSinceEpoch();
+        c.timeOffsetMs = situation.getTimeOffsetMs();
+        return c;
+    }
+
+    CAircraftSituation CCompactAircraftSituation::toSituation() const
+    {
+        CAircraftSituation s;
+        s.m_correspondingCallsign = this->getCallsign();
+        s.m_position.setNormalVector(normalX, normalY, normalZ);
+        s.m_position.setGeodeticHeight(toAltitude(altitude, altitudeDatum, altitudeType));
+        s.m_pressureAltitude = toAltitude(pressureAltitude, pressureAltitudeDatum, pressureAltitudeType);
+        s.m_heading = CHeading(heading.isNull() ? 0.0 : heading.value(), static_cast<CHeading::ReferenceNorth>(headingNorth),
+                               heading.isNull() ? CAngleUnit::nullUnit() : Fixed::deg::unit());
+        s.m_pitch = pitch.toQuantity();
+        s.m_bank = bank.toQuantity();
+        s.m_groundSpeed = groundSpeed.toQuantity();
+        s.m_cg = cg.toQuantity();
+        s.m_sceneryOffset = sceneryOffset.toQuantity();
+
+        s.m_groundElevationPlane.setNormalVector(elevationNormalX, elevationNormalY, elevationNormalZ);
+        s.m_groundElevationPlane.setGeodeticHeight(toAltitude(elevation, elevationDatum, elevationType));
+        s.m_groundElevationPlane.setRadius(elevationRadius.toQuantity());
+
+        s.m_hasVelocity = hasVelocity;
+        s.m_velocity = CAircraftVelocity(velocityX, velocityY, velocityZ, CAircraftVelocity::c_xyzSpeedUnit,
+                                         velocityPitch, velocityRoll, velocityHeading, CAircraftVelocity::c_pbhAngleUnit, CAircraftVelocity::c_timeUnit);
+
+        s.m_onGround = static_cast<int>(onGround);
+        s.m_onGroundDetails = static_cast<int>(onGroundDetails);
+        s.m_elvInfo = static_cast<int>(elvInfo);
+        s.m_isElvInfoTransferred = isElvInfoTransferred;
+        s.m_isInterim = isInterim;
+        s.m_onGroundFactor = onGroundFactor;
+        s.setMSecsSinceEpoch(msSinceEpoch);
+        s.setTimeOffsetMs(timeOffsetMs);
+        return s;
+    }
+
+    void CCompactAircraftSituation::addAltitudeOffset(CFixedLength<Fixed::ft> offset)
+    {
+        if (offset.isNull() || altitude.isNull()) { return; }
+        altitude += offset;
+    }
+
+    CCompactAircraftSituationList::CCompactAircraftSituationList(const CAircraftSituationList &situations)
+    {
+        m_situations.reserve(situations.sizeInt());
+        for (const CAircraftSituation &situation : situations)
+        {
+            m_situations.push_back(CCompactAircraftSituation::fromSituation(situation));
+        }
+    }
+
+    CAircraftSituation CCompactAircraftSituationList::findObjectBeforeAdjustedOrDefault(qint64 msSinceEpoch) const
+    {
+        const CCompactAircraftSituation *found = nullptr;
+        for (const CCompactAircraftSituation &situation : m_situations)
+        {
+            if (situation.getAdjustedMSecsSinceEpoch() >= msSinceEpoch) { continue; }
+            if (!found || situation.getAdjustedMSecsSinceEpoch() > found->getAdjustedMSecsSinceEpoch()) { found = &situation; }
+        }
+        return found ? found->toSituation() : CAircraftSituation();
+    }
+
+    int CCompactAircraftSituationList::addAltitudeOffset(const CLength &offset)
+    {
+        if (offset.isNull() || m_situations.isEmpty()) { return 0; }
+        const CFixedLength<Fixed::ft> offsetFt = CFixedLength<Fixed::ft>::fromQuantity(offset);
+        for (CCompactAircraftSituation &situation : m_situations) { situation.addAltitudeOffset(offsetFt); }
+        return m_situations.size();
+    }
+
+    bool CCompactAircraftSituationList::isSortedAdjustedLatestFirstWithoutNullPositions() const
+    {
+        qint64 min = std::numeric_limits<qint64>::max();
+        for (const CCompactAircraftSituation &situation : m_situations)
+        {
+            if (situation.isPositionNull()) { return false; }
+            if (m_situations.size() < 2) { continue; }
+            if (!situation.hasValidTimestamp() || situation.getAdjustedMSecsSinceEpoch() > min) { return false; }
+            min = situation.getAdjustedMSecsSinceEpoch();
+        }
+        return true;
+    }
+
+    CAircraftSituationList CCompactAircraftSituationList::toList() const
+    {
+        CAircraftSituationList situations;
+        for (const CCompactAircraftSituation &situation : m_situations) { situations.push_back(situation.toSituation()); }
+        situations.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
+        return situations;
+    }
+} // namespace
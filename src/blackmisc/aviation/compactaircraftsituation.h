@@ -0,0 +1,175 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_COMPACTAIRCRAFTSITUATION_H
+#define BLACKMISC_AVIATION_COMPACTAIRCRAFTSITUATION_H
+
+#include "blackmisc/aviation/internedcallsigns.h"
+#include "blackmisc/math/mathutils.h"
+#include "blackmisc/pq/fixedquantity.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QVector>
+#include <QtGlobal>
+#include <type_traits>
+
+namespace BlackMisc::Aviation
+{
+    class CAircraftSituation;
+    class CAircraftSituationList;
+
+    //! Aircraft situation as plain struct.
+    //! \details All values of CAircraftSituation without heap allocated members: the callsign is an interned
+    //!          handle, quantities are doubles in fixed units and the enums and flags are bit packed.
+    //!          Situations can be copied with memcpy, a history of situations is one contiguous block.
+    //!          Used for the situation history of the remote aircraft and the interpolator inputs,
+    //!          CAircraftSituation is only created where needed.
+    //! \remark the units are the ones CAircraftSituation normalizes to (e.g. altitude in ft), so converting
+    //!         back yields the same values. Quantities in other units are converted and equal within epsilon.
+    //! \remark the debug info of the ground guessing is not kept
+    struct BLACKMISC_EXPORT CCompactAircraftSituation
+    {
+        //! Default constructor, same values as a default CAircraftSituation
+        CCompactAircraftSituation();
+
+        //! From situation
+        static CCompactAircraftSituation fromSituation(const CAircraftSituation &situation);
+
+        //! To situation
+        CAircraftSituation toSituation() const;
+
+        //! Callsign
+        CCallsign getCallsign() const { return CInternedCallsigns::callsign(callsign); }
+
+        //! Timestamp with offset added
+        qint64 getAdjustedMSecsSinceEpoch() const { return msSinceEpoch + timeOffsetMs; }
+
+        //! Timestamp valid?
+        bool hasValidTimestamp() const { return msSinceEpoch >= 0; }
+
+        //! NULL position, like CCoordinateGeodetic::isNull
+        bool isPositionNull() const
+        {
+            if (altitude.isNull()) { return true; }
+            return Math::CMathUtils::epsilonZeroLimits(normalX) && Math::CMathUtils::epsilonZeroLimits(normalY) && Math::CMathUtils::epsilonZeroLimits(normalZ);
+        }
+
+        //! Add an offset to the altitude, like CAircraftSituationList::addAltitudeOffset
+        void addAltitudeOffset(PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> offset);
+
+        double normalX = 0; //!< position normal vector
+        double normalY = 0; //!< position normal vector
+        double normalZ = 0; //!< position normal vector
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> altitude;         //!< geodetic height of the position
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> pressureAltitude; //!< pressure altitude
+        PhysicalQuantities::CFixedAngle<PhysicalQuantities::Fixed::deg> heading;          //!< heading
+        PhysicalQuantities::CFixedAngle<PhysicalQuantities::Fixed::deg> pitch;            //!< pitch
+        PhysicalQuantities::CFixedAngle<PhysicalQuantities::Fixed::deg> bank;             //!< bank
+        PhysicalQuantities::CFixedSpeed<PhysicalQuantities::Fixed::kts> groundSpeed;      //!< ground speed
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> cg;               //!< CG
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> sceneryOffset;    //!< scenery offset
+        double elevationNormalX = 0; //!< ground elevation plane normal vector
+        double elevationNormalY = 0; //!< ground elevation plane normal vector
+        double elevationNormalZ = 0; //!< ground elevation plane normal vector
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::ft> elevation;        //!< ground elevation
+        PhysicalQuantities::CFixedLength<PhysicalQuantities::Fixed::m>  elevationRadius;  //!< ground elevation radius
+        double velocityX = 0;       //!< velocity in CAircraftVelocity::c_xyzSpeedUnit
+        double velocityY = 0;       //!< velocity in CAircraftVelocity::c_xyzSpeedUnit
+        double velocityZ = 0;       //!< velocity in CAircraftVelocity::c_xyzSpeedUnit
+        double velocityPitch = 0;   //!< angular velocity in CAircraftVelocity::c_pbhAngleUnit per CAircraftVelocity::c_timeUnit
+        double velocityRoll = 0;    //!< angular velocity in CAircraftVelocity::c_pbhAngleUnit per CAircraftVelocity::c_timeUnit
+        double velocityHeading = 0; //!< angular velocity in CAircraftVelocity::c_pbhAngleUnit per CAircraftVelocity::c_timeUnit
+        double onGroundFactor = -1; //!< interpolated ground flag
+        qint64 msSinceEpoch = -1;   //!< timestamp
+        qint64 timeOffsetMs = 0;    //!< time offset
+        CInternedCallsigns::Handle callsign = CInternedCallsigns::InvalidHandle; //!< interned callsign
+
+        //! Enums and flags
+        //! @{
+        quint32 altitudeDatum : 2;
+        quint32 altitudeType : 1;
+        quint32 pressureAltitudeDatum : 2;
+        quint32 pressureAltitudeType : 1;
+        quint32 elevationDatum : 2;
+        quint32 elevationType : 1;
+        quint32 headingNorth : 1;
+        quint32 onGround : 2;
+        quint32 onGroundDetails : 4;
+        quint32 elvInfo : 4;
+        quint32 hasVelocity : 1;
+        quint32 isInterim : 1;
+        quint32 isElvInfoTransferred : 1;
+        //! @}
+    };
+
+    static_assert(std::is_trivially_copyable_v<CCompactAircraftSituation>, "Compact situation has to be copyable by memcpy");
+
+    //! Compact situations, latest first like the situation history
+    class BLACKMISC_EXPORT CCompactAircraftSituationList
+    {
+    public:
+        //! Const iterator, latest first
+        using const_iterator = QVector<CCompactAircraftSituation>::const_iterator;
+
+        //! Default constructor
+        CCompactAircraftSituationList() = default;
+
+        //! From situations sorted latest first
+        explicit CCompactAircraftSituationList(const CAircraftSituationList &situations);
+
+        //! Number of situations
+        int size() const { return m_situations.size(); }
+
+        //! No situations?
+        bool isEmpty() const { return m_situations.isEmpty(); }
+
+        //! Remove all situations
+        void clear() { m_situations.clear(); }
+
+        //! Reserve capacity
+        void reserve(int size) { m_situations.reserve(size); }
+
+        //! Append an older situation
+        void push_back(const CCompactAircraftSituation &situation) { m_situations.push_back(situation); }
+
+        //! Situation by index
+        //! \param index 0..latest, 1..next older, ...
+        const CCompactAircraftSituation &operator [](int index) const { return m_situations[index]; }
+
+        //! Latest situation
+        const CCompactAircraftSituation &front() const { return m_situations.front(); }
+
+        //! Iterators, latest first
+        //! @{
+        const_iterator begin() const { return m_situations.cbegin(); }
+        const_iterator end() const { return m_situations.cend(); }
+        //! @}
+
+        //! Latest situation older than the adjusted time, or default
+        //! \sa CAircraftSituationList::findObjectBeforeAdjustedOrDefault
+        CAircraftSituation findObjectBeforeAdjustedOrDefault(qint64 msSinceEpoch) const;
+
+        //! \copydoc CAircraftSituationList::addAltitudeOffset
+        int addAltitudeOffset(const PhysicalQuantities::CLength &offset);
+
+        //! \copydoc CAircraftSituationList::isSortedAdjustedLatestFirstWithoutNullPositions
+        bool isSortedAdjustedLatestFirstWithoutNullPositions() const;
+
+        //! Situations as value objects
+        CAircraftSituationList toList() const;
+
+    private:
+        QVector<CCompactAircraftSituation> m_situations;
+    };
+} // namespace
+
+Q_DECLARE_TYPEINFO(BlackMisc::Aviation::CCompactAircraftSituation, Q_MOVABLE_TYPE);
+
+#endif // guard
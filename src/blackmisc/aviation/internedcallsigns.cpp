@@ -0,0 +1,81 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/aviation/internedcallsigns.h"
+
+#include <QHash>
+#include <QReadLocker>
+#include <QReadWriteLock>
+#include <QVector>
+#include <QWriteLocker>
+
+namespace BlackMisc::Aviation
+{
+    namespace
+    {
+        //! Storage of all interned callsigns
+        struct CInternedCallsignsTable
+        {
+            QReadWriteLock lock;
+            QHash<QString, CInternedCallsigns::Handle> handles; //!< callsign string to handle
+            QVector<CCallsign> callsigns { CCallsign() };        //!< callsign by handle, 0 is the invalid handle
+        };
+
+        CInternedCallsignsTable &table()
+        {
+            static CInternedCallsignsTable t;
+            return t;
+        }
+    }
+
+    CInternedCallsigns::Handle CInternedCallsigns::handle(const CCallsign &callsign)
+    {
+        if (callsign.m_handle != InvalidHandle) { return callsign.m_handle; }
+        if (callsign.asString().isEmpty()) { return InvalidHandle; }
+        CInternedCallsignsTable &t = table();
+        {
+            QReadLocker l(&t.lock);
+            const auto it = t.handles.constFind(callsign.asString());
+            if (it != t.handles.constEnd()) { return it.value(); }
+        }
+
+        QWriteLocker l(&t.lock);
+        const auto it = t.handles.constFind(callsign.asString());
+        if (it != t.handles.constEnd()) { return it.value(); } // added meanwhile
+        const Handle h = static_cast<Handle>(t.callsigns.size());
+        CCallsign interned(callsign);
+        interned.m_handle = h;
+        t.callsigns.push_back(interned);
+        t.handles.insert(callsign.asString(), h);
+        return h;
+    }
+
+    CInternedCallsigns::Handle CInternedCallsigns::find(const CCallsign &callsign)
+    {
+        if (callsign.m_handle != InvalidHandle) { return callsign.m_handle; }
+        if (callsign.asString().isEmpty()) { return InvalidHandle; }
+        CInternedCallsignsTable &t = table();
+        QReadLocker l(&t.lock);
+        return t.handles.value(callsign.asString(), InvalidHandle);
+    }
+
+    CCallsign CInternedCallsigns::callsign(Handle handle)
+    {
+        CInternedCallsignsTable &t = table();
+        QReadLocker l(&t.lock);
+        if (handle >= static_cast<Handle>(t.callsigns.size())) { return {}; }
+        return t.callsigns[static_cast<int>(handle)];
+    }
+
+    int CInternedCallsigns::count()
+    {
+        CInternedCallsignsTable &t = table();
+        QReadLocker l(&t.lock);
+        return t.callsigns.size() - 1;
+    }
+} // namespace
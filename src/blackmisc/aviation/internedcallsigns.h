@@ -0,0 +1,54 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_AVIATION_INTERNEDCALLSIGNS_H
+#define BLACKMISC_AVIATION_INTERNEDCALLSIGNS_H
+
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QtGlobal>
+
+namespace BlackMisc::Aviation
+{
+    //! Process wide table of callsigns, each callsign is represented by a small integer handle.
+    //! \details Handles are assigned when a callsign is seen first and are never reused, so they can be kept
+    //!          in plain structs like CCompactAircraftSituation or used as array index (CPerCallsign).
+    //!          The first callsign object seen is kept, callsigns are identified by their string like in
+    //!          CCallsign comparisons. CCallsign interns itself and carries its handle (CCallsign::getHandle),
+    //!          so the table is only locked when a callsign string is set.
+    //! \threadsafe
+    class BLACKMISC_EXPORT CInternedCallsigns
+    {
+    public:
+        //! Handle type
+        using Handle = quint32;
+
+        //! Invalid handle, used for the empty callsign
+        static constexpr Handle InvalidHandle = 0;
+
+        //! Handle of the callsign, the callsign is added if not yet known
+        static Handle handle(const CCallsign &callsign);
+
+        //! Handle of the callsign or InvalidHandle, the callsign is not added
+        static Handle find(const CCallsign &callsign);
+
+        //! Callsign of the handle, empty callsign for an invalid handle
+        static CCallsign callsign(Handle handle);
+
+        //! Number of interned callsigns
+        static int count();
+
+        //! Not instantiable
+        CInternedCallsigns() = delete;
+    };
+} // namespace
+
+#endif // guard
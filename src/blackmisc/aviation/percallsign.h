@@ -15,21 +15,156 @@
 #include "blackmisc/pq/length.h"
 #include "blackmisc/statusmessagelist.h"
 
-#include <QHash>
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
 
 namespace BlackMisc::Aviation
 {
+    //! Value per callsign, used instead of QHash<CCallsign, T>.
+    //! \details The values are kept in contiguous arrays, the slot of a callsign is found by indexing an array
+    //!          with the interned callsign handle (CCallsign::getHandle), so no callsign string is hashed or compared.
+    //!          The API is the part of the QHash API used with callsigns, the iteration order is unspecified like with QHash.
+    //! \remark implicitly shared like QHash, not thread safe
+    template <class T>
+    class CPerCallsign
+    {
+    public:
+        //! Const iterator with QHash like key() and value()
+        class const_iterator
+        {
+        public:
+            //! Constructor
+            const_iterator(const CPerCallsign *container, int index) : m_container(container), m_index(index) {}
+
+            //! Callsign
+            const CCallsign &key() const { return m_container->m_keys[m_index]; }
+
+            //! Value
+            const T &value() const { return m_container->m_values[m_index]; }
+
+            //! Value
+            const T &operator *() const { return this->value(); }
+
+            //! Value
+            const T *operator ->() const { return &this->value(); }
+
+            //! Next element
+            const_iterator &operator ++() { ++m_index; return *this; }
+
+            //! Compare
+            //! @{
+            bool operator ==(const const_iterator &other) const { return m_index == other.m_index; }
+            bool operator !=(const const_iterator &other) const { return m_index != other.m_index; }
+            //! @}
+
+        private:
+            const CPerCallsign *m_container = nullptr;
+            int m_index = 0;
+        };
+
+        //! Number of callsigns
+        int size() const { return m_keys.size(); }
+
+        //! No callsigns?
+        bool isEmpty() const { return m_keys.isEmpty(); }
+
+        //! Remove all callsigns
+        void clear() { m_slots.clear(); m_keys.clear(); m_values.clear(); }
+
+        //! Contains callsign?
+        bool contains(const CCallsign &callsign) const { return this->slot(callsign) >= 0; }
+
+        //! Value of the callsign or default value
+        T value(const CCallsign &callsign, const T &defaultValue = T()) const
+        {
+            const int s = this->slot(callsign);
+            return s < 0 ? defaultValue : m_values[s];
+        }
+
+        //! Value of the callsign, a default value is inserted if not yet contained
+        T &operator [](const CCallsign &callsign)
+        {
+            int s = this->slot(callsign);
+            if (s < 0) { s = this->append(callsign); }
+            return m_values[s];
+        }
+
+        //! Value of the callsign or default value
+        T operator [](const CCallsign &callsign) const { return this->value(callsign); }
+
+        //! Insert or replace the value of the callsign
+        void insert(const CCallsign &callsign, const T &value) { (*this)[callsign] = value; }
+
+        //! Remove the callsign, the last element takes its slot
+        //! \return number of removed elements
+        int remove(const CCallsign &callsign)
+        {
+            const int s = this->slot(callsign);
+            if (s < 0) { return 0; }
+            const int last = m_keys.size() - 1;
+            if (s != last)
+            {
+                m_keys[s] = m_keys[last];
+                m_values[s] = m_values[last];
+                m_slots[static_cast<int>(m_keys[s].getHandle())] = s + 1;
+            }
+            m_keys.removeLast();
+            m_values.removeLast();
+            m_slots[static_cast<int>(callsign.getHandle())] = 0;
+            return 1;
+        }
+
+        //! All callsigns
+        QList<CCallsign> keys() const { return m_keys.toList(); }
+
+        //! All values
+        QList<T> values() const { return m_values.toList(); }
+
+        //! Iterators
+        //! @{
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator cbegin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, m_keys.size()); }
+        const_iterator cend() const { return const_iterator(this, m_keys.size()); }
+        //! @}
+
+    private:
+        //! Slot of the callsign, -1 if not contained
+        int slot(const CCallsign &callsign) const
+        {
+            const int handle = static_cast<int>(callsign.getHandle());
+            Q_ASSERT_X(handle > 0 || callsign.asString().isEmpty(), Q_FUNC_INFO, "Callsign without handle");
+            return handle < m_slots.size() ? m_slots[handle] - 1 : -1;
+        }
+
+        //! Append a default value for the callsign
+        int append(const CCallsign &callsign)
+        {
+            const int handle = static_cast<int>(callsign.getHandle());
+            if (handle >= m_slots.size()) { m_slots.resize(handle + 1); }
+            m_keys.push_back(callsign);
+            m_values.push_back(T());
+            m_slots[handle] = m_keys.size();
+            return m_keys.size() - 1;
+        }
+
+        QVector<int> m_slots;         //!< slot + 1 by callsign handle, 0 if not contained
+        QVector<CCallsign> m_keys;    //!< callsigns
+        QVector<T> m_values;          //!< values, same index as callsigns
+    };
+
     //! Status message per callsign
-    using CStatusMessagePerCallsign = QHash<CCallsign, CStatusMessage>;
+    using CStatusMessagePerCallsign = CPerCallsign<CStatusMessage>;
 
     //! Status messages (list) per callsign
-    using CStatusMessageListPerCallsign = QHash<CCallsign, CStatusMessageList>;
+    using CStatusMessageListPerCallsign = CPerCallsign<CStatusMessageList>;
 
     //! Timestamp der callsign
-    using CTimestampPerCallsign = QHash<CCallsign, qint64>;
+    using CTimestampPerCallsign = CPerCallsign<qint64>;
 
     //! Lenght per callsign
-    using CLengthPerCallsign = QHash<CCallsign, PhysicalQuantities::CLength>;
+    using CLengthPerCallsign = CPerCallsign<PhysicalQuantities::CLength>;
 
 } // namespace
 
@@ -69,6 +69,7 @@ namespace BlackMisc
 
     CDataCache::CDataCache() : CValueCache(1), m_serializer(new CDataCacheSerializer { this, revisionFileName() })
     {
+        setBinaryFilesEnabled(true); // large values like model sets, faster to load than JSON
         if (! QDir::root().mkpath(persistentStore()))
         {
             CLogMessage(this).error(u"Failed to create directory '%1'") << persistentStore();
@@ -0,0 +1,299 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/geo/coordinategeodeticindex.h"
+#include "blackmisc/math/mathutils.h"
+
+#include <QSet>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Math;
+using namespace BlackMisc::PhysicalQuantities;
+
+namespace BlackMisc::Geo
+{
+    namespace
+    {
+        //! Same earth radius as used in calculateGreatCircleDistance
+        constexpr double MetersPerDegree = 6371000.8 * 3.14159265358979323846 / 180.0;
+
+        //! Latitude/longitude in degrees, without the physical quantity overhead
+        void latLngDegrees(const ICoordinateGeodetic &coordinate, double &latDeg, double &lngDeg)
+        {
+            const std::array<double, 3> v = coordinate.normalVectorDouble();
+            latDeg = CMathUtils::rad2deg(std::atan2(v[2], std::hypot(v[0], v[1])));
+            lngDeg = CMathUtils::rad2deg(std::atan2(v[1], v[0]));
+        }
+    }
+
+    CCoordinateGeodeticIndex::CCoordinateGeodeticIndex(double cellSizeDeg) :
+        m_cellSizeDeg(qBound(0.0001, cellSizeDeg, 90.0)),
+        m_latCells(static_cast<int>(std::ceil(180.0 / m_cellSizeDeg)) + 1),
+        m_lngCells(static_cast<int>(std::ceil(360.0 / m_cellSizeDeg)))
+    { }
+
+    template <typename F>
+    void CCoordinateGeodeticIndex::forEachCandidate(const ICoordinateGeodetic &reference, const CLength &range, F function) const
+    {
+        if (m_entries.empty() || reference.isNull() || range.isNull()) { return; }
+
+        // bounding box of the range, with some margin for the float based distance calculation
+        const double rangeDeg = range.value(CLengthUnit::m()) / MetersPerDegree * 1.01 + 0.00001;
+        double latDeg = 0.0;
+        double lngDeg = 0.0;
+        latLngDegrees(reference, latDeg, lngDeg);
+        const double latMin = latDeg - rangeDeg;
+        const double latMax = latDeg + rangeDeg;
+        const int latCellMin = qBound(0, static_cast<int>(std::floor((latMin + 90.0) / m_cellSizeDeg)), m_latCells - 1);
+        const int latCellMax = qBound(0, static_cast<int>(std::floor((latMax + 90.0) / m_cellSizeDeg)), m_latCells - 1);
+
+        // longitude range grows towards the poles, close to a pole all longitudes are used
+        bool allLng = true;
+        int lngCellMin = 0;
+        qint64 lngSpan = m_lngCells;
+        if (latMin > -89.0 && latMax < 89.0)
+        {
+            const double maxAbsLatRad = CMathUtils::deg2rad(std::max(std::abs(latMin), std::abs(latMax)));
+            const double lngRangeDeg = rangeDeg / std::cos(maxAbsLatRad);
+            lngCellMin = static_cast<int>(std::floor((lngDeg - lngRangeDeg + 180.0) / m_cellSizeDeg));
+            const int lngCellMax = static_cast<int>(std::floor((lngDeg + lngRangeDeg + 180.0) / m_cellSizeDeg));
+            lngSpan = static_cast<qint64>(lngCellMax) - lngCellMin + 1;
+            allLng = lngSpan >= m_lngCells;
+            if (allLng) { lngCellMin = 0; lngSpan = m_lngCells; }
+        }
+
+        // newest first within a cell
+        const auto visitCell = [&](const QVector<Sequence> &sequences)
+        {
+            for (auto it = sequences.crbegin(); it != sequences.crend(); ++it)
+            {
+                const auto entry = m_entries.find(*it);
+                Q_ASSERT_X(entry != m_entries.end(), Q_FUNC_INFO, "Inconsistent index");
+                if (!function(*it, entry->second)) { return false; }
+            }
+            return true;
+        };
+
+        const qint64 boxCells = (static_cast<qint64>(latCellMax) - latCellMin + 1) * lngSpan;
+        if (boxCells > m_cells.size())
+        {
+            // large range compared to the number of used cells, check all used cells
+            for (auto it = m_cells.cbegin(); it != m_cells.cend(); ++it)
+            {
+                const int latCell = static_cast<int>(it.key() / m_lngCells);
+                if (latCell < latCellMin || latCell > latCellMax) { continue; }
+                if (!allLng)
+                {
+                    const int lngCell = static_cast<int>(it.key() % m_lngCells);
+                    const int offset = ((lngCell - lngCellMin) % m_lngCells + m_lngCells) % m_lngCells;
+                    if (offset >= lngSpan) { continue; }
+                }
+                if (!visitCell(it.value())) { return; }
+            }
+            return;
+        }
+
+        for (int latCell = latCellMin; latCell <= latCellMax; ++latCell)
+        {
+            for (qint64 l = 0; l < lngSpan; ++l)
+            {
+                const int lngCell = static_cast<int>(((lngCellMin + l) % m_lngCells + m_lngCells) % m_lngCells);
+                const auto cell = m_cells.constFind(this->cellKey(latCell, lngCell));
+                if (cell == m_cells.cend()) { continue; }
+                if (!visitCell(cell.value())) { return; }
+            }
+        }
+    }
+
+    void CCoordinateGeodeticIndex::clear()
+    {
+        m_entries.clear();
+        m_cells.clear();
+    }
+
+    void CCoordinateGeodeticIndex::push(const CCoordinateGeodetic &coordinate)
+    {
+        int latCell = 0;
+        int lngCell = 0;
+        this->cellIndexes(coordinate, latCell, lngCell);
+        const CellKey key = this->cellKey(latCell, lngCell);
+        const Sequence sequence = m_nextSequence++;
+        m_entries.emplace_hint(m_entries.end(), sequence, Entry { coordinate, key });
+        m_cells[key].push_back(sequence);
+    }
+
+    bool CCoordinateGeodeticIndex::removeOldest()
+    {
+        if (m_entries.empty()) { return false; }
+        this->remove(m_entries.begin());
+        return true;
+    }
+
+    int CCoordinateGeodeticIndex::truncate(int maxSize)
+    {
+        int removed = 0;
+        while (this->size() > qMax(0, maxSize))
+        {
+            this->removeOldest();
+            removed++;
+        }
+        return removed;
+    }
+
+    CCoordinateGeodeticList CCoordinateGeodeticIndex::toList() const
+    {
+        CCoordinateGeodeticList list;
+        list.reserve(this->size());
+        for (auto it = m_entries.crbegin(); it != m_entries.crend(); ++it)
+        {
+            list.push_back(it->second.m_coordinate);
+        }
+        return list;
+    }
+
+    CCoordinateGeodetic CCoordinateGeodeticIndex::findFirstWithinRangeOrDefault(const ICoordinateGeodetic &reference, const CLength &range) const
+    {
+        const Entry *newest = nullptr;
+        Sequence newestSequence = 0;
+        this->forEachCandidate(reference, range, [&](Sequence sequence, const Entry &entry)
+        {
+            if (newest && sequence < newestSequence) { return true; }
+            if (calculateGreatCircleDistance(entry.m_coordinate, reference) <= range)
+            {
+                newest = &entry;
+                newestSequence = sequence;
+            }
+            return true;
+        });
+        return newest ? newest->m_coordinate : CCoordinateGeodetic();
+    }
+
+    CCoordinateGeodetic CCoordinateGeodeticIndex::findClosestWithinRange(const ICoordinateGeodetic &reference, const CLength &range) const
+    {
+        const Entry *closest = nullptr;
+        CLength distance = CLength::null();
+        this->forEachCandidate(reference, range, [&](Sequence, const Entry &entry)
+        {
+            const CLength d = reference.calculateGreatCircleDistance(entry.m_coordinate);
+            if (d > range) { return true; }
+            if (distance.isNull() || distance > d)
+            {
+                distance = d;
+                closest = &entry;
+            }
+            return true;
+        });
+        return closest ? closest->m_coordinate : CCoordinateGeodetic();
+    }
+
+    CCoordinateGeodeticList CCoordinateGeodeticIndex::findWithinRange(const ICoordinateGeodetic &reference, const CLength &range) const
+    {
+        QVector<QPair<Sequence, const Entry *>> found;
+        this->forEachCandidate(reference, range, [&](Sequence sequence, const Entry &entry)
+        {
+            if (calculateGreatCircleDistance(entry.m_coordinate, reference) <= range) { found.push_back({ sequence, &entry }); }
+            return true;
+        });
+
+        // newest first, like the list
+        std::sort(found.begin(), found.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+        CCoordinateGeodeticList list;
+        list.reserve(found.size());
+        for (const auto &f : std::as_const(found)) { list.push_back(f.second->m_coordinate); }
+        return list;
+    }
+
+    bool CCoordinateGeodeticIndex::containsWithinRange(const ICoordinateGeodetic &reference, const CLength &range) const
+    {
+        bool contains = false;
+        this->forEachCandidate(reference, range, [&](Sequence, const Entry &entry)
+        {
+            contains = calculateGreatCircleDistance(entry.m_coordinate, reference) <= range;
+            return !contains;
+        });
+        return contains;
+    }
+
+    int CCoordinateGeodeticIndex::removeInsideRange(const ICoordinateGeodetic &reference, const CLength &range)
+    {
+        QVector<Sequence> inside;
+        this->forEachCandidate(reference, range, [&](Sequence sequence, const Entry &entry)
+        {
+            if (calculateGreatCircleDistance(entry.m_coordinate, reference) <= range) { inside.push_back(sequence); }
+            return true;
+        });
+        for (Sequence sequence : std::as_const(inside))
+        {
+            this->remove(m_entries.find(sequence));
+        }
+        return inside.size();
+    }
+
+    int CCoordinateGeodeticIndex::removeOutsideRange(const ICoordinateGeodetic &reference, const CLength &range)
+    {
+        QSet<Sequence> inside;
+        this->forEachCandidate(reference, range, [&](Sequence sequence, const Entry &entry)
+        {
+            if (calculateGreatCircleDistance(entry.m_coordinate, reference) <= range) { inside.insert(sequence); }
+            return true;
+        });
+        if (inside.size() == this->size()) { return 0; }
+
+        int removed = 0;
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            auto current = it++;
+            if (inside.contains(current->first)) { continue; }
+            this->remove(current);
+            removed++;
+        }
+        return removed;
+    }
+
+    CAltitude CCoordinateGeodeticIndex::findMaxHeight() const
+    {
+        CAltitude max = CAltitude::null();
+        for (const auto &entry : m_entries)
+        {
+            const CCoordinateGeodetic &coordinate = entry.second.m_coordinate;
+            if (!coordinate.hasMSLGeodeticHeight()) { continue; }
+            const CAltitude alt = coordinate.geodeticHeight();
+            if (max.isNull() || alt > max) { max = alt; }
+        }
+        return max;
+    }
+
+    CCoordinateGeodeticIndex::CellKey CCoordinateGeodeticIndex::cellKey(int latCell, int lngCell) const
+    {
+        return static_cast<CellKey>(latCell) * m_lngCells + lngCell;
+    }
+
+    void CCoordinateGeodeticIndex::cellIndexes(const ICoordinateGeodetic &coordinate, int &latCell, int &lngCell) const
+    {
+        double latDeg = 0.0;
+        double lngDeg = 0.0;
+        latLngDegrees(coordinate, latDeg, lngDeg);
+        latCell = qBound(0, static_cast<int>(std::floor((latDeg + 90.0) / m_cellSizeDeg)), m_latCells - 1);
+        lngCell = qBound(0, static_cast<int>(std::floor((lngDeg + 180.0) / m_cellSizeDeg)), m_lngCells - 1);
+    }
+
+    void CCoordinateGeodeticIndex::remove(std::map<Sequence, Entry>::iterator it)
+    {
+        if (it == m_entries.end()) { return; }
+        const auto cell = m_cells.find(it->second.m_cell);
+        if (cell != m_cells.end())
+        {
+            cell.value().removeOne(it->first);
+            if (cell.value().isEmpty()) { m_cells.erase(cell); }
+        }
+        m_entries.erase(it);
+    }
+} // namespace
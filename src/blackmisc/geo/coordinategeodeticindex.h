@@ -0,0 +1,124 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_GEO_COORDINATEGEODETICINDEX_H
+#define BLACKMISC_GEO_COORDINATEGEODETICINDEX_H
+
+#include "blackmisc/geo/coordinategeodeticlist.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QVector>
+#include <map>
+
+namespace BlackMisc::Geo
+{
+    //! Coordinates indexed by a latitude/longitude cell grid.
+    //!
+    //! Range and closest queries only look at the cells overlapping the range,
+    //! so they do not scale with the number of stored coordinates like the
+    //! linear search of CCoordinateGeodeticList.
+    //! Coordinates are kept in insertion order, the oldest can be removed in O(1)
+    //! (amortized), which allows a FIFO cache of limited size.
+    //! \remark not threadsafe, like the containers
+    class BLACKMISC_EXPORT CCoordinateGeodeticIndex
+    {
+    public:
+        //! Default cell size in degrees, about 1.1km in latitude
+        static constexpr double DefaultCellSizeDeg = 0.01;
+
+        //! Constructor
+        explicit CCoordinateGeodeticIndex(double cellSizeDeg = DefaultCellSizeDeg);
+
+        //! Number of coordinates
+        int size() const { return static_cast<int>(m_entries.size()); }
+
+        //! Empty?
+        bool isEmpty() const { return m_entries.empty(); }
+
+        //! Remove all
+        void clear();
+
+        //! Add as newest coordinate
+        void push(const CCoordinateGeodetic &coordinate);
+
+        //! Remove the oldest coordinate
+        //! \return false if empty
+        bool removeOldest();
+
+        //! Remove the oldest coordinates until size is max. maxSize
+        //! \return number of removed coordinates
+        int truncate(int maxSize);
+
+        //! All coordinates, newest first
+        CCoordinateGeodeticList toList() const;
+
+        //! Newest coordinate within range, or default (null)
+        //! \remark same as CCoordinateGeodeticList::findFirstWithinRangeOrDefault for a list with the newest coordinates first
+        CCoordinateGeodetic findFirstWithinRangeOrDefault(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range) const;
+
+        //! Closest coordinate within range, or default (null)
+        CCoordinateGeodetic findClosestWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range) const;
+
+        //! All coordinates within range, newest first
+        CCoordinateGeodeticList findWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range) const;
+
+        //! Any coordinate within range?
+        bool containsWithinRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range) const;
+
+        //! Remove all coordinates within range
+        //! \return number of removed coordinates
+        int removeInsideRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range);
+
+        //! Remove all coordinates outside range
+        //! \return number of removed coordinates
+        int removeOutsideRange(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range);
+
+        //! Highest geodetic height
+        Aviation::CAltitude findMaxHeight() const;
+
+    private:
+        using Sequence = quint64;
+        using CellKey = qint64;
+
+        //! Stored coordinate
+        struct Entry
+        {
+            CCoordinateGeodetic m_coordinate;
+            CellKey m_cell = 0;
+        };
+
+        //! Cell of a lat/lng pair
+        CellKey cellKey(int latCell, int lngCell) const;
+
+        //! Cell indexes for coordinate
+        void cellIndexes(const ICoordinateGeodetic &coordinate, int &latCell, int &lngCell) const;
+
+        //! Call function for all entries (newest first per cell) which could be within range
+        //! \remark function returns false to stop
+        template <typename F>
+        void forEachCandidate(const ICoordinateGeodetic &reference, const PhysicalQuantities::CLength &range, F function) const;
+
+        //! Remove entry
+        void remove(std::map<Sequence, Entry>::iterator it);
+
+        double m_cellSizeDeg = DefaultCellSizeDeg;
+        int m_latCells = 0;
+        int m_lngCells = 0;
+        Sequence m_nextSequence = 0;
+        std::map<Sequence, Entry> m_entries;          //!< insertion order, oldest first
+        QHash<CellKey, QVector<Sequence>> m_cells;    //!< entries per cell, oldest first
+    };
+} // namespace
+
+#endif // guard
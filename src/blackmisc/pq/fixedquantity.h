@@ -0,0 +1,169 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_PQ_FIXEDQUANTITY_H
+#define BLACKMISC_PQ_FIXEDQUANTITY_H
+
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/length.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+
+#include <QtMath>
+#include <limits>
+#include <type_traits>
+
+namespace BlackMisc::PhysicalQuantities
+{
+    //! Units known at compile time, used with CFixedQuantity
+    //! \remark the factors to the default unit are the same as the ones of the runtime units in units.h,
+    //!         so values converted by either are identical
+    namespace Fixed
+    {
+        //! Common part of all units of one dimension
+        template <class MU, class PQ>
+        struct Dimension
+        {
+            using UnitType = MU;                    //!< runtime unit
+            using QuantityType = PQ;                //!< runtime quantity
+            static constexpr double epsilon = 1e-9; //!< same as CMeasurementUnit
+        };
+
+        //! Length units, default unit m
+        //! @{
+        struct m      : Dimension<CLengthUnit, CLength> { static constexpr double factor = 1.0;    static CLengthUnit unit() { return CLengthUnit::m(); } };
+        struct ft     : Dimension<CLengthUnit, CLength> { static constexpr double factor = 0.3048; static CLengthUnit unit() { return CLengthUnit::ft(); } };
+        struct km     : Dimension<CLengthUnit, CLength> { static constexpr double factor = 1.0 * 1000.0; static CLengthUnit unit() { return CLengthUnit::km(); } };
+        struct NM     : Dimension<CLengthUnit, CLength> { static constexpr double factor = 1852.0; static CLengthUnit unit() { return CLengthUnit::NM(); } };
+        //! @}
+
+        //! Angle units, default unit deg
+        //! @{
+        struct deg    : Dimension<CAngleUnit, CAngle> { static constexpr double factor = 1.0;          static CAngleUnit unit() { return CAngleUnit::deg(); } };
+        struct rad    : Dimension<CAngleUnit, CAngle> { static constexpr double factor = 180.0 / M_PI; static CAngleUnit unit() { return CAngleUnit::rad(); } };
+        //! @}
+
+        //! Speed units, default unit m/s
+        //! @{
+        struct m_s    : Dimension<CSpeedUnit, CSpeed> { static constexpr double factor = 1.0;             static CSpeedUnit unit() { return CSpeedUnit::m_s(); } };
+        struct kts    : Dimension<CSpeedUnit, CSpeed> { static constexpr double factor = 1852.0 / 3600.0; static CSpeedUnit unit() { return CSpeedUnit::kts(); } };
+        struct km_h   : Dimension<CSpeedUnit, CSpeed> { static constexpr double factor = 1.0 / 3.6;       static CSpeedUnit unit() { return CSpeedUnit::km_h(); } };
+        struct ft_min : Dimension<CSpeedUnit, CSpeed> { static constexpr double factor = 0.3048 / 60.0;   static CSpeedUnit unit() { return CSpeedUnit::ft_min(); } };
+        //! @}
+
+        //! Units of the same dimension?
+        template <class U1, class U2>
+        constexpr bool isSameDimension = std::is_same_v<typename U1::UnitType, typename U2::UnitType>;
+
+        //! Convert a value, the same operations as CMeasurementUnit::convertFrom with linear converters
+        template <class From, class To>
+        constexpr double convert(double value)
+        {
+            static_assert(isSameDimension<From, To>, "Units of different dimensions");
+            if constexpr (std::is_same_v<From, To>) { return value; }
+            else { return value * From::factor / To::factor; }
+        }
+    } // ns
+
+    /*!
+     * Physical quantity with its unit fixed at compile time
+     * \details A plain double, conversions are done with constexpr factors, there are no unit checks or
+     *          indirect calls. Meant for hot paths such as the interpolators, at the boundaries the quantity
+     *          is converted from and to the runtime quantities like CLength.
+     * \remark null is NaN, comparisons with null are false and arithmetic with null yields null
+     * \remark unlike CPhysicalQuantity comparisons do not consider epsilon
+     */
+    template <class Unit>
+    class CFixedQuantity
+    {
+    public:
+        using UnitType = typename Unit::UnitType;         //!< runtime unit
+        using QuantityType = typename Unit::QuantityType; //!< runtime quantity
+
+        //! Null quantity
+        constexpr CFixedQuantity() = default;
+
+        //! Value in Unit
+        constexpr explicit CFixedQuantity(double value) : m_value(value) {}
+
+        //! From a runtime quantity in any unit
+        static CFixedQuantity fromQuantity(const QuantityType &quantity)
+        {
+            return quantity.isNull() ? CFixedQuantity() : CFixedQuantity(quantity.value(Unit::unit()));
+        }
+
+        //! To a runtime quantity in Unit
+        QuantityType toQuantity() const
+        {
+            return this->isNull() ? QuantityType::null() : QuantityType(m_value, Unit::unit());
+        }
+
+        //! Converted to another unit of the same dimension
+        template <class To>
+        constexpr CFixedQuantity<To> to() const { return CFixedQuantity<To>(Fixed::convert<Unit, To>(m_value)); }
+
+        //! Value in Unit, NaN if null
+        constexpr double value() const { return m_value; }
+
+        //! Value in another unit of the same dimension
+        template <class To>
+        constexpr double value() const { return Fixed::convert<Unit, To>(m_value); }
+
+        //! Null?
+        constexpr bool isNull() const { return m_value != m_value; }
+
+        //! Epsilon considered like in CPhysicalQuantity
+        //! @{
+        constexpr bool isZeroEpsilonConsidered() const { return (m_value < 0 ? -m_value : m_value) <= Unit::epsilon; }
+        constexpr bool isPositiveWithEpsilonConsidered() const { return !this->isZeroEpsilonConsidered() && m_value > 0; }
+        constexpr bool isNegativeWithEpsilonConsidered() const { return !this->isZeroEpsilonConsidered() && m_value < 0; }
+        //! @}
+
+        //! Absolute value
+        constexpr CFixedQuantity abs() const { return CFixedQuantity(m_value < 0 ? -m_value : m_value); }
+
+        //! Arithmetic
+        //! @{
+        constexpr CFixedQuantity &operator +=(CFixedQuantity other) { m_value += other.m_value; return *this; }
+        constexpr CFixedQuantity &operator -=(CFixedQuantity other) { m_value -= other.m_value; return *this; }
+        constexpr CFixedQuantity &operator *=(double factor) { m_value *= factor; return *this; }
+        constexpr CFixedQuantity &operator /=(double divisor) { m_value /= divisor; return *this; }
+        friend constexpr CFixedQuantity operator +(CFixedQuantity a, CFixedQuantity b) { return CFixedQuantity(a.m_value + b.m_value); }
+        friend constexpr CFixedQuantity operator -(CFixedQuantity a, CFixedQuantity b) { return CFixedQuantity(a.m_value - b.m_value); }
+        friend constexpr CFixedQuantity operator -(CFixedQuantity a) { return CFixedQuantity(-a.m_value); }
+        friend constexpr CFixedQuantity operator *(CFixedQuantity a, double factor) { return CFixedQuantity(a.m_value * factor); }
+        friend constexpr CFixedQuantity operator *(double factor, CFixedQuantity a) { return CFixedQuantity(factor * a.m_value); }
+        friend constexpr CFixedQuantity operator /(CFixedQuantity a, double divisor) { return CFixedQuantity(a.m_value / divisor); }
+        friend constexpr double operator /(CFixedQuantity a, CFixedQuantity b) { return a.m_value / b.m_value; }
+        //! @}
+
+        //! Comparisons
+        //! @{
+        friend constexpr bool operator ==(CFixedQuantity a, CFixedQuantity b) { return a.m_value == b.m_value; }
+        friend constexpr bool operator !=(CFixedQuantity a, CFixedQuantity b) { return a.m_value != b.m_value; }
+        friend constexpr bool operator <(CFixedQuantity a, CFixedQuantity b) { return a.m_value < b.m_value; }
+        friend constexpr bool operator <=(CFixedQuantity a, CFixedQuantity b) { return a.m_value <= b.m_value; }
+        friend constexpr bool operator >(CFixedQuantity a, CFixedQuantity b) { return a.m_value > b.m_value; }
+        friend constexpr bool operator >=(CFixedQuantity a, CFixedQuantity b) { return a.m_value >= b.m_value; }
+        //! @}
+
+    private:
+        double m_value = std::numeric_limits<double>::quiet_NaN();
+    };
+
+    //! Fixed quantities of one dimension, e.g. CFixedLength<Fixed::ft>
+    //! @{
+    template <class Unit> using CFixedLength = std::enable_if_t<std::is_same_v<typename Unit::UnitType, CLengthUnit>, CFixedQuantity<Unit>>;
+    template <class Unit> using CFixedAngle  = std::enable_if_t<std::is_same_v<typename Unit::UnitType, CAngleUnit>, CFixedQuantity<Unit>>;
+    template <class Unit> using CFixedSpeed  = std::enable_if_t<std::is_same_v<typename Unit::UnitType, CSpeedUnit>, CFixedQuantity<Unit>>;
+    //! @}
+} // ns
+
+#endif // guard
@@ -18,6 +18,7 @@
 #include "blackmisc/stringutils.h"
 #include "blackconfig/buildconfig.h"
 
+#include <QDataStream>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
@@ -148,6 +149,28 @@ namespace BlackMisc::Simulation
         });
     }
 
+    void CAircraftModel::marshalToMemoizedDataStream(QDataStream &stream, MemoHelper::CMemoizer &helper) const
+    {
+        introspect<CAircraftModel>().forEachMember([ &, this ](auto member)
+        {
+            if constexpr (!decltype(member)::has(MetaFlags<DisabledForMarshalling>()))
+            {
+                stream << helper.maybeMemoize(member.in(*this));
+            }
+        });
+    }
+
+    void CAircraftModel::unmarshalFromMemoizedDataStream(QDataStream &stream, const MemoHelper::CUnmemoizer &helper)
+    {
+        introspect<CAircraftModel>().forEachMember([ &, this ](auto member)
+        {
+            if constexpr (!decltype(member)::has(MetaFlags<DisabledForMarshalling>()))
+            {
+                stream >> helper.maybeUnmemoize(member.in(*this)).get();
+            }
+        });
+    }
+
     QString CAircraftModel::asHtmlSummary(const QString &separator) const
     {
         return QStringLiteral("Model: %1 changed: %2%3Simulator: %4 Mode: %5 Distributor: %6%7Aircraft ICAO: %8%9Livery: %10")
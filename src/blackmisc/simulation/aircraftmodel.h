@@ -428,6 +428,12 @@ namespace BlackMisc
             //! From JSON with memoized members (used by CAircraftModelList)
             void convertFromMemoizedJson(const QJsonObject &json, const MemoHelper::CUnmemoizer &);
 
+            //! To data stream with memoized members (used by CAircraftModelList)
+            void marshalToMemoizedDataStream(QDataStream &stream, MemoHelper::CMemoizer &) const;
+
+            //! From data stream with memoized members (used by CAircraftModelList)
+            void unmarshalFromMemoizedDataStream(QDataStream &stream, const MemoHelper::CUnmemoizer &);
+
             //! To database JSON
             QJsonObject toDatabaseJson() const;
 
@@ -22,6 +22,8 @@
 #include "blackconfig/buildconfig.h"
 
 #include <QStringBuilder>
+#include <QByteArray>
+#include <QDataStream>
 #include <QJsonValue>
 #include <QList>
 #include <QMultiMap>
@@ -1743,6 +1745,45 @@ namespace BlackMisc::Simulation
         }
     }
 
+    void CAircraftModelList::marshalToMemoizedDataStream(QDataStream &stream) const
+    {
+        // the tables are needed first when reading, but are only complete after all models
+        CAircraftModel::MemoHelper::CMemoizer helper;
+        QByteArray models;
+        {
+            QDataStream modelStream(&models, QIODevice::WriteOnly);
+            modelStream.setVersion(stream.version());
+            for (const CAircraftModel &model : *this) { model.marshalToMemoizedDataStream(modelStream, helper); }
+        }
+        stream << helper.getTable<CAircraftIcaoCode>() << helper.getTable<CLivery>() << helper.getTable<CDistributor>();
+        stream << static_cast<qint32>(this->size()) << models;
+    }
+
+    void CAircraftModelList::unmarshalFromMemoizedDataStream(QDataStream &stream)
+    {
+        clear();
+        CAircraftModel::MemoHelper::CUnmemoizer helper;
+        qint32 size = 0;
+        QByteArray models;
+        stream >> helper.getTable<CAircraftIcaoCode>() >> helper.getTable<CLivery>() >> helper.getTable<CDistributor>();
+        stream >> size >> models;
+        if (stream.status() != QDataStream::Ok) { return; }
+
+        QDataStream modelStream(models);
+        modelStream.setVersion(stream.version());
+        for (int i = 0; i < size && modelStream.status() == QDataStream::Ok; ++i)
+        {
+            CAircraftModel value;
+            value.unmarshalFromMemoizedDataStream(modelStream, helper);
+            this->push_back(value);
+        }
+        if (modelStream.status() != QDataStream::Ok)
+        {
+            clear();
+            stream.setStatus(QDataStream::ReadCorruptData);
+        }
+    }
+
     QJsonArray CAircraftModelList::toDatabaseJson() const
     {
         QJsonArray array;
@@ -527,6 +527,12 @@ namespace BlackMisc
             //! From compact JSON format
             void convertFromMemoizedJson(const QJsonObject &json, bool fallbackToConvertToJson = false);
 
+            //! To compact data stream format, aircraft ICAO codes, liveries and distributors are only streamed once
+            void marshalToMemoizedDataStream(QDataStream &stream) const;
+
+            //! From compact data stream format
+            void unmarshalFromMemoizedDataStream(QDataStream &stream);
+
             //! To database JSON
             QJsonArray toDatabaseJson() const;
 
@@ -0,0 +1,247 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+
+#include <QSet>
+#include <algorithm>
+#include <iterator>
+
+using namespace BlackMisc::Aviation;
+
+namespace BlackMisc::Simulation
+{
+    CAircraftModelSetIndex::CAircraftModelSetIndex(const CAircraftModelList &modelSet) : m_models(modelSet)
+    {
+        const int size = m_models.sizeInt();
+        m_all.reserve(size);
+        m_military.reserve(size);
+        m_vtol.reserve(size);
+        for (ModelId id = 0; id < size; ++id)
+        {
+            // ids are added in ascending order, so all index lists are sorted
+            const CAircraftModel &model = m_models[id];
+            const CAircraftIcaoCode &aircraftIcao = model.getAircraftIcaoCode();
+            const CAirlineIcaoCode  &airlineIcao  = model.getAirlineIcaoCode();
+            m_all.push_back(id);
+            m_military.push_back(model.isMilitary());
+            m_vtol.push_back(model.isVtol());
+
+            m_byAircraftDesignator[aircraftIcao.getDesignator()].push_back(id);
+            m_byAirlineDesignator[airlineIcao.getDesignator()].push_back(id);
+            m_byCombinedType[aircraftIcao.getCombinedType()].push_back(id);
+            m_byManufacturer[aircraftIcao.getManufacturer()].push_back(id);
+            if (aircraftIcao.hasFamily()) { m_byFamily[aircraftIcao.getFamily()].push_back(id); }
+            if (model.getLivery().hasCombinedCode()) { m_byLiveryCombinedCode[model.getLivery().getCombinedCode()].push_back(id); }
+            if (airlineIcao.getGroupId() >= 0) { m_byAirlineGroupId[airlineIcao.getGroupId()].push_back(id); }
+
+            const QString ms = model.getModelString().toUpper();
+            if (!ms.isEmpty() && !m_byModelString.contains(ms)) { m_byModelString.insert(ms, id); }
+        }
+    }
+
+    template <class Predicate>
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::filter(const ModelIds &ids, Predicate predicate) const
+    {
+        ModelIds found;
+        for (ModelId id : ids)
+        {
+            if (predicate(m_models[id])) { found.push_back(id); }
+        }
+        return found;
+    }
+
+    template <class Key>
+    const CAircraftModelSetIndex::ModelIds &CAircraftModelSetIndex::indexed(const QHash<Key, ModelIds> &index, const Key &key)
+    {
+        static const ModelIds empty;
+        const auto it = index.constFind(key);
+        return it == index.constEnd() ? empty : it.value();
+    }
+
+    CAircraftModelList CAircraftModelSetIndex::toModels(const ModelIds &ids) const
+    {
+        if (ids.size() == this->size() && std::is_sorted(ids.cbegin(), ids.cend())) { return m_models; } // all, no copy
+        CAircraftModelList models;
+        models.reserve(ids.size());
+        for (ModelId id : ids) { models.push_back(m_models[id]); }
+        return models;
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::toIds(const CAircraftModelList &models) const
+    {
+        ModelIds ids;
+        ids.reserve(models.sizeInt());
+        for (const CAircraftModel &model : models)
+        {
+            const auto it = m_byModelString.constFind(model.getModelString().toUpper());
+            if (it != m_byModelString.constEnd()) { ids.push_back(it.value()); }
+        }
+        return ids;
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::unite(const ModelIds &ids, const ModelIds &other)
+    {
+        if (other.isEmpty()) { return ids; }
+        if (ids.isEmpty())   { return other; }
+        const QSet<ModelId> contained(ids.cbegin(), ids.cend());
+        ModelIds united(ids);
+        for (ModelId id : other)
+        {
+            if (!contained.contains(id)) { united.push_back(id); }
+        }
+        return united;
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::replaceOrAdd(const ModelIds &ids, const ModelIds &addOrReplace)
+    {
+        if (addOrReplace.isEmpty()) { return ids; }
+        if (ids.isEmpty())          { return addOrReplace; }
+        const QSet<ModelId> replaced(addOrReplace.cbegin(), addOrReplace.cend());
+        ModelIds result;
+        result.reserve(ids.size() + addOrReplace.size());
+        for (ModelId id : ids)
+        {
+            if (!replaced.contains(id)) { result.push_back(id); }
+        }
+        result += addOrReplace;
+        return result;
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByIcaoDesignators(const ModelIds &ids, const CAircraftIcaoCode &aircraftIcaoCode, const CAirlineIcaoCode &airlineIcaoCode) const
+    {
+        const QString aircraft(aircraftIcaoCode.getDesignator());
+        const QString airline(airlineIcaoCode.getDesignator());
+        if (airline.isEmpty())  { return this->intersect(ids, indexed(m_byAircraftDesignator, aircraft)); }
+        if (aircraft.isEmpty()) { return this->intersect(ids, indexed(m_byAirlineDesignator, airline)); }
+        return this->intersect(this->intersect(ids, indexed(m_byAirlineDesignator, airline)), indexed(m_byAircraftDesignator, aircraft));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByAircraftDesignatorAndLiveryCombinedCode(const ModelIds &ids, const QString &aircraftDesignator, const QString &combinedCode) const
+    {
+        if (aircraftDesignator.isEmpty() || combinedCode.isEmpty()) { return {}; }
+        const QString designator = aircraftDesignator.trimmed().toUpper();
+        const QString code = combinedCode.trimmed().toUpper();
+        return this->intersect(this->intersect(ids, indexed(m_byAircraftDesignator, designator)), indexed(m_byLiveryCombinedCode, code));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByAirlineGroup(const ModelIds &ids, const CAirlineIcaoCode &airline) const
+    {
+        const int id = airline.getGroupId();
+        if (id < 0) { return {}; }
+        return this->intersect(ids, indexed(m_byAirlineGroupId, id));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByManufacturer(const ModelIds &ids, const QString &manufacturer) const
+    {
+        if (manufacturer.isEmpty()) { return {}; }
+        return this->intersect(ids, indexed(m_byManufacturer, manufacturer.toUpper().trimmed()));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByFamily(const ModelIds &ids, const QString &family) const
+    {
+        if (family.isEmpty()) { return {}; }
+        return this->intersect(ids, indexed(m_byFamily, family.toUpper().trimmed()));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByCombinedType(const ModelIds &ids, const QString &combinedType) const
+    {
+        if (combinedType.length() != 3) { return {}; }
+        const QString cc(combinedType.trimmed().toUpper());
+        if (cc.length() != 3) { return {}; }
+
+        // wildcards like "L*J" can not be looked up
+        QString pattern(cc);
+        pattern.replace(' ', '*').replace('-', '*');
+        if (pattern.contains('*'))
+        {
+            return this->filter(ids, [&](const CAircraftModel &model)
+            {
+                return model.getAircraftIcaoCode().matchesCombinedType(cc);
+            });
+        }
+        return this->intersect(ids, indexed(m_byCombinedType, pattern));
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByCombinedAndManufacturer(const ModelIds &ids, const CAircraftIcaoCode &icao) const
+    {
+        const QString &combinedType = icao.getCombinedType();
+        const QString &manufacturer = icao.getManufacturer();
+        if (manufacturer.isEmpty()) { return this->findByCombinedType(ids, combinedType); }
+        if (combinedType.isEmpty()) { return this->findByManufacturer(ids, manufacturer); }
+
+        // narrow down by the combined type index, manufacturer is compared case insensitive
+        const bool indexable = combinedType.length() == 3 && combinedType == combinedType.trimmed();
+        return this->filter(indexable ? this->findByCombinedType(ids, combinedType) : ids, [&](const CAircraftModel &model)
+        {
+            return model.getAircraftIcaoCode().matchesCombinedTypeAndManufacturer(combinedType, manufacturer);
+        });
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByMilitaryFlag(const ModelIds &ids, bool military) const
+    {
+        ModelIds found;
+        for (ModelId id : ids)
+        {
+            if (m_military[id] == military) { found.push_back(id); }
+        }
+        return found;
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findByVtolFlag(const ModelIds &ids, bool vtol) const
+    {
+        ModelIds found;
+        for (ModelId id : ids)
+        {
+            if (m_vtol[id] == vtol) { found.push_back(id); }
+        }
+        return found;
+    }
+
+    bool CAircraftModelSetIndex::containsVtol(const ModelIds &ids) const
+    {
+        return std::any_of(ids.cbegin(), ids.cend(), [&](ModelId id) { return m_vtol[id]; });
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findWithModelString(const ModelIds &ids) const
+    {
+        return this->filter(ids, [](const CAircraftModel &model) { return model.hasModelString(); });
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findWithValidDbKey(const ModelIds &ids) const
+    {
+        return this->filter(ids, [](const CAircraftModel &model) { return model.hasValidDbKey(); });
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::findNotExcluded(const ModelIds &ids) const
+    {
+        return this->filter(ids, [](const CAircraftModel &model) { return model.getModelMode() != CAircraftModel::Exclude; });
+    }
+
+    CAircraftModelSetIndex::ModelIds CAircraftModelSetIndex::intersect(const ModelIds &ids, const ModelIds &indexedIds) const
+    {
+        if (ids.isEmpty() || indexedIds.isEmpty()) { return {}; }
+        ModelIds found;
+        if (std::is_sorted(ids.cbegin(), ids.cend()))
+        {
+            if (ids.size() == this->size()) { return indexedIds; } // all models
+            std::set_intersection(ids.cbegin(), ids.cend(), indexedIds.cbegin(), indexedIds.cend(), std::back_inserter(found));
+            return found;
+        }
+
+        // keep the order of ids
+        for (ModelId id : ids)
+        {
+            if (std::binary_search(indexedIds.cbegin(), indexedIds.cend(), id)) { found.push_back(id); }
+        }
+        return found;
+    }
+} // namespace
@@ -0,0 +1,146 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+#define BLACKMISC_SIMULATION_AIRCRAFTMODELSETINDEX_H
+
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/blackmiscexport.h"
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace BlackMisc
+{
+    namespace Aviation
+    {
+        class CAircraftIcaoCode;
+        class CAirlineIcaoCode;
+    }
+
+    namespace Simulation
+    {
+        //! Index of a model set for matching, built once per model set.
+        //! \details Models are referenced by compact integer ids (the position in the set),
+        //!          and the finders work on id sets with inverted indexes instead of copying models.
+        //!          All finders return the same models in the same order as their
+        //!          CAircraftModelList counterparts on the corresponding list.
+        class BLACKMISC_EXPORT CAircraftModelSetIndex
+        {
+        public:
+            //! Id of a model in the set
+            using ModelId = int;
+
+            //! Ids of models
+            using ModelIds = QVector<ModelId>;
+
+            //! Default constructor
+            CAircraftModelSetIndex() {}
+
+            //! Build the index
+            explicit CAircraftModelSetIndex(const CAircraftModelList &modelSet);
+
+            //! Indexed models
+            const CAircraftModelList &getModels() const { return m_models; }
+
+            //! Number of indexed models
+            int size() const { return m_models.sizeInt(); }
+
+            //! No models?
+            bool isEmpty() const { return m_models.isEmpty(); }
+
+            //! Model by id
+            const CAircraftModel &model(ModelId id) const { return m_models[id]; }
+
+            //! Ids of all models
+            const ModelIds &allIds() const { return m_all; }
+
+            //! Models for ids, in order of the ids
+            CAircraftModelList toModels(const ModelIds &ids) const;
+
+            //! Ids of the models (by model string), models not in the set are ignored
+            ModelIds toIds(const CAircraftModelList &models) const;
+
+            //! Ids in the order of the ids, plus all ids of other not yet contained
+            static ModelIds unite(const ModelIds &ids, const ModelIds &other);
+
+            //! Ids not in addOrReplace in the order of the ids, followed by all ids of addOrReplace
+            //! \remark same order as CAircraftModelList::replaceOrAddModelsWithString
+            static ModelIds replaceOrAdd(const ModelIds &ids, const ModelIds &addOrReplace);
+
+            //! \copydoc CAircraftModelList::findByIcaoDesignators
+            ModelIds findByIcaoDesignators(const ModelIds &ids, const Aviation::CAircraftIcaoCode &aircraftIcaoCode, const Aviation::CAirlineIcaoCode &airlineIcaoCode) const;
+
+            //! \copydoc CAircraftModelList::findByAircraftDesignatorAndLiveryCombinedCode
+            ModelIds findByAircraftDesignatorAndLiveryCombinedCode(const ModelIds &ids, const QString &aircraftDesignator, const QString &combinedCode) const;
+
+            //! \copydoc CAircraftModelList::findByAirlineGroup
+            ModelIds findByAirlineGroup(const ModelIds &ids, const Aviation::CAirlineIcaoCode &airline) const;
+
+            //! \copydoc CAircraftModelList::findByManufacturer
+            ModelIds findByManufacturer(const ModelIds &ids, const QString &manufacturer) const;
+
+            //! \copydoc CAircraftModelList::findByFamily
+            ModelIds findByFamily(const ModelIds &ids, const QString &family) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedType
+            ModelIds findByCombinedType(const ModelIds &ids, const QString &combinedType) const;
+
+            //! \copydoc CAircraftModelList::findByCombinedAndManufacturer
+            ModelIds findByCombinedAndManufacturer(const ModelIds &ids, const Aviation::CAircraftIcaoCode &icao) const;
+
+            //! \copydoc CAircraftModelList::findByMilitaryFlag
+            ModelIds findByMilitaryFlag(const ModelIds &ids, bool military) const;
+
+            //! \copydoc CAircraftModelList::findByVtolFlag
+            ModelIds findByVtolFlag(const ModelIds &ids, bool vtol) const;
+
+            //! \copydoc CAircraftModelList::containsVtol
+            bool containsVtol(const ModelIds &ids) const;
+
+            //! Models with model string
+            ModelIds findWithModelString(const ModelIds &ids) const;
+
+            //! Models with valid DB key
+            ModelIds findWithValidDbKey(const ModelIds &ids) const;
+
+            //! Models not marked as CAircraftModel::Exclude
+            ModelIds findNotExcluded(const ModelIds &ids) const;
+
+        private:
+            //! Ids contained in the index list, in order of the ids
+            ModelIds intersect(const ModelIds &ids, const ModelIds &indexedIds) const;
+
+            //! Ids for which predicate is true
+            template <class Predicate>
+            ModelIds filter(const ModelIds &ids, Predicate predicate) const;
+
+            //! Indexed ids for key, empty if not found
+            template <class Key>
+            static const ModelIds &indexed(const QHash<Key, ModelIds> &index, const Key &key);
+
+            CAircraftModelList m_models;
+            ModelIds m_all;
+            QHash<QString, ModelIds> m_byAircraftDesignator; //!< aircraft ICAO designator
+            QHash<QString, ModelIds> m_byAirlineDesignator;  //!< airline ICAO designator
+            QHash<QString, ModelIds> m_byFamily;             //!< aircraft family
+            QHash<QString, ModelIds> m_byCombinedType;       //!< combined type such as L2J
+            QHash<QString, ModelIds> m_byManufacturer;       //!< aircraft manufacturer
+            QHash<QString, ModelIds> m_byLiveryCombinedCode; //!< livery combined code
+            QHash<int, ModelIds>     m_byAirlineGroupId;     //!< airline group id
+            QHash<QString, ModelId>  m_byModelString;        //!< upper case model string
+            QVector<bool> m_military;
+            QVector<bool> m_vtol;
+        };
+    } // namespace
+} // namespace
+
+#endif // guard
@@ -12,6 +12,8 @@
 #include "blackmisc/simulation/simulatedaircraft.h"
 
 #include <QThread>
+#include <algorithm>
+#include <limits>
 
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::PhysicalQuantities;
@@ -23,69 +25,114 @@ namespace BlackMisc::Simulation
     CAirspaceAircraftSnapshot::CAirspaceAircraftSnapshot()
     { }
 
+    namespace
+    {
+        //! Aircraft sorted by distance
+        QVector<CAirspaceAircraftSnapshot::AircraftByDistance> sortedByDistance(const CSimulatedAircraftList &allAircraft)
+        {
+            QVector<CAirspaceAircraftSnapshot::AircraftByDistance> aircraft;
+            aircraft.reserve(allAircraft.size());
+            for (const CSimulatedAircraft &a : allAircraft)
+            {
+                aircraft.push_back(CAirspaceAircraftSnapshot::AircraftByDistance::fromAircraft(a));
+            }
+            std::sort(aircraft.begin(), aircraft.end(), &CAirspaceAircraftSnapshot::AircraftByDistance::lessByDistance);
+            return aircraft;
+        }
+    }
+
+    CAirspaceAircraftSnapshot::AircraftByDistance CAirspaceAircraftSnapshot::AircraftByDistance::fromAircraft(const CSimulatedAircraft &aircraft)
+    {
+        AircraftByDistance a;
+        a.callsign = aircraft.getCallsign();
+        const CLength &distance = aircraft.getRelativeDistance();
+        a.distanceM = distance.isNull() ? std::numeric_limits<double>::infinity() : distance.value(CLengthUnit::m());
+        a.enabled = aircraft.isEnabled();
+        a.rendered = aircraft.isRendered();
+        a.vtol = aircraft.isVtol();
+        return a;
+    }
+
+    bool CAirspaceAircraftSnapshot::AircraftByDistance::lessByDistance(const AircraftByDistance &a, const AircraftByDistance &b)
+    {
+        if (a.distanceM != b.distanceM) { return a.distanceM < b.distanceM; }
+        if (a.rendered != b.rendered) { return a.rendered; } // get the rendered first
+        return a.callsign.asString() < b.callsign.asString();
+    }
+
     CAirspaceAircraftSnapshot::CAirspaceAircraftSnapshot(
         const CSimulatedAircraftList &allAircraft,
         bool restricted, bool renderingEnabled, int maxAircraft,
         const CLength &maxRenderedDistance) :
+        CAirspaceAircraftSnapshot(sortedByDistance(allAircraft), restricted, renderingEnabled, maxAircraft, maxRenderedDistance)
+    { }
+
+    CAirspaceAircraftSnapshot::CAirspaceAircraftSnapshot(
+        const QVector<AircraftByDistance> &aircraftByDistance,
+        bool restricted, bool renderingEnabled, int maxAircraft,
+        const CLength &maxRenderedDistance) :
         m_timestampMsSinceEpoch(QDateTime::currentMSecsSinceEpoch()),
         m_restricted(restricted),
         m_renderingEnabled(renderingEnabled),
         m_threadName(QThread::currentThread()->objectName())
     {
-        if (allAircraft.isEmpty()) { return; }
-
-        CSimulatedAircraftList aircraft(allAircraft);
-        aircraft.sortByDistanceToReferencePositionRenderedCallsign();
-        const int numberAll = aircraft.size();
-        Q_ASSERT_X(numberAll == allAircraft.size(), Q_FUNC_INFO, "aircraft got lost");
-        const CSimulatedAircraftList vtolAircraft(aircraft.findByVtol(true));
-        const int numberVtol = vtolAircraft.size();
-        m_aircraftCallsignsByDistance = aircraft.getCallsigns();
-        Q_ASSERT_X(m_aircraftCallsignsByDistance.size() == allAircraft.size(), Q_FUNC_INFO, "redundant or missing callsigns");
-        m_vtolAircraftCallsignsByDistance = vtolAircraft.getCallsigns();
-        Q_ASSERT_X(m_vtolAircraftCallsignsByDistance.size() == numberVtol, Q_FUNC_INFO, "redundant or missing callsigns");
+        if (aircraftByDistance.isEmpty()) { return; }
+
+        const int numberAll = aircraftByDistance.size();
+        for (const AircraftByDistance &aircraft : aircraftByDistance)
+        {
+            m_aircraftCallsignsByDistance.push_back(aircraft.callsign);
+            if (aircraft.vtol) { m_vtolAircraftCallsignsByDistance.push_back(aircraft.callsign); }
+        }
+        Q_ASSERT_X(m_aircraftCallsignsByDistance.size() == numberAll, Q_FUNC_INFO, "redundant or missing callsigns");
 
         // no restrictions, just find by attributes
         if (!restricted)
         {
-            m_enabledAircraftCallsignsByDistance = aircraft.findByEnabled(true).getCallsigns();
-            m_disabledAircraftCallsignsByDistance = aircraft.findByEnabled(false).getCallsigns();
-            int numberEnabled = m_enabledAircraftCallsignsByDistance.size();
-            int numberDisabled = m_disabledAircraftCallsignsByDistance.size();
-            Q_ASSERT_X(numberEnabled + numberDisabled == numberAll, Q_FUNC_INFO, "Mismatch in enabled/disabled/all");
-            m_enabledVtolAircraftCallsignsByDistance = vtolAircraft.findByEnabled(true).getCallsigns();
+            for (const AircraftByDistance &aircraft : aircraftByDistance)
+            {
+                if (aircraft.enabled)
+                {
+                    m_enabledAircraftCallsignsByDistance.push_back(aircraft.callsign);
+                    if (aircraft.vtol) { m_enabledVtolAircraftCallsignsByDistance.push_back(aircraft.callsign); }
+                }
+                else
+                {
+                    m_disabledAircraftCallsignsByDistance.push_back(aircraft.callsign);
+                }
+            }
+            Q_ASSERT_X(m_enabledAircraftCallsignsByDistance.size() + m_disabledAircraftCallsignsByDistance.size() == numberAll, Q_FUNC_INFO, "Mismatch in enabled/disabled/all");
             return;
         }
 
         // no rendering, this means all aircraft are disabled
         if (!m_renderingEnabled)
         {
-            m_disabledAircraftCallsignsByDistance = aircraft.getCallsigns();
+            m_disabledAircraftCallsignsByDistance = m_aircraftCallsignsByDistance;
             return;
         }
 
         // restricted
+        const double maxDistanceM = maxRenderedDistance.isNull() ? std::numeric_limits<double>::infinity() : maxRenderedDistance.value(CLengthUnit::m());
         int count = 0; // when max. aircraft reached?
-        for (const CSimulatedAircraft &currentAircraft : aircraft)
+        for (const AircraftByDistance &aircraft : aircraftByDistance)
         {
-            const CCallsign cs(currentAircraft.getCallsign());
-            if (currentAircraft.isEnabled())
+            if (aircraft.enabled)
             {
-                CLength distance(currentAircraft.getRelativeDistance());
-                if (count >= maxAircraft || (!maxRenderedDistance.isNull() && distance >= maxRenderedDistance))
+                if (count >= maxAircraft || (!maxRenderedDistance.isNull() && aircraft.distanceM >= maxDistanceM))
                 {
-                    m_disabledAircraftCallsignsByDistance.push_back(cs);
+                    m_disabledAircraftCallsignsByDistance.push_back(aircraft.callsign);
                 }
                 else
                 {
                     count++;
-                    m_enabledAircraftCallsignsByDistance.push_back(cs);
-                    if (currentAircraft.isVtol()) { m_enabledVtolAircraftCallsignsByDistance.push_back(cs); }
+                    m_enabledAircraftCallsignsByDistance.push_back(aircraft.callsign);
+                    if (aircraft.vtol) { m_enabledVtolAircraftCallsignsByDistance.push_back(aircraft.callsign); }
                 }
             }
             else
             {
-                m_disabledAircraftCallsignsByDistance.push_back(cs);
+                m_disabledAircraftCallsignsByDistance.push_back(aircraft.callsign);
             }
         }
     }
@@ -95,6 +142,15 @@ namespace BlackMisc::Simulation
         return m_timestampMsSinceEpoch > 0;
     }
 
+    bool CAirspaceAircraftSnapshot::hasSameAircraft(const CAirspaceAircraftSnapshot &snapshot) const
+    {
+        return m_aircraftCallsignsByDistance == snapshot.m_aircraftCallsignsByDistance &&
+               m_enabledAircraftCallsignsByDistance == snapshot.m_enabledAircraftCallsignsByDistance &&
+               m_disabledAircraftCallsignsByDistance == snapshot.m_disabledAircraftCallsignsByDistance &&
+               m_vtolAircraftCallsignsByDistance == snapshot.m_vtolAircraftCallsignsByDistance &&
+               m_enabledVtolAircraftCallsignsByDistance == snapshot.m_enabledVtolAircraftCallsignsByDistance;
+    }
+
     void CAirspaceAircraftSnapshot::setRestrictionChanged(const CAirspaceAircraftSnapshot &snapshot)
     {
         if (this->isValidSnapshot() == snapshot.isValidSnapshot())
@@ -23,6 +23,7 @@
 #include <QDateTime>
 #include <QMetaType>
 #include <QString>
+#include <QVector>
 #include <QtGlobal>
 
 BLACK_DECLARE_VALUEOBJECT_MIXINS(BlackMisc::Simulation, CAirspaceAircraftSnapshot)
@@ -33,6 +34,22 @@ namespace BlackMisc::Simulation
     class BLACKMISC_EXPORT CAirspaceAircraftSnapshot : public CValueObject<CAirspaceAircraftSnapshot>
     {
     public:
+        //! The values of an aircraft needed for a snapshot
+        struct BLACKMISC_EXPORT AircraftByDistance
+        {
+            Aviation::CCallsign callsign; //!< callsign
+            double distanceM = 0;         //!< relative distance in m, infinity if unknown
+            bool enabled = false;         //!< enabled for rendering
+            bool rendered = false;        //!< rendered in simulator
+            bool vtol = false;            //!< VTOL aircraft
+
+            //! From aircraft
+            static AircraftByDistance fromAircraft(const CSimulatedAircraft &aircraft);
+
+            //! Closer? Same order as CSimulatedAircraftList::sortByDistanceToReferencePositionRenderedCallsign
+            static bool lessByDistance(const AircraftByDistance &a, const AircraftByDistance &b);
+        };
+
         //! Default constructor
         CAirspaceAircraftSnapshot();
 
@@ -43,6 +60,12 @@ namespace BlackMisc::Simulation
                                     int maxAircraft       = 100,
                                     const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance = { 0, nullptr });
 
+        //! Constructor from aircraft already sorted by AircraftByDistance::lessByDistance
+        //! \remark used by the airspace analyzer, which keeps its aircraft sorted
+        CAirspaceAircraftSnapshot(const QVector<AircraftByDistance> &aircraftByDistance,
+                                    bool restricted, bool renderingEnabled, int maxAircraft,
+                                    const BlackMisc::PhysicalQuantities::CLength &maxRenderedDistance);
+
         //! Time when snapshot was taken
         const QDateTime getTimestamp() const { return QDateTime::fromMSecsSinceEpoch(m_timestampMsSinceEpoch); }
 
@@ -76,6 +99,10 @@ namespace BlackMisc::Simulation
         //! Restricted values?
         bool isRestricted() const { return m_restricted; }
 
+        //! Same aircraft and same enabled/disabled/VTOL aircraft as in the other snapshot?
+        //! \remark the snapshots only differ in distances and timestamp then, the simulator would not change anything
+        bool hasSameAircraft(const CAirspaceAircraftSnapshot &snapshot) const;
+
         //! Rendering enabled or all aircraft disabled?
         bool isRenderingEnabled() const { return m_renderingEnabled; }
 
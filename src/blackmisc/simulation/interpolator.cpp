@@ -88,10 +88,11 @@ namespace BlackMisc::Simulation
     }
 
     template<typename Derived>
-    CAircraftSituationList CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
+    CCompactAircraftSituationList CInterpolator<Derived>::remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup)
     {
         // const bool vtol = setup.isForcingFullInterpolation() || m_model.isVtol();
-        CAircraftSituationList validSituations = this->remoteAircraftSituations(m_callsign);
+        // compact situations, only the situations used for the interpolation are converted to value objects
+        CCompactAircraftSituationList validSituations = this->remoteAircraftSituationsCompact(m_callsign);
 
         // get the changes, we need the second value as we want to look in the past
         // the first value is already based on the latest situation
@@ -398,7 +399,7 @@ namespace BlackMisc::Simulation
             log.cgAboveGround = currentSituation.getCG();
             log.sceneryOffset = m_currentSceneryOffset;
             log.noInvalidSituations = m_invalidSituations;
-            log.noNetworkSituations = m_currentSituations.sizeInt();
+            log.noNetworkSituations = m_currentSituations.size();
             log.useParts = this->isRemoteAircraftSupportingParts(m_callsign);
             m_logger->logInterpolation(log);
 
@@ -725,7 +726,7 @@ namespace BlackMisc::Simulation
         }
 
         bool success = false;
-        const int situationsSize = m_currentSituations.sizeInt();
+        const int situationsSize = m_currentSituations.size();
         m_currentInterpolationStatus.setSituationsCount(situationsSize);
         if (m_currentSituations.isEmpty())
         {
@@ -757,7 +758,7 @@ namespace BlackMisc::Simulation
     {
         if (m_currentSituations.isEmpty()) { return CAircraftSituation::null(); }
 
-        CAircraftSituation currentSituation = m_lastSituation.isNull() ? m_currentSituations.front() : m_lastSituation;
+        CAircraftSituation currentSituation = m_lastSituation.isNull() ? m_currentSituations.front().toSituation() : m_lastSituation;
         if (currentSituation.getCallsign() != m_callsign)
         {
             BLACK_VERIFY_X(false, Q_FUNC_INFO, "Wrong callsign");
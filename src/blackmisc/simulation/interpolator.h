@@ -19,6 +19,7 @@
 #include "blackmisc/aviation/aircraftsituationchange.h"
 #include "blackmisc/aviation/aircraftsituation.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
+#include "blackmisc/aviation/compactaircraftsituation.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/logcategories.h"
 #include "blackmisc/statusmessagelist.h"
@@ -285,7 +286,7 @@ namespace BlackMisc
             // values for current interpolation step
             qint64 m_currentTimeMsSinceEpoch = -1;                      //!< current time
             qint64 m_lastInvalidLogTs = -1;                             //!< last invalid situation timestamp
-            Aviation::CAircraftSituationList m_currentSituations;       //!< current situations obtained by remoteAircraftSituationsAndChange
+            Aviation::CCompactAircraftSituationList m_currentSituations; //!< current situations obtained by remoteAircraftSituationsAndChange
             Aviation::CAircraftSituationChange m_pastSituationsChange;  //!< situations change of provider (i.e. network) situations
             CInterpolationAndRenderingSetupPerCallsign m_currentSetup;  //!< used setup
             CInterpolationStatus m_currentInterpolationStatus;          //!< this step's situation status
@@ -322,7 +323,7 @@ namespace BlackMisc
 
             //! Get situations and calculate change, also correct altitudes if applicable
             //! \remark calculates offset (scenery) and situations change
-            Aviation::CAircraftSituationList remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup);
+            Aviation::CCompactAircraftSituationList remoteAircraftSituationsAndChange(const CInterpolationAndRenderingSetupPerCallsign &setup);
 
             //! Center of gravity, fetched from provider in case needed
             PhysicalQuantities::CLength getAndFetchModelCG(const PhysicalQuantities::CLength &dbCG);
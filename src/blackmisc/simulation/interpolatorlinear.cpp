@@ -11,6 +11,7 @@
 #include "blackmisc/aviation/aircraftsituationlist.h"
 #include "blackmisc/aviation/altitude.h"
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/logmessage.h"
@@ -81,13 +82,11 @@ namespace BlackMisc::Simulation
 
         // Interpolate altitude: Alt = (AltB - AltA) * t + AltA
         // avoid underflow below ground elevation by using getCorrectedAltitude
-        const CAltitude oldAlt(m_oldSituation.getCorrectedAltitude());
-        const CAltitude newAlt(m_newSituation.getCorrectedAltitude());
-        Q_ASSERT_X(oldAlt.getReferenceDatum() == CAltitude::MeanSeaLevel && oldAlt.getReferenceDatum() == newAlt.getReferenceDatum(), Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
-        const CAltitude altitude((newAlt - oldAlt)
-                                    * tf
-                                    + oldAlt,
-                                    oldAlt.getReferenceDatum());
+        // corrected altitudes are the altitude or the ground elevation, both MSL
+        Q_ASSERT_X(m_oldSituation.getAltitude().getReferenceDatum() == CAltitude::MeanSeaLevel && m_newSituation.getAltitude().getReferenceDatum() == CAltitude::MeanSeaLevel, Q_FUNC_INFO, "mismatch in reference"); // otherwise no calculation is possible
+        const CFixedLength<Fixed::ft> oldAlt = m_oldSituation.getCorrectedAltitudeFt();
+        const CFixedLength<Fixed::ft> newAlt = m_newSituation.getCorrectedAltitudeFt();
+        const CAltitude altitude(((newAlt - oldAlt) * tf + oldAlt).value(), CAltitude::MeanSeaLevel, CLengthUnit::ft());
 
         CAircraftSituation newSituation(situation);
         newSituation.setPosition(newPosition);
@@ -148,7 +147,7 @@ namespace BlackMisc::Simulation
                 // no before situations
                 if (situationsOlder.isEmpty())
                 {
-                    const CAircraftSituation currentSituation(*(situationsNewer.end() - 1)); // oldest newest
+                    const CAircraftSituation currentSituation((situationsNewer.end() - 1)->toSituation()); // oldest newest
                     m_currentInterpolationStatus.setInterpolatedAndCheckSituation(false, currentSituation);
                     m_interpolant = { currentSituation };
                     return m_interpolant;
@@ -157,20 +156,20 @@ namespace BlackMisc::Simulation
                 // only one before situation
                 if (situationsOlder.size() < 2)
                 {
-                    const CAircraftSituation currentSituation(situationsOlder.front()); // latest oldest
+                    const CAircraftSituation currentSituation(situationsOlder.front().toSituation()); // latest oldest
                     m_currentInterpolationStatus.setInterpolatedAndCheckSituation(false, currentSituation);
                     m_interpolant = { currentSituation };
                     return m_interpolant;
                 }
 
                 // extrapolate from two before situations
-                oldSituation = *(situationsOlder.begin() + 1); // before newest
-                newSituation = situationsOlder.front(); // newest
+                oldSituation = (situationsOlder.begin() + 1)->toSituation(); // before newest
+                newSituation = situationsOlder.front().toSituation(); // newest
             }
             else
             {
-                oldSituation = situationsOlder.front(); // first oldest (aka newest oldest)
-                newSituation = *(situationsNewer.end() - 1); // latest newest (aka oldest of newer block)
+                oldSituation = situationsOlder.front().toSituation(); // first oldest (aka newest oldest)
+                newSituation = (situationsNewer.end() - 1)->toSituation(); // latest newest (aka oldest of newer block)
                 Q_ASSERT(oldSituation.getAdjustedMSecsSinceEpoch() < newSituation.getAdjustedMSecsSinceEpoch());
             }
 
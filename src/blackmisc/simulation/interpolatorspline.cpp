@@ -9,6 +9,7 @@
 #include "blackmisc/simulation/interpolatorspline.h"
 #include "blackmisc/simulation/interpolatorfunctions.h"
 #include "blackmisc/network/fsdsetup.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/logmessage.h"
 #include "blackmisc/verify.h"
 #include "blackconfig/buildconfig.h"
@@ -120,7 +121,7 @@ namespace BlackMisc::Simulation
             else
             {
                 // we start with the latest situation just to init the values
-                CAircraftSituation f = m_currentSituations.front();
+                CAircraftSituation f = m_currentSituations.front().toSituation();
                 f.setAdjustedMSecsSinceEpoch(m_currentTimeMsSinceEpoch); // adjusted time exactly "now"
                 m_s[0] = m_s[1] = m_s[2] = f;
             }
@@ -139,7 +140,7 @@ namespace BlackMisc::Simulation
 
         // and use the real values if available
         // m_s[0] .. oldest -> m_[2] .. latest
-        const CAircraftSituation latest = m_currentSituations.front();
+        const CAircraftSituation latest = m_currentSituations.front().toSituation();
         if (latest.isNewerThanAdjusted(m_s[1])) { m_s[2] = latest; }
         const qint64 currentAdjusted = m_s[1].getAdjustedMSecsSinceEpoch();
 
@@ -218,11 +219,10 @@ namespace BlackMisc::Simulation
             // - and the elevation remains (almost) constant for a wider area
             // - during flying the ground elevation not really matters
             this->updateElevations(true);
-            static const CLengthUnit altUnit = CAltitude::defaultUnit();
-            const CLength cg(this->getModelCG().switchedUnit(altUnit));
-            const double a0 = m_s[0].getCorrectedAltitude(cg).value(altUnit); // oldest
-            const double a1 = m_s[1].getCorrectedAltitude(cg).value(altUnit);
-            const double a2 = m_s[2].getCorrectedAltitude(cg).value(altUnit); // latest
+            const CFixedLength<Fixed::ft> cg = CFixedLength<Fixed::ft>::fromQuantity(this->getModelCG());
+            const double a0 = m_s[0].getCorrectedAltitudeFt(cg).value(); // oldest
+            const double a1 = m_s[1].getCorrectedAltitudeFt(cg).value();
+            const double a2 = m_s[2].getCorrectedAltitudeFt(cg).value(); // latest
             pa.a    = {{ a0, a1, a2 }};
             pa.gnd  = {{ m_s[0].getOnGroundFactor(), m_s[1].getOnGroundFactor(), m_s[2].getOnGroundFactor() }};
             pa.da   = getDerivatives(pa.t, pa.a);
@@ -232,7 +232,7 @@ namespace BlackMisc::Simulation
             m_nextSampleAdjustedTime = m_s[2].getAdjustedMSecsSinceEpoch(); // latest
             m_prevSampleTime = m_s[1].getMSecsSinceEpoch(); // last interpolated situation normally
             m_nextSampleTime = m_s[2].getMSecsSinceEpoch(); // latest
-            m_interpolant = CInterpolant(pa, altUnit, CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
+            m_interpolant = CInterpolant(pa, CLengthUnit::ft(), CInterpolatorPbh(m_s[1], m_s[2])); // older, newer
             Q_ASSERT_X(m_prevSampleAdjustedTime < m_nextSampleAdjustedTime, Q_FUNC_INFO, "Wrong time order");
         }
 
@@ -45,6 +45,31 @@ namespace BlackMisc::Simulation
                         sv.isModified(), sv.isRerun())
     { }
 
+    void MSInOutValues::initByModel(const CAircraftModel &model)
+    {
+        const MSInOutValues values(model);
+        m_callsign         = values.m_callsign;
+        m_callsignAsSet    = values.m_callsignAsSet;
+        m_flightNumber     = values.m_flightNumber;
+        m_aircraftIcao     = values.m_aircraftIcao;
+        m_aircraftFamily   = values.m_aircraftFamily;
+        m_combinedType     = values.m_combinedType;
+        m_airlineIcao      = values.m_airlineIcao;
+        m_vAirlineIcao     = values.m_vAirlineIcao;
+        m_livery           = values.m_livery;
+        m_modelString      = values.m_modelString;
+        m_dbAircraftIcaoId = values.m_dbAircraftIcaoId;
+        m_dbAirlineIcaoId  = values.m_dbAirlineIcaoId;
+        m_dbLiveryId       = values.m_dbLiveryId;
+        m_dbModelId        = values.m_dbModelId;
+        m_logMessage       = values.m_logMessage;
+        m_modifiedAircraftDesignator = values.m_modifiedAircraftDesignator;
+        m_modifiedAircraftFamily     = values.m_modifiedAircraftFamily;
+        m_modifiedAirlineDesignator  = values.m_modifiedAirlineDesignator;
+        m_modified = values.m_modified;
+        m_rerun    = values.m_rerun;
+    }
+
     void MSInOutValues::setCallsign(const QString &callsign)
     {
         if (m_callsign == callsign) { return; }
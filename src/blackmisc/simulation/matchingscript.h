@@ -93,6 +93,9 @@ namespace BlackMisc::Simulation
         //! Ctor
         MSInOutValues(const MSInOutValues &sv);
 
+        //! Init all values by model, like MSInOutValues(const CAircraftModel &), so the object can be reused
+        void initByModel(const BlackMisc::Simulation::CAircraftModel &model);
+
         //! Callsign values
         //! @{
         const QString &getCallsign()      const { return m_callsign; }
@@ -322,7 +325,7 @@ namespace BlackMisc::Simulation
     private:
         QString m_simulator;
         bool m_available = false;
-        int m_inputAircraftAndAirlineCount; //! values in set for airline and aircraft
+        int m_inputAircraftAndAirlineCount = 0; //! values in set for airline and aircraft
         BlackMisc::Simulation::CAircraftModelList m_modelSet;
     };
 
@@ -70,17 +70,30 @@ namespace BlackMisc::Simulation
 
     CAircraftSituationList CRemoteAircraftProvider::remoteAircraftSituations(const CCallsign &callsign) const
     {
-        static const CAircraftSituationList empty;
-        QReadLocker l(&m_lockSituations);
-        if (!m_situationsByCallsign.contains(callsign)) { return empty; }
-        return m_situationsByCallsign[callsign];
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return {}; }
+
+        // implicitly shared, the list is only built once after the situations have been updated
+        QReadLocker l(&data->lockSituations);
+        return data->situationsAsList();
+    }
+
+    CCompactAircraftSituationList CRemoteAircraftProvider::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return {}; }
+
+        // copied as one block, no value objects are created
+        QReadLocker l(&data->lockSituations);
+        return data->situationsAsCompactList();
     }
 
     CAircraftSituation CRemoteAircraftProvider::remoteAircraftSituation(const CCallsign &callsign, int index) const
     {
-        const CAircraftSituationList situations = this->remoteAircraftSituations(callsign);
-        if (index < 0 || index >= situations.size()) { return CAircraftSituation::null(); }
-        return situations[index];
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return CAircraftSituation::null(); }
+        QReadLocker l(&data->lockSituations);
+        return data->situations.indexOrNull(index);
     }
 
     MillisecondsMinMaxMean CRemoteAircraftProvider::remoteAircraftSituationsTimestampDifferenceMinMaxMean(const CCallsign &callsign) const
@@ -91,70 +104,92 @@ namespace BlackMisc::Simulation
 
     CAircraftSituationList CRemoteAircraftProvider::latestRemoteAircraftSituations() const
     {
-        QReadLocker l(&m_lockSituations);
-        const QList<CAircraftSituation> situations(m_latestSituationByCallsign.values());
-        l.unlock();
-        return CAircraftSituationList(situations);
+        CAircraftSituationList situations;
+        for (const RemoteAircraftDataPtr &data : this->allRemoteAircraftData())
+        {
+            QReadLocker l(&data->lockSituations);
+            if (data->latestSituation.hasCallsign()) { situations.push_back(data->latestSituation); }
+        }
+        return situations;
     }
 
     CAircraftSituationList CRemoteAircraftProvider::latestOnGroundProviderElevations() const
     {
-        QReadLocker l(&m_lockSituations);
-        const QList<CAircraftSituation> situations(m_latestOnGroundProviderElevation.values());
-        l.unlock();
-        return CAircraftSituationList(situations);
+        CAircraftSituationList situations;
+        for (const RemoteAircraftDataPtr &data : this->allRemoteAircraftData())
+        {
+            QReadLocker l(&data->lockSituations);
+            if (data->latestOnGroundProviderElevation.hasCallsign()) { situations.push_back(data->latestOnGroundProviderElevation); }
+        }
+        return situations;
     }
 
     int CRemoteAircraftProvider::remoteAircraftSituationsCount(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockSituations);
-        if (!m_situationsByCallsign.contains(callsign)) { return -1; }
-        return m_situationsByCallsign[callsign].size();
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return -1; }
+        QReadLocker l(&data->lockSituations);
+        return data->situations.size();
     }
 
     CAircraftPartsList CRemoteAircraftProvider::remoteAircraftParts(const CCallsign &callsign) const
     {
-        static const CAircraftPartsList empty;
-        QReadLocker l(&m_lockParts);
-        if (!m_partsByCallsign.contains(callsign)) { return empty; }
-        return m_partsByCallsign[callsign];
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return {}; }
+        QReadLocker l(&data->lockParts);
+        return data->parts;
     }
 
     int CRemoteAircraftProvider::remoteAircraftPartsCount(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockParts);
-        if (!m_partsByCallsign.contains(callsign)) { return -1; }
-        return m_partsByCallsign[callsign].size();
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return -1; }
+        QReadLocker l(&data->lockParts);
+        return data->parts.size();
     }
 
     bool CRemoteAircraftProvider::isRemoteAircraftSupportingParts(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockParts);
-        return m_aircraftWithParts.contains(callsign);
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return false; }
+        QReadLocker l(&data->lockParts);
+        return data->supportsParts;
     }
 
     int CRemoteAircraftProvider::getRemoteAircraftSupportingPartsCount() const
     {
-        QReadLocker l(&m_lockParts);
-        return m_aircraftWithParts.size();
+        return this->remoteAircraftSupportingParts().size();
     }
 
     CCallsignSet CRemoteAircraftProvider::remoteAircraftSupportingParts() const
     {
-        QReadLocker l(&m_lockParts);
-        return m_aircraftWithParts;
+        QReadLocker l(&m_lockRemoteAircraftData);
+        const CPerCallsign<RemoteAircraftDataPtr> remoteAircraftData = m_remoteAircraftData;
+        l.unlock();
+
+        CCallsignSet callsigns;
+        for (auto it = remoteAircraftData.cbegin(); it != remoteAircraftData.cend(); ++it)
+        {
+            QReadLocker lp(&it.value()->lockParts);
+            if (it.value()->supportsParts) { callsigns.insert(it.key()); }
+        }
+        return callsigns;
     }
 
     CAircraftSituationChangeList CRemoteAircraftProvider::remoteAircraftSituationChanges(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockChanges);
-        return m_changesByCallsign[callsign];
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return {}; }
+        QReadLocker l(&data->lockSituations);
+        return data->changes;
     }
 
     int CRemoteAircraftProvider::remoteAircraftSituationChangesCount(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockChanges);
-        return m_changesByCallsign[callsign].size();
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return 0; }
+        QReadLocker l(&data->lockSituations);
+        return data->changes.size();
     }
 
     int CRemoteAircraftProvider::getAircraftInRangeCount() const
@@ -169,25 +204,12 @@ namespace BlackMisc::Simulation
 
         // locked members
         {
-            QWriteLocker l(&m_lockParts);
-            m_partsByCallsign.clear();
-            m_aircraftWithParts.clear();
-            m_partsAdded = 0;
-            m_partsLastModified.clear();
-        }
-        {
-            QWriteLocker l(&m_lockSituations);
-            m_situationsByCallsign.clear();
-            m_latestSituationByCallsign.clear();
-            m_latestOnGroundProviderElevation.clear();
+            QWriteLocker l(&m_lockRemoteAircraftData);
+            m_remoteAircraftData.clear();
             m_situationsAdded = 0;
-            m_situationsLastModified.clear();
-            m_testOffset.clear();
-        }
-        {
-            QWriteLocker l(&m_lockChanges);
-            m_changesByCallsign.clear();
+            m_partsAdded = 0;
         }
+        { QWriteLocker l(&m_lockTestOffset); m_testOffset.clear(); }
 
         { QWriteLocker l(&m_lockPartsHistory); m_aircraftPartsMessages.clear(); }
         { QWriteLocker l(&m_lockMessages); m_reverseLookupMessages.clear(); }
@@ -276,45 +298,36 @@ namespace BlackMisc::Simulation
         }
 
         // list from new to old
+        const RemoteAircraftDataPtr data = this->remoteAircraftDataOrCreate(cs);
         CAircraftSituationList updatedSituations; // copy of updated situations
+        CAircraftSituationChange change;
         {
             const qint64 now = QDateTime::currentMSecsSinceEpoch();
-            QWriteLocker lock(&m_lockSituations);
             m_situationsAdded++;
-            m_situationsLastModified[cs] = now;
-            CAircraftSituationList &newSituationsList = m_situationsByCallsign[cs];
-            newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-            const int situations = newSituationsList.size();
-            if (situations < 1)
+            QWriteLocker lock(&data->lockSituations);
+            CAircraftSituationRingBuffer &newSituations = data->situations;
+            if (newSituations.isEmpty())
             {
-                newSituationsList.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
+                newSituations.prefillLatestAdjustedFirst(situationCorrected, IRemoteAircraftProvider::MaxSituationsPerCallsign);
             }
-            else if (!situationCorrected.hasVelocity() && newSituationsList.front().hasVelocity())
+            else if (!situationCorrected.hasVelocity() && newSituations.compact(0).hasVelocity)
             {
                 return situationCorrected;
             }
             else
             {
-                // newSituationsList.push_frontKeepLatestFirstIgnoreOverlapping(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                newSituationsList.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
-                newSituationsList.setAdjustedSortHint(CAircraftSituationList::AdjustedTimestampLatestFirst);
-                newSituationsList.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
+                // fixed capacity, the oldest situation is overwritten
+                newSituations.push_frontKeepLatestFirstAdjustOffset(situationCorrected, true);
+                newSituations.transferElevationForward(); // transfer elevations, will do nothing if elevations already exist
 
                 // unify all inbound ground information
                 if (situation.hasInboundGroundDetails())
                 {
-                    newSituationsList.setOnGroundDetails(situation.getOnGroundDetails());
+                    newSituations.setOnGroundDetails(situation.getOnGroundDetails());
                 }
             }
-            m_latestSituationByCallsign[cs] = situationCorrected;
-
-            // check sort order
-            if (CBuildConfig::isLocalDeveloperDebugBuild())
-            {
-                BLACK_VERIFY_X(newSituationsList.isSortedAdjustedLatestFirstWithoutNullPositions(), Q_FUNC_INFO, "wrong adjusted sort order");
-                BLACK_VERIFY_X(newSituationsList.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
-                BLACK_VERIFY_X(newSituationsList.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
-            }
+            data->situationsLastModified = now;
+            data->latestSituation = situationCorrected;
 
             if (!situation.hasInboundGroundDetails())
             {
@@ -322,15 +335,27 @@ namespace BlackMisc::Simulation
                 const CAircraftSituationChange simpleChange(updatedSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true, false);
 
                 // guess GND
-                simpleChange.guessOnGround(newSituationsList.front(), aircraftModel);
+                CAircraftSituation latest = newSituations.front();
+                simpleChange.guessOnGround(latest, aircraftModel);
+                newSituations.setFront(latest);
             }
-            updatedSituations = m_situationsByCallsign[cs];
 
+            // the list for the readers is only built when read
+            data->invalidateSituationsList();
+
+            // check sort order
+            if (CBuildConfig::isLocalDeveloperDebugBuild())
+            {
+                BLACK_VERIFY_X(newSituations.isSortedAdjustedLatestFirst(), Q_FUNC_INFO, "wrong adjusted sort order");
+                BLACK_VERIFY_X(newSituations.isSortedLatestFirst(), Q_FUNC_INFO, "wrong sort order");
+                BLACK_VERIFY_X(newSituations.size() <= IRemoteAircraftProvider::MaxSituationsPerCallsign, Q_FUNC_INFO, "Wrong size");
+            }
+
+            // calculate change AFTER gnd. was guessed, directly from the compact situations
+            Q_ASSERT_X(!newSituations.isEmpty(), Q_FUNC_INFO, "Missing situations");
+            change = CAircraftSituationChange(newSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true);
         } // lock
 
-        // calculate change AFTER gnd. was guessed
-        Q_ASSERT_X(!updatedSituations.isEmpty(), Q_FUNC_INFO, "Missing situations");
-        const CAircraftSituationChange change(updatedSituations, situationCorrected.getCG(), aircraftModel.isVtol(), true, true);
         this->storeChange(change);
 
         if (change.hasSceneryDeviation())
@@ -338,9 +363,15 @@ namespace BlackMisc::Simulation
             const CLength offset = change.getGuessedSceneryDeviation();
             situationCorrected.setSceneryOffset(offset);
 
-            QWriteLocker lock(&m_lockSituations);
-            m_latestSituationByCallsign[cs].setSceneryOffset(offset);
-            m_situationsByCallsign[cs].front().setSceneryOffset(offset);
+            QWriteLocker lock(&data->lockSituations);
+            data->latestSituation.setSceneryOffset(offset);
+            if (!data->situations.isEmpty())
+            {
+                CAircraftSituation latest = data->situations.front();
+                latest.setSceneryOffset(offset);
+                data->situations.setFront(latest);
+                data->invalidateSituationsList();
+            }
         }
 
         // situation has been added
@@ -357,12 +388,14 @@ namespace BlackMisc::Simulation
 
         // list sorted from new to old
         const qint64 ts = QDateTime::currentMSecsSinceEpoch();
+        const RemoteAircraftDataPtr data = this->remoteAircraftDataOrCreate(callsign);
         CAircraftPartsList correctiveParts;
         {
-            QWriteLocker lock(&m_lockParts);
             m_partsAdded++;
-            m_partsLastModified[callsign] = ts;
-            CAircraftPartsList &partsList = m_partsByCallsign[callsign];
+            QWriteLocker lock(&data->lockParts);
+            data->partsLastModified = ts;
+            data->supportsParts = true; // mark as callsign which supports parts
+            CAircraftPartsList &partsList = data->parts;
             partsList.push_frontKeepLatestFirstAdjustOffset(parts, true, IRemoteAircraftProvider::MaxPartsPerCallsign);
             partsList.setAdjustedSortHint(CAircraftPartsList::AdjustedTimestampLatestFirst);
 
@@ -378,10 +411,10 @@ namespace BlackMisc::Simulation
         // adjust gnd.flag from parts
         if (!correctiveParts.isEmpty())
         {
-            QWriteLocker lock(&m_lockSituations);
-            CAircraftSituationList &situationList = m_situationsByCallsign[callsign];
-            const int c = situationList.adjustGroundFlag(parts);
-            if (c > 0) { m_situationsLastModified[callsign] = ts; }
+            QWriteLocker lock(&data->lockSituations);
+            const int c = data->situations.adjustGroundFlag(parts);
+            if (c > 0) { data->situationsLastModified = ts; }
+            data->invalidateSituationsList(); // details are always set
         }
 
         // update aircraft
@@ -395,13 +428,6 @@ namespace BlackMisc::Simulation
             }
         }
 
-        // update parts
-        {
-            // aircraft supporting parts
-            QWriteLocker l(&m_lockParts);
-            m_aircraftWithParts.insert(callsign); // mark as callsign which supports parts
-        }
-
         emit this->addedAircraftParts(callsign, parts);
     }
 
@@ -495,9 +521,9 @@ namespace BlackMisc::Simulation
     void CRemoteAircraftProvider::storeChange(const CAircraftSituationChange &change)
     {
         // a change with the same timestamp will be replaced
-        const CCallsign cs(change.getCallsign());
-        QWriteLocker lock(&m_lockChanges);
-        CAircraftSituationChangeList &changeList = m_changesByCallsign[cs];
+        const RemoteAircraftDataPtr data = this->remoteAircraftDataOrCreate(change.getCallsign());
+        QWriteLocker lock(&data->lockSituations);
+        CAircraftSituationChangeList &changeList = data->changes;
         changeList.push_frontKeepLatestAdjustedFirst(change, true, IRemoteAircraftProvider::MaxSituationsPerCallsign);
     }
 
@@ -516,22 +542,33 @@ namespace BlackMisc::Simulation
 
     bool CRemoteAircraftProvider::setAircraftEnabledFlag(const CCallsign &callsign, bool enabledForRendering)
     {
-        QWriteLocker l(&m_lockAircraft);
-        if (!m_aircraftInRange.contains(callsign)) { return false; }
-        return m_aircraftInRange[callsign].setEnabled(enabledForRendering);
+        CSimulatedAircraft aircraft;
+        {
+            QWriteLocker l(&m_lockAircraft);
+            if (!m_aircraftInRange.contains(callsign)) { return false; }
+            CSimulatedAircraft &aircraftInRange = m_aircraftInRange[callsign];
+            if (!aircraftInRange.setEnabled(enabledForRendering)) { return false; }
+            aircraft = aircraftInRange;
+        }
+        emit this->changedAircraftRenderingValues(aircraft);
+        return true;
     }
 
     int CRemoteAircraftProvider::updateMultipleAircraftEnabled(const CCallsignSet &callsigns, bool enabledForRendering)
     {
         if (callsigns.isEmpty()) { return 0; }
-        QWriteLocker l(&m_lockAircraft);
-        int c = 0;
-        for (const CCallsign &cs : callsigns)
+        CSimulatedAircraftList changed;
         {
-            if (!m_aircraftInRange.contains(cs)) { continue; }
-            if (m_aircraftInRange[cs].setEnabled(enabledForRendering)) { c++; }
+            QWriteLocker l(&m_lockAircraft);
+            for (const CCallsign &cs : callsigns)
+            {
+                if (!m_aircraftInRange.contains(cs)) { continue; }
+                CSimulatedAircraft &aircraftInRange = m_aircraftInRange[cs];
+                if (aircraftInRange.setEnabled(enabledForRendering)) { changed.push_back(aircraftInRange); }
+            }
         }
-        return c;
+        for (const CSimulatedAircraft &aircraft : changed) { emit this->changedAircraftRenderingValues(aircraft); }
+        return changed.size();
     }
 
     bool CRemoteAircraftProvider::updateAircraftModel(const CCallsign &callsign, const CAircraftModel &model, const CIdentifier &originator)
@@ -539,7 +576,9 @@ namespace BlackMisc::Simulation
         if (CIdentifiable::isMyIdentifier(originator)) { return false; }
         const CPropertyIndexVariantMap vm(CSimulatedAircraft::IndexModel, CVariant::from(model));
         const int c = this->updateAircraftInRange(callsign, vm);
-        return c > 0;
+        if (c < 1) { return false; }
+        emit this->changedAircraftRenderingValues(this->getAircraftInRangeForCallsign(callsign));
+        return true;
     }
 
     bool CRemoteAircraftProvider::updateAircraftNetworkModel(const CCallsign &callsign, const CAircraftModel &model, const CIdentifier &originator)
@@ -559,21 +598,33 @@ namespace BlackMisc::Simulation
 
     bool CRemoteAircraftProvider::updateAircraftRendered(const CCallsign &callsign, bool rendered)
     {
-        QWriteLocker l(&m_lockAircraft);
-        if (!m_aircraftInRange.contains(callsign)) { return false; }
-        return m_aircraftInRange[callsign].setRendered(rendered);
+        CSimulatedAircraft aircraft;
+        {
+            QWriteLocker l(&m_lockAircraft);
+            if (!m_aircraftInRange.contains(callsign)) { return false; }
+            CSimulatedAircraft &aircraftInRange = m_aircraftInRange[callsign];
+            if (!aircraftInRange.setRendered(rendered)) { return false; }
+            aircraft = aircraftInRange;
+        }
+        emit this->changedAircraftRenderingValues(aircraft);
+        return true;
     }
 
     int CRemoteAircraftProvider::updateMultipleAircraftRendered(const CCallsignSet &callsigns, bool rendered)
     {
         if (callsigns.isEmpty()) { return 0; }
-        int c = 0;
-        for (const CCallsign &cs : callsigns)
+        CSimulatedAircraftList changed;
         {
-            if (!m_aircraftInRange.contains(cs)) { continue; }
-            if (m_aircraftInRange[cs].setRendered(rendered)) { c++; }
+            QWriteLocker l(&m_lockAircraft);
+            for (const CCallsign &cs : callsigns)
+            {
+                if (!m_aircraftInRange.contains(cs)) { continue; }
+                CSimulatedAircraft &aircraftInRange = m_aircraftInRange[cs];
+                if (aircraftInRange.setRendered(rendered)) { changed.push_back(aircraftInRange); }
+            }
         }
-        return c;
+        for (const CSimulatedAircraft &aircraft : changed) { emit this->changedAircraftRenderingValues(aircraft); }
+        return changed.size();
     }
 
     int CRemoteAircraftProvider::updateAircraftGroundElevation(const CCallsign &callsign, const CElevationPlane &elevation, CAircraftSituation::GndElevationInfo info, bool *setForOnGroundPosition)
@@ -588,16 +639,22 @@ namespace BlackMisc::Simulation
 
         int updated = 0;
         {
-            QWriteLocker l(&m_lockSituations);
-            CAircraftSituationList &situations = m_situationsByCallsign[callsign];
-            if (situations.isEmpty()) { return 0; }
+            const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+            if (!data) { return 0; }
+            QWriteLocker l(&data->lockSituations);
+            if (data->situations.isEmpty()) { return 0; }
+            CAircraftSituationList situations = data->situationsAsList();
             updated = setGroundElevationCheckedAndGuessGround(situations, elevation, info, model, &change, &setForOnGndPosition);
             if (updated < 1) { return 0; }
-            m_situationsLastModified[callsign] = now;
+            data->situations.assignLatestFirst(situations);
+            data->invalidateSituationsList();
+            data->situationsList = situations;
+            data->situationsListValid = true;
+            data->situationsLastModified = now;
             const CAircraftSituation latestSituation = situations.front();
             if (info == CAircraftSituation::FromProvider && latestSituation.isOnGround())
             {
-                m_latestOnGroundProviderElevation[callsign] = latestSituation;
+                data->latestOnGroundProviderElevation = latestSituation;
             }
         }
 
@@ -680,11 +737,7 @@ namespace BlackMisc::Simulation
     void CRemoteAircraftProvider::updateMarkAllAsNotRendered()
     {
         const CCallsignSet callsigns = this->getAircraftInRangeCallsigns();
-        QWriteLocker l(&m_lockAircraft);
-        for (const CCallsign &cs : callsigns)
-        {
-            m_aircraftInRange[cs].setRendered(false);
-        }
+        this->updateMultipleAircraftRendered(callsigns, false);
     }
 
     void CRemoteAircraftProvider::enableReverseLookupMessages(ReverseLookupLogging enable)
@@ -745,13 +798,13 @@ namespace BlackMisc::Simulation
     bool CRemoteAircraftProvider::hasTestAltitudeOffset(const CCallsign &callsign) const
     {
         if (callsign.isEmpty()) { return false; }
-        QReadLocker l(&m_lockSituations);
+        QReadLocker l(&m_lockTestOffset);
         return m_testOffset.contains(callsign);
     }
 
     bool CRemoteAircraftProvider::hasTestAltitudeOffsetGlobalValue() const
     {
-        QReadLocker l(&m_lockSituations);
+        QReadLocker l(&m_lockTestOffset);
         return m_testOffset.contains(testAltitudeOffsetCallsign());
     }
 
@@ -761,7 +814,7 @@ namespace BlackMisc::Simulation
         const bool globalOffset = this->hasTestAltitudeOffsetGlobalValue();
         if (!globalOffset && !this->hasTestAltitudeOffset(cs)) { return situation; }
 
-        QReadLocker l(&m_lockSituations);
+        QReadLocker l(&m_lockTestOffset);
         const CLength os = m_testOffset.contains(cs) ? m_testOffset.value(cs) : m_testOffset.value(testAltitudeOffsetCallsign());
         if (os.isNull() || os.isZeroEpsilonConsidered()) { return situation; }
         return situation.withAltitudeOffset(os);
@@ -839,20 +892,23 @@ namespace BlackMisc::Simulation
 
     int CRemoteAircraftProvider::aircraftSituationsAdded() const
     {
-        QReadLocker l(&m_lockSituations);
         return m_situationsAdded;
     }
 
     qint64 CRemoteAircraftProvider::situationsLastModified(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockSituations);
-        return m_situationsLastModified.value(callsign, -1);
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return -1; }
+        QReadLocker l(&data->lockSituations);
+        return data->situationsLastModified;
     }
 
     qint64 CRemoteAircraftProvider::partsLastModified(const CCallsign &callsign) const
     {
-        QReadLocker l(&m_lockParts);
-        return m_partsLastModified.value(callsign, -1);
+        const RemoteAircraftDataPtr data = this->remoteAircraftData(callsign);
+        if (!data) { return -1; }
+        QReadLocker l(&data->lockParts);
+        return data->partsLastModified;
     }
 
     CElevationPlane CRemoteAircraftProvider::averageElevationOfNonMovingAircraft(const CAircraftSituation &reference, const CLength &range, int minValues, int sufficientValues) const
@@ -864,7 +920,7 @@ namespace BlackMisc::Simulation
     bool CRemoteAircraftProvider::testAddAltitudeOffset(const CCallsign &callsign, const CLength &offset)
     {
         const bool remove = offset.isNull() || offset.isZeroEpsilonConsidered();
-        QWriteLocker l(&m_lockSituations);
+        QWriteLocker l(&m_lockTestOffset);
         if (remove)
         {
             m_testOffset.remove(callsign);
@@ -877,7 +933,6 @@ namespace BlackMisc::Simulation
 
     int CRemoteAircraftProvider::aircraftPartsAdded() const
     {
-        QReadLocker l(&m_lockParts);
         return m_partsAdded;
     }
 
@@ -920,17 +975,8 @@ namespace BlackMisc::Simulation
     bool CRemoteAircraftProvider::removeAircraft(const CCallsign &callsign)
     {
         {
-            QWriteLocker l1(&m_lockParts);
-            m_partsByCallsign.remove(callsign);
-            m_aircraftWithParts.remove(callsign);
-            m_partsLastModified.remove(callsign);
-        }
-        {
-            QWriteLocker l2(&m_lockSituations);
-            m_situationsByCallsign.remove(callsign);
-            m_latestSituationByCallsign.remove(callsign);
-            m_latestOnGroundProviderElevation.remove(callsign);
-            m_situationsLastModified.remove(callsign);
+            QWriteLocker l1(&m_lockRemoteAircraftData);
+            m_remoteAircraftData.remove(callsign);
         }
         { QWriteLocker l4(&m_lockPartsHistory); m_aircraftPartsMessages.remove(callsign); }
         bool removedCallsign = false;
@@ -943,6 +989,55 @@ namespace BlackMisc::Simulation
         return removedCallsign;
     }
 
+    CRemoteAircraftProvider::RemoteAircraftDataPtr CRemoteAircraftProvider::remoteAircraftData(const CCallsign &callsign) const
+    {
+        QReadLocker l(&m_lockRemoteAircraftData);
+        return m_remoteAircraftData.value(callsign);
+    }
+
+    CRemoteAircraftProvider::RemoteAircraftDataPtr CRemoteAircraftProvider::remoteAircraftDataOrCreate(const CCallsign &callsign)
+    {
+        {
+            QReadLocker l(&m_lockRemoteAircraftData);
+            const RemoteAircraftDataPtr data = m_remoteAircraftData.value(callsign);
+            if (data) { return data; }
+        }
+
+        // the hash is only locked for writing when an aircraft is added
+        QWriteLocker l(&m_lockRemoteAircraftData);
+        RemoteAircraftDataPtr &data = m_remoteAircraftData[callsign];
+        if (!data) { data = RemoteAircraftDataPtr::create(); }
+        return data;
+    }
+
+    QList<CRemoteAircraftProvider::RemoteAircraftDataPtr> CRemoteAircraftProvider::allRemoteAircraftData() const
+    {
+        QReadLocker l(&m_lockRemoteAircraftData);
+        return m_remoteAircraftData.values();
+    }
+
+    CAircraftSituationList CRemoteAircraftProvider::RemoteAircraftData::situationsAsList() const
+    {
+        QMutexLocker l(&lockSituationsList);
+        if (!situationsListValid)
+        {
+            situationsList = situations.toList();
+            situationsListValid = true;
+        }
+        return situationsList;
+    }
+
+    CCompactAircraftSituationList CRemoteAircraftProvider::RemoteAircraftData::situationsAsCompactList() const
+    {
+        QMutexLocker l(&lockSituationsList);
+        if (!situationsCompactValid)
+        {
+            situationsCompact = situations.toCompactList();
+            situationsCompactValid = true;
+        }
+        return situationsCompact;
+    }
+
     CRemoteAircraftAware::~CRemoteAircraftAware()
     { }
 
@@ -1000,6 +1095,12 @@ namespace BlackMisc::Simulation
         return this->provider()->remoteAircraftSituations(callsign);
     }
 
+    CCompactAircraftSituationList CRemoteAircraftAware::remoteAircraftSituationsCompact(const CCallsign &callsign) const
+    {
+        Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
+        return this->provider()->remoteAircraftSituationsCompact(callsign);
+    }
+
     CAircraftSituation CRemoteAircraftAware::remoteAircraftSituation(const CCallsign &callsign, int index) const
     {
         Q_ASSERT_X(this->provider(), Q_FUNC_INFO, "No object available");
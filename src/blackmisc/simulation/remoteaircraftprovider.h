@@ -17,6 +17,7 @@
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/aviation/aircraftpartslist.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituationringbuffer.h"
 #include "blackmisc/aviation/aircraftsituationchangelist.h"
 #include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/aviation/callsignset.h"
@@ -30,7 +31,10 @@
 #include <QObject>
 #include <QJsonObject>
 #include <QtGlobal>
+#include <QMutex>
 #include <QReadWriteLock>
+#include <QSharedPointer>
+#include <atomic>
 #include <functional>
 
 namespace BlackMisc
@@ -94,6 +98,11 @@ namespace BlackMisc
             //! \threadsafe
             virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const = 0;
 
+            //! Rendered aircraft situations (per callsign, time history) as compact situations
+            //! \remark latest situations first, meant for the interpolators
+            //! \threadsafe
+            virtual Aviation::CCompactAircraftSituationList remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const = 0;
+
             //! Average update time
             //! \threadsafe
             virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const = 0;
@@ -312,6 +321,7 @@ namespace BlackMisc::Simulation
         virtual bool isAircraftInRange(const Aviation::CCallsign &callsign) const override;
         virtual bool isVtolAircraft(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const override;
+        virtual Aviation::CCompactAircraftSituationList remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const override;
         virtual MillisecondsMinMaxMean remoteAircraftSituationsTimestampDifferenceMinMaxMean(const Aviation::CCallsign &callsign) const override;
         virtual Aviation::CAircraftSituationList latestRemoteAircraftSituations() const override;
@@ -407,6 +417,10 @@ namespace BlackMisc::Simulation
         //! Aircraft were changed
         void changedAircraftInRange();
 
+        //! Enabled or rendered flag or model of an aircraft changed
+        //! \remark not emitted for position updates, see addedAircraftSituation
+        void changedAircraftRenderingValues(const BlackMisc::Simulation::CSimulatedAircraft &aircraft);
+
         //! An aircraft disappeared
         void removedAircraft(const BlackMisc::Aviation::CCallsign &callsign);
 
@@ -476,26 +490,66 @@ namespace BlackMisc::Simulation
         static int setGroundElevationCheckedAndGuessGround(Aviation::CAircraftSituationList &situations, const Geo::CElevationPlane &elevationPlane, Aviation::CAircraftSituation::GndElevationInfo info, const Simulation::CAircraftModel &model, Aviation::CAircraftSituationChange *changeOut, bool *setForOnGroundPosition);
 
     private:
+        //! Situations, parts and changes of one remote aircraft
+        //! \remark every aircraft has its own locks, so updating one aircraft does not block readers or writers of the others
+        struct RemoteAircraftData
+        {
+            mutable QReadWriteLock lockSituations;   //!< lock for situations and changes
+            mutable QReadWriteLock lockParts;        //!< lock for parts
+            mutable QMutex lockSituationsList;       //!< lock for the situations lists, readers build them while holding lockSituations for reading
+            Aviation::CAircraftSituationRingBuffer situations { IRemoteAircraftProvider::MaxSituationsPerCallsign }; //!< situations, latest first
+            mutable Aviation::CAircraftSituationList situationsList;         //!< situations as list, built once per update when read
+            mutable bool situationsListValid = false;                        //!< situations list up to date?
+            mutable Aviation::CCompactAircraftSituationList situationsCompact; //!< compact situations, built once per update when read
+            mutable bool situationsCompactValid = false;                     //!< compact situations up to date?
+            Aviation::CAircraftSituation latestSituation;                    //!< latest situation
+            Aviation::CAircraftSituation latestOnGroundProviderElevation;    //!< situation on ground with elevation from provider
+            Aviation::CAircraftSituationChangeList changes;                  //!< changes, same timestamps as corresponding situations
+            Aviation::CAircraftPartsList parts;                              //!< parts, latest first
+            qint64 situationsLastModified = -1;                              //!< when situations last modified
+            qint64 partsLastModified = -1;                                   //!< when parts last modified
+            bool supportsParts = false;                                      //!< aircraft supporting parts
+
+            //! Situations as list, latest first
+            //! \remark lockSituations has to be held for reading or writing
+            Aviation::CAircraftSituationList situationsAsList() const;
+
+            //! Compact situations, latest first
+            //! \remark lockSituations has to be held for reading or writing
+            Aviation::CCompactAircraftSituationList situationsAsCompactList() const;
+
+            //! Situations have been modified, lockSituations has to be held for writing
+            void invalidateSituationsList() { situationsListValid = false; situationsCompactValid = false; }
+        };
+
+        //! Shared pointer to the data of one aircraft
+        using RemoteAircraftDataPtr = QSharedPointer<RemoteAircraftData>;
+
+        //! Data of the aircraft, null if not existing
+        //! \threadsafe
+        RemoteAircraftDataPtr remoteAircraftData(const Aviation::CCallsign &callsign) const;
+
+        //! Data of the aircraft, created if not existing
+        //! \threadsafe
+        RemoteAircraftDataPtr remoteAircraftDataOrCreate(const Aviation::CCallsign &callsign);
+
+        //! Data of all aircraft
+        //! \threadsafe
+        QList<RemoteAircraftDataPtr> allRemoteAircraftData() const;
+
         //! Store the latest changes
         //! \remark latest first
         //! \threadsafe
         void storeChange(const Aviation::CAircraftSituationChange &change);
 
-        Aviation::CAircraftSituationListPerCallsign m_situationsByCallsign;        //!< situations, for performance reasons per callsign, thread safe access required
-        Aviation::CAircraftSituationPerCallsign m_latestSituationByCallsign;       //!< latest situations, for performance reasons per callsign, thread safe access required
-        Aviation::CAircraftSituationPerCallsign m_latestOnGroundProviderElevation; //!< situations on ground with elevation from provider
-        Aviation::CAircraftPartsListPerCallsign m_partsByCallsign;                 //!< parts, for performance reasons per callsign, thread safe access required
-        Aviation::CAircraftSituationChangeListPerCallsign m_changesByCallsign;     //!< changes, for performance reasons per callsign, thread safe access required (same timestamps as corresponding situations)
-        Aviation::CCallsignSet m_aircraftWithParts;                                //!< aircraft supporting parts, thread safe access required
-        int m_situationsAdded = 0; //!< total number of situations added, thread safe access required
-        int m_partsAdded      = 0; //!< total number of parts added, thread safe access required
+        Aviation::CPerCallsign<RemoteAircraftDataPtr> m_remoteAircraftData; //!< situations, parts and changes per callsign, thread safe access required
+        std::atomic_int m_situationsAdded { 0 }; //!< total number of situations added
+        std::atomic_int m_partsAdded      { 0 }; //!< total number of parts added
 
         ReverseLookupLogging m_enableReverseLookupMsgs = RevLogSimplifiedInfo;     //!< shall we log. information about the matching process
         Simulation::CSimulatedAircraftPerCallsign m_aircraftInRange;      //!< aircraft, thread safe access required
         Aviation::CStatusMessageListPerCallsign m_reverseLookupMessages;  //!< reverse lookup messages
         Aviation::CStatusMessageListPerCallsign m_aircraftPartsMessages;  //!< status messages for parts history
-        Aviation::CTimestampPerCallsign m_situationsLastModified;         //!< when situations last modified
-        Aviation::CTimestampPerCallsign m_partsLastModified;              //!< when parts last modified
         Aviation::CLengthPerCallsign    m_testOffset;                     //!< offsets
         Aviation::CLengthPerCallsign    m_dbCGPerCallsign;                //!< DB CG per callsign
         QHash<QString, PhysicalQuantities::CLength> m_dbCGPerModelString; //!< DB CG per model string
@@ -503,9 +557,8 @@ namespace BlackMisc::Simulation
         bool m_enableAircraftPartsHistory = true;  //!< shall we keep a history of aircraft parts
 
         // locks
-        mutable QReadWriteLock m_lockSituations;   //!< lock for situations: m_situationsByCallsign
-        mutable QReadWriteLock m_lockParts;        //!< lock for parts: m_partsByCallsign, m_aircraftSupportingParts
-        mutable QReadWriteLock m_lockChanges;      //!< lock for changes: m_changesByCallsign
+        mutable QReadWriteLock m_lockRemoteAircraftData; //!< lock for m_remoteAircraftData, only the hash, not the data of an aircraft
+        mutable QReadWriteLock m_lockTestOffset;   //!< lock for m_testOffset
         mutable QReadWriteLock m_lockAircraft;     //!< lock aircraft: m_aircraftInRange, m_dbCGPerCallsign
         mutable QReadWriteLock m_lockMessages;     //!< lock for messages
         mutable QReadWriteLock m_lockPartsHistory; //!< lock for aircraft parts
@@ -545,6 +598,9 @@ namespace BlackMisc::Simulation
         //! \copydoc IRemoteAircraftProvider::remoteAircraftSituations
         Aviation::CAircraftSituationList remoteAircraftSituations(const Aviation::CCallsign &callsign) const;
 
+        //! \copydoc IRemoteAircraftProvider::remoteAircraftSituationsCompact
+        Aviation::CCompactAircraftSituationList remoteAircraftSituationsCompact(const Aviation::CCallsign &callsign) const;
+
         //! \copydoc IRemoteAircraftProvider::remoteAircraftSituation
         Aviation::CAircraftSituation remoteAircraftSituation(const Aviation::CCallsign &callsign, int index) const;
 
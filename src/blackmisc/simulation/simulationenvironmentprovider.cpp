@@ -79,19 +79,17 @@ namespace BlackMisc::Simulation
 
         const qint64 now = QDateTime::currentMSecsSinceEpoch();
         {
-            // we keep latest at front
-            // * we assume we find them faster
-            // * and need them more frequently (the recent ones)
+            // FIFO, the oldest value is removed when the max. is reached
             QWriteLocker l(&m_lockElvCoordinates);
             if (likelyOnGroundElevation)
             {
-                if (m_elvCoordinatesGnd.size() > m_maxElevationsGnd) { m_elvCoordinatesGnd.pop_back(); }
-                m_elvCoordinatesGnd.push_front(elevationCoordinate);
+                if (m_elvCoordinatesGnd.size() > m_maxElevationsGnd) { m_elvCoordinatesGnd.removeOldest(); }
+                m_elvCoordinatesGnd.push(elevationCoordinate);
             }
             else
             {
-                if (m_elvCoordinates.size() > m_maxElevations) { m_elvCoordinates.pop_back(); }
-                m_elvCoordinates.push_front(elevationCoordinate);
+                if (m_elvCoordinates.size() > m_maxElevations) { m_elvCoordinates.removeOldest(); }
+                m_elvCoordinates.push(elevationCoordinate);
             }
 
             // statistics
@@ -271,36 +269,41 @@ namespace BlackMisc::Simulation
     CCoordinateGeodeticList ISimulationEnvironmentProvider::getAllElevationCoordinates() const
     {
         QReadLocker l(&m_lockElvCoordinates);
-        CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-        cl.push_back(m_elvCoordinates);
+        CCoordinateGeodeticList cl(m_elvCoordinatesGnd.toList());
+        cl.push_back(m_elvCoordinates.toList());
         return cl;
     }
 
     CCoordinateGeodeticList ISimulationEnvironmentProvider::getElevationCoordinatesOnGround() const
     {
         QReadLocker l(&m_lockElvCoordinates);
-        return m_elvCoordinatesGnd;
+        return m_elvCoordinatesGnd.toList();
     }
 
     CElevationPlane ISimulationEnvironmentProvider::averageElevationOfOnGroundAircraft(const CAircraftSituation &reference, const CLength &range, int minValues, int sufficientValues) const
     {
-        const CCoordinateGeodeticList coordinates = this->getElevationCoordinatesOnGround();
+        // only the values within range are relevant for the average
+        CCoordinateGeodeticList coordinates;
+        {
+            QReadLocker l(&m_lockElvCoordinates);
+            coordinates = m_elvCoordinatesGnd.findWithinRange(reference, range);
+        }
         return coordinates.averageGeodeticHeight(reference, range, CAircraftSituation::allowedAltitudeDeviation(), minValues, sufficientValues);
     }
 
     CAltitude ISimulationEnvironmentProvider::highestElevation() const
     {
-        const CCoordinateGeodeticList coordinates = this->getElevationCoordinatesOnGround();
-        if (coordinates.isEmpty()) { return CAltitude::null(); }
-        return coordinates.findMaxHeight();
+        QReadLocker l(&m_lockElvCoordinates);
+        if (m_elvCoordinatesGnd.isEmpty()) { return CAltitude::null(); }
+        return m_elvCoordinatesGnd.findMaxHeight();
     }
 
     CCoordinateGeodeticList ISimulationEnvironmentProvider::getAllElevationCoordinates(int &maxRemembered) const
     {
         QReadLocker l(&m_lockElvCoordinates);
         maxRemembered = m_maxElevations;
-        CCoordinateGeodeticList cl(m_elvCoordinatesGnd);
-        cl.push_back(m_elvCoordinates);
+        CCoordinateGeodeticList cl(m_elvCoordinatesGnd.toList());
+        cl.push_back(m_elvCoordinates.toList());
         return cl;
     }
 
@@ -315,8 +318,10 @@ namespace BlackMisc::Simulation
         coordinates.truncate(maxNumber);
         const int delta = size - coordinates.size();
         {
+            // closest is kept as newest
             QWriteLocker l(&m_lockElvCoordinates);
-            m_elvCoordinates = coordinates;
+            m_elvCoordinates.clear();
+            for (auto it = coordinates.crbegin(); it != coordinates.crend(); ++it) { m_elvCoordinates.push(*it); }
         }
         return delta;
     }
@@ -327,10 +332,25 @@ namespace BlackMisc::Simulation
 
         // for single point we use a slightly optimized version
         const bool singlePoint = (&range == &CElevationPlane::singlePointRadius() || range.isNull() || range <= CElevationPlane::singlePointRadius());
-        const CCoordinateGeodeticList elevations = this->getAllElevationCoordinates();
-        const CCoordinateGeodetic coordinate = singlePoint ?
-                                                elevations.findFirstWithinRangeOrDefault(reference, CElevationPlane::singlePointRadius()) :
-                                                elevations.findClosestWithinRange(reference, range);
+        CCoordinateGeodetic coordinate;
+        {
+            // ground values first, both caches are indexed, so no copies are needed
+            QReadLocker l(&m_lockElvCoordinates);
+            if (singlePoint)
+            {
+                coordinate = m_elvCoordinatesGnd.findFirstWithinRangeOrDefault(reference, CElevationPlane::singlePointRadius());
+                if (coordinate.isNull()) { coordinate = m_elvCoordinates.findFirstWithinRangeOrDefault(reference, CElevationPlane::singlePointRadius()); }
+            }
+            else
+            {
+                coordinate = m_elvCoordinatesGnd.findClosestWithinRange(reference, range);
+                const CCoordinateGeodetic closest = m_elvCoordinates.findClosestWithinRange(reference, range);
+                if (!closest.isNull() && (coordinate.isNull() || reference.calculateGreatCircleDistance(closest) < reference.calculateGreatCircleDistance(coordinate)))
+                {
+                    coordinate = closest;
+                }
+            }
+        }
         const bool found = !coordinate.isNull();
 
         {
@@ -386,8 +406,8 @@ namespace BlackMisc::Simulation
         int elv;
         {
             QReadLocker l(&m_lockElvCoordinates);
-            elvGnd = m_elvCoordinatesGnd.sizeInt();
-            elv    = m_elvCoordinates.sizeInt();
+            elvGnd = m_elvCoordinatesGnd.size();
+            elv    = m_elvCoordinates.size();
         }
         return info.arg(f).arg(m).arg(QString::number(hitRatioPercent, 'f', 1)).arg(elv).arg(elvGnd);
     }
@@ -561,41 +581,16 @@ namespace BlackMisc::Simulation
         if (reference.isNull() || keptRange.isNull()) { return false; }
         const CLength r = minRange(keptRange);
 
-        CCoordinateGeodeticList cleanedKeptElvs;
-        bool maxReached = false;
-        bool cleaned    = false;
-
-        {
-            QReadLocker l(&m_lockElvCoordinates);
-            cleanedKeptElvs = m_elvCoordinates;
-            maxReached = m_elvCoordinates.size() >= m_maxElevations;
-        }
-        if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
-        {
-            const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-            if (removed > 0)
-            {
-                cleaned = true;
-                QWriteLocker l(&m_lockElvCoordinates);
-                m_elvCoordinates = cleanedKeptElvs;
-            }
-        }
-
-        cleanedKeptElvs.clear();
+        // the index removes in place, no copies needed
+        bool cleaned = false;
+        QWriteLocker l(&m_lockElvCoordinates);
+        if (!m_elvCoordinates.isEmpty() && (forced || m_elvCoordinates.size() >= m_maxElevations))
         {
-            QReadLocker l(&m_lockElvCoordinates);
-            cleanedKeptElvs = m_elvCoordinatesGnd;
-            maxReached = m_elvCoordinatesGnd.size() >= m_maxElevationsGnd;
+            cleaned = m_elvCoordinates.removeOutsideRange(reference, r) > 0;
         }
-        if (!cleanedKeptElvs.isEmpty() && (forced || maxReached))
+        if (!m_elvCoordinatesGnd.isEmpty() && (forced || m_elvCoordinatesGnd.size() >= m_maxElevationsGnd))
         {
-            const int removed = cleanedKeptElvs.removeOutsideRange(reference, r);
-            if (removed > 0)
-            {
-                cleaned = true;
-                QWriteLocker l(&m_lockElvCoordinates);
-                m_elvCoordinatesGnd = cleanedKeptElvs;
-            }
+            cleaned = m_elvCoordinatesGnd.removeOutsideRange(reference, r) > 0 || cleaned;
         }
 
         return cleaned;
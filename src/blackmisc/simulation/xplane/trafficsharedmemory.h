@@ -0,0 +1,405 @@
+/* Copyright (C) 2021
+ * swift Project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_SIMULATION_XPLANE_TRAFFICSHAREDMEMORY_H
+#define BLACKMISC_SIMULATION_XPLANE_TRAFFICSHAREDMEMORY_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Strict header only shared memory transport for per frame traffic data between the X-Plane driver and XSwiftBus.
+// Header only is necessary to not require XSwiftBus to link against BlackMisc.
+// Only POSIX shared memory is supported, on other platforms creating and opening fails and DBus has to be used.
+
+namespace BlackMisc::Simulation::XPlane::TrafficSharedMemory
+{
+    //! Magic number to identify the segment
+    constexpr std::uint32_t Magic = 0x53574254;
+
+    //! Version of the layout, to be incremented with any change of the structs below
+    constexpr std::uint32_t Version = 1;
+
+    //! Max. number of plane slots
+    constexpr int MaxPlanes = 256;
+
+    //! Number of frames in the ring
+    constexpr int RingFrames = 4;
+
+    //! Max. callsign length including the terminating 0
+    constexpr int CallsignSize = 16;
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Need address free atomics in shared memory");
+
+    //! Traffic data of all plane slots as struct of arrays, trivially copyable.
+    //! \remark the serials are incremented whenever the data of a slot are updated, so a reader applies only new data
+    struct FrameData
+    {
+        std::uint32_t slots;                        //!< number of used slots, slots above are free
+        char          callsigns[MaxPlanes][CallsignSize]; //!< empty for free slots
+
+        // positions
+        std::uint32_t positionSerials[MaxPlanes];   //!< position serial
+        double        latitudesDeg[MaxPlanes];      //!< latitude
+        double        longitudesDeg[MaxPlanes];     //!< longitude
+        double        altitudesFt[MaxPlanes];       //!< altitude
+        double        pitchesDeg[MaxPlanes];        //!< pitch
+        double        rollsDeg[MaxPlanes];          //!< roll
+        double        headingsDeg[MaxPlanes];       //!< heading
+        std::uint8_t  onGrounds[MaxPlanes];         //!< on ground
+
+        // surfaces
+        std::uint32_t surfacesSerials[MaxPlanes];   //!< surfaces serial
+        double        gears[MaxPlanes];             //!< gear
+        double        flaps[MaxPlanes];             //!< flaps
+        double        spoilers[MaxPlanes];          //!< spoilers
+        double        speedBrakes[MaxPlanes];       //!< speed brakes
+        double        slats[MaxPlanes];             //!< slats
+        double        wingSweeps[MaxPlanes];        //!< wing sweep
+        double        thrusts[MaxPlanes];           //!< thrust
+        double        elevators[MaxPlanes];         //!< elevator
+        double        rudders[MaxPlanes];           //!< rudder
+        double        ailerons[MaxPlanes];          //!< aileron
+        std::uint8_t  landLights[MaxPlanes];        //!< landing lights
+        std::uint8_t  taxiLights[MaxPlanes];        //!< taxi lights
+        std::uint8_t  beaconLights[MaxPlanes];      //!< beacon lights
+        std::uint8_t  strobeLights[MaxPlanes];      //!< strobe lights
+        std::uint8_t  navLights[MaxPlanes];         //!< nav lights
+        std::int32_t  lightPatterns[MaxPlanes];     //!< light pattern
+
+        // transponders
+        std::uint32_t transponderSerials[MaxPlanes]; //!< transponder serial
+        std::int32_t  codes[MaxPlanes];             //!< transponder code
+        std::uint8_t  modeCs[MaxPlanes];            //!< mode C
+        std::uint8_t  idents[MaxPlanes];            //!< ident
+
+        //! Callsign of slot
+        std::string callsign(int slot) const { return std::string(callsigns[slot], strnlen(callsigns[slot], CallsignSize)); }
+    };
+    static_assert(std::is_trivially_copyable_v<FrameData>, "Copied with memcpy");
+
+    //! One frame of the ring, guarded by a sequence lock
+    struct Frame
+    {
+        std::atomic<std::uint64_t> sequence { 0 }; //!< odd while being written
+        FrameData data;                            //!< traffic data
+    };
+
+    //! Layout of the shared memory segment
+    struct Segment
+    {
+        std::uint32_t magic   = 0;                  //!< Magic
+        std::uint32_t version = 0;                  //!< Version
+        std::uint64_t size    = 0;                  //!< sizeof(Segment)
+        std::atomic<std::uint64_t> published { 0 }; //!< number of the latest complete frame, 0 if none
+        Frame frames[RingFrames];                   //!< ring of frames, frame n is at n % RingFrames
+    };
+
+    //! Name of the segment used by the driver process
+    inline std::string segmentName()
+    {
+#if defined(_WIN32)
+        return {};
+#else
+        return "/swift-xswiftbus-traffic-" + std::to_string(::getpid());
+#endif
+    }
+
+    //! Writes traffic data into a new shared memory segment, used by the driver
+    class CWriter
+    {
+    public:
+        //! Constructor
+        CWriter() : m_state(new FrameData()) {} // value initialized, all zero
+
+        //! Destructor
+        ~CWriter() { this->close(); }
+
+        //! Not copyable
+        CWriter(const CWriter &) = delete;
+
+        //! Not copyable
+        CWriter &operator =(const CWriter &) = delete;
+
+        //! Create the segment, false if not possible
+        bool create(const std::string &name)
+        {
+            this->close();
+#if defined(_WIN32)
+            (void) name;
+            return false;
+#else
+            if (name.empty()) { return false; }
+            ::shm_unlink(name.c_str()); // left over from a crashed process with the same pid
+            const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+            if (fd < 0) { return false; }
+            if (::ftruncate(fd, static_cast<off_t>(sizeof(Segment))) != 0)
+            {
+                ::close(fd);
+                ::shm_unlink(name.c_str());
+                return false;
+            }
+            void *memory = ::mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED)
+            {
+                ::shm_unlink(name.c_str());
+                return false;
+            }
+
+            m_segment = new (memory) Segment();
+            m_segment->version = Version;
+            m_segment->size = sizeof(Segment);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_segment->magic = Magic;
+            m_name = name;
+            return true;
+#endif
+        }
+
+        //! Unmap and remove the segment
+        void close()
+        {
+#if !defined(_WIN32)
+            if (m_segment)
+            {
+                ::munmap(m_segment, sizeof(Segment));
+                ::shm_unlink(m_name.c_str());
+            }
+#endif
+            m_segment = nullptr;
+            m_name.clear();
+            this->removeAllPlanes();
+        }
+
+        //! Segment created?
+        bool isOpen() const { return m_segment; }
+
+        //! Name of the segment
+        const std::string &name() const { return m_name; }
+
+        //! Slot of the plane, a new slot is used for an unknown callsign, -1 if all slots are used
+        int slot(const std::string &callsign)
+        {
+            const auto it = m_slots.find(callsign);
+            if (it != m_slots.end()) { return it->second; }
+            if (callsign.empty() || callsign.size() >= static_cast<size_t>(CallsignSize)) { return -1; }
+
+            int slot = -1;
+            if (!m_freeSlots.empty())
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            else if (m_state->slots < static_cast<std::uint32_t>(MaxPlanes))
+            {
+                slot = static_cast<int>(m_state->slots++);
+            }
+            if (slot < 0) { return -1; }
+
+            std::memset(m_state->callsigns[slot], 0, CallsignSize);
+            std::memcpy(m_state->callsigns[slot], callsign.data(), callsign.size());
+            m_slots[callsign] = slot;
+            return slot;
+        }
+
+        //! Free the slot of the plane
+        void removePlane(const std::string &callsign)
+        {
+            const auto it = m_slots.find(callsign);
+            if (it == m_slots.end()) { return; }
+            std::memset(m_state->callsigns[it->second], 0, CallsignSize);
+            m_freeSlots.push_back(it->second);
+            m_slots.erase(it);
+        }
+
+        //! Free all slots
+        void removeAllPlanes()
+        {
+            // serials are kept, so a reused slot never looks unchanged to a reader
+            for (const auto &pair : m_slots) { std::memset(m_state->callsigns[pair.second], 0, CallsignSize); }
+            m_slots.clear();
+            m_freeSlots.clear();
+            for (int slot = static_cast<int>(m_state->slots) - 1; slot >= 0; --slot) { m_freeSlots.push_back(slot); }
+        }
+
+        //! Set the position of a slot
+        void setPosition(int slot, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg, bool onGround)
+        {
+            if (!isValidSlot(slot)) { return; }
+            m_state->latitudesDeg[slot] = latitudeDeg;
+            m_state->longitudesDeg[slot] = longitudeDeg;
+            m_state->altitudesFt[slot] = altitudeFt;
+            m_state->pitchesDeg[slot] = pitchDeg;
+            m_state->rollsDeg[slot] = rollDeg;
+            m_state->headingsDeg[slot] = headingDeg;
+            m_state->onGrounds[slot] = onGround;
+            m_state->positionSerials[slot]++;
+        }
+
+        //! Set the surfaces of a slot
+        void setSurfaces(int slot, double gear, double flaps, double spoilers, double speedBrakes, double slats, double wingSweep, double thrust,
+                         double elevator, double rudder, double aileron, bool landLight, bool taxiLight, bool beaconLight, bool strobeLight, bool navLight, int lightPattern)
+        {
+            if (!isValidSlot(slot)) { return; }
+            m_state->gears[slot] = gear;
+            m_state->flaps[slot] = flaps;
+            m_state->spoilers[slot] = spoilers;
+            m_state->speedBrakes[slot] = speedBrakes;
+            m_state->slats[slot] = slats;
+            m_state->wingSweeps[slot] = wingSweep;
+            m_state->thrusts[slot] = thrust;
+            m_state->elevators[slot] = elevator;
+            m_state->rudders[slot] = rudder;
+            m_state->ailerons[slot] = aileron;
+            m_state->landLights[slot] = landLight;
+            m_state->taxiLights[slot] = taxiLight;
+            m_state->beaconLights[slot] = beaconLight;
+            m_state->strobeLights[slot] = strobeLight;
+            m_state->navLights[slot] = navLight;
+            m_state->lightPatterns[slot] = lightPattern;
+            m_state->surfacesSerials[slot]++;
+        }
+
+        //! Set the transponder of a slot
+        void setTransponder(int slot, int code, bool modeC, bool ident)
+        {
+            if (!isValidSlot(slot)) { return; }
+            m_state->codes[slot] = code;
+            m_state->modeCs[slot] = modeC;
+            m_state->idents[slot] = ident;
+            m_state->transponderSerials[slot]++;
+        }
+
+        //! Publish the current data of all slots as next frame of the ring
+        void publish()
+        {
+            if (!m_segment) { return; }
+            const std::uint64_t number = ++m_frameNumber;
+            Frame &frame = m_segment->frames[number % RingFrames];
+            const std::uint64_t sequence = frame.sequence.load(std::memory_order_relaxed);
+            frame.sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(&frame.data, m_state.get(), sizeof(FrameData));
+            frame.sequence.store(sequence + 2, std::memory_order_release);
+            m_segment->published.store(number, std::memory_order_release);
+        }
+
+    private:
+        bool isValidSlot(int slot) const { return slot >= 0 && slot < static_cast<int>(m_state->slots); }
+
+        Segment *m_segment = nullptr;
+        std::string m_name;
+        std::unique_ptr<FrameData> m_state;           //!< current data of all slots
+        std::unordered_map<std::string, int> m_slots; //!< slot by callsign
+        std::vector<int> m_freeSlots;
+        std::uint64_t m_frameNumber = 0;
+    };
+
+    //! Reads traffic data from the segment created by CWriter, used by XSwiftBus
+    class CReader
+    {
+    public:
+        //! Constructor
+        CReader() = default;
+
+        //! Destructor
+        ~CReader() { this->close(); }
+
+        //! Not copyable
+        CReader(const CReader &) = delete;
+
+        //! Not copyable
+        CReader &operator =(const CReader &) = delete;
+
+        //! Open an existing segment, false if it does not exist or has an incompatible layout
+        bool open(const std::string &name)
+        {
+            this->close();
+#if defined(_WIN32)
+            (void) name;
+            return false;
+#else
+            if (name.empty()) { return false; }
+            const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0) { return false; }
+            struct stat info {};
+            if (::fstat(fd, &info) != 0 || info.st_size != static_cast<off_t>(sizeof(Segment)))
+            {
+                ::close(fd);
+                return false;
+            }
+            void *memory = ::mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (memory == MAP_FAILED) { return false; }
+
+            const Segment *segment = static_cast<const Segment *>(memory);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (segment->magic != Magic || segment->version != Version || segment->size != sizeof(Segment))
+            {
+                ::munmap(memory, sizeof(Segment));
+                return false;
+            }
+            m_segment = segment;
+            m_lastFrame = 0;
+            return true;
+#endif
+        }
+
+        //! Unmap the segment
+        void close()
+        {
+#if !defined(_WIN32)
+            if (m_segment) { ::munmap(const_cast<Segment *>(m_segment), sizeof(Segment)); }
+#endif
+            m_segment = nullptr;
+        }
+
+        //! Segment opened?
+        bool isOpen() const { return m_segment; }
+
+        //! Copy the latest frame, false if there is no new complete frame
+        bool readLatest(FrameData &data)
+        {
+            if (!m_segment) { return false; }
+            const std::uint64_t number = m_segment->published.load(std::memory_order_acquire);
+            if (number == 0 || number == m_lastFrame) { return false; }
+
+            const Frame &frame = m_segment->frames[number % RingFrames];
+            const std::uint64_t sequence = frame.sequence.load(std::memory_order_acquire);
+            if (sequence & 1) { return false; } // being written, try again next time
+            std::memcpy(&data, &frame.data, sizeof(FrameData));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (frame.sequence.load(std::memory_order_relaxed) != sequence) { return false; } // overwritten while copying
+
+            m_lastFrame = number;
+            return true;
+        }
+
+    private:
+        const Segment *m_segment = nullptr;
+        std::uint64_t m_lastFrame = 0;
+    };
+} // ns
+
+#endif // guard
@@ -9,6 +9,7 @@
 //! \cond PRIVATE
 
 #include "blackmisc/valuecache.h"
+#include "blackmisc/valuecachebinaryfile.h"
 #include "blackmisc/atomicfile.h"
 #include "blackmisc/swiftdirectories.h"
 #include "blackmisc/identifier.h"
@@ -372,7 +373,11 @@ namespace BlackMisc
         }
         for (auto it = namespaces.cbegin(); it != namespaces.cend(); ++it)
         {
-            CAtomicFile file(dir + "/" + it.key() + ".json");
+            const QString fileName = dir + "/" + it.key() + ".json";
+            CValueCacheBinaryFile binaryFile(CValueCacheBinaryFile::fileNameForJsonFile(fileName));
+            const bool binaryUpToDate = m_binaryFiles && binaryFile.open(QFileInfo(fileName)); // before the JSON file is replaced
+
+            CAtomicFile file(fileName);
             if (! QDir::root().mkpath(QFileInfo(file).path()))
             {
                 return CStatusMessage(this).error(u"Failed to create directory '%1'") << QFileInfo(file).path();
@@ -393,6 +398,7 @@ namespace BlackMisc
             {
                 return CStatusMessage(this).error(u"Failed to write to %1: %2") << file.fileName() << file.errorString();
             }
+            if (m_binaryFiles) { saveToBinaryFile(fileName, *it, json.object(), binaryUpToDate ? &binaryFile : nullptr); }
         }
         return CStatusMessage(this).info(u"Written '%1' to value cache in '%2'") <<
             (keysMessage.isEmpty() ? values.keys().to<QStringList>().join(",") : keysMessage) << dir;
@@ -440,6 +446,16 @@ namespace BlackMisc
             {
                 continue;
             }
+            if (m_binaryFiles)
+            {
+                CVariantMap temp;
+                if (loadFromBinaryFile(file, it.value(), keysOnly, temp))
+                {
+                    temp.removeDuplicates(currentValues);
+                    o_values.insert(temp, QFileInfo(file).lastModified().toMSecsSinceEpoch());
+                    continue;
+                }
+            }
             if (! file.open(QFile::ReadOnly | QFile::Text))
             {
                 return CStatusMessage(this).error(u"Failed to open %1: %2") << file.fileName() << file.errorString();
@@ -466,6 +482,11 @@ namespace BlackMisc
                     backupFile(file);
                     CLogMessage::preformatted(messages);
                 }
+                else if (m_binaryFiles && temp.size() == json.object().size())
+                {
+                    // all values of the file parsed, so the binary file can be created now
+                    saveToBinaryFile(file.fileName(), temp, {}, nullptr);
+                }
             }
             temp.removeDuplicates(currentValues);
             o_values.insert(temp, QFileInfo(file).lastModified().toMSecsSinceEpoch());
@@ -494,6 +515,59 @@ namespace BlackMisc
         CLogMessage(this).info(u"Backed up %1 to %2") << QFileInfo(file).fileName() << dir.absoluteFilePath("backups");
     }
 
+    bool CValueCache::loadFromBinaryFile(const QFile &jsonFile, const QStringList &keys, bool keysOnly, CVariantMap &o_values) const
+    {
+        CValueCacheBinaryFile binaryFile(CValueCacheBinaryFile::fileNameForJsonFile(jsonFile.fileName()));
+        if (! binaryFile.open(QFileInfo(jsonFile)))
+        {
+            CLogMessage(this).debug(u"Using JSON: %1") << binaryFile.getErrorString();
+            return false;
+        }
+
+        // only the requested values are deserialized
+        for (const QString &key : (keys.isEmpty() ? binaryFile.keys() : keys))
+        {
+            if (! binaryFile.contains(key)) { continue; }
+            CVariant value;
+            if (! keysOnly && ! binaryFile.value(key, value))
+            {
+                CLogMessage(this).warning(u"Using JSON: %1") << binaryFile.getErrorString();
+                o_values.clear();
+                return false;
+            }
+            o_values.insert(key, value);
+        }
+        return true;
+    }
+
+    void CValueCache::saveToBinaryFile(const QString &jsonFileName, const CVariantMap &values, const QJsonObject &json, CValueCacheBinaryFile *upToDate) const
+    {
+        CVariantMap allValues = values;
+        if (! upToDate)
+        {
+            // other values of the file only in the JSON file so far
+            QStringList otherKeys;
+            for (auto it = json.begin(); it != json.end(); ++it)
+            {
+                if (! values.contains(it.key())) { otherKeys.push_back(it.key()); }
+            }
+            if (! otherKeys.isEmpty())
+            {
+                CVariantMap otherValues;
+                const auto messages = otherValues.convertFromMemoizedJsonNoThrow(json, otherKeys, this, QStringLiteral("Parsing %1").arg(jsonFileName));
+                if (! messages.isEmpty()) { return; } // binary file stays outdated, JSON is used
+                for (auto it = otherValues.cbegin(); it != otherValues.cend(); ++it) { allValues.insert(it.key(), it.value()); }
+            }
+        }
+
+        QString error;
+        const QString fileName = CValueCacheBinaryFile::fileNameForJsonFile(jsonFileName);
+        if (! CValueCacheBinaryFile::write(fileName, allValues, QFileInfo(jsonFileName), upToDate, error))
+        {
+            CLogMessage(this).warning(u"%1, JSON is used") << error;
+        }
+    }
+
     void CValueCache::markAllAsSaved(const QString &keyPrefix)
     {
         QMutexLocker lock(&m_mutex);
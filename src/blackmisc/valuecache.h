@@ -48,10 +48,12 @@
 #include <tuple>
 #include <utility>
 #include <memory>
+#include <atomic>
 
 namespace BlackMisc
 {
     class CLogCategoryList;
+    class CValueCacheBinaryFile;
 
     /*!
      * Overwrite the default root directory for cache and settings, for testing purposes.
@@ -220,6 +222,13 @@ namespace BlackMisc
         //! \threadsafe
         CStatusMessage loadFromFiles(const QString &directory);
 
+        //! Save binary files alongside the Json files, and load from them as long as they are up to date.
+        //! \sa CValueCacheBinaryFile
+        void setBinaryFilesEnabled(bool enabled) { m_binaryFiles = enabled; }
+
+        //! Binary files enabled?
+        bool isBinaryFilesEnabled() const { return m_binaryFiles; }
+
         //! Return the (relative) filename that may is (or would be) used to save the value with the given key.
         //! The file may or may not exist (because it might not have been saved yet).
         //! \threadsafe
@@ -322,11 +331,14 @@ namespace BlackMisc
         QMap<QString, ElementPtr> m_elements;
         QMap<QString, QString> m_humanReadable;
         const int m_fileSplitDepth = 1; //!< How many levels of subdirectories to split JSON files
+        std::atomic_bool m_binaryFiles { false }; //!< Binary files alongside the JSON files
 
         Element &getElement(const QString &key);
         Element &getElement(const QString &key, QMap<QString, ElementPtr>::const_iterator pos);
         std::tuple<CVariant, qint64, bool> getValue(const QString &key);
         void backupFile(QFile &file) const;
+        bool loadFromBinaryFile(const QFile &jsonFile, const QStringList &keys, bool keysOnly, CVariantMap &o_values) const;
+        void saveToBinaryFile(const QString &jsonFileName, const CVariantMap &values, const QJsonObject &json, CValueCacheBinaryFile *upToDate) const;
 
         virtual void connectPage(Private::CValuePage *page);
 
@@ -0,0 +1,352 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blackmisc/valuecachebinaryfile.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/atomicfile.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QDateTime>
+#include <QHash>
+#include <QIODevice>
+#include <QPair>
+#include <QVector>
+#include <QtEndian>
+#include <cstring>
+#include <utility>
+
+using namespace BlackMisc::Simulation;
+
+namespace BlackMisc
+{
+    namespace
+    {
+        //! File layout
+        //! @{
+        constexpr char Magic[4] = { 'S', 'W', 'C', 'B' };
+        constexpr quint64 HeaderSize = 72;
+        constexpr quint64 StringIndexEntrySize = 8;
+        constexpr quint64 RecordSize = 32;
+        constexpr int DataStreamVersion = QDataStream::Qt_5_15;
+        //! @}
+
+        //! Append in little endian
+        template <typename T>
+        void append(QByteArray &data, T value)
+        {
+            const T le = qToLittleEndian(value);
+            data.append(reinterpret_cast<const char *>(&le), sizeof(T));
+        }
+
+        //! Read little endian
+        template <typename T>
+        T read(const uchar *data, quint64 offset)
+        {
+            return qFromLittleEndian<T>(data + offset);
+        }
+
+        //! Checksum of a payload
+        quint32 checksum(const char *data, quint64 size)
+        {
+            return qChecksum(data, static_cast<uint>(size));
+        }
+    }
+
+    CValueCacheBinaryFile::CValueCacheBinaryFile(const QString &fileName) : m_file(fileName)
+    { }
+
+    CValueCacheBinaryFile::~CValueCacheBinaryFile()
+    {
+        this->close();
+    }
+
+    QString CValueCacheBinaryFile::fileNameForJsonFile(const QString &jsonFileName)
+    {
+        QString fileName = jsonFileName;
+        if (fileName.endsWith(".json")) { fileName.chop(5); }
+        return fileName + ".bin";
+    }
+
+    bool CValueCacheBinaryFile::open(const QFileInfo &jsonFile)
+    {
+        this->close();
+        if (!m_file.exists()) { return this->fail(QStringLiteral("No binary file '%1'").arg(m_file.fileName())); }
+        if (!jsonFile.exists()) { return this->fail(QStringLiteral("No Json file for '%1'").arg(m_file.fileName())); }
+        if (!m_file.open(QIODevice::ReadOnly)) { return this->fail(QStringLiteral("Failed to open %1: %2").arg(m_file.fileName(), m_file.errorString())); }
+
+        m_size = m_file.size();
+        if (m_size < static_cast<qint64>(HeaderSize)) { this->close(); return this->fail(QStringLiteral("Truncated %1").arg(m_file.fileName())); }
+        m_data = m_file.map(0, m_size);
+        if (!m_data) { this->close(); return this->fail(QStringLiteral("Failed to map %1: %2").arg(m_file.fileName(), m_file.errorString())); }
+
+        // header
+        const quint32 formatVersion = read<quint32>(m_data, 4);
+        m_dataStreamVersion = read<quint32>(m_data, 8);
+        m_stringCount = read<quint32>(m_data, 12);
+        const quint32 recordCount = read<quint32>(m_data, 16);
+        const qint64 jsonSize = read<qint64>(m_data, 24);
+        const qint64 jsonLastModified = read<qint64>(m_data, 32);
+        m_stringIndexOffset = read<quint64>(m_data, 40);
+        m_recordsOffset = read<quint64>(m_data, 48);
+        m_stringDataOffset = read<quint64>(m_data, 56);
+        const quint64 payloadOffset = read<quint64>(m_data, 64);
+
+        QString error;
+        if (std::memcmp(m_data, Magic, sizeof(Magic)) != 0) { error = QStringLiteral("Not a binary cache file %1"); }
+        else if (formatVersion != FormatVersion) { error = QStringLiteral("Other format version of %1"); }
+        else if (m_dataStreamVersion > static_cast<quint32>(QDataStream::Qt_DefaultCompiledVersion)) { error = QStringLiteral("Newer data stream version in %1"); }
+        else if (jsonSize != jsonFile.size() || jsonLastModified != jsonFile.lastModified().toMSecsSinceEpoch()) { error = QStringLiteral("Outdated %1"); }
+        else if (m_stringIndexOffset != HeaderSize || m_recordsOffset != m_stringIndexOffset + m_stringCount * StringIndexEntrySize ||
+                 m_stringDataOffset != m_recordsOffset + recordCount * RecordSize || payloadOffset < m_stringDataOffset ||
+                 payloadOffset > static_cast<quint64>(m_size))
+        {
+            error = QStringLiteral("Corrupt tables in %1");
+        }
+        if (error.isEmpty())
+        {
+            for (quint32 i = 0; i < m_stringCount; ++i)
+            {
+                const quint64 entry = m_stringIndexOffset + i * StringIndexEntrySize;
+                const quint64 end = m_stringDataOffset + read<quint32>(m_data, entry) + 2 * static_cast<quint64>(read<quint32>(m_data, entry + 4));
+                if (end > payloadOffset) { error = QStringLiteral("Corrupt string table in %1"); break; }
+            }
+        }
+        if (error.isEmpty())
+        {
+            for (quint32 i = 0; i < recordCount; ++i)
+            {
+                const Record r = this->record(i);
+                if (r.keyIndex >= m_stringCount || r.typeIndex >= m_stringCount ||
+                        r.payloadOffset < payloadOffset || r.payloadOffset + r.payloadSize > static_cast<quint64>(m_size))
+                {
+                    error = QStringLiteral("Corrupt record in %1");
+                    break;
+                }
+                m_records.insert(this->string(r.keyIndex), i);
+            }
+        }
+        if (!error.isEmpty())
+        {
+            this->close();
+            return this->fail(error.arg(m_file.fileName()));
+        }
+        return true;
+    }
+
+    void CValueCacheBinaryFile::close()
+    {
+        if (m_data) { m_file.unmap(m_data); }
+        m_data = nullptr;
+        m_size = 0;
+        m_records.clear();
+        m_file.close();
+    }
+
+    bool CValueCacheBinaryFile::value(const QString &key, CVariant &o_value) const
+    {
+        const auto it = m_records.constFind(key);
+        if (it == m_records.constEnd()) { return this->fail(QStringLiteral("No value '%1' in %2").arg(key, m_file.fileName())); }
+        const Record r = this->record(it.value());
+        const char *payload = reinterpret_cast<const char *>(m_data + r.payloadOffset);
+        if (checksum(payload, r.payloadSize) != r.checksum) { return this->fail(QStringLiteral("Checksum mismatch of '%1' in %2").arg(key, m_file.fileName())); }
+
+        const QString type = this->string(r.typeIndex);
+        const int typeId = QMetaType::type(qPrintable(type));
+        if (typeId == QMetaType::UnknownType) { return this->fail(QStringLiteral("Unknown type '%1' of '%2' in %3").arg(type, key, m_file.fileName())); }
+
+        // no copy, the data stay in the mapped file
+        const QByteArray data = QByteArray::fromRawData(payload, static_cast<int>(r.payloadSize));
+        QDataStream stream(data);
+        stream.setVersion(static_cast<int>(m_dataStreamVersion));
+        switch (r.encoding)
+        {
+        case EncodingDataStream:
+            stream >> o_value;
+            break;
+        case EncodingAircraftModelList:
+        {
+            CAircraftModelList models;
+            models.unmarshalFromMemoizedDataStream(stream);
+            o_value = CVariant::from(models);
+            break;
+        }
+        default:
+            return this->fail(QStringLiteral("Unknown encoding of '%1' in %2").arg(key, m_file.fileName()));
+        }
+
+        if (stream.status() != QDataStream::Ok || o_value.userType() != typeId)
+        {
+            o_value = CVariant();
+            return this->fail(QStringLiteral("Failed to read '%1' from %2").arg(key, m_file.fileName()));
+        }
+        return true;
+    }
+
+    bool CValueCacheBinaryFile::write(const QString &fileName, const CVariantMap &values, const QFileInfo &jsonFile, CValueCacheBinaryFile *previous, QString &o_errorString)
+    {
+        //! Value to be written
+        struct Entry
+        {
+            QString key;
+            QString type;
+            quint32 encoding = EncodingDataStream;
+            quint32 checksum = 0;
+            QByteArray payload; //!< raw data of previous file are not copied
+        };
+
+        // values of the previous file unchanged, in key order like the values
+        QMap<QString, Entry> entries;
+        if (previous && previous->isOpen())
+        {
+            for (auto it = previous->m_records.cbegin(); it != previous->m_records.cend(); ++it)
+            {
+                if (values.contains(it.key())) { continue; }
+                const Record r = previous->record(it.value());
+                Entry &entry = entries[it.key()];
+                entry.key = it.key();
+                entry.type = previous->string(r.typeIndex);
+                entry.encoding = r.encoding;
+                entry.checksum = r.checksum;
+                entry.payload = QByteArray::fromRawData(reinterpret_cast<const char *>(previous->m_data + r.payloadOffset), static_cast<int>(r.payloadSize));
+            }
+        }
+        for (auto it = values.cbegin(); it != values.cend(); ++it)
+        {
+            Entry &entry = entries[it.key()];
+            entry.key = it.key();
+            entry.type = QString::fromLatin1(it.value().typeName());
+            QDataStream stream(&entry.payload, QIODevice::WriteOnly);
+            stream.setVersion(DataStreamVersion);
+            if (it.value().userType() == qMetaTypeId<CAircraftModelList>())
+            {
+                entry.encoding = EncodingAircraftModelList;
+                it.value().value<CAircraftModelList>().marshalToMemoizedDataStream(stream);
+            }
+            else
+            {
+                entry.encoding = EncodingDataStream;
+                stream << it.value();
+            }
+            entry.checksum = checksum(entry.payload.constData(), entry.payload.size());
+        }
+
+        // interned strings
+        QHash<QString, quint32> stringIndexes;
+        QStringList strings;
+        const auto intern = [&](const QString &s)
+        {
+            auto it = stringIndexes.constFind(s);
+            if (it == stringIndexes.constEnd())
+            {
+                it = stringIndexes.insert(s, static_cast<quint32>(strings.size()));
+                strings.push_back(s);
+            }
+            return it.value();
+        };
+        QVector<QPair<quint32, quint32>> entryStrings;
+        entryStrings.reserve(entries.size());
+        for (const Entry &entry : std::as_const(entries)) { entryStrings.push_back({ intern(entry.key), intern(entry.type) }); }
+
+        QByteArray stringData;
+        QByteArray stringIndex;
+        for (const QString &s : std::as_const(strings))
+        {
+            append<quint32>(stringIndex, static_cast<quint32>(stringData.size()));
+            append<quint32>(stringIndex, static_cast<quint32>(s.size()));
+            for (const QChar c : s) { append<quint16>(stringData, c.unicode()); }
+        }
+
+        const quint64 stringIndexOffset = HeaderSize;
+        const quint64 recordsOffset = stringIndexOffset + stringIndex.size();
+        const quint64 stringDataOffset = recordsOffset + static_cast<quint64>(entries.size()) * RecordSize;
+        const quint64 payloadOffset = stringDataOffset + stringData.size();
+
+        QByteArray tables;
+        tables.append(Magic, sizeof(Magic));
+        append<quint32>(tables, FormatVersion);
+        append<quint32>(tables, DataStreamVersion);
+        append<quint32>(tables, static_cast<quint32>(strings.size()));
+        append<quint32>(tables, static_cast<quint32>(entries.size()));
+        append<quint32>(tables, 0); // reserved
+        append<qint64>(tables, jsonFile.size());
+        append<qint64>(tables, jsonFile.lastModified().toMSecsSinceEpoch());
+        append<quint64>(tables, stringIndexOffset);
+        append<quint64>(tables, recordsOffset);
+        append<quint64>(tables, stringDataOffset);
+        append<quint64>(tables, payloadOffset);
+        Q_ASSERT_X(static_cast<quint64>(tables.size()) == HeaderSize, Q_FUNC_INFO, "Wrong header size");
+        tables.append(stringIndex);
+
+        quint64 offset = payloadOffset;
+        int i = 0;
+        for (const Entry &entry : std::as_const(entries))
+        {
+            append<quint32>(tables, entryStrings[i].first);
+            append<quint32>(tables, entryStrings[i].second);
+            append<quint32>(tables, entry.encoding);
+            append<quint32>(tables, entry.checksum);
+            append<quint64>(tables, offset);
+            append<quint64>(tables, static_cast<quint64>(entry.payload.size()));
+            offset += entry.payload.size();
+            ++i;
+        }
+        tables.append(stringData);
+
+        CAtomicFile file(fileName);
+        if (!file.open(QIODevice::WriteOnly))
+        {
+            o_errorString = QStringLiteral("Failed to open %1: %2").arg(fileName, file.errorString());
+            return false;
+        }
+        bool ok = file.write(tables) == tables.size();
+        for (auto it = entries.cbegin(); ok && it != entries.cend(); ++it)
+        {
+            ok = file.write(it->payload) == it->payload.size();
+        }
+
+        // raw data of the previous file are written, it can be replaced now
+        if (previous) { previous->close(); }
+        if (!ok || !file.checkedClose())
+        {
+            o_errorString = QStringLiteral("Failed to write to %1: %2").arg(fileName, file.errorString());
+            if (file.isOpen()) { file.abandon(); }
+            return false;
+        }
+        return true;
+    }
+
+    CValueCacheBinaryFile::Record CValueCacheBinaryFile::record(int i) const
+    {
+        const quint64 offset = m_recordsOffset + static_cast<quint64>(i) * RecordSize;
+        Record r;
+        r.keyIndex = read<quint32>(m_data, offset);
+        r.typeIndex = read<quint32>(m_data, offset + 4);
+        r.encoding = read<quint32>(m_data, offset + 8);
+        r.checksum = read<quint32>(m_data, offset + 12);
+        r.payloadOffset = read<quint64>(m_data, offset + 16);
+        r.payloadSize = read<quint64>(m_data, offset + 24);
+        return r;
+    }
+
+    QString CValueCacheBinaryFile::string(quint32 i) const
+    {
+        const quint64 entry = m_stringIndexOffset + i * StringIndexEntrySize;
+        const quint64 offset = m_stringDataOffset + read<quint32>(m_data, entry);
+        const int length = static_cast<int>(read<quint32>(m_data, entry + 4));
+        QString s(length, Qt::Uninitialized);
+        for (int c = 0; c < length; ++c) { s[c] = QChar(read<quint16>(m_data, offset + 2 * c)); }
+        return s;
+    }
+
+    bool CValueCacheBinaryFile::fail(const QString &errorString) const
+    {
+        m_errorString = errorString;
+        return false;
+    }
+} // ns
@@ -0,0 +1,124 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKMISC_VALUECACHEBINARYFILE_H
+#define BLACKMISC_VALUECACHEBINARYFILE_H
+
+#include "blackmisc/blackmiscexport.h"
+#include "blackmisc/variant.h"
+#include "blackmisc/variantmap.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+namespace BlackMisc
+{
+    /*!
+     * Binary file of the values of a value cache Json file, saved alongside the Json file.
+     *
+     * The file is memory mapped when opened, values are only deserialized when requested.
+     * Layout (little endian): header, string index, fixed width records, string table, payloads.
+     * Keys and type names are interned in the string table, aircraft model lists are stored with
+     * their aircraft ICAO codes, liveries and distributors only once (like the memoized Json).
+     * The Json file remains the reference: the binary file is only valid for the Json file
+     * (size and modification time) it was written with, otherwise the Json file is used.
+     */
+    class BLACKMISC_EXPORT CValueCacheBinaryFile
+    {
+    public:
+        //! Version of the file format, files of other versions are ignored
+        static constexpr quint32 FormatVersion = 1;
+
+        //! Constructor
+        explicit CValueCacheBinaryFile(const QString &fileName);
+
+        //! Destructor, unmaps the file
+        ~CValueCacheBinaryFile();
+
+        //! Not copyable
+        //! @{
+        CValueCacheBinaryFile(const CValueCacheBinaryFile &) = delete;
+        CValueCacheBinaryFile &operator =(const CValueCacheBinaryFile &) = delete;
+        //! @}
+
+        //! Binary file name for a Json file name
+        static QString fileNameForJsonFile(const QString &jsonFileName);
+
+        //! Map the file, fails if the file is invalid or was not written along with the current Json file
+        bool open(const QFileInfo &jsonFile);
+
+        //! Unmap and close the file
+        void close();
+
+        //! Open?
+        bool isOpen() const { return m_data; }
+
+        //! Keys of all values, without deserializing them
+        QStringList keys() const { return m_records.keys(); }
+
+        //! Contains value for key?
+        bool contains(const QString &key) const { return m_records.contains(key); }
+
+        //! Deserialize the value for a key
+        bool value(const QString &key, CVariant &o_value) const;
+
+        //! Reason why open or value failed
+        const QString &getErrorString() const { return m_errorString; }
+
+        //! Write values, values of the previous file (if open) which are not in values are copied unchanged.
+        //! The previous file is closed before the new file replaces it.
+        static bool write(const QString &fileName, const CVariantMap &values, const QFileInfo &jsonFile, CValueCacheBinaryFile *previous, QString &o_errorString);
+
+    private:
+        //! How a payload is encoded
+        enum Encoding : quint32
+        {
+            EncodingDataStream = 0,      //!< CVariant in a QDataStream
+            EncodingAircraftModelList = 1 //!< CAircraftModelList with memoized members
+        };
+
+        //! Fixed width record of a value
+        struct Record
+        {
+            quint32 keyIndex = 0;      //!< index in string table
+            quint32 typeIndex = 0;     //!< index in string table
+            quint32 encoding = EncodingDataStream;
+            quint32 checksum = 0;      //!< of the payload
+            quint64 payloadOffset = 0; //!< from begin of file
+            quint64 payloadSize = 0;
+        };
+
+        //! Record i of the mapped file
+        Record record(int i) const;
+
+        //! String i of the mapped file
+        QString string(quint32 i) const;
+
+        //! Fail with error
+        bool fail(const QString &errorString) const;
+
+        QFile m_file;
+        uchar *m_data = nullptr;
+        qint64 m_size = 0;
+        quint32 m_dataStreamVersion = 0;
+        quint32 m_stringCount = 0;
+        quint64 m_stringIndexOffset = 0;
+        quint64 m_stringDataOffset = 0;
+        quint64 m_recordsOffset = 0;
+        QMap<QString, int> m_records; //!< record by key
+        mutable QString m_errorString;
+    };
+} // ns
+
+#endif // guard
@@ -42,6 +42,24 @@ namespace BlackSound::Codecs
         return decoded;
     }
 
+    QVector<qint16> COpusDecoder::decodeFec(const QByteArray &nextOpusData, int frameSamples)
+    {
+        if (nextOpusData.isEmpty()) { return this->decodeLost(frameSamples); }
+
+        QVector<qint16> decoded(frameSamples * m_channels, 0);
+        const int length = opus_decode(m_opusDecoder, reinterpret_cast<const unsigned char *>(nextOpusData.data()), nextOpusData.size(), decoded.data(), frameSamples, 1);
+        if (length >= 0) { decoded.resize(length * m_channels); } // silence on errors, keeps the timing
+        return decoded;
+    }
+
+    QVector<qint16> COpusDecoder::decodeLost(int frameSamples)
+    {
+        QVector<qint16> decoded(frameSamples * m_channels, 0);
+        const int length = opus_decode(m_opusDecoder, nullptr, 0, decoded.data(), frameSamples, 0);
+        if (length >= 0) { decoded.resize(length * m_channels); } // silence on errors, keeps the timing
+        return decoded;
+    }
+
     void COpusDecoder::resetState()
     {
         if (!m_opusDecoder) { return; }
@@ -40,6 +40,13 @@ namespace BlackSound::Codecs
         //! Decode
         QVector<qint16> decode(const QByteArray &opusData, int dataLength, int *decodedLength);
 
+        //! Decode a lost frame from the forward error correction data of the next packet
+        //! \remark falls back to decodeLost if the next packet is empty
+        QVector<qint16> decodeFec(const QByteArray &nextOpusData, int frameSamples);
+
+        //! Packet loss concealment of a lost frame
+        QVector<qint16> decodeLost(int frameSamples);
+
         //! Reset
         void resetState();
 
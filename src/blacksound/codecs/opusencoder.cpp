@@ -26,6 +26,12 @@ namespace BlackSound::Codecs
         opus_encoder_ctl(opusEncoder, OPUS_SET_BITRATE(bitRate));
     }
 
+    void COpusEncoder::setInbandFec(bool enabled, int expectedLossPercent)
+    {
+        opus_encoder_ctl(opusEncoder, OPUS_SET_INBAND_FEC(enabled ? 1 : 0));
+        opus_encoder_ctl(opusEncoder, OPUS_SET_PACKET_LOSS_PERC(enabled ? qBound(0, expectedLossPercent, 100) : 0));
+    }
+
     QByteArray COpusEncoder::encode(const QVector<qint16> &pcmSamples, int samplesLength, int *encodedLength)
     {
         QByteArray encoded(maxDataBytes, 0);
@@ -38,6 +38,9 @@ namespace BlackSound::Codecs
         //! Bit rate
         void setBitRate(int bitRate);
 
+        //! In-band forward error correction, lets the receiver recover a lost frame from the next packet
+        void setInbandFec(bool enabled, int expectedLossPercent = 10);
+
         //! Encode
         QByteArray encode(const QVector<qint16> &pcmSamples, int samplesLength, int *encodedLength);
 
@@ -34,6 +34,24 @@ namespace BlackSound::Dsp
         return m_y1;
     }
 
+    void BiQuadFilter::process(float *samples, int count)
+    {
+        // same arithmetic as transform, with the state kept in locals for the block
+        const double a0 = m_a0, a1 = m_a1, a2 = m_a2, a3 = m_a3, a4 = m_a4;
+        float x1 = m_x1, x2 = m_x2, y1 = m_y1, y2 = m_y2;
+        for (int i = 0; i < count; i++)
+        {
+            const float inSample = samples[i];
+            const double result = a0 * inSample + a1 * x1 + a2 * x2 - a3 * y1 - a4 * y2;
+            x2 = x1;
+            x1 = inSample;
+            y2 = y1;
+            y1 = static_cast<float>(result);
+            samples[i] = y1;
+        }
+        m_x1 = x1; m_x2 = x2; m_y1 = y1; m_y2 = y2;
+    }
+
     void BiQuadFilter::setCoefficients(double aa0, double aa1, double aa2, double b0, double b1, double b2)
     {
         if (CBuildConfig::isLocalDeveloperDebugBuild()) { BLACK_VERIFY_X(qAbs(aa0) > 1E-06, Q_FUNC_INFO, "Div by zero?"); }
@@ -16,7 +16,7 @@
 namespace BlackSound::Dsp
 {
     //! Digital biquad filter
-    class BiQuadFilter
+    class BLACKSOUND_EXPORT BiQuadFilter
     {
     public:
         //! Ctor
@@ -25,6 +25,9 @@ namespace BlackSound::Dsp
         //! Transform
         float transform(float inSample);
 
+        //! Transform a block in place, same result as transform per sample
+        void process(float *samples, int count);
+
         //! Set filter parameters
         //! @{
         void setCoefficients(double aa0, double aa1, double aa2, double b0, double b1, double b2);
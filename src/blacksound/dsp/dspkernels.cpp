@@ -0,0 +1,61 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blacksound/dsp/dspkernels.h"
+#include "blacksound/dsp/biquadfilter.h"
+
+#include <QtGlobal>
+#include <cmath>
+
+namespace BlackSound::Dsp
+{
+    void mixAccumulate(float *output, const float *input, int count)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            output[i] += input[i];
+        }
+    }
+
+    void applyGain(float *samples, int count, float gain)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            samples[i] *= gain;
+        }
+    }
+
+    void applyGainRamp(float *samples, int count, float startGain, float endGain)
+    {
+        if (count < 1) { return; }
+        const float step = (endGain - startGain) / static_cast<float>(count);
+        for (int i = 0; i < count; i++)
+        {
+            samples[i] *= startGain + step * static_cast<float>(i + 1);
+        }
+    }
+
+    void processBiQuads(BiQuadFilter *filters, int filterCount, float *samples, int count)
+    {
+        // band by band over the whole block, the filter state stays in registers
+        for (int band = 0; band < filterCount; band++)
+        {
+            filters[band].process(samples, count);
+        }
+    }
+
+    float peak(const float *samples, int count)
+    {
+        float max = 0.0f;
+        for (int i = 0; i < count; i++)
+        {
+            max = qMax(max, std::abs(samples[i]));
+        }
+        return max;
+    }
+} // ns
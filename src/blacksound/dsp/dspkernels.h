@@ -0,0 +1,43 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_DSP_DSPKERNELS_H
+#define BLACKSOUND_DSP_DSPKERNELS_H
+
+#include "blacksound/blacksoundexport.h"
+
+namespace BlackSound::Dsp
+{
+    class BiQuadFilter;
+
+    //! Block kernels of the audio graph
+    //! \remark plain loops over contiguous samples without branches in the loop body,
+    //!         so they are vectorized by the compiler (SSE2 on x86-64, NEON on ARM64)
+    //! @{
+
+    //! Add input to output
+    BLACKSOUND_EXPORT void mixAccumulate(float *output, const float *input, int count);
+
+    //! Multiply by a constant gain
+    BLACKSOUND_EXPORT void applyGain(float *samples, int count, float gain);
+
+    //! Multiply by a gain changing linearly from startGain to endGain over the block
+    //! \remark avoids clicks when the gain changes between blocks
+    BLACKSOUND_EXPORT void applyGainRamp(float *samples, int count, float startGain, float endGain);
+
+    //! Run the block through the filters one after another, same result as BiQuadFilter::transform per sample and filter
+    BLACKSOUND_EXPORT void processBiQuads(BiQuadFilter *filters, int filterCount, float *samples, int count);
+
+    //! Max. absolute sample
+    BLACKSOUND_EXPORT float peak(const float *samples, int count);
+    //! @}
+} // ns
+
+#endif // guard
@@ -1,7 +1,7 @@
 #include "bufferedwaveprovider.h"
 #include "blacksound/audioutilities.h"
 
-#include <QDebug>
+#include <algorithm>
 
 namespace BlackSound::SampleProvider
 {
@@ -11,31 +11,58 @@ namespace BlackSound::SampleProvider
         const QString on = QStringLiteral("%1 format: '%2'").arg(this->metaObject()->className(), BlackSound::toQString(format));
         this->setObjectName(on);
 
-        // Set buffer size to 10 secs
-        m_maxBufferSize = format.bytesForDuration(10 * 1000 * 1000);
+        // Set buffer size to 2 secs, way more than the max. delay of a stream
+        const int maxBufferSize = format.framesForDuration(2 * 1000 * 1000) * qMax(1, format.channelCount());
+        m_audioBuffer.resize(static_cast<size_t>(qMax(1, maxBufferSize)), 0.0f);
     }
 
     void CBufferedWaveProvider::addSamples(const QVector<float> &samples)
     {
-        int delta = m_audioBuffer.size() + samples.size() - m_maxBufferSize;
-        if (delta > 0)
+        const quint64 write = m_writeIndex.load(std::memory_order_relaxed);
+        const quint64 read  = m_readIndex.load(std::memory_order_acquire);
+        const int capacity  = this->getCapacity();
+        const int free      = capacity - static_cast<int>(write - read);
+        const int len       = qMin(samples.size(), free);
+        if (len < 1) { return; }
+
+        const int writeIndex = static_cast<int>(write % static_cast<quint64>(capacity));
+        const int first = qMin(len, capacity - writeIndex);
+        const float *source = samples.constData();
+        std::copy(source, source + first, m_audioBuffer.begin() + writeIndex);
+        std::copy(source + first, source + len, m_audioBuffer.begin());
+        m_writeIndex.store(write + static_cast<quint64>(len), std::memory_order_release);
+    }
+
+    int CBufferedWaveProvider::readSamples(CSampleSpan samples)
+    {
+        const quint64 write = m_writeIndex.load(std::memory_order_acquire);
+        const quint64 clear = m_clearIndex.load(std::memory_order_relaxed);
+        quint64 read = m_readIndex.load(std::memory_order_relaxed);
+        if (clear > read) { read = qMin(clear, write); }
+
+        const int len = qMin(samples.size(), static_cast<int>(write - read));
+        if (len > 0)
         {
-            m_audioBuffer.remove(0, delta);
+            const int capacity  = this->getCapacity();
+            const int readIndex = static_cast<int>(read % static_cast<quint64>(capacity));
+            const int first     = qMin(len, capacity - readIndex);
+            const float *ring   = m_audioBuffer.data();
+            std::copy(ring + readIndex, ring + readIndex + first, samples.begin());
+            std::copy(ring, ring + len - first, samples.begin() + first);
         }
-        m_audioBuffer.append(samples);
+        m_readIndex.store(read + static_cast<quint64>(qMax(0, len)), std::memory_order_release);
+        return qMax(0, len);
     }
 
-    int CBufferedWaveProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CBufferedWaveProvider::getBufferedBytes() const
     {
-        const int len = static_cast<int>(qMin(count, static_cast<qint64>(m_audioBuffer.size())));
-        samples = m_audioBuffer.mid(0, len);
-        // if (len != 0) qDebug() << "Reading" << count << "samples." << m_audioBuffer.size() << "currently in the buffer.";
-        m_audioBuffer.remove(0, len);
-        return len;
+        const quint64 read  = qMax(m_readIndex.load(), m_clearIndex.load());
+        const quint64 write = m_writeIndex.load();
+        return write > read ? static_cast<int>(write - read) : 0;
     }
 
     void CBufferedWaveProvider::clearBuffer()
     {
-        m_audioBuffer.clear();
+        m_clearIndex.store(m_writeIndex.load());
     }
 } // ns
@@ -17,10 +17,14 @@
 #include <QAudioFormat>
 #include <QByteArray>
 #include <QVector>
+#include <atomic>
+#include <vector>
 
 namespace BlackSound::SampleProvider
 {
     //! Buffered wave generator
+    //! \remark lock free ring for one producer thread adding and one consumer thread reading samples,
+    //!         allocated once, so it can be used as jitter buffer between the decoder and the audio callback
     class BLACKSOUND_EXPORT CBufferedWaveProvider : public ISampleProvider
     {
         Q_OBJECT
@@ -29,21 +33,30 @@ namespace BlackSound::SampleProvider
         //! Ctor
         CBufferedWaveProvider(const QAudioFormat &format, QObject *parent = nullptr);
 
-        //! Add samples
+        //! Add samples, samples not fitting in the buffer any more are dropped
+        //! \remark producer side, one thread only
         void addSamples(const QVector<float> &samples);
 
         //! ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        //! \remark consumer side, one thread only
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Bytes from buffer
-        int getBufferedBytes() const { return m_audioBuffer.size(); }
+        //! \remark thread safe
+        int getBufferedBytes() const;
+
+        //! Max. number of samples in the buffer
+        int getCapacity() const { return static_cast<int>(m_audioBuffer.size()); }
 
         //! Clear the buffer
+        //! \remark thread safe, the consumer skips the samples buffered so far
         void clearBuffer();
 
     private:
-        QVector<float> m_audioBuffer;
-        qint32 m_maxBufferSize;
+        std::vector<float> m_audioBuffer;       //!< ring, allocated once
+        std::atomic<quint64> m_writeIndex { 0 }; //!< samples added so far, only changed by the producer
+        std::atomic<quint64> m_readIndex  { 0 }; //!< samples read so far, only changed by the consumer
+        std::atomic<quint64> m_clearIndex { 0 }; //!< samples before are skipped by the consumer
     };
 } // ns
 
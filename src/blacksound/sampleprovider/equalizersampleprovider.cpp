@@ -1,5 +1,6 @@
 #include "equalizersampleprovider.h"
 #include "blacksound/audioutilities.h"
+#include "blacksound/dsp/dspkernels.h"
 #include <QDebug>
 
 using namespace BlackSound::Dsp;
@@ -17,19 +18,13 @@ namespace BlackSound::SampleProvider
         setupPreset(preset);
     }
 
-    int CEqualizerSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CEqualizerSampleProvider::readSamples(CSampleSpan samples)
     {
-        const int samplesRead = m_sourceProvider->readSamples(samples, count);
+        const int samplesRead = m_sourceProvider->readSamples(samples);
         if (m_bypass) return samplesRead;
 
-        for (int n = 0; n < samplesRead; n++)
-        {
-            for (int band = 0; band < m_filters.size(); band++)
-            {
-                samples[n] = m_filters[band].transform(samples[n]);
-            }
-            samples[n] *= static_cast<float>(m_outputGain);
-        }
+        processBiQuads(m_filters.data(), m_filters.size(), samples.data(), samplesRead);
+        applyGain(samples.data(), samplesRead, static_cast<float>(m_outputGain));
         return samplesRead;
     }
 
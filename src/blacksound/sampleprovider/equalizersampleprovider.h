@@ -36,7 +36,7 @@ namespace BlackSound::SampleProvider
         CEqualizerSampleProvider(ISampleProvider *sourceProvider, EqualizerPresets preset, QObject *parent = nullptr);
 
         //! \copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Bypassing?
         void setBypassEffects(bool value) { m_bypass = value; }
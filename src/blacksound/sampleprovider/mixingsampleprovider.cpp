@@ -7,9 +7,11 @@
  */
 
 #include "mixingsampleprovider.h"
+#include "blacksound/dsp/dspkernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound::SampleProvider
 {
@@ -28,37 +30,28 @@ namespace BlackSound::SampleProvider
         this->setObjectName(on);
     }
 
-    int CMixingSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CMixingSampleProvider::readSamples(CSampleSpan samples)
     {
-        samples.clear();
-        samples.fill(0, static_cast<int>(count));
+        Q_ASSERT_X(samples.size() <= m_sourceBuffer.capacity(), Q_FUNC_INFO, "Block larger than MaxBlockSize");
+        const CSampleSpan output = samples.first(m_sourceBuffer.capacity());
+        const CSampleSpan sourceBuffer = m_sourceBuffer.span(output.size());
+        output.fill(0);
         int outputLen = 0;
 
-        QVector<ISampleProvider *> finishedProviders;
         for (int i = 0; i < m_sources.size(); i++)
         {
             ISampleProvider *sampleProvider = m_sources.at(i);
-            QVector<float> sourceBuffer;
-
-            const int len = sampleProvider->readSamples(sourceBuffer, count);
-            for (int n = 0; n < len; n++)
-            {
-                samples[n] += sourceBuffer[n];
-            }
+            const int len = sampleProvider->readSamples(sourceBuffer);
+            mixAccumulate(output.data(), sourceBuffer.data(), len);
 
             outputLen = qMax(len, outputLen);
-            if (sampleProvider->isFinished())
+            if (sampleProvider->isFinished() && sampleProvider->parent() == this)
             {
-                finishedProviders.push_back(sampleProvider);
+                sampleProvider->deleteLater();
+                m_sources.remove(i--);
             }
         }
 
-        for (ISampleProvider *sampleProvider : finishedProviders)
-        {
-            sampleProvider->deleteLater();
-            m_sources.removeAll(sampleProvider);
-        }
-
         return outputLen;
     }
 } // ns
@@ -26,13 +26,16 @@ namespace BlackSound::SampleProvider
         CMixingSampleProvider(QObject *parent = nullptr);
 
         //! Add a provider
+        //! \remark finished providers owned by the mixer are removed and deleted, others are kept and can be restarted
         void addMixerInput(ISampleProvider *provider);
 
         //! \copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
     private:
         QVector<ISampleProvider *> m_sources;
+        CSampleBuffer m_sourceBuffer { MaxBlockSize }; //!< block read from a source, allocated once
+
     };
 } // ns
 
@@ -12,13 +12,10 @@
 
 namespace BlackSound::SampleProvider
 {
-    int CPinkNoiseGenerator::readSamples(QVector<float> &samples, qint64 count)
+    int CPinkNoiseGenerator::readSamples(CSampleSpan samples)
     {
-        const int c = static_cast<int>(count);
-        samples.clear();
-        samples.fill(0, c);
-
-        for (int sampleCount = 0; sampleCount < count; sampleCount++)
+        const int c = samples.size();
+        for (int sampleCount = 0; sampleCount < c; sampleCount++)
         {
             double white = 2 * m_random.generateDouble() - 1;
 
@@ -31,7 +31,7 @@ namespace BlackSound::SampleProvider
         CPinkNoiseGenerator(QObject *parent = nullptr) : ISampleProvider(parent) {}
 
         //! Read samples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Gain
         void setGain(double gain) { m_gain = gain; }
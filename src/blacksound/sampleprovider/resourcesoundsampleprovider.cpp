@@ -9,7 +9,7 @@
 #include "resourcesoundsampleprovider.h"
 #include "blackmisc/metadatautils.h"
 
-#include <QDebug>
+#include <algorithm>
 
 using namespace BlackMisc;
 
@@ -21,40 +21,28 @@ namespace BlackSound::SampleProvider
     {
         const QString on = QStringLiteral("%1 %2").arg(classNameShort(this), resourceSound.getFileName());
         this->setObjectName(on);
-        m_tempBuffer.resize(m_tempBufferSize);
     }
 
-    int CResourceSoundSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CResourceSoundSampleProvider::readSamples(CSampleSpan samples)
     {
-        if (!m_resourceSound.isLoaded()) { return 0; }
-        if (count > m_tempBufferSize)
-        {
-            qDebug() << "Count too large for temp buffer" << count;
-            return 0;
-        }
-        const qint64 availableSamples = m_resourceSound.audioData().size() - m_position;
-        const qint64 samplesToCopy    = qMin(availableSamples, count);
-        samples.clear();
-        samples.fill(0, static_cast<int>(samplesToCopy));
+        if (!m_resourceSound.isLoaded() || m_isFinished) { return 0; }
+        const QVector<float> &audioData = m_resourceSound.audioData();
+        const qint64 availableSamples = audioData.size() - m_position;
+        const int samplesToCopy = static_cast<int>(qMin(availableSamples, static_cast<qint64>(samples.size())));
+        const float *source = audioData.constData() + m_position;
 
-        for (int i = 0; i < samplesToCopy; i++)
+        if (qFuzzyCompare(m_gain, 1.0))
         {
-            m_tempBuffer[i] = m_resourceSound.audioData().at(static_cast<int>(m_position) + i);
+            std::copy(source, source + samplesToCopy, samples.begin());
         }
-
-        if (!qFuzzyCompare(m_gain, 1.0))
+        else
         {
             for (int i = 0; i < samplesToCopy; i++)
             {
-                m_tempBuffer[i] = static_cast<float>(m_gain * m_tempBuffer[i]);
+                samples[i] = static_cast<float>(m_gain * source[i]);
             }
         }
 
-        for (int i = 0; i < samplesToCopy; i++)
-        {
-            samples[i] = m_tempBuffer.at(i);
-        }
-
         m_position += samplesToCopy;
 
         if (m_position > availableSamples - 1)
@@ -63,6 +51,17 @@ namespace BlackSound::SampleProvider
             else { m_isFinished = true; }
         }
 
-        return static_cast<int>(samplesToCopy);
+        return samplesToCopy;
+    }
+
+    void CResourceSoundSampleProvider::restart()
+    {
+        m_position = 0;
+        m_isFinished = false;
+    }
+
+    void CResourceSoundSampleProvider::stop()
+    {
+        m_isFinished = true;
     }
 } // ns
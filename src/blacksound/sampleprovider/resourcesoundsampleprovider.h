@@ -25,11 +25,17 @@ namespace BlackSound::SampleProvider
         CResourceSoundSampleProvider(const CResourceSound &resourceSound, QObject *parent = nullptr);
 
         //! copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! copydoc ISampleProvider::isFinished
         virtual bool isFinished() const override { return m_isFinished; }
 
+        //! Play again from the start, also when finished
+        void restart();
+
+        //! Stop playing, the provider is finished afterwards
+        void stop();
+
         //! Looping
         //! @{
         bool looping() const { return m_looping; }
@@ -48,8 +54,6 @@ namespace BlackSound::SampleProvider
 
         CResourceSound  m_resourceSound;
         qint64          m_position = 0;
-        const int       m_tempBufferSize = 24000; //24000 = 500ms (avoid buffer overflow), m_tempBufferSize = 9600; //9600 = 200ms
-        QVector<float>  m_tempBuffer;
         bool            m_isFinished = false;
     };
 } // ns
@@ -0,0 +1,24 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+#include "blacksound/sampleprovider/samplebuffer.h"
+
+#include <cstdint>
+
+namespace BlackSound::SampleProvider
+{
+    CSampleBuffer::CSampleBuffer(int capacity) : m_capacity(qMax(0, capacity))
+    {
+        constexpr int extra = Alignment / static_cast<int>(sizeof(float));
+        m_storage.resize(static_cast<size_t>(m_capacity + extra), 0.0f);
+
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_storage.data());
+        const std::uintptr_t aligned = (address + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1);
+        m_data = m_storage.data() + (aligned - address) / sizeof(float);
+    }
+} // ns
@@ -0,0 +1,95 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \file
+
+#ifndef BLACKSOUND_SAMPLEPROVIDER_SAMPLEBUFFER_H
+#define BLACKSOUND_SAMPLEPROVIDER_SAMPLEBUFFER_H
+
+#include "blacksound/blacksoundexport.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <vector>
+
+namespace BlackSound::SampleProvider
+{
+    //! Non owning view on a block of samples
+    //! \remark blocks are passed through the audio graph by span, the memory is owned by the graph
+    class CSampleSpan
+    {
+    public:
+        //! Empty span
+        CSampleSpan() = default;
+
+        //! Span of samples
+        CSampleSpan(float *data, int size) : m_data(data), m_size(size) { Q_ASSERT_X(size >= 0, Q_FUNC_INFO, "Negative size"); }
+
+        //! Samples
+        float *data() const { return m_data; }
+
+        //! Number of samples
+        int size() const { return m_size; }
+
+        //! No samples?
+        bool isEmpty() const { return m_size < 1; }
+
+        //! Sample by index
+        float &operator [](int index) const { Q_ASSERT_X(index >= 0 && index < m_size, Q_FUNC_INFO, "Index out of range"); return m_data[index]; }
+
+        //! Iterators
+        //! @{
+        float *begin() const { return m_data; }
+        float *end() const { return m_data + m_size; }
+        //! @}
+
+        //! The first samples
+        CSampleSpan first(int count) const { return { m_data, qBound(0, count, m_size) }; }
+
+        //! Set all samples
+        void fill(float value) const { std::fill(this->begin(), this->end(), value); }
+
+    private:
+        float *m_data = nullptr;
+        int m_size = 0;
+    };
+
+    //! Scratch buffer of the audio graph
+    //! \remark allocated once when the graph is configured, never resized in the audio callback
+    class BLACKSOUND_EXPORT CSampleBuffer
+    {
+    public:
+        //! Alignment of the samples in bytes, suitable for vector registers
+        static constexpr int Alignment = 32;
+
+        //! Ctor, allocates the capacity
+        explicit CSampleBuffer(int capacity);
+
+        //! Not copyable, spans point into the buffer
+        //! @{
+        CSampleBuffer(const CSampleBuffer &) = delete;
+        CSampleBuffer &operator =(const CSampleBuffer &) = delete;
+        //! @}
+
+        //! Max. number of samples
+        int capacity() const { return m_capacity; }
+
+        //! Aligned samples
+        float *data() const { return m_data; }
+
+        //! Span of the first samples, count is limited to the capacity
+        CSampleSpan span(int count) const { return { m_data, qBound(0, count, m_capacity) }; }
+
+    private:
+        std::vector<float> m_storage; //!< storage, larger than capacity for the alignment
+        float *m_data = nullptr;      //!< aligned begin in storage
+        int m_capacity = 0;
+    };
+} // ns
+
+#endif // guard
@@ -13,8 +13,8 @@
 
 #include "blackconfig/buildconfig.h"
 #include "blacksound/blacksoundexport.h"
+#include "blacksound/sampleprovider/samplebuffer.h"
 #include <QObject>
-#include <QVector>
 
 namespace BlackSound::SampleProvider
 {
@@ -30,8 +30,13 @@ namespace BlackSound::SampleProvider
         //! Dtor
         virtual ~ISampleProvider() override {}
 
-        //! Read samples
-        virtual int readSamples(QVector<float> &samples, qint64 count) = 0;
+        //! Max. number of samples read at once, the buffers of the graph are allocated for this size
+        static constexpr int MaxBlockSize = 4800; // 100ms at 48kHz
+
+        //! Read samples into the front of the block
+        //! \remark called in the audio callback, implementations must not allocate memory
+        //! \remark the block size is max. MaxBlockSize, the number of samples read is returned
+        virtual int readSamples(CSampleSpan samples) = 0;
 
         //! Finished?
         virtual bool isFinished() const { return false; }
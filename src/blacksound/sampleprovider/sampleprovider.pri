@@ -5,6 +5,7 @@ SOURCES += \
     $$files($$PWD/sampleprovider/pinknoisegenerator.cpp) \
     $$files($$PWD/sampleprovider/resourcesound.cpp) \
     $$files($$PWD/sampleprovider/resourcesoundsampleprovider.cpp) \
+    $$files($$PWD/sampleprovider/samplebuffer.cpp) \
     $$files($$PWD/sampleprovider/samples.cpp) \
     $$files($$PWD/sampleprovider/sawtoothgenerator.cpp) \
     $$files($$PWD/sampleprovider/simplecompressoreffect.cpp) \
@@ -14,6 +15,7 @@ HEADERS += \
     $$files($$PWD/sampleprovider/mixingsampleprovider.h) \
     $$files($$PWD/sampleprovider/resourcesound.h) \
     $$files($$PWD/sampleprovider/resourcesoundsampleprovider.h) \
+    $$files($$PWD/sampleprovider/samplebuffer.h) \
     $$files($$PWD/sampleprovider/sampleprovider.h) \
     $$files($$PWD/sampleprovider/equalizersampleprovider.h) \
     $$files($$PWD/sampleprovider/pinknoisegenerator.h) \
@@ -18,11 +18,9 @@ namespace BlackSound::SampleProvider
         this->setObjectName("CSawToothGenerator");
     }
 
-    int CSawToothGenerator::readSamples(QVector<float> &samples, qint64 count)
+    int CSawToothGenerator::readSamples(CSampleSpan samples)
     {
-        samples.clear();
-        samples.fill(0, static_cast<int>(count));
-
+        const int count = samples.size();
         for (int sampleCount = 0; sampleCount < count; sampleCount++)
         {
             double multiple = 2 * m_frequency / m_sampleRate;
@@ -31,6 +29,6 @@ namespace BlackSound::SampleProvider
             samples[sampleCount] = static_cast<float>(sampleValue);
             m_nSample++;
         }
-        return static_cast<int>(count);
+        return count;
     }
 } // ns
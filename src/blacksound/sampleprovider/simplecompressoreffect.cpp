@@ -29,22 +29,33 @@ namespace BlackSound::SampleProvider
         m_timer->start(3000);
     }
 
-    int CSimpleCompressorEffect::readSamples(QVector<float> &samples, qint64 count)
+    int CSimpleCompressorEffect::readSamples(CSampleSpan samples)
     {
-        int samplesRead = m_sourceStream->readSamples(samples, count);
+        const int samplesRead = m_sourceStream->readSamples(samples);
 
-        if (m_enabled)
+        if (!m_enabled) { return samplesRead; }
+
+        // the envelope follower is recursive, so sample by sample, but without branches in the loop
+        float *data = samples.data();
+        if (m_channels == 1)
+        {
+            for (int sample = 0; sample < samplesRead; sample++)
+            {
+                double in1 = data[sample];
+                double in2 = 0;
+                m_simpleCompressor.process(in1, in2);
+                data[sample] = static_cast<float>(in1);
+            }
+        }
+        else
         {
-            for (int sample = 0; sample < samplesRead; sample += m_channels)
+            for (int sample = 0; sample + 1 < samplesRead; sample += 2)
             {
-                double in1 = samples.at(sample);
-                double in2 = (m_channels == 1) ? 0 : samples.at(sample + 1);
+                double in1 = data[sample];
+                double in2 = data[sample + 1];
                 m_simpleCompressor.process(in1, in2);
-                samples[sample] = static_cast<float>(in1);
-                if (m_channels > 1)
-                {
-                    samples[sample + 1] = static_cast<float>(in2);
-                }
+                data[sample]     = static_cast<float>(in1);
+                data[sample + 1] = static_cast<float>(in2);
             }
         }
         return samplesRead;
@@ -30,7 +30,7 @@ namespace BlackSound::SampleProvider
         CSimpleCompressorEffect(ISampleProvider *source, QObject *parent = nullptr);
 
         //! \copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Enable
         void setEnabled(bool enabled);
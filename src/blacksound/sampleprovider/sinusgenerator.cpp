@@ -22,11 +22,9 @@ namespace BlackSound::SampleProvider
         this->setObjectName(on);
     }
 
-    int CSinusGenerator::readSamples(QVector<float> &samples, qint64 count)
+    int CSinusGenerator::readSamples(CSampleSpan samples)
     {
-        samples.clear();
-        samples.fill(0, static_cast<int>(count));
-
+        const int count = samples.size();
         for (int sampleCount = 0; sampleCount < count; sampleCount++)
         {
             const double multiple    = s_twoPi * m_frequencyHz / m_sampleRate;
@@ -34,7 +32,7 @@ namespace BlackSound::SampleProvider
             samples[sampleCount]     = static_cast<float>(sampleValue);
             m_nSample++;
         }
-        return static_cast<int>(count);
+        return count;
     }
 
     void CSinusGenerator::setFrequency(double frequencyHz)
@@ -28,7 +28,7 @@ namespace BlackSound::SampleProvider
         CSinusGenerator(double frequencyHz, QObject *parent = nullptr);
 
         //! \copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Set the gain
         void setGain(double gain) { m_gain = gain; }
@@ -9,9 +9,11 @@
 //! \file
 
 #include "volumesampleprovider.h"
+#include "blacksound/dsp/dspkernels.h"
 #include "blackmisc/metadatautils.h"
 
 using namespace BlackMisc;
+using namespace BlackSound::Dsp;
 
 namespace BlackSound::SampleProvider
 {
@@ -24,15 +26,19 @@ namespace BlackSound::SampleProvider
         this->setObjectName(on);
     }
 
-    int CVolumeSampleProvider::readSamples(QVector<float> &samples, qint64 count)
+    int CVolumeSampleProvider::readSamples(CSampleSpan samples)
     {
-        const int samplesRead = m_sourceProvider->readSamples(samples, count);
-        if (!qFuzzyCompare(m_gainRatio, 1.0))
+        const int samplesRead = m_sourceProvider->readSamples(samples);
+        const float gain = static_cast<float>(m_gainRatio);
+        if (!qFuzzyCompare(m_appliedGain, gain))
         {
-            for (int n = 0; n < samplesRead; n++)
-            {
-                samples[n] = static_cast<float>(m_gainRatio * samples[n]);
-            }
+            // changed gain, ramp over the block
+            applyGainRamp(samples.data(), samplesRead, m_appliedGain, gain);
+            if (samplesRead > 0) { m_appliedGain = gain; }
+        }
+        else if (!qFuzzyCompare(gain, 1.0f))
+        {
+            applyGain(samples.data(), samplesRead, gain);
         }
         return samplesRead;
     }
@@ -26,7 +26,7 @@ namespace BlackSound::SampleProvider
         CVolumeSampleProvider(ISampleProvider *sourceProvider, QObject *parent = nullptr);
 
         //! \copydoc ISampleProvider::readSamples
-        virtual int readSamples(QVector<float> &samples, qint64 count) override;
+        virtual int readSamples(CSampleSpan samples) override;
 
         //! Gain ratio, value a amplitude need to be multiplied with
         //! \see http://www.sengpielaudio.com/calculator-amplification.htm
@@ -42,6 +42,7 @@ namespace BlackSound::SampleProvider
     private:
         ISampleProvider *m_sourceProvider = nullptr;
         double m_gainRatio = 1.0;
+        float m_appliedGain = 1.0f; //!< gain of the last block, a new ratio is ramped from there
     };
 } // ns
 
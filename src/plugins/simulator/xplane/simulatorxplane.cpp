@@ -179,6 +179,7 @@ namespace BlackSimPlugin::XPlane
             m_trafficProxy->setPlanesSurfaces(surfaces);
             u++;
         }
+        m_trafficProxy->publishSharedMemory();
         return u > 0;
     }
 
@@ -526,6 +527,7 @@ namespace BlackSimPlugin::XPlane
         connect(m_trafficProxy, &CXSwiftBusTrafficProxy::remoteAircraftAddingFailed, this, &CSimulatorXPlane::onRemoteAircraftAddingFailed);
         if (m_watcher) { m_watcher->setConnection(m_dBusConnection); }
         m_trafficProxy->removeAllPlanes();
+        m_trafficProxy->initializeSharedMemory();
 
         // send the settings
         this->sendXSwiftBusSettings();
@@ -837,6 +839,7 @@ namespace BlackSimPlugin::XPlane
             PlanesSurfaces surfaces;
             surfaces.push_back(newRemoteAircraft.getCallsign(), newRemoteAircraft.getParts());
             m_trafficProxy->setPlanesSurfaces(surfaces);
+            m_trafficProxy->publishSharedMemory();
         }
         else
         {
@@ -1121,6 +1124,9 @@ namespace BlackSimPlugin::XPlane
             m_trafficProxy->setPlanesSurfaces(planesSurfaces);
         }
 
+        // one shared memory frame with positions, surfaces and transponders
+        m_trafficProxy->publishSharedMemory();
+
         // stats
         this->finishUpdateRemoteAircraftAndSetStatistics(currentTimestamp);
     }
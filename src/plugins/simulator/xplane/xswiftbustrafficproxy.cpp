@@ -11,6 +11,9 @@
 
 #include <QLatin1String>
 #include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QPointer>
 #include <cmath>
 
 #define XSWIFTBUS_SERVICENAME "org.swift-project.xswiftbus"
@@ -70,6 +73,60 @@ namespace BlackSimPlugin::XPlane
     void CXSwiftBusTrafficProxy::cleanup()
     {
         m_dbusInterface->callDBus(QLatin1String("cleanup"));
+        m_sharedMemoryOpened = false;
+        m_sharedMemoryChanged = false;
+        m_sharedMemory.close();
+    }
+
+    bool CXSwiftBusTrafficProxy::initializeSharedMemory()
+    {
+        using namespace BlackMisc::Simulation::XPlane;
+        if (m_sharedMemory.isOpen()) { return true; }
+        if (!m_sharedMemory.create(TrafficSharedMemory::segmentName()))
+        {
+            CLogMessage(this).info(u"Shared memory not available, traffic data sent via DBus");
+            return false;
+        }
+
+        // fails if XSwiftBus is on another machine or an older version, until answered DBus is used
+        const QString name = QString::fromStdString(m_sharedMemory.name());
+        QPointer<CXSwiftBusTrafficProxy> myself(this);
+        std::function<void(QDBusPendingCallWatcher *)> callback = [ = ](QDBusPendingCallWatcher * watcher)
+        {
+            const QDBusPendingReply<bool> reply = *watcher;
+            watcher->deleteLater();
+            if (!myself || !m_sharedMemory.isOpen() || QString::fromStdString(m_sharedMemory.name()) != name) { return; } // closed meanwhile
+            if (reply.isError() || !reply.value())
+            {
+                m_sharedMemory.close();
+                CLogMessage(this).info(u"XSwiftBus can not use shared memory '%1', traffic data sent via DBus") << name;
+                return;
+            }
+            m_sharedMemoryOpened = true;
+            CLogMessage(this).info(u"Traffic data sent via shared memory '%1'") << name;
+        };
+        m_dbusInterface->callDBusAsync(QLatin1String("openSharedMemory"), callback, name);
+        return true;
+    }
+
+    void CXSwiftBusTrafficProxy::publishSharedMemory()
+    {
+        if (!m_sharedMemoryChanged || !this->isUsingSharedMemory()) { return; }
+        m_sharedMemoryChanged = false;
+        m_sharedMemory.publish();
+    }
+
+    std::vector<int> CXSwiftBusTrafficProxy::sharedMemorySlots(const QStringList &callsigns)
+    {
+        std::vector<int> slots;
+        slots.reserve(static_cast<size_t>(callsigns.size()));
+        for (const QString &callsign : callsigns)
+        {
+            const int slot = m_sharedMemory.slot(callsign.toStdString());
+            if (slot < 0) { return {}; }
+            slots.push_back(slot);
+        }
+        return slots;
     }
 
     QString CXSwiftBusTrafficProxy::loadPlanesPackage(const QString &path)
@@ -100,15 +157,33 @@ namespace BlackSimPlugin::XPlane
     void CXSwiftBusTrafficProxy::removePlane(const QString &callsign)
     {
         m_dbusInterface->callDBus(QLatin1String("removePlane"), callsign);
+        m_sharedMemory.removePlane(callsign.toStdString());
     }
 
     void CXSwiftBusTrafficProxy::removeAllPlanes()
     {
         m_dbusInterface->callDBus(QLatin1String("removeAllPlanes"));
+        m_sharedMemory.removeAllPlanes();
     }
 
     void CXSwiftBusTrafficProxy::setPlanesPositions(const PlanesPositions &planesPositions)
     {
+        if (this->isUsingSharedMemory() && planesPositions.hasSameSizes())
+        {
+            const std::vector<int> slots = this->sharedMemorySlots(planesPositions.callsigns);
+            if (!slots.empty())
+            {
+                for (int i = 0; i < planesPositions.callsigns.size(); ++i)
+                {
+                    const bool onGround = i < planesPositions.onGrounds.size() && planesPositions.onGrounds[i];
+                    m_sharedMemory.setPosition(slots[static_cast<size_t>(i)], planesPositions.latitudesDeg[i], planesPositions.longitudesDeg[i], planesPositions.altitudesFt[i],
+                                               planesPositions.pitchesDeg[i], planesPositions.rollsDeg[i], planesPositions.headingsDeg[i], onGround);
+                }
+                m_sharedMemoryChanged = true; // published once per frame
+                return;
+            }
+        }
+
         m_dbusInterface->callDBus(QLatin1String("setPlanesPositions"),
                                     planesPositions.callsigns, planesPositions.latitudesDeg, planesPositions.longitudesDeg,
                                     planesPositions.altitudesFt, planesPositions.pitchesDeg, planesPositions.rollsDeg,
@@ -117,6 +192,24 @@ namespace BlackSimPlugin::XPlane
 
     void CXSwiftBusTrafficProxy::setPlanesSurfaces(const PlanesSurfaces &planesSurfaces)
     {
+        if (this->isUsingSharedMemory() && planesSurfaces.hasSameSizes())
+        {
+            const std::vector<int> slots = this->sharedMemorySlots(planesSurfaces.callsigns);
+            if (!slots.empty())
+            {
+                for (int i = 0; i < planesSurfaces.callsigns.size(); ++i)
+                {
+                    m_sharedMemory.setSurfaces(slots[static_cast<size_t>(i)], planesSurfaces.gears[i], planesSurfaces.flaps[i], planesSurfaces.spoilers[i],
+                                               planesSurfaces.speedBrakes[i], planesSurfaces.slats[i], planesSurfaces.wingSweeps[i], planesSurfaces.thrusts[i],
+                                               planesSurfaces.elevators[i], planesSurfaces.rudders[i], planesSurfaces.ailerons[i],
+                                               planesSurfaces.landLights[i], planesSurfaces.taxiLights[i], planesSurfaces.beaconLights[i],
+                                               planesSurfaces.strobeLights[i], planesSurfaces.navLights[i], planesSurfaces.lightPatterns[i]);
+                }
+                m_sharedMemoryChanged = true; // published once per frame
+                return;
+            }
+        }
+
         m_dbusInterface->callDBus(QLatin1String("setPlanesSurfaces"),
                                     planesSurfaces.callsigns, planesSurfaces.gears, planesSurfaces.flaps,
                                     planesSurfaces.spoilers, planesSurfaces.speedBrakes, planesSurfaces.slats,
@@ -129,6 +222,20 @@ namespace BlackSimPlugin::XPlane
 
     void CXSwiftBusTrafficProxy::setPlanesTransponders(const PlanesTransponders &planesTransponders)
     {
+        if (this->isUsingSharedMemory() && planesTransponders.hasSameSizes())
+        {
+            const std::vector<int> slots = this->sharedMemorySlots(planesTransponders.callsigns);
+            if (!slots.empty())
+            {
+                for (int i = 0; i < planesTransponders.callsigns.size(); ++i)
+                {
+                    m_sharedMemory.setTransponder(slots[static_cast<size_t>(i)], planesTransponders.codes[i], planesTransponders.modeCs[i], planesTransponders.idents[i]);
+                }
+                m_sharedMemoryChanged = true; // published once per frame
+                return;
+            }
+        }
+
         m_dbusInterface->callDBus(QLatin1String("setPlanesTransponders"),
                                     planesTransponders.callsigns, planesTransponders.codes,
                                     planesTransponders.modeCs, planesTransponders.idents);
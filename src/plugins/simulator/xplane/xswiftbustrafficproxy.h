@@ -16,6 +16,7 @@
 #include "blackmisc/aviation/aircraftparts.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/geo/elevationplane.h"
+#include "blackmisc/simulation/xplane/trafficsharedmemory.h"
 #include "blackmisc/logcategories.h"
 
 #include <QObject>
@@ -109,6 +110,29 @@ namespace BlackSimPlugin::XPlane
             this->lightPatterns.push_back(0);
         }
 
+        //! Check function
+        bool hasSameSizes() const
+        {
+            const int s = callsigns.size();
+            if (s != gears.size())         { return false; }
+            if (s != flaps.size())         { return false; }
+            if (s != spoilers.size())      { return false; }
+            if (s != speedBrakes.size())   { return false; }
+            if (s != slats.size())         { return false; }
+            if (s != wingSweeps.size())    { return false; }
+            if (s != thrusts.size())       { return false; }
+            if (s != elevators.size())     { return false; }
+            if (s != rudders.size())       { return false; }
+            if (s != ailerons.size())      { return false; }
+            if (s != landLights.size())    { return false; }
+            if (s != taxiLights.size())    { return false; }
+            if (s != beaconLights.size())  { return false; }
+            if (s != strobeLights.size())  { return false; }
+            if (s != navLights.size())     { return false; }
+            if (s != lightPatterns.size()) { return false; }
+            return true;
+        }
+
         QStringList callsigns;      //!< List of callsigns
         QList<double> gears;        //!< List of gears
         QList<double> flaps;        //!< List of flaps
@@ -134,6 +158,16 @@ namespace BlackSimPlugin::XPlane
         //! Is empty?
         bool isEmpty() const { return callsigns.isEmpty(); }
 
+        //! Check function
+        bool hasSameSizes() const
+        {
+            const int s = callsigns.size();
+            if (s != codes.size())   { return false; }
+            if (s != modeCs.size())  { return false; }
+            if (s != idents.size())  { return false; }
+            return true;
+        }
+
         QStringList callsigns;  //!< List of callsigns
         QList<int> codes;       //!< List of transponder codes
         QList<bool> modeCs;     //!< List of active mode C's
@@ -226,6 +260,18 @@ namespace BlackSimPlugin::XPlane
         //! \copydoc XSwiftBus::CTraffic::removeAllPlanes
         void removeAllPlanes();
 
+        //! Send positions, surfaces and transponders through shared memory instead of DBus
+        //! \remark only possible if XSwiftBus runs on the same machine, otherwise DBus is used
+        //! \remark XSwiftBus is asked asynchronously to open the shared memory, until it has DBus is used
+        bool initializeSharedMemory();
+
+        //! Sending positions, surfaces and transponders through shared memory?
+        bool isUsingSharedMemory() const { return m_sharedMemoryOpened && m_sharedMemory.isOpen(); }
+
+        //! Publish the positions, surfaces and transponders set since the last call as one frame
+        //! \remark to be called once per frame after all setPlanes... calls, no-op if DBus is used
+        void publishSharedMemory();
+
         //! \copydoc XSwiftBus::CTraffic::setPlanesPositions
         void setPlanesPositions(const BlackSimPlugin::XPlane::PlanesPositions &planesPositions);
 
@@ -249,7 +295,13 @@ namespace BlackSimPlugin::XPlane
         void setFollowedAircraft(const QString &callsign);
 
     private:
+        //! Shared memory slots for all callsigns, empty if not all planes fit
+        std::vector<int> sharedMemorySlots(const QStringList &callsigns);
+
         BlackMisc::CGenericDBusInterface *m_dbusInterface = nullptr;
+        BlackMisc::Simulation::XPlane::TrafficSharedMemory::CWriter m_sharedMemory; //!< per frame traffic data if XSwiftBus is local
+        bool m_sharedMemoryOpened  = false; //!< XSwiftBus has opened the shared memory
+        bool m_sharedMemoryChanged = false; //!< data set since the last published frame
     };
 } // ns
 
@@ -19,7 +19,10 @@
 #include <QNetworkReply>
 #include <QEventLoop>
 #include <QStringBuilder>
+#include <QElapsedTimer>
 #include <cmath>
+#include <thread>
+#include <vector>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -116,6 +119,35 @@ namespace BlackWxPlugin::Gfs
         float surfacePrecipitationRate = 0;
         float pressureAtMsl = 0.0;
     };
+
+    struct GribMessage
+    {
+        g2int offset = 0;
+        g2int length = 0;
+    };
+
+    //! Unpacks all fields of the GRIB message, caller has to g2_free them
+    //! \threadsafe
+    std::vector<gribfield *> unpackGribMessage(unsigned char *message)
+    {
+        std::vector<gribfield *> fields;
+        g2int sec0[3];
+        g2int sec1[13];
+        g2int numlocal = 0;
+        g2int numfields = 0;
+        if (g2_info(message, sec0, sec1, &numfields, &numlocal) != 0) { return fields; }
+
+        fields.reserve(static_cast<size_t>(numfields));
+        for (int n = 0; n < numfields; n++)
+        {
+            g2int unpack = 1;
+            g2int expand = 1;
+            gribfield *gfld = nullptr;
+            g2_getfld(message, n + 1, unpack, expand, &gfld);
+            if (gfld) { fields.push_back(gfld); }
+        }
+        return fields;
+    }
     //! \endcond
 
     const CWeatherDataGfs::Grib2ParameterTable CWeatherDataGfs::m_grib2ParameterTable
@@ -335,69 +367,79 @@ namespace BlackWxPlugin::Gfs
         m_gfsWeatherGrid.clear();
         m_weatherGrid.clear();
 
-        // Messages should be 76. This is a combination
-        // of requested values (e.g. temperature, clouds etc) at specific layers (2 mbar, 10 mbar, surface).
-        constexpr int maxMessages = 76;
-        int messageNo = 0;
+        QElapsedTimer timer;
+        timer.start();
+
+        // First pass: index all GRIB messages, this is cheap compared to unpacking them
+        auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
+        QVector<GribMessage> messages;
         g2int iseek = 0;
         for (;;)
         {
-            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
-
-            // Search next grib field
             g2int lskip = 0;
             g2int lgrib = 0;
-            auto constData = reinterpret_cast<unsigned char *>(const_cast<char *>(gribData.data()));
             findNextGribMessage(constData, gribData.size(), iseek, &lskip, &lgrib);
             if (lgrib == 0) { break; }
-
-            unsigned char *readPtr = constData + lskip;
+            messages.push_back({ lskip, lgrib });
             iseek = lskip + lgrib;
-
-            g2int sec0[3];
-            g2int sec1[13];
-            g2int numlocal = 0;
-            g2int numfields = 0;
-            g2_info(readPtr, sec0, sec1, &numfields, &numlocal);
-
-            for (int n = 0; n < numfields; n++)
-            {
-                g2int unpack = 1;
-                g2int expand = 1;
-                gribfield *gfld = nullptr;
-                g2_getfld(readPtr, n + 1, unpack, expand, &gfld);
-                if (gfld->idsectlen < 12) { CLogMessage(this).warning(u"Identification section: wrong length!"); continue; }
-
-                if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
-
-                int nscan = gfld->igdtmpl[18];
-                int npnts = gfld->ngrdpts;
-                int nx = gfld->igdtmpl[7];
-                int ny = gfld->igdtmpl[8];
-                if (nscan != 0) {  CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
-                if (npnts != nx * ny) {  CLogMessage(this).error(u"Cannot handle non-regular grid."); }
-
-                if (m_gfsWeatherGrid.isEmpty()) { createWeatherGrid(gfld); }
-
-                if (gfld->ipdtnum == 0) { handleProductDefinitionTemplate40(gfld); }
-                else if (gfld->ipdtnum == 8) { handleProductDefinitionTemplate48(gfld); }
-                else { CLogMessage(this).warning(u"Cannot handle product definition template %1") << gfld->ipdtnum; continue; }
-
-                g2_free(gfld);
-            }
-            messageNo++;
         }
+        const qint64 indexMs = timer.elapsed();
 
-        // validate
-        if (messageNo > maxMessages && CBuildConfig::isLocalDeveloperDebugBuild())
+        // Messages should be 76. This is a combination
+        // of requested values (e.g. temperature, clouds etc) at specific layers (2 mbar, 10 mbar, surface).
+        constexpr int maxMessages = 76;
+        if (messages.size() > maxMessages && CBuildConfig::isLocalDeveloperDebugBuild())
         {
             // as discussed this means a format change
             BLACK_VERIFY_X(false, Q_FUNC_INFO, "Format change in GRIB, too many messages");
         }
 
+        // Second pass: messages are independent and unpacked in parallel.
+        // All fields write the same grid points, so they are applied afterwards in message order.
+        // An unpacked field has one value per grid point, hence only one batch is kept in memory.
+        const int threads = qBound(1, QThread::idealThreadCount(), 16);
+        rdieee(nullptr, nullptr, 0); // initializes the static constants of g2clib before it is used concurrently
+        std::vector<std::vector<gribfield *>> unpacked(static_cast<size_t>(threads));
+        qint64 unpackMs = 0;
+        qint64 applyMs = 0;
+        QElapsedTimer stepTimer;
+        for (int batchStart = 0; batchStart < messages.size(); batchStart += threads)
+        {
+            if (QThread::currentThread()->isInterruptionRequested()) { return false; }
+
+            const int batchSize = qMin(threads, messages.size() - batchStart);
+            stepTimer.start();
+            std::vector<std::thread> decoders;
+            decoders.reserve(static_cast<size_t>(batchSize - 1));
+            for (int i = 1; i < batchSize; i++)
+            {
+                unsigned char *message = constData + messages[batchStart + i].offset;
+                decoders.emplace_back([&unpacked, i, message]
+                {
+                    unpacked[i] = unpackGribMessage(message);
+                });
+            }
+            unpacked[0] = unpackGribMessage(constData + messages[batchStart].offset);
+            for (std::thread &decoder : decoders) { decoder.join(); }
+            unpackMs += stepTimer.elapsed();
+
+            stepTimer.start();
+            for (int i = 0; i < batchSize; i++)
+            {
+                for (gribfield *gfld : unpacked[i])
+                {
+                    handleGribField(gfld);
+                    g2_free(gfld);
+                }
+                unpacked[i].clear();
+            }
+            applyMs += stepTimer.elapsed();
+        }
+
         const int weatherGridPointsNo = m_gfsWeatherGrid.size();
-        CLogMessage(this).debug() << "Parsed"   << messageNo << "GRIB messages.";
+        CLogMessage(this).debug() << "Parsed"   << messages.size() << "GRIB messages.";
         CLogMessage(this).debug() << "Obtained" << weatherGridPointsNo << "grid points.";
+        CLogMessage(this).debug() << "GRIB indexed in" << indexMs << "ms, unpacked in" << unpackMs << "ms with" << threads << "threads, applied in" << applyMs << "ms";
 
         constexpr int maxPoints = 200;
         for (const GfsGridPoint &gfsGridPoint : std::as_const(m_gfsWeatherGrid))
@@ -466,9 +508,31 @@ namespace BlackWxPlugin::Gfs
             }
         }
 
+        CLogMessage(this).debug() << "GRIB file parsed in" << timer.elapsed() << "ms";
         return true;
     }
 
+    void CWeatherDataGfs::handleGribField(const gribfield *gfld)
+    {
+        if (!gfld) { return; }
+        if (gfld->idsectlen < 12) { CLogMessage(this).warning(u"Identification section: wrong length!"); return; }
+
+        if (gfld->igdtnum != 0) { CLogMessage(this).warning(u"Can handle only grid definition template number = 0"); }
+
+        int nscan = gfld->igdtmpl[18];
+        int npnts = gfld->ngrdpts;
+        int nx = gfld->igdtmpl[7];
+        int ny = gfld->igdtmpl[8];
+        if (nscan != 0) {  CLogMessage(this).error(u"Can only handle scanning mode NS:WE."); }
+        if (npnts != nx * ny) {  CLogMessage(this).error(u"Cannot handle non-regular grid."); }
+
+        if (m_gfsWeatherGrid.isEmpty()) { createWeatherGrid(gfld); }
+
+        if (gfld->ipdtnum == 0) { handleProductDefinitionTemplate40(gfld); }
+        else if (gfld->ipdtnum == 8) { handleProductDefinitionTemplate48(gfld); }
+        else { CLogMessage(this).warning(u"Cannot handle product definition template %1") << gfld->ipdtnum; }
+    }
+
     void CWeatherDataGfs::findNextGribMessage(unsigned char *buffer, g2int size, g2int iseek, g2int *lskip, g2int *lgrib)
     {
         *lgrib = 0;
@@ -67,6 +67,7 @@ namespace BlackWxPlugin::Gfs
         void parseGfsFile(QNetworkReply *nwReplyPtr);
         BlackMisc::Network::CUrl getDownloadUrl() const;
         bool parseGfsFileImpl(const QByteArray &gribData);
+        void handleGribField(const gribfield *gfld);
         void findNextGribMessage(unsigned char *buffer, g2int size, g2int iseek, g2int *lskip, g2int *lgrib);
         void createWeatherGrid(const gribfield *gfld);
         void handleProductDefinitionTemplate40(const gribfield *gfld);
@@ -33,6 +33,7 @@
 float XPMP_PrepListHook(float, float, int, void *); // defined in xplanemp2/src/Renderer.cpp
 
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+using namespace BlackMisc::Simulation::XPlane::TrafficSharedMemory;
 using namespace std::chrono_literals;
 
 namespace XSwiftBus
@@ -133,6 +134,7 @@ namespace XSwiftBus
 
     void CTraffic::cleanup()
     {
+        closeSharedMemory();
         removeAllPlanes();
 
         if (m_enabledMultiplayer)
@@ -389,29 +391,33 @@ namespace XSwiftBus
 
             Plane *plane = planeIt->second;
             if (!plane) { continue; }
-            plane->positions[2].lat = latitudesDeg.at(i);
-            plane->positions[2].lon = longitudesDeg.at(i);
-            plane->positions[2].elevation = altitudesFt.at(i);
-            plane->positions[2].pitch   = static_cast<float>(pitchesDeg.at(i));
-            plane->positions[2].roll    = static_cast<float>(rollsDeg.at(i));
-            plane->positions[2].heading = static_cast<float>(headingsDeg.at(i));
-            plane->positions[2].offsetScale = 1.0f;
-            plane->positions[2].clampToGround = true;
-            plane->positionTimes[2] = std::chrono::steady_clock::now();
-
-            // save 2 positions at 1-second intervals for use in interpolation
-            if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
-            {
-                plane->positionTimes[0] = plane->positionTimes[1];
-                plane->positionTimes[1] = plane->positionTimes[2];
-                std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
-                std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
-            }
-
+            updatePlanePosition(plane, latitudesDeg.at(i), longitudesDeg.at(i), altitudesFt.at(i), pitchesDeg.at(i), rollsDeg.at(i), headingsDeg.at(i));
             if (setOnGround) { plane->isOnGround = onGrounds.at(i); }
         }
     }
 
+    void CTraffic::updatePlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg)
+    {
+        plane->positions[2].lat = latitudeDeg;
+        plane->positions[2].lon = longitudeDeg;
+        plane->positions[2].elevation = altitudeFt;
+        plane->positions[2].pitch   = static_cast<float>(pitchDeg);
+        plane->positions[2].roll    = static_cast<float>(rollDeg);
+        plane->positions[2].heading = static_cast<float>(headingDeg);
+        plane->positions[2].offsetScale = 1.0f;
+        plane->positions[2].clampToGround = true;
+        plane->positionTimes[2] = std::chrono::steady_clock::now();
+
+        // save 2 positions at 1-second intervals for use in interpolation
+        if (plane->positionTimes[2] - plane->positionTimes[1] > 1s)
+        {
+            plane->positionTimes[0] = plane->positionTimes[1];
+            plane->positionTimes[1] = plane->positionTimes[2];
+            std::memcpy(&plane->positions[0], &plane->positions[1], sizeof(plane->positions[0]));
+            std::memcpy(&plane->positions[1], &plane->positions[2], sizeof(plane->positions[0]));
+        }
+    }
+
     void CTraffic::setPlanesSurfaces(const std::vector<std::string> &callsigns, const std::vector<double> &gears, const std::vector<double> &flaps, const std::vector<double> &spoilers,
                                      const std::vector<double> &speedBrakes, const std::vector<double> &slats, const std::vector<double> &wingSweeps, const std::vector<double> &thrusts,
                                      const std::vector<double> &elevators, const std::vector<double> &rudders, const std::vector<double> &ailerons,
@@ -428,35 +434,43 @@ namespace XSwiftBus
             Plane *plane = planeIt->second;
             if (!plane) { continue; }
 
-            plane->hasSurfaces = true;
-            plane->targetGearPosition = static_cast<float>(gears.at(i));
-            plane->surfaces.flapRatio = static_cast<float>(flaps.at(i));
-            plane->surfaces.spoilerRatio = static_cast<float>(spoilers.at(i));
-            plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrakes.at(i));
-            plane->surfaces.slatRatio = static_cast<float>(slats.at(i));
-            plane->surfaces.wingSweep = static_cast<float>(wingSweeps.at(i));
-            plane->surfaces.thrust = static_cast<float>(thrusts.at(i));
-            plane->surfaces.yokePitch = static_cast<float>(elevators.at(i));
-            plane->surfaces.yokeHeading = static_cast<float>(rudders.at(i));
-            plane->surfaces.yokeRoll = static_cast<float>(ailerons.at(i));
-            if (bundleTaxiLandingLights)
-            {
-                const bool on = landLights.at(i) || taxiLights.at(i);
-                plane->surfaces.lights.landLights = on;
-                plane->surfaces.lights.taxiLights = on;
-            }
-            else
-            {
-                plane->surfaces.lights.landLights = landLights.at(i);
-                plane->surfaces.lights.taxiLights = taxiLights.at(i);
-            }
-            plane->surfaces.lights.bcnLights = beaconLights.at(i);
-            plane->surfaces.lights.strbLights = strobeLights.at(i);
-            plane->surfaces.lights.navLights = navLights.at(i);
-            plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPatterns.at(i));
+            updatePlaneSurfaces(plane, gears.at(i), flaps.at(i), spoilers.at(i), speedBrakes.at(i), slats.at(i), wingSweeps.at(i), thrusts.at(i),
+                                elevators.at(i), rudders.at(i), ailerons.at(i),
+                                landLights.at(i), taxiLights.at(i), beaconLights.at(i), strobeLights.at(i), navLights.at(i), lightPatterns.at(i), bundleTaxiLandingLights);
         }
     }
 
+    void CTraffic::updatePlaneSurfaces(Plane *plane, double gear, double flap, double spoiler, double speedBrake, double slat, double wingSweep, double thrust,
+                                       double elevator, double rudder, double aileron, bool landLight, bool taxiLight, bool beaconLight, bool strobeLight, bool navLight, int lightPattern, bool bundleTaxiLandingLights)
+    {
+        plane->hasSurfaces = true;
+        plane->targetGearPosition = static_cast<float>(gear);
+        plane->surfaces.flapRatio = static_cast<float>(flap);
+        plane->surfaces.spoilerRatio = static_cast<float>(spoiler);
+        plane->surfaces.speedBrakeRatio = static_cast<float>(speedBrake);
+        plane->surfaces.slatRatio = static_cast<float>(slat);
+        plane->surfaces.wingSweep = static_cast<float>(wingSweep);
+        plane->surfaces.thrust = static_cast<float>(thrust);
+        plane->surfaces.yokePitch = static_cast<float>(elevator);
+        plane->surfaces.yokeHeading = static_cast<float>(rudder);
+        plane->surfaces.yokeRoll = static_cast<float>(aileron);
+        if (bundleTaxiLandingLights)
+        {
+            const bool on = landLight || taxiLight;
+            plane->surfaces.lights.landLights = on;
+            plane->surfaces.lights.taxiLights = on;
+        }
+        else
+        {
+            plane->surfaces.lights.landLights = landLight;
+            plane->surfaces.lights.taxiLights = taxiLight;
+        }
+        plane->surfaces.lights.bcnLights = beaconLight;
+        plane->surfaces.lights.strbLights = strobeLight;
+        plane->surfaces.lights.navLights = navLight;
+        plane->surfaces.lights.flashPattern = static_cast<unsigned int>(lightPattern);
+    }
+
     void CTraffic::setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents)
     {
         for (size_t i = 0; i < callsigns.size(); i++)
@@ -466,11 +480,74 @@ namespace XSwiftBus
 
             Plane *plane = planeIt->second;
             if (!plane) { continue; }
+            updatePlaneTransponder(plane, codes.at(i), modeCs.at(i), idents.at(i));
+        }
+    }
+
+    void CTraffic::updatePlaneTransponder(Plane *plane, int code, bool modeC, bool ident)
+    {
+        plane->surveillance.code = code;
+        if (ident) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
+        else if (modeC) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
+        else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    }
 
-            plane->surveillance.code = codes.at(i);
-            if (idents.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC_Ident; }
-            else if (modeCs.at(i)) { plane->surveillance.mode = xpmpTransponderMode_ModeC; }
-            else { plane->surveillance.mode = xpmpTransponderMode_Standby; }
+    bool CTraffic::openSharedMemory(const std::string &name)
+    {
+        if (!m_sharedMemory.open(name)) { return false; }
+        m_sharedMemoryFrame.reset(new FrameData());
+        m_sharedMemorySerials.reset(new SharedMemorySerials());
+        INFO_LOG("Traffic data from shared memory " + name);
+        return true;
+    }
+
+    void CTraffic::closeSharedMemory()
+    {
+        m_sharedMemory.close();
+        m_sharedMemoryFrame.reset();
+        m_sharedMemorySerials.reset();
+    }
+
+    void CTraffic::readSharedMemory()
+    {
+        if (!m_sharedMemory.isOpen() || !m_sharedMemory.readLatest(*m_sharedMemoryFrame)) { return; }
+
+        // only the latest frame is read, the serials tell which slots have new data
+        const FrameData &frame = *m_sharedMemoryFrame;
+        SharedMemorySerials &applied = *m_sharedMemorySerials;
+        const bool bundleTaxiLandingLights = this->getSettings().isBundlingTaxiAndLandingLights();
+        const int slots = std::min(static_cast<int>(frame.slots), MaxPlanes);
+        for (int slot = 0; slot < slots; ++slot)
+        {
+            const bool newPosition    = frame.positionSerials[slot] != applied.positions[slot];
+            const bool newSurfaces    = frame.surfacesSerials[slot] != applied.surfaces[slot];
+            const bool newTransponder = frame.transponderSerials[slot] != applied.transponders[slot];
+            if (!newPosition && !newSurfaces && !newTransponder) { continue; }
+            if (frame.callsigns[slot][0] == 0) { continue; } // free slot
+
+            // plane could not yet be added, then the data are applied with the next frame
+            const auto planeIt = m_planesByCallsign.find(frame.callsign(slot));
+            if (planeIt == m_planesByCallsign.end() || !planeIt->second) { continue; }
+            Plane *plane = planeIt->second;
+
+            if (newPosition)
+            {
+                updatePlanePosition(plane, frame.latitudesDeg[slot], frame.longitudesDeg[slot], frame.altitudesFt[slot], frame.pitchesDeg[slot], frame.rollsDeg[slot], frame.headingsDeg[slot]);
+                plane->isOnGround = frame.onGrounds[slot];
+                applied.positions[slot] = frame.positionSerials[slot];
+            }
+            if (newSurfaces)
+            {
+                updatePlaneSurfaces(plane, frame.gears[slot], frame.flaps[slot], frame.spoilers[slot], frame.speedBrakes[slot], frame.slats[slot], frame.wingSweeps[slot], frame.thrusts[slot],
+                                    frame.elevators[slot], frame.rudders[slot], frame.ailerons[slot],
+                                    frame.landLights[slot], frame.taxiLights[slot], frame.beaconLights[slot], frame.strobeLights[slot], frame.navLights[slot], frame.lightPatterns[slot], bundleTaxiLandingLights);
+                applied.surfaces[slot] = frame.surfacesSerials[slot];
+            }
+            if (newTransponder)
+            {
+                updatePlaneTransponder(plane, frame.codes[slot], frame.modeCs[slot], frame.idents[slot]);
+                applied.transponders[slot] = frame.transponderSerials[slot];
+            }
         }
     }
 
@@ -538,6 +615,7 @@ namespace XSwiftBus
 
     void CTraffic::dbusDisconnectedHandler()
     {
+        closeSharedMemory();
         removeAllPlanes();
     }
 
@@ -807,6 +885,24 @@ namespace XSwiftBus
                     sendDBusMessage(reply);
                 });
             }
+            else if (message.getMethodName() == "openSharedMemory")
+            {
+                std::string name;
+                message.beginArgumentRead();
+                message.getArgument(name);
+                queueDBusCall([ = ]()
+                {
+                    sendDBusReply(sender, serial, openSharedMemory(name));
+                });
+            }
+            else if (message.getMethodName() == "closeSharedMemory")
+            {
+                maybeSendEmptyDBusReply(wantsReply, sender, serial);
+                queueDBusCall([ = ]()
+                {
+                    closeSharedMemory();
+                });
+            }
             else if (message.getMethodName() == "setFollowedAircraft")
             {
                 maybeSendEmptyDBusReply(wantsReply, sender, serial);
@@ -830,6 +926,7 @@ namespace XSwiftBus
     int CTraffic::process()
     {
         invokeQueuedDBusCalls();
+        readSharedMemory();
         doPlaneUpdates();
         setDrawingLabels(getSettings().isDrawingLabels(), getSettings().getLabelColor());
         emitSimFrame();
@@ -19,9 +19,11 @@
 #include "drawable.h"
 #include "menus.h"
 #include "XPMPMultiplayer.h"
+#include "blackmisc/simulation/xplane/trafficsharedmemory.h"
 #include <XPLM/XPLMCamera.h>
 #include <XPLM/XPLMDisplay.h>
 #include <functional>
+#include <memory>
 #include <utility>
 
 //! \cond PRIVATE
@@ -111,6 +113,13 @@ namespace XSwiftBus
         //! Set the transponder of multiple traffic aircraft
         void setPlanesTransponders(const std::vector<std::string> &callsigns, const std::vector<int> &codes, const std::vector<bool> &modeCs, const std::vector<bool> &idents);
 
+        //! Read positions, surfaces and transponders from the shared memory segment created by the driver,
+        //! false if not possible (e.g. driver on another machine), then DBus is used
+        bool openSharedMemory(const std::string &name);
+
+        //! Stop reading from shared memory
+        void closeSharedMemory();
+
         //! Get remote aircrafts data (lat, lon, elevation and CG)
         void getRemoteAircraftData(std::vector<std::string> &callsigns, std::vector<double> &latitudesDeg, std::vector<double> &longitudesDeg,
                                    std::vector<double> &elevationsM, std::vector<bool> &waterFlags, std::vector<double> &verticalOffsets) const;
@@ -264,6 +273,24 @@ namespace XSwiftBus
         bool m_emitSimFrame = true;
         int m_countFrame    = 0; //!< allows to do something every n-th frame
 
+        //! Serials of the shared memory data already applied per slot
+        struct SharedMemorySerials
+        {
+            std::uint32_t positions[BlackMisc::Simulation::XPlane::TrafficSharedMemory::MaxPlanes] {};
+            std::uint32_t surfaces[BlackMisc::Simulation::XPlane::TrafficSharedMemory::MaxPlanes] {};
+            std::uint32_t transponders[BlackMisc::Simulation::XPlane::TrafficSharedMemory::MaxPlanes] {};
+        };
+
+        BlackMisc::Simulation::XPlane::TrafficSharedMemory::CReader m_sharedMemory;
+        std::unique_ptr<BlackMisc::Simulation::XPlane::TrafficSharedMemory::FrameData> m_sharedMemoryFrame;
+        std::unique_ptr<SharedMemorySerials> m_sharedMemorySerials;
+        void readSharedMemory();
+
+        void updatePlanePosition(Plane *plane, double latitudeDeg, double longitudeDeg, double altitudeFt, double pitchDeg, double rollDeg, double headingDeg);
+        void updatePlaneSurfaces(Plane *plane, double gear, double flap, double spoiler, double speedBrake, double slat, double wingSweep, double thrust,
+                                 double elevator, double rudder, double aileron, bool landLight, bool taxiLight, bool beaconLight, bool strobeLight, bool navLight, int lightPattern, bool bundleTaxiLandingLights);
+        void updatePlaneTransponder(Plane *plane, int code, bool modeC, bool ident);
+
         std::vector<XPMPUpdate_t> m_updates;
         void doPlaneUpdates();
         void interpolatePosition(Plane *);
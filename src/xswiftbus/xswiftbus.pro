@@ -55,6 +55,9 @@ unix:!macx {
     } else {
     INCLUDEPATH *= /usr/lib/dbus-1.0/include
     }
+
+    # shm_open for the traffic shared memory
+    LIBS += -lrt
 }
 
 # PlatformUtils also not used
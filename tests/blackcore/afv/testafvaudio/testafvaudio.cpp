@@ -0,0 +1,816 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/afv/audio/audiodecodepool.h"
+#include "blackcore/afv/audio/jitterbuffer.h"
+#include "blackcore/afv/audio/receiversampleprovider.h"
+#include "blacksound/codecs/opusdecoder.h"
+#include "blacksound/codecs/opusencoder.h"
+#include "blacksound/dsp/biquadfilter.h"
+#include "blacksound/dsp/dspkernels.h"
+#include "blacksound/sampleprovider/bufferedwaveprovider.h"
+#include "blacksound/sampleprovider/mixingsampleprovider.h"
+#include "blacksound/sampleprovider/samplebuffer.h"
+#include "test.h"
+
+#include <QAudioFormat>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTest>
+#include <QtMath>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Audio;
+using namespace BlackSound::Codecs;
+using namespace BlackSound::Dsp;
+using namespace BlackSound::SampleProvider;
+
+namespace
+{
+    //! Allocations while counting is enabled
+    std::atomic_int g_allocations { 0 };
+
+    //! Count allocations?
+    std::atomic_bool g_countAllocations { false };
+
+    //! Allocate and count
+    void *countedAlloc(std::size_t size)
+    {
+        if (g_countAllocations) { g_allocations++; }
+        if (void *p = std::malloc(size > 0 ? size : 1)) { return p; }
+        throw std::bad_alloc();
+    }
+}
+
+//! \cond PRIVATE
+// replaced for the whole process, also catches allocations in the libraries on platforms with a single heap
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+//! \endcond
+
+namespace BlackCoreTest
+{
+    //! AFV receive chain audio tests
+    class CTestAfvAudio : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Buffered samples are read in the order they were added, the oldest are dropped
+        void bufferedWaveProvider();
+
+        //! Lock free from one thread to another
+        void bufferedWaveProviderThreads();
+
+        //! Frames of one stream are decoded in order
+        void decodePoolOrder();
+
+        //! Frames are decoded in the pool and played
+        void decodeInPool();
+
+        //! Decoding a frame for 100 callsigns, directly vs. in the pool
+        void benchmarkDecode_data();
+
+        //! Decoding a frame for 100 callsigns, directly vs. in the pool
+        void benchmarkDecode();
+
+        //! Frames are played out in sequence order, missing frames are concealed
+        void jitterBuffer();
+
+        //! Replay packet timings with injected loss and reordering
+        void jitterBufferSimulation_data();
+
+        //! Replay packet timings with injected loss and reordering
+        void jitterBufferSimulation();
+
+        //! Target delay follows the conditions of the stream
+        void jitterBufferAdaptation();
+
+        //! Lost frames are concealed by the decoder
+        void opusConcealment();
+
+        //! Blocks are aligned and limited to the capacity
+        void sampleBuffer();
+
+        //! Block kernels yield the same samples as the scalar per sample code
+        void dspKernels();
+
+        //! Filtering a block band by band is the same as per sample through all bands
+        void biQuadBlock();
+
+        //! Cascaded biquads of the VHF equalizer, per sample vs. per block
+        void benchmarkBiQuads_data();
+
+        //! Cascaded biquads of the VHF equalizer, per sample vs. per block
+        void benchmarkBiQuads();
+
+        //! No allocations in the audio callback
+        void noAllocationsInCallback();
+
+        //! One second of audio for 10 receivers with 10 callsigns each
+        void benchmarkCallback_data();
+
+        //! One second of audio for 10 receivers with 10 callsigns each
+        void benchmarkCallback();
+
+    private:
+        //! Receive chain like CSoundcardSampleProvider, with receivers transmitting callsigns
+        struct ReceiveChain
+        {
+            //! Ctor
+            ReceiveChain(int receivers, int callsigns, int frames);
+
+            CMixingSampleProvider mixer;
+            QVector<CReceiverSampleProvider *> receiverInputs;
+        };
+
+        //! Transmission replayed through a jitter buffer
+        struct Simulation
+        {
+            int injectedLoss = 0; //!< packets not sent to the jitter buffer
+            int decoded = 0;      //!< received frames played out
+            int concealed = 0;    //!< lost frames played out
+            int fecFromNext = 0;  //!< concealed from the next packet
+            int underflows = 0;   //!< played out faster than received
+            bool inOrder = true;  //!< frames played out in sequence order
+        };
+
+        //! Replay a transmission, the packets are sent every 20ms and arrive with the delays of the trace
+        //! \param lossEvery drop one of this many packets, 0 for no loss
+        //! \param reorderEvery one of this many packets is overtaken by the next two, 0 for no reordering
+        static Simulation simulateTransmission(CJitterBuffer &jitterBuffer, const QVector<int> &delaysMs, int frames, int lossEvery, int reorderEvery, uint firstSequence = 0);
+
+        //! Network delays of a WiFi link with bursts, ms
+        static const QVector<int> &wifiDelays();
+
+        //! Network delays of a wired link, ms
+        static const QVector<int> &lanDelays();
+
+        //! Random samples -1..1
+        static QVector<float> randomSamples(int count, quint32 seed);
+
+        //! Filters like CEqualizerSampleProvider with VHFEmulation
+        static QVector<BiQuadFilter> vhfFilters();
+
+        //! Audio format of the receive chain
+        static QAudioFormat audioFormat();
+
+        //! Opus frames of a tone
+        static QVector<QByteArray> opusFrames(int frames);
+
+        static constexpr int SampleRate = 48000;
+        static constexpr int FrameSize  = 960; //!< 20ms
+        static constexpr uint Frequency = 122800000;
+    };
+
+    void CTestAfvAudio::bufferedWaveProvider()
+    {
+        CBufferedWaveProvider provider(audioFormat());
+        const int capacity = provider.getCapacity();
+        QCOMPARE(capacity, 2 * SampleRate);
+
+        QVector<float> samples;
+        for (int i = 0; i < 1000; i++) { samples.push_back(i); }
+        provider.addSamples(samples);
+        provider.addSamples(samples);
+        QCOMPARE(provider.getBufferedBytes(), 2000);
+
+        CSampleBuffer buffer(1500);
+        QCOMPARE(provider.readSamples(buffer.span(1500)), 1500);
+        QCOMPARE(buffer.data()[999], 999.0f);
+        QCOMPARE(buffer.data()[1000], 0.0f);
+        QCOMPARE(buffer.data()[1499], 499.0f);
+
+        // wraps around in the ring
+        QVector<float> fill(capacity - 1000, -1.0f);
+        provider.addSamples(fill);
+        provider.addSamples(samples);
+        QCOMPARE(provider.getBufferedBytes(), capacity);
+        QCOMPARE(provider.readSamples(buffer.span(500)), 500);
+        QCOMPARE(buffer.data()[0], 500.0f);
+        QCOMPARE(buffer.data()[499], 999.0f);
+
+        // full, newer samples are dropped
+        provider.addSamples(samples);
+        provider.addSamples(samples);
+        QCOMPARE(provider.getBufferedBytes(), capacity);
+
+        provider.clearBuffer();
+        QCOMPARE(provider.getBufferedBytes(), 0);
+        QCOMPARE(provider.readSamples(buffer.span(1500)), 0);
+        provider.addSamples(samples);
+        QCOMPARE(provider.readSamples(buffer.span(1500)), 1000);
+        QCOMPARE(buffer.data()[999], 999.0f);
+    }
+
+    void CTestAfvAudio::bufferedWaveProviderThreads()
+    {
+        // one thread adding, one reading, like decoder and audio callback
+        CBufferedWaveProvider provider(audioFormat());
+        constexpr int total = 10 * SampleRate;
+        std::atomic_bool outOfOrder { false };
+        std::thread consumer([&]
+        {
+            CSampleBuffer buffer(480);
+            int expected = 0;
+            while (expected < total)
+            {
+                const int read = provider.readSamples(buffer.span(480));
+                for (int i = 0; i < read; i++)
+                {
+                    if (buffer.data()[i] != static_cast<float>(expected++ % 4096)) { outOfOrder = true; }
+                }
+            }
+        });
+
+        QVector<float> frame(FrameSize);
+        for (int added = 0; added < total;)
+        {
+            if (provider.getCapacity() - provider.getBufferedBytes() < FrameSize) { std::this_thread::yield(); continue; }
+            for (int i = 0; i < FrameSize; i++) { frame[i] = static_cast<float>((added + i) % 4096); }
+            provider.addSamples(frame);
+            added += FrameSize;
+        }
+        consumer.join();
+        QVERIFY(!outOfOrder);
+        QCOMPARE(provider.getBufferedBytes(), 0);
+    }
+
+    void CTestAfvAudio::decodePoolOrder()
+    {
+        // each stream has to see its frames in the order they were queued
+        constexpr int streams = 20;
+        constexpr int frames  = 200;
+        std::vector<std::vector<int>> decoded(streams);
+        {
+            CAudioDecodePool pool(3);
+            QCOMPARE(pool.threadCount(), 3);
+            for (int f = 0; f < frames; f++)
+            {
+                for (int s = 0; s < streams; s++)
+                {
+                    std::vector<int> *stream = &decoded[static_cast<size_t>(s)];
+                    pool.decode(stream, [stream, f] { stream->push_back(f); });
+                }
+            }
+            QTRY_COMPARE(pool.getStatistics().queued, 0);
+
+            const AudioDecodeStatistics statistics = pool.getStatistics();
+            QCOMPARE(statistics.frames, static_cast<qint64>(streams * frames));
+            QVERIFY(statistics.maxLatencyUs >= statistics.maxDecodeUs);
+            pool.resetStatistics();
+            QCOMPARE(pool.getStatistics().frames, static_cast<qint64>(0));
+        }
+
+        for (const std::vector<int> &stream : decoded)
+        {
+            QCOMPARE(static_cast<int>(stream.size()), frames);
+            QVERIFY(std::is_sorted(stream.begin(), stream.end()));
+        }
+    }
+
+    void CTestAfvAudio::decodeInPool()
+    {
+        // the pool is destroyed first, before the receivers
+        CMixingSampleProvider mixer;
+        CAudioDecodePool pool(2);
+        CReceiverSampleProvider *receiver = new CReceiverSampleProvider(audioFormat(), 0, 4, &pool, &mixer);
+        receiver->setFrequency(Frequency);
+        mixer.addMixerInput(receiver);
+
+        const QVector<QByteArray> opus = opusFrames(10);
+        for (int c = 0; c < 4; c++)
+        {
+            uint sequence = 0;
+            for (const QByteArray &audio : opus)
+            {
+                const IAudioDto dto { QStringLiteral("SWIFT%1").arg(c), sequence++, audio, false };
+                receiver->addOpusSamples(dto, Frequency, 1.0f);
+            }
+        }
+        QTRY_COMPARE(pool.getStatistics().queued, 0);
+        QCOMPARE(pool.getStatistics().frames, static_cast<qint64>(4 * opus.size()));
+        QCOMPARE(receiver->activeCallsigns(), 4);
+
+        // decoded audio is played
+        CSampleBuffer buffer(FrameSize);
+        QCOMPARE(mixer.readSamples(buffer.span(FrameSize)), FrameSize);
+        QCOMPARE(receiver->activeCallsigns(), 4);
+    }
+
+    void CTestAfvAudio::benchmarkDecode_data()
+    {
+        QTest::addColumn<int>("threads");
+        QTest::newRow("direct")    << 0;
+        QTest::newRow("1 thread")  << 1;
+        QTest::newRow("4 threads") << 4;
+    }
+
+    void CTestAfvAudio::benchmarkDecode()
+    {
+        QFETCH(int, threads);
+        CMixingSampleProvider mixer;
+        std::unique_ptr<CAudioDecodePool> pool(threads > 0 ? new CAudioDecodePool(threads) : nullptr);
+        QVector<CReceiverSampleProvider *> receivers;
+        for (int r = 0; r < 10; r++)
+        {
+            CReceiverSampleProvider *receiver = new CReceiverSampleProvider(audioFormat(), static_cast<quint16>(r), 10, pool.get(), &mixer);
+            receiver->setFrequency(Frequency);
+            receivers.push_back(receiver);
+        }
+
+        // one frame for 10 receivers with 10 callsigns each, 20ms of audio
+        const QVector<QByteArray> opus = opusFrames(50);
+        uint sequence = 0;
+        QBENCHMARK
+        {
+            const QByteArray &audio = opus[static_cast<int>(sequence % 50)];
+            for (int r = 0; r < receivers.size(); r++)
+            {
+                for (int c = 0; c < 10; c++)
+                {
+                    const IAudioDto dto { QStringLiteral("SWIFT%1").arg(r * 10 + c), sequence, audio, false };
+                    receivers[r]->addOpusSamples(dto, Frequency, 1.0f);
+                }
+            }
+            sequence++;
+            if (pool) { while (pool->getStatistics().queued > 0) { std::this_thread::yield(); } }
+        }
+    }
+
+    void CTestAfvAudio::jitterBuffer()
+    {
+        CJitterBuffer jitterBuffer;
+        QCOMPARE(jitterBuffer.getTargetDelayMs(), CJitterBuffer::DefaultDelayMs);
+
+        QVector<JitterBufferFrame> frames;
+        const auto put = [&](uint sequence, bool lastPacket = false)
+        {
+            jitterBuffer.put(sequence, QByteArray::number(sequence), lastPacket, sequence * CJitterBuffer::FrameMs);
+            JitterBufferFrame frame;
+            while (jitterBuffer.takeFrame(frame)) { frames.push_back(frame); }
+        };
+
+        put(0);
+        put(1);
+        QCOMPARE(frames.size(), 2);
+        QCOMPARE(frames[1].type, JitterBufferFrame::Decode);
+        QCOMPARE(frames[1].opus, QByteArray("1"));
+
+        // 2 is waited for within the target delay, then recovered from 3
+        frames.clear();
+        put(3);
+        put(4);
+        QVERIFY(frames.isEmpty());
+        put(5);
+        QCOMPARE(frames.size(), 4);
+        QCOMPARE(frames[0].sequence, 2u);
+        QCOMPARE(frames[0].type, JitterBufferFrame::ConcealFec);
+        QCOMPARE(frames[0].opus, QByteArray("3"));
+        QCOMPARE(frames[1].sequence, 3u);
+        QCOMPARE(frames[1].type, JitterBufferFrame::Decode);
+
+        // 6 and 7 lost, 6 has no next packet
+        frames.clear();
+        put(8);
+        put(9);
+        put(9);
+        put(10);
+        QCOMPARE(frames.size(), 1);
+        QCOMPARE(frames[0].type, JitterBufferFrame::ConcealPlc);
+        put(11);
+        QCOMPARE(frames.size(), 6);
+        QCOMPARE(frames[1].type, JitterBufferFrame::ConcealFec);
+        QCOMPARE(frames[5].sequence, 11u);
+
+        // 12 to 19 lost, a long gap is only concealed in parts
+        frames.clear();
+        put(20);
+        put(21);
+        put(22);
+        put(23);
+        put(24, true);
+        QCOMPARE(frames.size(), CJitterBuffer::MaxConcealFrames + 5);
+        QCOMPARE(frames[CJitterBuffer::MaxConcealFrames].sequence, 20u);
+        QVERIFY(frames.last().lastPacket);
+        QVERIFY(jitterBuffer.isEnded());
+
+        // too late
+        frames.clear();
+        put(2);
+        QVERIFY(frames.isEmpty());
+
+        const JitterBufferStatistics statistics = jitterBuffer.getStatistics();
+        QCOMPARE(statistics.received, 16);
+        QCOMPARE(statistics.late, 1);
+        QCOMPARE(statistics.duplicates, 1);
+        QCOMPARE(statistics.lost, 11);
+        QCOMPARE(statistics.concealedFec, 2);
+        QCOMPARE(statistics.concealedPlc, 1 + CJitterBuffer::MaxConcealFrames);
+        QCOMPARE(statistics.targetDelayMs, CJitterBuffer::DefaultDelayMs);
+    }
+
+    void CTestAfvAudio::jitterBufferSimulation_data()
+    {
+        QTest::addColumn<bool>("wifi");
+        QTest::addColumn<int>("lossEvery");
+        QTest::addColumn<int>("reorderEvery");
+        QTest::addColumn<int>("maxUnderflows");
+
+        QTest::newRow("LAN")                          << false << 0  << 0  << 0;
+        QTest::newRow("WiFi")                         << true  << 0  << 0  << 0;
+        QTest::newRow("LAN, 5% loss")                 << false << 20 << 0  << 0;
+        QTest::newRow("LAN, reordering")              << false << 0  << 10 << 0;
+        QTest::newRow("WiFi, 5% loss and reordering") << true  << 20 << 10 << 1;
+    }
+
+    void CTestAfvAudio::jitterBufferSimulation()
+    {
+        QFETCH(bool, wifi);
+        QFETCH(int, lossEvery);
+        QFETCH(int, reorderEvery);
+        QFETCH(int, maxUnderflows);
+
+        constexpr int frames = 250; // 5s
+        CJitterBuffer jitterBuffer;
+        const Simulation simulation = simulateTransmission(jitterBuffer, wifi ? wifiDelays() : lanDelays(), frames, lossEvery, reorderEvery);
+        const JitterBufferStatistics statistics = jitterBuffer.getStatistics();
+
+        // every frame is played out once, in order, received or concealed
+        QVERIFY(simulation.inOrder);
+        QVERIFY(jitterBuffer.isEnded());
+        QCOMPARE(simulation.decoded + statistics.lost, frames);
+        QCOMPARE(simulation.concealed, statistics.concealedFec + statistics.concealedPlc);
+        QCOMPARE(simulation.fecFromNext, statistics.concealedFec);
+        QCOMPARE(statistics.lost, simulation.injectedLoss + statistics.late);
+        QCOMPARE(statistics.received, frames - simulation.injectedLoss);
+        QVERIFY(simulation.underflows <= maxUnderflows);
+        QCOMPARE(statistics.underflows, simulation.underflows);
+
+        // single losses are recovered from the next packet
+        if (lossEvery > 0) { QVERIFY(statistics.concealedFec >= simulation.injectedLoss - statistics.late); }
+        if (reorderEvery > 0) { QVERIFY(statistics.reorderFrames > 0); }
+        if (!wifi && reorderEvery < 1) { QCOMPARE(statistics.targetDelayMs, CJitterBuffer::MinDelayMs); }
+    }
+
+    void CTestAfvAudio::jitterBufferAdaptation()
+    {
+        CJitterBuffer jitterBuffer;
+        simulateTransmission(jitterBuffer, wifiDelays(), 250, 20, 10);
+        const int delayMs = jitterBuffer.getTargetDelayMs();
+        QVERIFY(delayMs > CJitterBuffer::DefaultDelayMs);
+        QVERIFY(delayMs <= CJitterBuffer::MaxDelayMs);
+
+        // next transmissions of the callsign start with the history, the delay shrinks when the link is good
+        int lastDelayMs = delayMs;
+        for (int t = 1; t <= 3; t++)
+        {
+            jitterBuffer.restart(jitterBuffer.getStatistics());
+            const Simulation simulation = simulateTransmission(jitterBuffer, lanDelays(), 250, 0, 0, static_cast<uint>(t * 1000));
+            QCOMPARE(simulation.underflows, 0);
+            QVERIFY(jitterBuffer.getTargetDelayMs() <= lastDelayMs);
+            lastDelayMs = jitterBuffer.getTargetDelayMs();
+        }
+        QCOMPARE(lastDelayMs, CJitterBuffer::MinDelayMs);
+        QCOMPARE(jitterBuffer.getStatistics().received, 4 * 250 - 12);
+
+        // underflows increase the delay
+        jitterBuffer.underflow();
+        QVERIFY(jitterBuffer.getTargetDelayMs() > lastDelayMs);
+        QCOMPARE(jitterBuffer.getStatistics().underflows, 1 + 1);
+    }
+
+    void CTestAfvAudio::opusConcealment()
+    {
+        const QVector<QByteArray> opus = opusFrames(10);
+        COpusDecoder decoder(SampleRate, 1);
+        int decodedLength = 0;
+        for (int f = 0; f < 5; f++) { decoder.decode(opus[f], opus[f].size(), &decodedLength); }
+        QCOMPARE(decodedLength, FrameSize);
+
+        // frame 5 lost
+        QCOMPARE(decoder.decodeFec(opus[6], FrameSize).size(), FrameSize);
+        QCOMPARE(decoder.decode(opus[6], opus[6].size(), &decodedLength).size(), FrameSize);
+
+        // frames 7 and 8 lost
+        QCOMPARE(decoder.decodeLost(FrameSize).size(), FrameSize);
+        QCOMPARE(decoder.decodeLost(FrameSize).size(), FrameSize);
+        QCOMPARE(decoder.decodeFec({}, FrameSize).size(), FrameSize);
+    }
+
+    void CTestAfvAudio::sampleBuffer()
+    {
+        const CSampleBuffer buffer(ISampleProvider::MaxBlockSize);
+        QCOMPARE(buffer.capacity(), ISampleProvider::MaxBlockSize);
+        QCOMPARE(reinterpret_cast<quintptr>(buffer.data()) % CSampleBuffer::Alignment, quintptr(0));
+        QCOMPARE(buffer.span(100).size(), 100);
+        QCOMPARE(buffer.span(ISampleProvider::MaxBlockSize + 1).size(), ISampleProvider::MaxBlockSize);
+        QCOMPARE(buffer.span(100).first(10).size(), 10);
+    }
+
+    void CTestAfvAudio::dspKernels()
+    {
+        // odd size, so the remainder after full vectors is covered
+        constexpr int count = 1001;
+        const QVector<float> input = randomSamples(count, 1);
+        const QVector<float> other = randomSamples(count, 2);
+
+        QVector<float> expected = input;
+        QVector<float> samples = input;
+        for (int i = 0; i < count; i++) { expected[i] += other[i]; }
+        mixAccumulate(samples.data(), other.constData(), count);
+        QCOMPARE(samples, expected);
+
+        expected = input;
+        samples = input;
+        for (int i = 0; i < count; i++) { expected[i] *= 0.25f; }
+        applyGain(samples.data(), count, 0.25f);
+        QCOMPARE(samples, expected);
+
+        samples = input;
+        applyGainRamp(samples.data(), count, 1.0f, 0.5f);
+        for (int i = 0; i < count; i++)
+        {
+            const float gain = 1.0f - 0.5f * (i + 1) / count;
+            QVERIFY2(qAbs(samples[i] - input[i] * gain) < 1E-6f, "Wrong ramp");
+        }
+        QVERIFY(qAbs(samples.last() - input.last() * 0.5f) < 1E-6f);
+
+        float max = 0.0f;
+        for (float sample : input) { max = qMax(max, qAbs(sample)); }
+        QCOMPARE(peak(input.constData(), count), max);
+        QCOMPARE(peak(input.constData(), 0), 0.0f);
+    }
+
+    void CTestAfvAudio::biQuadBlock()
+    {
+        const QVector<float> input = randomSamples(4800, 3);
+        QVector<BiQuadFilter> perSample = vhfFilters();
+        QVector<BiQuadFilter> perBlock = vhfFilters();
+
+        QVector<float> expected = input;
+        for (float &sample : expected)
+        {
+            for (BiQuadFilter &filter : perSample) { sample = filter.transform(sample); }
+        }
+
+        // several blocks, the state has to be carried over
+        QVector<float> samples = input;
+        for (int offset = 0; offset < samples.size(); offset += 480)
+        {
+            processBiQuads(perBlock.data(), perBlock.size(), samples.data() + offset, 480);
+        }
+        QCOMPARE(samples, expected);
+    }
+
+    void CTestAfvAudio::benchmarkBiQuads_data()
+    {
+        QTest::addColumn<bool>("perBlock");
+        QTest::newRow("per sample") << false;
+        QTest::newRow("per block")  << true;
+    }
+
+    void CTestAfvAudio::benchmarkBiQuads()
+    {
+        QFETCH(bool, perBlock);
+        QVector<BiQuadFilter> filters = vhfFilters();
+        const QVector<float> input = randomSamples(960, 4);
+        QVector<float> samples(input.size());
+
+        // 100 callsign inputs
+        QBENCHMARK
+        {
+            for (int callsign = 0; callsign < 100; callsign++)
+            {
+                std::copy(input.begin(), input.end(), samples.begin());
+                if (perBlock)
+                {
+                    processBiQuads(filters.data(), filters.size(), samples.data(), samples.size());
+                }
+                else
+                {
+                    for (float &sample : samples)
+                    {
+                        for (BiQuadFilter &filter : filters) { sample = filter.transform(sample); }
+                    }
+                }
+            }
+        }
+    }
+
+    void CTestAfvAudio::noAllocationsInCallback()
+    {
+        ReceiveChain chain(10, 10, 50);
+        CSampleBuffer buffer(ISampleProvider::MaxBlockSize);
+
+        // first callback reports the receiving callsigns
+        chain.mixer.readSamples(buffer.span(480));
+
+        g_allocations = 0;
+        g_countAllocations = true;
+        for (int i = 0; i < 50; i++) { chain.mixer.readSamples(buffer.span(480)); }
+        g_countAllocations = false;
+        QCOMPARE(g_allocations.load(), 0);
+    }
+
+    void CTestAfvAudio::benchmarkCallback_data()
+    {
+        QTest::addColumn<int>("blockSize");
+        QTest::newRow("10ms blocks")  << 480;
+        QTest::newRow("20ms blocks")  << 960;
+        QTest::newRow("100ms blocks") << ISampleProvider::MaxBlockSize;
+    }
+
+    void CTestAfvAudio::benchmarkCallback()
+    {
+        QFETCH(int, blockSize);
+        ReceiveChain chain(10, 10, SampleRate / FrameSize);
+        CSampleBuffer buffer(ISampleProvider::MaxBlockSize);
+        chain.mixer.readSamples(buffer.span(blockSize));
+
+        g_allocations = 0;
+        QBENCHMARK_ONCE
+        {
+            g_countAllocations = true;
+            for (int samples = blockSize; samples < SampleRate; samples += blockSize)
+            {
+                chain.mixer.readSamples(buffer.span(blockSize));
+            }
+            g_countAllocations = false;
+        }
+        QCOMPARE(g_allocations.load(), 0);
+    }
+
+    CTestAfvAudio::ReceiveChain::ReceiveChain(int receivers, int callsigns, int frames)
+    {
+        const QVector<QByteArray> opus = opusFrames(frames);
+        for (int r = 0; r < receivers; r++)
+        {
+            CReceiverSampleProvider *receiver = new CReceiverSampleProvider(audioFormat(), static_cast<quint16>(r), callsigns, nullptr, &mixer);
+            receiver->setFrequency(Frequency);
+            receiverInputs.push_back(receiver);
+            mixer.addMixerInput(receiver);
+
+            for (int c = 0; c < callsigns; c++)
+            {
+                const QString callsign = QStringLiteral("SWIFT%1").arg(r * callsigns + c);
+                uint sequence = 0;
+                for (const QByteArray &audio : opus)
+                {
+                    const IAudioDto dto { callsign, sequence++, audio, false };
+                    receiver->addOpusSamples(dto, Frequency, 1.0f);
+                }
+            }
+        }
+    }
+
+    CTestAfvAudio::Simulation CTestAfvAudio::simulateTransmission(CJitterBuffer &jitterBuffer, const QVector<int> &delaysMs, int frames, int lossEvery, int reorderEvery, uint firstSequence)
+    {
+        struct Packet
+        {
+            uint sequence;
+            qint64 arrivalMs;
+        };
+
+        Simulation simulation;
+        QVector<Packet> packets;
+        for (int f = 0; f < frames; f++)
+        {
+            const bool lastPacket = f == frames - 1;
+            if (lossEvery > 0 && f % lossEvery == lossEvery / 2 && !lastPacket)
+            {
+                simulation.injectedLoss++;
+                continue;
+            }
+            qint64 arrivalMs = f * CJitterBuffer::FrameMs + delaysMs[f % delaysMs.size()];
+            if (reorderEvery > 0 && f % reorderEvery == reorderEvery - 1 && !lastPacket) { arrivalMs += 2 * CJitterBuffer::FrameMs + 5; }
+            packets.push_back({ firstSequence + static_cast<uint>(f), arrivalMs });
+        }
+        std::stable_sort(packets.begin(), packets.end(), [](const Packet &a, const Packet &b) { return a.arrivalMs < b.arrivalMs; });
+
+        // playing out like CCallsignSampleProvider, buffered for the target delay at the start and after underflows
+        const int primeMs = jitterBuffer.getTargetDelayMs();
+        qint64 bufferedUntilMs = -1;
+        uint expected = firstSequence;
+        for (const Packet &packet : packets)
+        {
+            jitterBuffer.put(packet.sequence, QByteArray::number(packet.sequence), packet.sequence == firstSequence + static_cast<uint>(frames - 1), packet.arrivalMs);
+            JitterBufferFrame frame;
+            while (jitterBuffer.takeFrame(frame))
+            {
+                if (frame.sequence < expected) { simulation.inOrder = false; }
+                expected = frame.sequence + 1;
+
+                if (frame.type == JitterBufferFrame::Decode) { simulation.decoded++; }
+                else { simulation.concealed++; }
+                if (frame.type == JitterBufferFrame::ConcealFec && frame.opus == QByteArray::number(frame.sequence + 1)) { simulation.fecFromNext++; }
+
+                if (bufferedUntilMs < 0) { bufferedUntilMs = packet.arrivalMs + primeMs; }
+                else if (packet.arrivalMs > bufferedUntilMs)
+                {
+                    simulation.underflows++;
+                    jitterBuffer.underflow();
+                    bufferedUntilMs = packet.arrivalMs + jitterBuffer.getTargetDelayMs();
+                }
+                bufferedUntilMs += CJitterBuffer::FrameMs;
+            }
+        }
+        return simulation;
+    }
+
+    const QVector<int> &CTestAfvAudio::wifiDelays()
+    {
+        static const QVector<int> delays
+        {
+            3, 5, 2, 8, 4, 1, 12, 35, 28, 19, 9, 4, 3, 6, 2, 5, 7, 3, 41, 33, 22, 14, 6, 3, 2,
+            4, 5, 3, 9, 6, 2, 3, 18, 11, 4, 3, 5, 2, 26, 17, 8, 4, 3, 6, 2, 4, 3, 5, 7, 2
+        };
+        return delays;
+    }
+
+    const QVector<int> &CTestAfvAudio::lanDelays()
+    {
+        static const QVector<int> delays { 1, 2, 1, 1, 2, 1, 3, 1, 1, 2 };
+        return delays;
+    }
+
+    QVector<float> CTestAfvAudio::randomSamples(int count, quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        QVector<float> samples;
+        samples.reserve(count);
+        for (int i = 0; i < count; i++) { samples.push_back(static_cast<float>(2 * random.generateDouble() - 1)); }
+        return samples;
+    }
+
+    QVector<BiQuadFilter> CTestAfvAudio::vhfFilters()
+    {
+        return
+        {
+            BiQuadFilter::highPassFilter(44100, 310, 0.25),
+            BiQuadFilter::peakingEQ(44100, 450, 0.75, 17.0),
+            BiQuadFilter::peakingEQ(44100, 1450, 1.0, 25.0),
+            BiQuadFilter::peakingEQ(44100, 2000, 1.0, 25.0),
+            BiQuadFilter::lowPassFilter(44100, 2500, 0.25)
+        };
+    }
+
+    QAudioFormat CTestAfvAudio::audioFormat()
+    {
+        QAudioFormat format;
+        format.setSampleRate(SampleRate);
+        format.setChannelCount(1);
+        format.setSampleSize(16);
+        format.setSampleType(QAudioFormat::SignedInt);
+        format.setByteOrder(QAudioFormat::LittleEndian);
+        format.setCodec("audio/pcm");
+        return format;
+    }
+
+    QVector<QByteArray> CTestAfvAudio::opusFrames(int frames)
+    {
+        COpusEncoder encoder(SampleRate, 1);
+        encoder.setBitRate(16 * 1024);
+        encoder.setInbandFec(true);
+
+        QVector<QByteArray> encoded;
+        QVector<qint16> pcm(FrameSize);
+        for (int f = 0; f < frames; f++)
+        {
+            for (int i = 0; i < FrameSize; i++)
+            {
+                pcm[i] = static_cast<qint16>(8000 * qSin(2 * M_PI * 440 * (f * FrameSize + i) / SampleRate));
+            }
+            int encodedLength = 0;
+            encoded.push_back(encoder.encode(pcm, pcm.size(), &encodedLength));
+        }
+        return encoded;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackCoreTest::CTestAfvAudio);
+
+#include "testafvaudio.moc"
+
+//! \endcond
@@ -0,0 +1,287 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/afv/crypto/cryptodtochannel.h"
+#include "blackcore/afv/crypto/cryptodtopacket.h"
+#include "blackcore/afv/crypto/cryptodtoserializer.h"
+#include "blackcore/afv/dto.h"
+#include "test.h"
+
+#include <QByteArray>
+#include <QObject>
+#include <QTest>
+
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Crypto;
+
+namespace BlackCoreTest
+{
+    //! AFV UDP packet tests
+    class CTestAfvCrypto : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Packets are the same as the ones of the serializer
+        void sameAsSerializer();
+
+        //! Received packets are decrypted and deserialized
+        void deserialize();
+
+        //! Modified or truncated packets are rejected
+        void rejectInvalid();
+
+        //! The received DTO can be reused
+        void reuseDto();
+
+        //! Serialize and encrypt an audio packet, serializer vs. packet
+        void benchmarkSerialize_data();
+
+        //! Serialize and encrypt an audio packet, serializer vs. packet
+        void benchmarkSerialize();
+
+        //! Decrypt and deserialize an audio packet, serializer vs. packet
+        void benchmarkDeserialize_data();
+
+        //! Decrypt and deserialize an audio packet, serializer vs. packet
+        void benchmarkDeserialize();
+
+    private:
+        //! Channel with the same key for both directions, so sent packets can be received
+        static CCryptoDtoChannel channel();
+
+        //! Audio as sent by the client, 20ms of Opus
+        static AudioTxOnTransceiversDto txDto(uint sequence);
+
+        //! Audio as received from the server, 20ms of Opus
+        static AudioRxOnTransceiversDto rxDto(uint sequence);
+
+        //! Same DTO?
+        static bool equals(const AudioRxOnTransceiversDto &a, const AudioRxOnTransceiversDto &b);
+    };
+
+    void CTestAfvCrypto::sameAsSerializer()
+    {
+        const CCryptoDtoChannel c = channel();
+        const QByteArray key = QByteArray(32, 'k');
+        CCryptoDtoPacket packet;
+        for (uint sequence : { 0u, 1u, 200u, 70000u })
+        {
+            const QByteArray bytes = CryptoDtoSerializer::serialize(c.getChannelTag(), CryptoDtoMode::AEAD_ChaCha20Poly1305, key, sequence, txDto(sequence));
+            QVERIFY(packet.serialize(c.getChannelTagUtf8(), CryptoDtoMode::AEAD_ChaCha20Poly1305, key, sequence, txDto(sequence)));
+            QCOMPARE(QByteArray(packet.data(), packet.size()), bytes);
+        }
+
+        HeartbeatDto heartbeat;
+        heartbeat.callsign = "DECHK";
+        QVERIFY(packet.serialize(c.getChannelTagUtf8(), CryptoDtoMode::AEAD_ChaCha20Poly1305, key, 5, heartbeat));
+        QCOMPARE(QByteArray(packet.data(), packet.size()), CryptoDtoSerializer::serialize(c.getChannelTag(), CryptoDtoMode::AEAD_ChaCha20Poly1305, key, 5, heartbeat));
+
+        // only AEAD is supported, like by the serializer
+        QVERIFY(!packet.serialize(c.getChannelTagUtf8(), CryptoDtoMode::None, key, 6, heartbeat));
+        QCOMPARE(packet.size(), 0);
+    }
+
+    void CTestAfvCrypto::deserialize()
+    {
+        CCryptoDtoChannel c = channel();
+        const AudioRxOnTransceiversDto sent = rxDto(42);
+        const QByteArray bytes = CryptoDtoSerializer::serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, sent);
+
+        CCryptoDtoPacket packet;
+        QVERIFY(packet.deserialize(c, bytes, false));
+        QVERIFY(packet.isVerified());
+        QVERIFY(packet.isDto<AudioRxOnTransceiversDto>());
+        QVERIFY(!packet.isDto<HeartbeatAckDto>());
+        QCOMPARE(packet.getSequence(), 0ull);
+        QVERIFY(packet.getDtoName() == AudioRxOnTransceiversDto::ShortDtoName);
+
+        AudioRxOnTransceiversDto received;
+        QVERIFY(packet.getDto(received));
+        QVERIFY(equals(received, sent));
+
+        HeartbeatAckDto ack;
+        QVERIFY(!packet.getDto(ack));
+
+        // a packet of the packet is read by the serializer
+        QVERIFY(packet.serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, sent));
+        CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(c, QByteArray(packet.data(), packet.size()), false);
+        QVERIFY(deserializer.m_verified);
+        QCOMPARE(deserializer.m_header.Sequence, 1ull);
+        QVERIFY(equals(deserializer.getDto<AudioRxOnTransceiversDto>(), sent));
+    }
+
+    void CTestAfvCrypto::rejectInvalid()
+    {
+        CCryptoDtoChannel c = channel();
+        const QByteArray bytes = CryptoDtoSerializer::serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, rxDto(1));
+        CCryptoDtoPacket packet;
+        QVERIFY(packet.deserialize(c, bytes, false));
+
+        // header, payload and MAC are authenticated
+        for (int i : { 5, bytes.size() / 2, bytes.size() - 1 })
+        {
+            QByteArray modified(bytes);
+            modified[i] = static_cast<char>(modified[i] ^ 0x01);
+            QVERIFY2(!packet.deserialize(c, modified, false), qPrintable(QStringLiteral("byte %1").arg(i)));
+            QVERIFY(!packet.isVerified());
+            QVERIFY(!packet.isDto<AudioRxOnTransceiversDto>());
+        }
+
+        QVERIFY(!packet.deserialize(c, bytes.left(bytes.size() - 1), false));
+        QVERIFY(!packet.deserialize(c, bytes.left(10), false));
+        QVERIFY(!packet.deserialize(c, QByteArray(), false));
+        QVERIFY(!packet.deserialize(c, QByteArray(CCryptoDtoPacket::MaxSize + 1, 0), false));
+
+        // wrong key
+        CCryptoDtoChannel other(QStringLiteral("tag"), QByteArray(32, 'x'), QByteArray(32, 'x'));
+        QVERIFY(!packet.deserialize(other, bytes, false));
+        QVERIFY(packet.deserialize(c, bytes, false));
+    }
+
+    void CTestAfvCrypto::reuseDto()
+    {
+        CCryptoDtoChannel c = channel();
+        CCryptoDtoPacket sendPacket;
+        CCryptoDtoPacket receivePacket;
+        AudioRxOnTransceiversDto received;
+        for (uint sequence = 0; sequence < 10; sequence++)
+        {
+            AudioRxOnTransceiversDto sent = rxDto(sequence);
+            sent.lastPacket = sequence == 9;
+            sent.transceivers.resize(1 + sequence % 3);
+            QVERIFY(sendPacket.serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, sent));
+
+            // received directly into the buffer
+            std::copy(sendPacket.data(), sendPacket.data() + sendPacket.size(), receivePacket.receiveBuffer());
+            QVERIFY(receivePacket.deserialize(c, sendPacket.size(), false));
+            QVERIFY(receivePacket.getDto(received));
+            QVERIFY(equals(received, sent));
+        }
+    }
+
+    void CTestAfvCrypto::benchmarkSerialize_data()
+    {
+        QTest::addColumn<bool>("inPlace");
+        QTest::newRow("serializer") << false;
+        QTest::newRow("packet")     << true;
+    }
+
+    void CTestAfvCrypto::benchmarkSerialize()
+    {
+        QFETCH(bool, inPlace);
+        CCryptoDtoChannel c = channel();
+        const AudioTxOnTransceiversDto dto = txDto(1);
+        CCryptoDtoPacket packet;
+        int bytes = 0;
+        QBENCHMARK
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                if (inPlace)
+                {
+                    packet.serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+                    bytes += packet.size();
+                }
+                else
+                {
+                    bytes += CryptoDtoSerializer::serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto).size();
+                }
+            }
+        }
+        QVERIFY(bytes > 0);
+    }
+
+    void CTestAfvCrypto::benchmarkDeserialize_data()
+    {
+        QTest::addColumn<bool>("inPlace");
+        QTest::newRow("serializer") << false;
+        QTest::newRow("packet")     << true;
+    }
+
+    void CTestAfvCrypto::benchmarkDeserialize()
+    {
+        QFETCH(bool, inPlace);
+        CCryptoDtoChannel c = channel();
+        const QByteArray bytes = CryptoDtoSerializer::serialize(c, CryptoDtoMode::AEAD_ChaCha20Poly1305, rxDto(1));
+        CCryptoDtoPacket packet;
+        AudioRxOnTransceiversDto dto;
+        int verified = 0;
+        QBENCHMARK
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                if (inPlace)
+                {
+                    // like the datagram being received into the buffer
+                    std::copy(bytes.cbegin(), bytes.cend(), packet.receiveBuffer());
+                    if (packet.deserialize(c, bytes.size(), false) && packet.getDto(dto)) { verified++; }
+                }
+                else
+                {
+                    CryptoDtoSerializer::Deserializer deserializer = CryptoDtoSerializer::deserialize(c, bytes, false);
+                    dto = deserializer.getDto<AudioRxOnTransceiversDto>();
+                    if (deserializer.m_verified) { verified++; }
+                }
+            }
+        }
+        QVERIFY(verified > 0);
+    }
+
+    CCryptoDtoChannel CTestAfvCrypto::channel()
+    {
+        const QByteArray key(32, 'k');
+        return CCryptoDtoChannel(QStringLiteral("CHANNELTAG"), key, key);
+    }
+
+    AudioTxOnTransceiversDto CTestAfvCrypto::txDto(uint sequence)
+    {
+        AudioTxOnTransceiversDto dto;
+        dto.callsign = "DECHK";
+        dto.sequenceCounter = sequence;
+        dto.audio = std::vector<char>(60, static_cast<char>(sequence));
+        dto.lastPacket = false;
+        dto.transceivers = { TxTransceiverDto(0), TxTransceiverDto(1) };
+        return dto;
+    }
+
+    AudioRxOnTransceiversDto CTestAfvCrypto::rxDto(uint sequence)
+    {
+        AudioRxOnTransceiversDto dto;
+        dto.callsign = "DLH123";
+        dto.sequenceCounter = sequence;
+        dto.audio = std::vector<char>(60, static_cast<char>(sequence));
+        dto.lastPacket = false;
+        dto.transceivers = { { 0, 122800000, 0.5f }, { 1, 121500000, 0.75f }, { 2, 118000000, 1.0f } };
+        return dto;
+    }
+
+    bool CTestAfvCrypto::equals(const AudioRxOnTransceiversDto &a, const AudioRxOnTransceiversDto &b)
+    {
+        if (a.callsign != b.callsign || a.sequenceCounter != b.sequenceCounter || a.audio != b.audio || a.lastPacket != b.lastPacket) { return false; }
+        if (a.transceivers.size() != b.transceivers.size()) { return false; }
+        for (std::size_t i = 0; i < a.transceivers.size(); i++)
+        {
+            const RxTransceiverDto &ta = a.transceivers[i];
+            const RxTransceiverDto &tb = b.transceivers[i];
+            if (ta.id != tb.id || ta.frequency != tb.frequency || !qFuzzyCompare(ta.distanceRatio, tb.distanceRatio)) { return false; }
+        }
+        return true;
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackCoreTest::CTestAfvCrypto);
+
+#include "testafvcrypto.moc"
+
+//! \endcond
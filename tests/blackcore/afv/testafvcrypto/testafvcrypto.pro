@@ -0,0 +1,30 @@
+load(common_pre)
+
+QT += core dbus testlib
+
+TARGET = testafvcrypto
+CONFIG   -= app_bundle
+CONFIG   += blackconfig
+CONFIG   += blackmisc
+CONFIG   += blackcore
+CONFIG   += testcase
+CONFIG   += no_testcase_installs
+
+TEMPLATE = app
+
+DEPENDPATH += \
+    . \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+INCLUDEPATH += \
+    $$SourceRoot/src \
+    $$SourceRoot/tests \
+
+SOURCES += testafvcrypto.cpp
+
+LIBS *= -lsodium
+
+DESTDIR = $$DestRoot/bin
+
+load(common_post)
@@ -0,0 +1,305 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/afv/connection/voicesocket.h"
+#include "blackcore/afv/crypto/cryptodtochannel.h"
+#include "blackcore/afv/crypto/cryptodtopacket.h"
+#include "blackcore/afv/dto.h"
+#include "test.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QObject>
+#include <QTest>
+#include <QUdpSocket>
+#include <atomic>
+#include <vector>
+
+using namespace BlackCore::Afv;
+using namespace BlackCore::Afv::Connection;
+using namespace BlackCore::Afv::Crypto;
+
+namespace BlackCoreTest
+{
+    //! AFV voice socket tests with a local stand-in for the voice server
+    class CTestAfvNetwork : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Stand-in voice server on the loopback interface
+        void init();
+
+        //! Close all sockets
+        void cleanup();
+
+        //! Heartbeat to the server, audio back to the client
+        void heartbeatAndAudio();
+
+        //! Burst of datagrams, all received in order
+        void burst();
+
+        //! Queue full, datagrams are dropped instead of blocking the network thread
+        void queueFull();
+
+        //! Closed socket
+        void closed();
+
+        //! Latency from sending at the server until taken by the consumer
+        void latency();
+
+    private:
+        //! Open the client socket to the stand-in server
+        bool openClient(CVoiceSocket &client);
+
+        //! Server receives one datagram from the client
+        QByteArray serverReceive();
+
+        //! Server sends audio to the client
+        void serverSendAudio(uint sequence, CVoiceSocket &client);
+
+        //! Take datagrams until the count is reached or the timeout expires
+        int takeDatagrams(CVoiceSocket &client, int count, std::vector<QByteArray> *datagrams = nullptr, std::vector<qint64> *receivedUs = nullptr, int timeoutMs = 5000);
+
+        //! Channel with the same key for both directions
+        static CCryptoDtoChannel channel();
+
+        QUdpSocket *m_server = nullptr;
+        CCryptoDtoChannel m_serverChannel = channel();
+        CCryptoDtoPacket m_serverPacket;
+    };
+
+    void CTestAfvNetwork::init()
+    {
+        m_server = new QUdpSocket(this);
+        QVERIFY(m_server->bind(QHostAddress::LocalHost, 0));
+        m_serverChannel = channel();
+    }
+
+    void CTestAfvNetwork::cleanup()
+    {
+        delete m_server;
+        m_server = nullptr;
+    }
+
+    void CTestAfvNetwork::heartbeatAndAudio()
+    {
+        std::atomic_int notified { 0 };
+        CVoiceSocket client;
+        client.setNotify([&notified] { notified++; });
+        QVERIFY(openClient(client));
+
+        // client to server
+        CCryptoDtoChannel clientChannel = channel();
+        CCryptoDtoPacket packet;
+        HeartbeatDto heartbeat;
+        heartbeat.callsign = "DECHK";
+        QVERIFY(packet.serialize(clientChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, heartbeat));
+        QVERIFY(client.send(packet.data(), packet.size()));
+
+        const QByteArray received = serverReceive();
+        QVERIFY(m_serverPacket.deserialize(m_serverChannel, received, false));
+        HeartbeatDto receivedHeartbeat;
+        QVERIFY(m_serverPacket.getDto(receivedHeartbeat));
+        QCOMPARE(receivedHeartbeat.callsign, heartbeat.callsign);
+
+        // server to client
+        const qint64 startUs = CVoiceSocket::nowUs();
+        for (uint sequence = 0; sequence < 10; sequence++) { serverSendAudio(sequence, client); }
+
+        std::vector<QByteArray> datagrams;
+        std::vector<qint64> receivedUs;
+        QCOMPARE(takeDatagrams(client, 10, &datagrams, &receivedUs), 10);
+        QVERIFY(notified > 0);
+        for (uint sequence = 0; sequence < 10; sequence++)
+        {
+            QVERIFY(packet.deserialize(clientChannel, datagrams[sequence], false));
+            AudioRxOnTransceiversDto audio;
+            QVERIFY(packet.getDto(audio));
+            QCOMPARE(audio.sequenceCounter, sequence);
+            QVERIFY(receivedUs[sequence] >= startUs);
+            if (sequence > 0) { QVERIFY(receivedUs[sequence] >= receivedUs[sequence - 1]); }
+        }
+
+        const VoiceSocketStatistics statistics = client.getStatistics();
+        QCOMPARE(statistics.datagrams, 10ll);
+        QVERIFY(statistics.batches >= 1 && statistics.batches <= 10);
+        QCOMPARE(statistics.dropped, 0ll);
+        QCOMPARE(statistics.queued, 0);
+    }
+
+    void CTestAfvNetwork::burst()
+    {
+        CVoiceSocket client;
+        QVERIFY(openClient(client));
+
+        const int count = 200;
+        for (int i = 0; i < count; i++) { serverSendAudio(static_cast<uint>(i), client); }
+
+        std::vector<QByteArray> datagrams;
+        QCOMPARE(takeDatagrams(client, count, &datagrams), count);
+
+        CCryptoDtoChannel clientChannel = channel();
+        CCryptoDtoPacket packet;
+        AudioRxOnTransceiversDto audio;
+        for (int i = 0; i < count; i++)
+        {
+            QVERIFY(packet.deserialize(clientChannel, datagrams[static_cast<std::size_t>(i)], false));
+            QVERIFY(packet.getDto(audio));
+            QCOMPARE(audio.sequenceCounter, static_cast<uint>(i));
+        }
+
+        const VoiceSocketStatistics statistics = client.getStatistics();
+        QCOMPARE(statistics.datagrams, static_cast<qint64>(count));
+        QVERIFY(statistics.maxBatch >= 1 && statistics.maxBatch <= CVoiceSocket::BatchSize);
+        qDebug() << statistics.toQString();
+    }
+
+    void CTestAfvNetwork::queueFull()
+    {
+        CVoiceSocket client;
+        QVERIFY(openClient(client));
+
+        // nothing taken, the queue fills up
+        const int count = CVoiceSocket::QueueSize + 20;
+        for (int i = 0; i < count; i++) { serverSendAudio(static_cast<uint>(i), client); }
+
+        QElapsedTimer timer;
+        timer.start();
+        VoiceSocketStatistics statistics;
+        do
+        {
+            QTest::qWait(10);
+            statistics = client.getStatistics();
+        }
+        while (statistics.datagrams + statistics.dropped < count && timer.elapsed() < 5000);
+
+        QCOMPARE(statistics.datagrams, static_cast<qint64>(CVoiceSocket::QueueSize));
+        QCOMPARE(statistics.dropped, 20ll);
+        QCOMPARE(statistics.queued, CVoiceSocket::QueueSize);
+
+        // the oldest are kept
+        std::vector<QByteArray> datagrams;
+        QCOMPARE(takeDatagrams(client, CVoiceSocket::QueueSize, &datagrams), CVoiceSocket::QueueSize);
+        CCryptoDtoChannel clientChannel = channel();
+        CCryptoDtoPacket packet;
+        AudioRxOnTransceiversDto audio;
+        QVERIFY(packet.deserialize(clientChannel, datagrams.front(), false));
+        QVERIFY(packet.getDto(audio));
+        QCOMPARE(audio.sequenceCounter, 0u);
+    }
+
+    void CTestAfvNetwork::closed()
+    {
+        CVoiceSocket client;
+        QVERIFY(!client.isOpen());
+        QVERIFY(!client.send("x", 1));
+        std::vector<char> buffer(CVoiceSocket::MaxDatagramSize);
+        qint64 receivedUs = 0;
+        QCOMPARE(client.takeDatagram(buffer.data(), receivedUs), -1);
+
+        QVERIFY(!client.open(QHostAddress(QStringLiteral("::1")), 1234));
+        QVERIFY(!client.getLastError().isEmpty());
+
+        QVERIFY(openClient(client));
+        QVERIFY(client.getLocalPort() > 0);
+        client.close();
+        QVERIFY(!client.isOpen());
+
+        // reopened, e.g. connected again
+        QVERIFY(openClient(client));
+        serverSendAudio(1, client);
+        QCOMPARE(takeDatagrams(client, 1), 1);
+    }
+
+    void CTestAfvNetwork::latency()
+    {
+        CVoiceSocket client;
+        QVERIFY(openClient(client));
+
+        // one datagram at a time, like the 20ms frames of the voice server
+        qint64 totalUs = 0;
+        qint64 maxUs = 0;
+        const int count = 50;
+        std::vector<qint64> receivedUs;
+        for (int i = 0; i < count; i++)
+        {
+            const qint64 sentUs = CVoiceSocket::nowUs();
+            serverSendAudio(static_cast<uint>(i), client);
+            receivedUs.clear();
+            QCOMPARE(takeDatagrams(client, 1, nullptr, &receivedUs), 1);
+            const qint64 takenUs = CVoiceSocket::nowUs();
+            QVERIFY(receivedUs.front() >= sentUs);
+            QVERIFY(receivedUs.front() <= takenUs);
+            totalUs += takenUs - sentUs;
+            maxUs = qMax(maxUs, takenUs - sentUs);
+        }
+        qDebug() << "Latency sent until taken avg/max:" << (totalUs / count) << "/" << maxUs << "us";
+    }
+
+    bool CTestAfvNetwork::openClient(CVoiceSocket &client)
+    {
+        return client.open(QHostAddress::LocalHost, m_server->localPort());
+    }
+
+    QByteArray CTestAfvNetwork::serverReceive()
+    {
+        if (!m_server->hasPendingDatagrams() && !m_server->waitForReadyRead(5000)) { return {}; }
+        QByteArray datagram(static_cast<int>(m_server->pendingDatagramSize()), 0);
+        m_server->readDatagram(datagram.data(), datagram.size());
+        return datagram;
+    }
+
+    void CTestAfvNetwork::serverSendAudio(uint sequence, CVoiceSocket &client)
+    {
+        AudioRxOnTransceiversDto dto;
+        dto.callsign = "DLH123";
+        dto.sequenceCounter = sequence;
+        dto.audio = std::vector<char>(60, static_cast<char>(sequence));
+        dto.lastPacket = false;
+        dto.transceivers = { { 0, 122800000, 1.0f } };
+        m_serverPacket.serialize(m_serverChannel, CryptoDtoMode::AEAD_ChaCha20Poly1305, dto);
+        m_server->writeDatagram(m_serverPacket.data(), m_serverPacket.size(), QHostAddress::LocalHost, client.getLocalPort());
+    }
+
+    int CTestAfvNetwork::takeDatagrams(CVoiceSocket &client, int count, std::vector<QByteArray> *datagrams, std::vector<qint64> *receivedUs, int timeoutMs)
+    {
+        std::vector<char> buffer(CVoiceSocket::MaxDatagramSize);
+        QElapsedTimer timer;
+        timer.start();
+        int taken = 0;
+        while (taken < count && timer.elapsed() < timeoutMs)
+        {
+            qint64 us = 0;
+            const int size = client.takeDatagram(buffer.data(), us);
+            if (size < 0) { QThread::usleep(100); continue; }
+            if (datagrams) { datagrams->push_back(QByteArray(buffer.data(), size)); }
+            if (receivedUs) { receivedUs->push_back(us); }
+            taken++;
+        }
+        return taken;
+    }
+
+    CCryptoDtoChannel CTestAfvNetwork::channel()
+    {
+        const QByteArray key(32, 'k');
+        return CCryptoDtoChannel(QStringLiteral("CHANNELTAG"), key, key);
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackCoreTest::CTestAfvNetwork);
+
+#include "testafvnetwork.moc"
+
+//! \endcond
@@ -1,6 +1,8 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
+    afv \
     context \
     fsd \
     testconnectivity \
+    testmatchingscript \
@@ -63,6 +63,7 @@ namespace BlackFsdTest
         void testTextMessage();
         void testRadioMessage();
         void testPilotDataUpdate();
+        void testBatchedPositionUpdates();
         void testAtcDataUpdate();
         void testPong();
         void testClientResponseEmptyType();
@@ -256,6 +257,59 @@ namespace BlackFsdTest
         //        QCOMPARE(arguments.at(12).toBool(), false);
     }
 
+    void CTestFSDClient::testBatchedPositionUpdates()
+    {
+        QSignalSpy spyFull(m_client, &CFSDClient::pilotDataUpdateReceived);
+        QSignalSpy spyBatch(m_client, &CFSDClient::batchedPositionUpdatesReceived);
+        QSignalSpy spyVisual(m_client, &CFSDClient::visualPilotDataUpdateReceived);
+        m_client->setMaxBatchedSituationsPerCallsign(2);
+
+        // as if read from socket at once
+        m_client->m_batchPositions = true;
+        m_client->sendFsdMessage("@N:ABCD:1200:1:48.353855:11.786155:110:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("@N:ABCD:1200:1:48.353955:11.786155:120:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("^ABCD:48.3539551:11.7861551:121.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->sendFsdMessage("^ABCD:48.3539552:11.7861552:122.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->sendFsdMessage("^ABCD:48.3539553:11.7861553:123.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->sendFsdMessage("^EFGH:50.0000000:8.0000000:1000.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->m_batchPositions = false;
+        QCOMPARE(spyFull.count(), 0);
+        QCOMPARE(spyBatch.count(), 0);
+
+        m_client->emitBatchedPositions();
+        QCOMPARE(spyVisual.count(), 0);
+        QCOMPARE(spyFull.count(), 1);
+        const CAircraftSituation full = spyFull.takeFirst().at(0).value<CAircraftSituation>();
+        QCOMPARE(full.getAltitude(), CAltitude(120, CLengthUnit::ft()));
+
+        QCOMPARE(spyBatch.count(), 1);
+        const CAircraftSituationList situations = spyBatch.takeFirst().at(0).value<CAircraftSituationList>();
+        QCOMPARE(situations.size(), 3);
+        const CAircraftSituationList abcd = situations.findByCallsign("ABCD");
+        QCOMPARE(abcd.size(), 2);
+        QCOMPARE(abcd.front().getAltitude(), CAltitude(122, CLengthUnit::ft()));
+        QCOMPARE(abcd.back().getAltitude(), CAltitude(123, CLengthUnit::ft()));
+
+        // emitted in order of reception
+        QStringList received;
+        QObject context;
+        connect(m_client, &CFSDClient::pilotDataUpdateReceived, &context, [&](const CAircraftSituation &situation)
+        {
+            received.push_back(QStringLiteral("full %1").arg(situation.getAltitude().value(CLengthUnit::ft())));
+        });
+        connect(m_client, &CFSDClient::batchedPositionUpdatesReceived, &context, [&](const CAircraftSituationList &situations)
+        {
+            for (const CAircraftSituation &situation : situations) { received.push_back(QStringLiteral("batch %1").arg(situation.getAltitude().value(CLengthUnit::ft()))); }
+        });
+        m_client->m_batchPositions = true;
+        m_client->sendFsdMessage("^ABCD:48.3539554:11.7861554:124.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->sendFsdMessage("@N:ABCD:1200:1:48.353955:11.786155:125:0:4290769188:1\r\n");
+        m_client->sendFsdMessage("^ABCD:48.3539556:11.7861556:126.00:0.00:4290769188:0.0000:0.0000:0.0000:0.0000:0.0000:0.0000:0.00\r\n");
+        m_client->m_batchPositions = false;
+        m_client->emitBatchedPositions();
+        QCOMPARE(received, QStringList({ "batch 124", "full 125", "batch 126" }));
+    }
+
     void CTestFSDClient::testAtcDataUpdate()
     {
         QSignalSpy spy(m_client, &CFSDClient::atcDataUpdateReceived);
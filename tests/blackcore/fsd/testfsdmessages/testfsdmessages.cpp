@@ -44,11 +44,17 @@
 #include "blackcore/fsd/planeinforequestfsinn.h"
 #include "blackcore/fsd/planeinformationfsinn.h"
 #include "blackcore/fsd/enums.h"
+#include "blackcore/fsd/tokenview.h"
+#include "blackmisc/swiftdirectories.h"
+#include "blackmisc/fileutils.h"
 #include "test.h"
 
 #include <QObject>
+#include <QFile>
+#include <QVector>
 #include <QTest>
 
+using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
 using namespace BlackMisc::Network;
 using namespace BlackConfig;
@@ -96,6 +102,19 @@ namespace BlackMiscTest
         void testPong();
         void testServerError();
         void testTextMessage();
+        void testTokenView();
+        void benchmarkParseSessionTokenList();
+        void benchmarkParseSessionTokenView();
+
+    private:
+        //! Lines of a recorded FSD session
+        static const QVector<QByteArray> &recordedSession();
+
+        //! Parse the position and pong lines, returns number of parsed messages
+        //! @{
+        static int parseWithTokenList(const QVector<QByteArray> &lines);
+        static int parseWithTokenView(const QVector<QByteArray> &lines);
+        //! @}
     };
 
     void CTestFsdMessages::testAddAtc()
@@ -500,6 +519,10 @@ namespace BlackMiscTest
         QVERIFY(message.m_bank - messageFromTokens.m_bank < 1.0);
         QVERIFY(message.m_heading - messageFromTokens.m_heading < 1.0);
         QCOMPARE(messageFromTokens.m_onGround, true);
+
+        const QByteArray raw("N:ABCD:7000:1:43.12578:-72.15841:12000:125:25132146:8");
+        const auto messageFromView = PilotDataUpdate::fromTokens(TokenView(QLatin1String(raw)));
+        QCOMPARE(messageFromView, messageFromTokens);
     }
 
     void CTestFsdMessages::testVisualPilotDataUpdate()
@@ -543,6 +566,24 @@ namespace BlackMiscTest
         QCOMPARE(0.0524, messageFromTokens.m_bankRadPerSec);
         QCOMPARE(0.0175, messageFromTokens.m_headingRadPerSec);
         QCOMPARE(0.0, messageFromTokens.m_noseGearAngle);
+
+        const QByteArray raw("ABCD:43.1257891:-72.1584142:12000.12:1404.00:25132144:-1.0001:2.0001:3.0001:-0.0349:0.0175:0.0524:0.00");
+        const auto messageFromView = VisualPilotDataUpdate::fromTokens(TokenView(QLatin1String(raw)));
+        QCOMPARE(messageFromView.sender(), messageFromTokens.sender());
+        QCOMPARE(messageFromView.m_latitude, messageFromTokens.m_latitude);
+        QCOMPARE(messageFromView.m_longitude, messageFromTokens.m_longitude);
+        QCOMPARE(messageFromView.m_altitudeTrue, messageFromTokens.m_altitudeTrue);
+        QCOMPARE(messageFromView.m_heightAgl, messageFromTokens.m_heightAgl);
+        QCOMPARE(messageFromView.m_pitch, messageFromTokens.m_pitch);
+        QCOMPARE(messageFromView.m_bank, messageFromTokens.m_bank);
+        QCOMPARE(messageFromView.m_heading, messageFromTokens.m_heading);
+        QCOMPARE(messageFromView.m_xVelocity, messageFromTokens.m_xVelocity);
+        QCOMPARE(messageFromView.m_yVelocity, messageFromTokens.m_yVelocity);
+        QCOMPARE(messageFromView.m_zVelocity, messageFromTokens.m_zVelocity);
+        QCOMPARE(messageFromView.m_pitchRadPerSec, messageFromTokens.m_pitchRadPerSec);
+        QCOMPARE(messageFromView.m_bankRadPerSec, messageFromTokens.m_bankRadPerSec);
+        QCOMPARE(messageFromView.m_headingRadPerSec, messageFromTokens.m_headingRadPerSec);
+        QCOMPARE(messageFromView.m_noseGearAngle, messageFromTokens.m_noseGearAngle);
     }
 
     void CTestFsdMessages::testVisualPilotDataToggle()
@@ -684,6 +725,9 @@ namespace BlackMiscTest
         QStringList tokens = QString("ABCD:SERVER:85275222").split(':');
         auto messageFromTokens = Pong::fromTokens(tokens);
         QCOMPARE(messageFromTokens, message);
+
+        const QByteArray raw("ABCD:SERVER:85275222");
+        QCOMPARE(Pong::fromTokens(TokenView(QLatin1String(raw))), message);
     }
 
     void CTestFsdMessages::testServerError()
@@ -708,10 +752,155 @@ namespace BlackMiscTest
     {
 
     }
+
+    void CTestFsdMessages::testTokenView()
+    {
+        const QByteArray raw("ABCD::-12:4294967295:-0.00125:1e3:x");
+        const TokenView tokens((QLatin1String(raw)));
+        QCOMPARE(tokens.size(), 7);
+        QCOMPARE(tokens.at(0), QLatin1String("ABCD"));
+        QVERIFY(tokens.at(1).isEmpty());
+        QVERIFY(tokens.value(7).isEmpty());
+        QVERIFY(!tokens.isTruncated());
+
+        QCOMPARE(tokens.toInt(2), -12);
+        QCOMPARE(tokens.toUInt(3), 4294967295u);
+        QCOMPARE(tokens.toDouble(4), -0.00125);
+        QCOMPARE(tokens.toDouble(5), 1000.0); // slow path
+
+        bool ok = true;
+        QCOMPARE(tokens.toInt(6, &ok), 0);
+        QVERIFY(!ok);
+        QCOMPARE(tokens.toInt(1, &ok), 0);
+        QVERIFY(!ok);
+        QCOMPARE(tokens.toInt(3, &ok), 0); // overflow
+        QVERIFY(!ok);
+
+        // same results as QString for all numbers of a recorded session
+        for (const QByteArray &line : recordedSession())
+        {
+            const QString lineString = QString::fromLatin1(line);
+            const QStringList stringTokens = lineString.split(':');
+            const TokenView viewTokens((QLatin1String(line)));
+            QCOMPARE(viewTokens.size(), stringTokens.size());
+            for (int i = 0; i < stringTokens.size(); ++i)
+            {
+                QCOMPARE(viewTokens.toQString(i), stringTokens.at(i));
+                QCOMPARE(viewTokens.toDouble(i), stringTokens.at(i).toDouble());
+                QCOMPARE(viewTokens.toInt(i), stringTokens.at(i).toInt());
+                QCOMPARE(viewTokens.toUInt(i), stringTokens.at(i).toUInt());
+            }
+        }
+
+        QByteArray many;
+        for (int i = 0; i < TokenView::MaxTokens + 5; ++i) { many += "1:"; }
+        const TokenView truncated((QLatin1String(many)));
+        QCOMPARE(truncated.size(), TokenView::MaxTokens);
+        QVERIFY(truncated.isTruncated());
+    }
+
+    void CTestFsdMessages::benchmarkParseSessionTokenList()
+    {
+        const QVector<QByteArray> &lines = recordedSession();
+        QVERIFY2(!lines.isEmpty(), "Missing recorded session");
+        int parsed = 0;
+        QBENCHMARK { parsed = parseWithTokenList(lines); }
+        QVERIFY(parsed > 0);
+    }
+
+    void CTestFsdMessages::benchmarkParseSessionTokenView()
+    {
+        const QVector<QByteArray> &lines = recordedSession();
+        QVERIFY2(!lines.isEmpty(), "Missing recorded session");
+        int parsed = 0;
+        QBENCHMARK { parsed = parseWithTokenView(lines); }
+        QCOMPARE(parsed, parseWithTokenList(lines));
+    }
+
+    const QVector<QByteArray> &CTestFsdMessages::recordedSession()
+    {
+        static const QVector<QByteArray> lines = []
+        {
+            QVector<QByteArray> l;
+            QFile file(CFileUtils::appendFilePaths(CSwiftDirectories::testFilesDirectory(), "fsdsession.txt"));
+            if (!file.open(QIODevice::ReadOnly)) { return l; }
+            while (!file.atEnd())
+            {
+                const QByteArray line = file.readLine().trimmed();
+                if (!line.isEmpty()) { l.push_back(line); }
+            }
+            return l;
+        }();
+        return lines;
+    }
+
+    int CTestFsdMessages::parseWithTokenList(const QVector<QByteArray> &lines)
+    {
+        int c = 0;
+        for (const QByteArray &raw : lines)
+        {
+            const QString line = QString::fromUtf8(raw).trimmed();
+            if (line.startsWith('@'))
+            {
+                const PilotDataUpdate m = PilotDataUpdate::fromTokens(line.mid(1).split(':'));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith('^'))
+            {
+                const VisualPilotDataUpdate m = VisualPilotDataUpdate::fromTokens(line.mid(1).split(':'));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith("#SB"))
+            {
+                const QStringList tokens = line.mid(3).split(':');
+                if (tokens.value(2) != "VI") { continue; }
+                const InterimPilotDataUpdate m = InterimPilotDataUpdate::fromTokens(tokens);
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith("$PO"))
+            {
+                const Pong m = Pong::fromTokens(line.mid(3).split(':'));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+        }
+        return c;
+    }
+
+    int CTestFsdMessages::parseWithTokenView(const QVector<QByteArray> &lines)
+    {
+        int c = 0;
+        for (const QByteArray &raw : lines)
+        {
+            const QLatin1String line = QLatin1String(raw).trimmed();
+            if (line.startsWith(QLatin1Char('@')))
+            {
+                const PilotDataUpdate m = PilotDataUpdate::fromTokens(TokenView(line.mid(1)));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith(QLatin1Char('^')))
+            {
+                const VisualPilotDataUpdate m = VisualPilotDataUpdate::fromTokens(TokenView(line.mid(1)));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith(QLatin1String("#SB")))
+            {
+                const TokenView tokens(line.mid(3));
+                if (tokens.value(2) != QLatin1String("VI")) { continue; }
+                const InterimPilotDataUpdate m = InterimPilotDataUpdate::fromTokens(tokens);
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+            else if (line.startsWith(QLatin1String("$PO")))
+            {
+                const Pong m = Pong::fromTokens(TokenView(line.mid(3)));
+                c += m.sender().isEmpty() ? 0 : 1;
+            }
+        }
+        return c;
+    }
 }
 
 //! main
-BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestFsdMessages);
+BLACKTEST_MAIN(BlackMiscTest::CTestFsdMessages);
 
 #include "testfsdmessages.moc"
 
@@ -0,0 +1,256 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackcore
+
+#include "blackcore/aircraftmatcher.h"
+#include "blackcore/matchingscriptruntime.h"
+#include "blackcore/webdataservicesms.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/aircraftmatchersetup.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/matchingscript.h"
+#include "blackmisc/simulation/simulatedaircraft.h"
+#include "blackmisc/simulation/simulatorinfo.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/fileutils.h"
+#include "test.h"
+
+#include <QDebug>
+#include <QJSEngine>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackCore;
+
+namespace BlackCoreTest
+{
+    //! Test the matching script runtime
+    class CTestMatchingScript : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Script is only evaluated again when the file changes
+        void reloadOnChange();
+
+        //! Bound objects are initialized for every run
+        void objectsInitialized();
+
+        //! Errors of the script file
+        void scriptErrors();
+
+        //! 1000 matchings with the persistent runtime, with an engine per matching and with the matcher
+        void benchmarkMatchings_data();
+
+        //! 1000 matchings with the persistent runtime, with an engine per matching and with the matcher
+        void benchmarkMatchings();
+
+    private:
+        //! How the benchmark runs the script
+        enum BenchmarkMode
+        {
+            PersistentRuntime,
+            EnginePerMatching,
+            Matcher
+        };
+
+        //! Some models
+        static CAircraftModelList models(int number);
+
+        //! Script changing the aircraft ICAO code, logging the initial out object value
+        static QString changeIcaoScript();
+
+        QTemporaryDir m_dir;
+    };
+
+    CAircraftModelList CTestMatchingScript::models(int number)
+    {
+        static const QStringList icaos({ "B738", "A320", "A319", "C172", "B744", "E190" });
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            CAircraftModel model(QStringLiteral("Swift Model %1").arg(i), CAircraftModel::TypeNetwork);
+            model.setCallsign(CCallsign(QStringLiteral("SWF%1").arg(i)));
+            model.setAircraftIcaoCode(CAircraftIcaoCode(icaos[i % icaos.size()]));
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    QString CTestMatchingScript::changeIcaoScript()
+    {
+        return QStringLiteral(
+                   "(function() {\n"
+                   "  outObject.logMessage = outObject.aircraftIcao + ' ' + outObject.modified;\n"
+                   "  outObject.aircraftIcao = 'C172';\n"
+                   "  outObject.modified = true;\n"
+                   "  return outObject;\n"
+                   "})");
+    }
+
+    void CTestMatchingScript::reloadOnChange()
+    {
+        QVERIFY(m_dir.isValid());
+        const QString file = m_dir.filePath("reload.js");
+        QVERIFY(CFileUtils::writeStringToFile("(function() { return 'A'; })", file));
+
+        const CAircraftModel model = models(1).front();
+        CMatchingScriptRuntime runtime;
+        CMatchingScriptRuntime::resetStatistics();
+        QVERIFY(runtime.load(file));
+        QCOMPARE(runtime.run(model, model, {}).toString(), QString("A"));
+        QVERIFY(runtime.load(file));
+        QCOMPARE(runtime.run(model, model, {}).toString(), QString("A"));
+        QCOMPARE(CMatchingScriptRuntime::getStatistics().loads, Q_INT64_C(1));
+        QCOMPARE(CMatchingScriptRuntime::getStatistics().runs, Q_INT64_C(2));
+
+        // different size, so detected even with a coarse modification time
+        QVERIFY(CFileUtils::writeStringToFile("(function() { return 'BB'; })", file));
+        QVERIFY(runtime.load(file));
+        QCOMPARE(runtime.run(model, model, {}).toString(), QString("BB"));
+        QCOMPARE(CMatchingScriptRuntime::getStatistics().loads, Q_INT64_C(2));
+    }
+
+    void CTestMatchingScript::objectsInitialized()
+    {
+        QVERIFY(m_dir.isValid());
+        const QString file = m_dir.filePath("objects.js");
+        QVERIFY(CFileUtils::writeStringToFile(changeIcaoScript(), file));
+
+        CMatchingScriptRuntime runtime;
+        QVERIFY(runtime.load(file));
+        const CAircraftModelList list = models(6);
+        for (const CAircraftModel &model : list)
+        {
+            const QJSValue result = runtime.run(model, model, list);
+            QVERIFY(result.isQObject());
+            const MSInOutValues *out = qobject_cast<const MSInOutValues *>(result.toQObject());
+            QVERIFY(out);
+            QCOMPARE(out->getLogMessage(), model.getAircraftIcaoCodeDesignator() + " false");
+            QCOMPARE(out->getAircraftIcao(), QString("C172"));
+            QVERIFY(out->isModified());
+            QCOMPARE(out->getCallsign(), model.getCallsign().asString());
+        }
+    }
+
+    void CTestMatchingScript::scriptErrors()
+    {
+        QVERIFY(m_dir.isValid());
+        CMatchingScriptRuntime runtime;
+        QVERIFY(!runtime.load(m_dir.filePath("missing.js")));
+        QVERIFY(!runtime.getErrorString().isEmpty());
+
+        const QString file = m_dir.filePath("error.js");
+        QVERIFY(CFileUtils::writeStringToFile("(function() { return ", file));
+        QVERIFY(!runtime.load(file));
+        QVERIFY(!runtime.isLoaded());
+
+        QVERIFY(CFileUtils::writeStringToFile("'no function'", file));
+        QVERIFY(!runtime.load(file));
+
+        const CAircraftModel model = models(1).front();
+        QVERIFY(CFileUtils::writeStringToFile("(function() { return undefinedFunction(); })", file));
+        QVERIFY(runtime.load(file));
+        QVERIFY(runtime.run(model, model, {}).isError());
+    }
+
+    void CTestMatchingScript::benchmarkMatchings_data()
+    {
+        QTest::addColumn<int>("mode");
+        QTest::newRow("persistent runtime") << static_cast<int>(PersistentRuntime);
+        QTest::newRow("engine per matching") << static_cast<int>(EnginePerMatching);
+        QTest::newRow("matcher") << static_cast<int>(Matcher);
+    }
+
+    void CTestMatchingScript::benchmarkMatchings()
+    {
+        QFETCH(int, mode);
+        QVERIFY(m_dir.isValid());
+        const QString file = m_dir.filePath("benchmark.js");
+        QVERIFY(CFileUtils::writeStringToFile(changeIcaoScript(), file));
+        const CAircraftModelList list = models(1000);
+
+        CMatchingScriptRuntime runtime;
+        CAircraftMatcherSetup setup;
+        setup.setMsMatchingStageFile(file);
+        setup.setMsMatchingStageEnabled(true);
+        CAircraftMatcher matcher(setup);
+        matcher.setModelSet(list, CSimulatorInfo(CSimulatorInfo::XPLANE), true);
+        QBENCHMARK
+        {
+            int modified = 0;
+            matcher.clearMatchingStatistics();
+            for (const CAircraftModel &model : list)
+            {
+                if (mode == Matcher)
+                {
+                    // the matching stage script runs for every matching, the runs are checked with the statistics below
+                    const CAircraftModel matched = matcher.getClosestMatch(CSimulatedAircraft(model), MatchingLogNothing, nullptr, true);
+                    modified += matched.hasModelString();
+                    continue;
+                }
+
+                if (mode == PersistentRuntime)
+                {
+                    runtime.load(file);
+                    const QJSValue result = runtime.run(model, model, list);
+                    modified += qobject_cast<const MSInOutValues *>(result.toQObject())->isModified();
+                    continue;
+                }
+
+                // like the matcher did before the runtime
+                const QString js = CFileUtils::readFileToString(file);
+                QJSEngine engine;
+                MSInOutValues inObject(model);
+                MSInOutValues matchedObject(model);
+                matchedObject.evaluateChanges(model.getAircraftIcaoCode(), model.getAirlineIcaoCode());
+                MSInOutValues outObject(model);
+                MSModelSet modelSetObject(list);
+                modelSetObject.initByAircraftAndAirline(model.getAircraftIcaoCode(), model.getAirlineIcaoCode());
+                MSWebServices webServices;
+                for (QObject *object : { static_cast<QObject *>(&inObject), static_cast<QObject *>(&outObject), static_cast<QObject *>(&matchedObject), static_cast<QObject *>(&modelSetObject), static_cast<QObject *>(&webServices) })
+                {
+                    QJSEngine::setObjectOwnership(object, QJSEngine::CppOwnership);
+                }
+                engine.globalObject().setProperty("inObject", engine.newQObject(&inObject));
+                engine.globalObject().setProperty("outObject", engine.newQObject(&outObject));
+                engine.globalObject().setProperty("matchedObject", engine.newQObject(&matchedObject));
+                engine.globalObject().setProperty("modelSet", engine.newQObject(&modelSetObject));
+                engine.globalObject().setProperty("webServices", engine.newQObject(&webServices));
+                const QJSValue result = engine.evaluate(js, file).call();
+                modified += qobject_cast<const MSInOutValues *>(result.toQObject())->isModified();
+            }
+            QCOMPARE(modified, list.size());
+            if (mode == Matcher)
+            {
+                // the script cost is measured per matching
+                const MatchingScriptStatistics statistics = matcher.getMatchingScriptStatistics();
+                QCOMPARE(statistics.matchings, static_cast<qint64>(list.size()));
+                QCOMPARE(statistics.runs, static_cast<qint64>(list.size()));
+                QVERIFY(statistics.loads <= 1);
+                QVERIFY(statistics.totalNs > 0);
+                QVERIFY(statistics.maxNs <= statistics.totalNs);
+                qDebug() << statistics.toQString();
+            }
+        }
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackCoreTest::CTestMatchingScript);
+
+#include "testmatchingscript.moc"
+
+//! \endcond
@@ -2,3 +2,6 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     testguiutility \
+    testlistview \
+    testmodelfilter \
+    testmodelsort \
@@ -0,0 +1,212 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/aircraftmodellistmodel.h"
+#include "blackgui/views/aircraftmodelview.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/propertyindexvariantmap.h"
+#include "test.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QScrollBar>
+#include <QSet>
+#include <QTableView>
+#include <QTest>
+#include <QVector>
+#include <algorithm>
+#include <numeric>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackGui::Models;
+using namespace BlackGui::Views;
+
+namespace BlackGuiTest
+{
+    //! Test list models displayed in views
+    class CTestListView : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Cached cell data are updated with the model
+        void displayCache();
+
+        //! Cached cell data are updated for all updated selected rows
+        void displayCacheUpdateSelected();
+
+        //! Scroll through a large view
+        void benchmarkScroll_data();
+
+        //! Scroll through a large view
+        void benchmarkScroll();
+
+    private:
+        //! Some models
+        static CAircraftModelList models(int number);
+    };
+
+    CAircraftModelList CTestListView::models(int number)
+    {
+        static const QStringList icaos({ "B738", "A320", "A319", "C172", "B744", "E190" });
+        static const QStringList distributors({ "FSX", "PMDG", "AEROSOFT", "WOAI" });
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            CAircraftModel model(QStringLiteral("Swift Model %1").arg(i), CAircraftModel::TypeDatabaseEntry);
+            model.setAircraftIcaoCode(CAircraftIcaoCode(icaos[i % icaos.size()]));
+            model.setDistributor(CDistributor(distributors[i % distributors.size()]));
+            model.setDescription(QStringLiteral("Description %1").arg(i));
+            model.setDbKey(i);
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    void CTestListView::displayCache()
+    {
+        CAircraftModelListModel model(CAircraftModelListModel::Database);
+        model.setNoSorting();
+        model.update(models(100), false);
+        const int column = model.propertyIndexToColumn(CAircraftModel::IndexDescription);
+        QVERIFY(column >= 0);
+
+        QCOMPARE(model.data(model.index(5, column), Qt::DisplayRole).toString(), QString("Description 5"));
+        QCOMPARE(model.data(model.index(6, column), Qt::DisplayRole).toString(), QString("Description 6"));
+        QCOMPARE(model.getDisplayCacheRows(), 2);
+
+        // single row changed
+        CAircraftModel changed = model.container()[5];
+        changed.setDescription("changed");
+        model.update(5, changed);
+        QCOMPARE(model.data(model.index(5, column), Qt::DisplayRole).toString(), QString("changed"));
+        QCOMPARE(model.data(model.index(6, column), Qt::DisplayRole).toString(), QString("Description 6"));
+
+        // row inserted in front
+        model.insert(CAircraftModel("inserted", CAircraftModel::TypeDatabaseEntry));
+        QCOMPARE(model.data(model.index(6, column), Qt::DisplayRole).toString(), QString("changed"));
+
+        // new container
+        model.update(models(10), false);
+        QCOMPARE(model.data(model.index(5, column), Qt::DisplayRole).toString(), QString("Description 5"));
+
+        // bounded
+        model.update(models(100), false);
+        model.setDisplayCacheMaxRows(20);
+        for (int row = 0; row < 100; ++row) { model.data(model.index(row, column), Qt::DisplayRole); }
+        QVERIFY(model.getDisplayCacheRows() <= 20);
+        QCOMPARE(model.data(model.index(99, column), Qt::DisplayRole).toString(), QString("Description 99"));
+
+        // disabled
+        model.setDisplayCacheMaxRows(0);
+        model.data(model.index(1, column), Qt::DisplayRole);
+        QCOMPARE(model.getDisplayCacheRows(), 0);
+    }
+
+    void CTestListView::displayCacheUpdateSelected()
+    {
+        CAircraftModelView view;
+        CAircraftModelListModel *model = view.derivedModel();
+        model->setNoSorting();
+        model->update(models(20), false);
+        const int column = model->propertyIndexToColumn(CAircraftModel::IndexDescription);
+        QVERIFY(column >= 0);
+
+        // cache the rows
+        for (int row = 0; row < 20; ++row) { model->data(model->index(row, column), Qt::DisplayRole); }
+        QCOMPARE(model->data(model->index(10, column), Qt::DisplayRole).toString(), QString("Description 10"));
+
+        // non adjacent rows, selected in reverse order
+        view.selectRows(QSet<int>({ 10, 3 }));
+        CPropertyIndexVariantMap vm;
+        vm.addValue(CAircraftModel::IndexDescription, CVariant::from(QString("updated")));
+        QCOMPARE(view.updateSelected(vm), 2);
+
+        QCOMPARE(model->data(model->index(3, column), Qt::DisplayRole).toString(), QString("updated"));
+        QCOMPARE(model->data(model->index(10, column), Qt::DisplayRole).toString(), QString("updated"));
+        QCOMPARE(model->data(model->index(5, column), Qt::DisplayRole).toString(), QString("Description 5"));
+    }
+
+    void CTestListView::benchmarkScroll_data()
+    {
+        QTest::addColumn<int>("maxCachedRows");
+        QTest::newRow("no cache") << 0;
+        QTest::newRow("cache") << static_cast<int>(CListModelDisplayCache::DefaultMaxRows);
+    }
+
+    void CTestListView::benchmarkScroll()
+    {
+        QFETCH(int, maxCachedRows);
+
+        CAircraftModelListModel model(CAircraftModelListModel::Database);
+        model.setNoSorting();
+        model.update(models(50000), false);
+        model.setDisplayCacheMaxRows(maxCachedRows);
+
+        QTableView view;
+        view.setModel(&model);
+        view.resize(1600, 900);
+        view.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+        // scroll by a quarter page down and up again, like with the mouse wheel
+        QScrollBar *scrollBar = view.verticalScrollBar();
+        const int step = qMax(1, scrollBar->pageStep() / 4);
+        const int frames = 400;
+        QVector<qint64> frameTimesNs;
+        frameTimesNs.reserve(2 * frames);
+        QElapsedTimer timer;
+        QBENCHMARK
+        {
+            for (int frame = 0; frame < 2 * frames; ++frame)
+            {
+                const int position = frame < frames ? frame * step : (2 * frames - frame) * step;
+                timer.start();
+                scrollBar->setValue(position);
+                view.viewport()->repaint();
+                frameTimesNs.push_back(timer.nsecsElapsed());
+            }
+        }
+
+        std::sort(frameTimesNs.begin(), frameTimesNs.end());
+        const double averageMs = std::accumulate(frameTimesNs.cbegin(), frameTimesNs.cend(), 0.0) / frameTimesNs.size() / 1e6;
+        const double p95Ms = frameTimesNs[frameTimesNs.size() * 95 / 100] / 1e6;
+        const double maxMs = frameTimesNs.back() / 1e6;
+        qInfo("%s: %d frames, average %.2fms, 95%% %.2fms, max %.2fms", QTest::currentDataTag(), frameTimesNs.size(), averageMs, p95Ms, maxMs);
+        QVERIFY(maxCachedRows == 0 || model.getDisplayCacheRows() > 0);
+    }
+} // ns
+
+//! main, views need a QApplication, headless with the offscreen platform
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) { qputenv("QT_QPA_PLATFORM", "offscreen"); }
+    try
+    {
+        QApplication app(argc, argv);
+        BLACKTEST_INIT(BlackGuiTest::CTestListView)
+        return QTest::qExec(&to, args);
+    }
+    catch (...)
+    {
+        return EXIT_FAILURE;
+    }
+}
+
+#include "testlistview.moc"
+
+//! \endcond
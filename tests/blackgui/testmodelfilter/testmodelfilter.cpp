@@ -0,0 +1,186 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/aircraftmodelfilter.h"
+#include "blackgui/models/aircraftmodellistmodel.h"
+#include "blackgui/models/filterstringindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/db/datastore.h"
+#include "test.h"
+
+#include <QTest>
+#include <QVector>
+#include <memory>
+#include <utility>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackGui::Models;
+
+namespace BlackGuiTest
+{
+    //! Test filtering of list models
+    class CTestModelFilter : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Narrowing filter expressions
+        void narrowingExpression();
+
+        //! Rows found by the index pass the filter like all rows
+        void indexCandidates_data();
+
+        //! Rows found by the index pass the filter like all rows
+        void indexCandidates();
+
+        //! Larger models are filtered in background
+        void asyncFilter();
+
+    private:
+        //! Some models
+        static CAircraftModelList models(int number);
+
+        //! Filter by model string and aircraft ICAO
+        static std::unique_ptr<CAircraftModelFilter> modelFilter(const QString &modelKey, const QString &aircraftIcao = {});
+    };
+
+    CAircraftModelList CTestModelFilter::models(int number)
+    {
+        static const QStringList icaos({ "B738", "A320", "A319", "C172", "B744", "E190" });
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            CAircraftModel model(QStringLiteral("Swift Model %1").arg(i), CAircraftModel::TypeDatabaseEntry);
+            model.setAircraftIcaoCode(CAircraftIcaoCode(icaos[i % icaos.size()]));
+            model.setDescription(QStringLiteral("Description %1").arg(i));
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    std::unique_ptr<CAircraftModelFilter> CTestModelFilter::modelFilter(const QString &modelKey, const QString &aircraftIcao)
+    {
+        return std::make_unique<CAircraftModelFilter>(-1, modelKey, QString(), CAircraftModel::All, Db::All,
+                Qt::PartiallyChecked, Qt::PartiallyChecked, aircraftIcao, QString(), QString(), QString(), QString(), QString(), QString());
+    }
+
+    void CTestModelFilter::narrowingExpression()
+    {
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("*MODEL 12*", ""));
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("*MODEL 12*", "*MODEL 1*"));
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("SWIFT MODEL 12*", "*MODEL 1*"));
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("SWIFT MODEL 12*", "swift*"));
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("*L 12", "*12"));
+        QVERIFY(CFilterStringIndex::isNarrowingExpression("SWIFT MODEL 12", "SWIFT MODEL 1*"));
+        QVERIFY(!CFilterStringIndex::isNarrowingExpression("*MODEL 1*", "*MODEL 12*"));
+        QVERIFY(!CFilterStringIndex::isNarrowingExpression("SWIFT*", "*MODEL*"));
+        QVERIFY(!CFilterStringIndex::isNarrowingExpression("SWIFT MODEL 12", "SWIFT MODEL 1"));
+        QVERIFY(!CFilterStringIndex::isNarrowingExpression("", "SWIFT*"));
+        QVERIFY(!CFilterStringIndex::isNarrowingExpression("S*12", "S*1"));
+
+        const auto previous = modelFilter("*MODEL 1*");
+        QVERIFY(modelFilter("*MODEL 12*")->isNarrowing(*previous));
+        QVERIFY(modelFilter("*MODEL 12*", "B7*")->isNarrowing(*previous));
+        QVERIFY(!modelFilter("*MODEL*")->isNarrowing(*previous));
+    }
+
+    void CTestModelFilter::indexCandidates_data()
+    {
+        QTest::addColumn<QString>("modelKey");
+        QTest::addColumn<QString>("aircraftIcao");
+        QTest::addColumn<bool>("indexed");
+
+        QTest::newRow("contains")     << "*model 12*"       << ""     << true;
+        QTest::newRow("starts with")  << "swift model 77*"  << ""     << true;
+        QTest::newRow("ends with")    << "*del 99"          << ""     << true;
+        QTest::newRow("exact")        << "Swift Model 1234" << ""     << true;
+        QTest::newRow("no match")     << "*xyz*"            << ""     << true;
+        QTest::newRow("two fields")   << "*model 1*"        << "B7*"  << true;
+        QTest::newRow("short")        << "*12*"             << ""     << false;
+        QTest::newRow("wildcard")     << "swift*12"         << ""     << false;
+        QTest::newRow("short field")  << "*model 4*"        << "A3*"  << true;
+    }
+
+    void CTestModelFilter::indexCandidates()
+    {
+        QFETCH(QString, modelKey);
+        QFETCH(QString, aircraftIcao);
+        QFETCH(bool, indexed);
+
+        const CAircraftModelList list = models(5000);
+        const auto filter = modelFilter(modelKey, aircraftIcao);
+        const auto index = filter->createIndex(list);
+        QVERIFY(index);
+        QCOMPARE(index->rows(), list.size());
+
+        QVector<int> rows;
+        QCOMPARE(filter->candidateRows(*index, rows), indexed);
+        if (!indexed) { return; }
+
+        CAircraftModelList candidates;
+        for (int row : std::as_const(rows)) { candidates.push_back(list[row]); }
+        QVERIFY(candidates.size() <= list.size());
+        QCOMPARE(filter->filter(candidates), filter->filter(list));
+    }
+
+    void CTestModelFilter::asyncFilter()
+    {
+        CAircraftModelListModel model(CAircraftModelListModel::Database);
+        model.setNoSorting();
+        const CAircraftModelList list = models(5000);
+        model.update(list, false);
+        QCOMPARE(model.rowCount(), list.size());
+
+        // full container
+        std::unique_ptr<IModelFilter<CAircraftModelList>> filter = modelFilter("*model 12*");
+        const int expected1 = filter->filter(list).size();
+        model.takeFilterOwnership(filter);
+        QTRY_COMPARE(model.rowCount(), expected1);
+        QVERIFY(model.hasFilter());
+
+        // narrowing, only the previous result is filtered
+        filter = modelFilter("*model 123*");
+        const int expected2 = filter->filter(list).size();
+        model.takeFilterOwnership(filter);
+        QTRY_COMPARE(model.rowCount(), expected2);
+
+        // container changed while filtering, filtered again
+        const CAircraftModelList list2 = models(3000);
+        filter = modelFilter("swift model 2*");
+        const int expected3 = filter->filter(list2).size();
+        model.takeFilterOwnership(filter);
+        model.update(list2, false);
+        QTRY_COMPARE(model.rowCount(), expected3);
+        QTest::qWait(100);
+        QCOMPARE(model.rowCount(), expected3);
+
+        // removed filter, pending results are discarded
+        filter = modelFilter("*model 7*");
+        model.takeFilterOwnership(filter);
+        model.removeFilter();
+        QCOMPARE(model.rowCount(), list2.size());
+        QTest::qWait(100);
+        QCOMPARE(model.rowCount(), list2.size());
+        QVERIFY(!model.hasFilter());
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestModelFilter);
+
+#include "testmodelfilter.moc"
+
+//! \endcond
@@ -0,0 +1,176 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackgui
+
+#include "blackgui/models/aircraftmodellistmodel.h"
+#include "blackgui/models/listmodelsortkeys.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/aircraftmodel.h"
+#include "blackmisc/simulation/distributor.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/propertyindexlist.h"
+#include "test.h"
+
+#include <QTest>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+using namespace BlackGui::Models;
+
+namespace BlackGuiTest
+{
+    //! Test sorting of list models
+    class CTestModelSort : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Sort keys of a container
+        void sortKeys();
+
+        //! All columns of the aircraft model list model sorted like by comparePropertyByIndex
+        void sortAircraftModels();
+
+        //! Sort a larger model set by several columns
+        void benchmarkSortAircraftModels_data();
+
+        //! Sort a larger model set by several columns
+        void benchmarkSortAircraftModels();
+
+    private:
+        //! Some models with mixed case strings and duplicates
+        static CAircraftModelList models(int number);
+
+        //! Indexes of some columns of the DB model view
+        static CPropertyIndexList sortIndexes();
+    };
+
+    CAircraftModelList CTestModelSort::models(int number)
+    {
+        static const QStringList icaos({ "B738", "A320", "A319", "C172", "B744", "E190" });
+        static const QStringList distributors({ "FSX", "PMDG", "AEROSOFT", "WOAI" });
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            const int j = (i * 7919) % number; // not already sorted
+            CAircraftModel model(QStringLiteral("%1 Model %2").arg(j % 2 ? "swift" : "Swift").arg(j), CAircraftModel::TypeOwnSimulatorModel);
+            model.setAircraftIcaoCode(CAircraftIcaoCode(icaos[j % icaos.size()]));
+            model.setDistributor(CDistributor(distributors[j % distributors.size()]));
+            model.setDescription(QStringLiteral("Description %1").arg(j % 100));
+            model.setFileTimestamp(1600000000000 + (j % 1000) * 1000);
+            model.setDbKey(j % 3 ? j : -1);
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    CPropertyIndexList CTestModelSort::sortIndexes()
+    {
+        return
+        {
+            CPropertyIndex(CAircraftModel::IndexDbIntegerKey),
+            CPropertyIndex(CAircraftModel::IndexAllModelStrings),
+            CPropertyIndex({ CAircraftModel::IndexDistributor, CDistributor::IndexDbStringKey }),
+            CPropertyIndex(CAircraftModel::IndexDescription),
+            CPropertyIndex({ CAircraftModel::IndexAircraftIcaoCode, CAircraftIcaoCode::IndexAircraftDesignator })
+        };
+    }
+
+    void CTestModelSort::sortKeys()
+    {
+        const CAircraftModelList list = models(10);
+        const CPropertyIndexList indexes { CPropertyIndex(CAircraftModel::IndexModelString) };
+        const CListModelSortKeys caseInsensitive = CListModelSortKeys::fromContainer(list, indexes, true);
+        const CListModelSortKeys caseSensitive = CListModelSortKeys::fromContainer(list, indexes, false);
+        QCOMPARE(caseInsensitive.rows(), 10);
+        QCOMPARE(caseInsensitive.columns(), 1);
+
+        for (int a = 0; a < list.size(); ++a)
+        {
+            for (int b = 0; b < list.size(); ++b)
+            {
+                const QString &sa = list[a].getModelString();
+                const QString &sb = list[b].getModelString();
+                QCOMPARE(qBound(-1, caseInsensitive.compare(a, b), 1), qBound(-1, sa.compare(sb, Qt::CaseInsensitive), 1));
+                QCOMPARE(qBound(-1, caseSensitive.compare(a, b), 1), qBound(-1, sa.compare(sb), 1));
+            }
+        }
+
+        // stable, tie breaker
+        const CPropertyIndexList icaoAndKey { CPropertyIndex({ CAircraftModel::IndexAircraftIcaoCode, CAircraftIcaoCode::IndexAircraftDesignator }),
+                                              CPropertyIndex(CAircraftModel::IndexDbIntegerKey) };
+        const QVector<int> rows = CListModelSortKeys::fromContainer(list, icaoAndKey, true).sortedRows(Qt::DescendingOrder);
+        QCOMPARE(rows.size(), list.size());
+        for (int i = 1; i < rows.size(); ++i)
+        {
+            const CAircraftModel &m1 = list[rows[i - 1]];
+            const CAircraftModel &m2 = list[rows[i]];
+            const int c = m1.getAircraftIcaoCodeDesignator().compare(m2.getAircraftIcaoCodeDesignator());
+            QVERIFY(c >= 0);
+            if (c == 0) { QVERIFY(m1.getDbKey() >= m2.getDbKey()); }
+            if (c == 0 && m1.getDbKey() == m2.getDbKey()) { QVERIFY(rows[i - 1] < rows[i]); }
+        }
+    }
+
+    void CTestModelSort::sortAircraftModels()
+    {
+        const CAircraftModelList list = models(200);
+        const CAircraftModelListModel model(CAircraftModelListModel::Database);
+        for (const CPropertyIndex &index : sortIndexes())
+        {
+            const int column = model.propertyIndexToColumn(index);
+            QVERIFY(column >= 0);
+            for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder })
+            {
+                const CAircraftModelList sorted = model.sortContainerByColumn(list, column, order);
+                QCOMPARE(sorted.size(), list.size());
+                for (int i = 1; i < sorted.size(); ++i)
+                {
+                    const int c = sorted[i - 1].comparePropertyByIndex(index, sorted[i]);
+                    QVERIFY2(order == Qt::AscendingOrder ? c <= 0 : c >= 0, qPrintable(index.toQString()));
+                }
+            }
+        }
+    }
+
+    void CTestModelSort::benchmarkSortAircraftModels_data()
+    {
+        QTest::addColumn<CPropertyIndex>("index");
+        for (const CPropertyIndex &index : sortIndexes())
+        {
+            QTest::newRow(qPrintable(index.toQString())) << index;
+        }
+    }
+
+    void CTestModelSort::benchmarkSortAircraftModels()
+    {
+        QFETCH(CPropertyIndex, index);
+        const CAircraftModelList list = models(20000);
+        const CAircraftModelListModel model(CAircraftModelListModel::Database);
+        const int column = model.propertyIndexToColumn(index);
+        QVERIFY(column >= 0);
+
+        CAircraftModelList sorted;
+        QBENCHMARK
+        {
+            sorted = model.sortContainerByColumn(list, column, Qt::AscendingOrder);
+        }
+        QCOMPARE(sorted.size(), list.size());
+    }
+} // ns
+
+//! main
+BLACKTEST_MAIN(BlackGuiTest::CTestModelSort);
+
+#include "testmodelsort.moc"
+
+//! \endcond
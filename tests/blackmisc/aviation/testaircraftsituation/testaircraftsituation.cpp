@@ -13,6 +13,8 @@
 #include "blackconfig/buildconfig.h"
 #include "blackmisc/aviation/aircraftsituationchange.h"
 #include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/aircraftsituationringbuffer.h"
+#include "blackmisc/aviation/compactaircraftsituation.h"
 #include "blackmisc/network/fsdsetup.h"
 #include "blackmisc/cputime.h"
 // #include "blackmisc/math/mathutils.h"
@@ -23,6 +25,7 @@
 #include <QTimer>
 #include <QDateTime>
 #include <QDebug>
+#include <cstring>
 
 using namespace BlackConfig;
 using namespace BlackMisc;
@@ -64,6 +67,30 @@ namespace BlackMiscTest
         //! Using sort hint
         void sortHint();
 
+        //! Ring buffer keeps the same situations as the list
+        void ringBufferSameAsList();
+
+        //! Ring buffer with situations out of order
+        void ringBufferOutOfOrder();
+
+        //! Change calculated from the ring buffer same as from the list
+        void ringBufferChangeSameAsList();
+
+        //! Adding situations to the history, list vs. ring buffer
+        void benchmarkHistory_data();
+
+        //! Adding situations to the history, list vs. ring buffer
+        void benchmarkHistory();
+
+        //! Compact situation converted back is the same situation
+        void compactSituation();
+
+        //! Copying the situations of 500 aircraft, value objects vs. compact situations
+        void benchmarkCompactCopy_data();
+
+        //! Copying the situations of 500 aircraft, value objects vs. compact situations
+        void benchmarkCompactCopy();
+
     private:
         //! Test situations (ascending)
         static BlackMisc::Aviation::CAircraftSituationList testSituations();
@@ -303,6 +330,250 @@ namespace BlackMiscTest
         }
     }
 
+    void CTestAircraftSituation::ringBufferSameAsList()
+    {
+        constexpr int Capacity = 6;
+        const CAircraftSituationList situations = testSituations().reversed(); // oldest first, incoming order
+
+        CAircraftSituationList list;
+        CAircraftSituationRingBuffer ring(Capacity);
+        QVERIFY(ring.isEmpty());
+        QCOMPARE(ring.capacity(), Capacity);
+        for (const CAircraftSituation &situation : std::as_const(situations))
+        {
+            list.push_frontKeepLatestFirstAdjustOffset(situation, true, Capacity);
+            ring.push_frontKeepLatestFirstAdjustOffset(situation, true);
+            QCOMPARE(ring.size(), list.size());
+            QCOMPARE(ring.toList(), list);
+        }
+
+        QVERIFY(ring.isFull());
+        QVERIFY(ring.isSortedLatestFirst());
+        QVERIFY(ring.isSortedAdjustedLatestFirst());
+        QCOMPARE(ring.front(), list.front());
+        QCOMPARE(ring.back(), list.back());
+        QVERIFY(ring.indexOrNull(Capacity).isNull());
+
+        const qint64 middle = list[2].getAdjustedMSecsSinceEpoch();
+        QCOMPARE(ring.findObjectBeforeAdjustedOrDefault(middle), list.findObjectBeforeAdjustedOrDefault(middle));
+        QCOMPARE(ring.findObjectAfterAdjustedOrDefault(middle), list.findObjectAfterAdjustedOrDefault(middle));
+
+        // same timestamp replaces the latest situation
+        CAircraftSituation latest = ring.front();
+        latest.setAltitude(CAltitude(1, CAltitude::MeanSeaLevel, CLengthUnit::m()));
+        ring.push_frontKeepLatestFirstAdjustOffset(latest, true);
+        QCOMPARE(ring.size(), Capacity);
+        QCOMPARE(ring.front().getAltitude(), latest.getAltitude());
+
+        // prefill
+        ring.prefillLatestAdjustedFirst(situations.front(), Capacity);
+        list.prefillLatestAdjustedFirst(situations.front(), Capacity);
+        QCOMPARE(ring.toList(), list);
+
+        ring.assignLatestFirst(list);
+        QCOMPARE(ring.toList(), list);
+        ring.clear();
+        QVERIFY(ring.isEmpty());
+        QVERIFY(ring.frontOrNull().isNull());
+    }
+
+    void CTestAircraftSituation::ringBufferOutOfOrder()
+    {
+        constexpr int Capacity = 4;
+        const CAircraftSituationList situations = testSituations(); // latest first
+        CAircraftSituationRingBuffer ring(Capacity);
+        ring.push_frontKeepLatestFirstAdjustOffset(situations[0], true);
+        ring.push_frontKeepLatestFirstAdjustOffset(situations[3], true);
+        ring.push_frontKeepLatestFirstAdjustOffset(situations[1], true);
+        ring.push_frontKeepLatestFirstAdjustOffset(situations[2], true);
+        QVERIFY(ring.isFull());
+        QVERIFY(ring.isSortedLatestFirst());
+        QCOMPARE(ring.front().getMSecsSinceEpoch(), situations[0].getMSecsSinceEpoch());
+        QCOMPARE(ring.back().getMSecsSinceEpoch(), situations[3].getMSecsSinceEpoch());
+
+        // full, older situation drops the oldest
+        ring.push_frontKeepLatestFirstAdjustOffset(situations[5], true);
+        QCOMPARE(ring.size(), Capacity);
+        QVERIFY(ring.isSortedLatestFirst());
+        QCOMPARE(ring.back().getMSecsSinceEpoch(), situations[5].getMSecsSinceEpoch());
+        QCOMPARE(ring[2].getMSecsSinceEpoch(), situations[2].getMSecsSinceEpoch());
+
+        // and a newer one overwrites the oldest
+        CAircraftSituation newer(situations[0]);
+        newer.addMsecs(CFsdSetup::c_positionTimeOffsetMsec);
+        ring.push_frontKeepLatestFirstAdjustOffset(newer, true);
+        QCOMPARE(ring.size(), Capacity);
+        QCOMPARE(ring.front().getMSecsSinceEpoch(), newer.getMSecsSinceEpoch());
+        QCOMPARE(ring.back().getMSecsSinceEpoch(), situations[2].getMSecsSinceEpoch());
+        QVERIFY(ring.isSortedAdjustedLatestFirst());
+    }
+
+    void CTestAircraftSituation::ringBufferChangeSameAsList()
+    {
+        CAircraftSituationList onGround = testSituations();
+        onGround.setOnGround(CAircraftSituation::OnGround);
+        CAircraftSituationList takeOff = onGround;
+        CAircraftSituation f = takeOff.front();
+        f.setOnGround(false);
+        takeOff.pop_front();
+        takeOff.push_front(f);
+        CAircraftSituationList rotateUp = testSetRotateUpPitch(testSituations());
+        f = rotateUp.front();
+        f.setPitch(CAngle(7.3, CAngleUnit::deg()));
+        rotateUp.pop_front();
+        rotateUp.push_front(f);
+
+        for (const CAircraftSituationList &situations : { testSituations(), testSetDescendingAltitudes(testSituations()), onGround, takeOff, rotateUp })
+        {
+            CAircraftSituationRingBuffer ring(situations.size());
+            ring.assignLatestFirst(situations);
+            for (bool calcStdDeviations : { false, true })
+            {
+                const CAircraftSituationChange fromList(ring.toList(), cg(), false, true, calcStdDeviations);
+                const CAircraftSituationChange fromRing(ring, cg(), false, calcStdDeviations);
+                QCOMPARE(fromRing, fromList);
+            }
+        }
+    }
+
+    void CTestAircraftSituation::benchmarkHistory_data()
+    {
+        QTest::addColumn<bool>("useRingBuffer");
+        QTest::newRow("list") << false;
+        QTest::newRow("ring buffer") << true;
+    }
+
+    void CTestAircraftSituation::benchmarkHistory()
+    {
+        QFETCH(bool, useRingBuffer);
+        constexpr int Capacity = 50; // like IRemoteAircraftProvider::MaxSituationsPerCallsign
+        CAircraftSituation situation = testSituations().back();
+        CAircraftSituationList list;
+        CAircraftSituationRingBuffer ring(Capacity);
+        list.prefillLatestAdjustedFirst(situation, Capacity);
+        ring.prefillLatestAdjustedFirst(situation, Capacity);
+
+        QBENCHMARK
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                situation.addMsecs(CFsdSetup::c_positionTimeOffsetMsec);
+                if (useRingBuffer)
+                {
+                    ring.push_frontKeepLatestFirstAdjustOffset(situation, true);
+                    ring.transferElevationForward();
+                }
+                else
+                {
+                    list.push_frontKeepLatestFirstAdjustOffset(situation, true, Capacity);
+                    list.transferElevationForward();
+                }
+            }
+        }
+        QVERIFY(useRingBuffer ? ring.isFull() : list.size() == Capacity);
+    }
+
+    void CTestAircraftSituation::compactSituation()
+    {
+        QCOMPARE(CCompactAircraftSituation().toSituation(), CAircraftSituation());
+        QCOMPARE(CCompactAircraftSituation::fromSituation(CAircraftSituation::null()).toSituation(), CAircraftSituation::null());
+
+        CAircraftSituation situation = testSituations().front();
+        situation.setCallsign("DLH123");
+        situation.setHeading(CHeading(270.5, CHeading::Magnetic, CAngleUnit::deg()));
+        situation.setPitch(CAngle(0.05, CAngleUnit::rad()));
+        situation.setBank(CAngle(-3, CAngleUnit::deg()));
+        situation.setGroundSpeed(CSpeed(120, CSpeedUnit::m_s()));
+        situation.setPressureAltitude(CAltitude(9900, CAltitude::MeanSeaLevel, CAltitude::PressureAltitude, CLengthUnit::ft()));
+        situation.setCG(cg());
+        situation.setSceneryOffset(CLength(1.5, CLengthUnit::m()));
+        situation.setVelocity(CAircraftVelocity(10, 1, -2, CSpeedUnit::m_s(), 1, 0.5, -0.5, CAngleUnit::deg(), CTimeUnit::s()));
+        situation.setGroundElevation(CElevationPlane(situation, 500.0, CElevationPlane::singlePointRadius()), CAircraftSituation::FromProvider, true);
+        situation.setOnGround(CAircraftSituation::OnGround, CAircraftSituation::InFromNetwork);
+        situation.setOnGroundFactor(1.0);
+        situation.setInterimFlag(true);
+
+        const CCompactAircraftSituation compact = CCompactAircraftSituation::fromSituation(situation);
+        QCOMPARE(compact.toSituation(), situation);
+        QCOMPARE(compact.getCallsign(), situation.getCallsign());
+        QCOMPARE(compact.getAdjustedMSecsSinceEpoch(), situation.getAdjustedMSecsSinceEpoch());
+
+        // plain memory
+        CCompactAircraftSituation copy;
+        std::memcpy(&copy, &compact, sizeof(CCompactAircraftSituation));
+        QCOMPARE(copy.toSituation(), situation);
+
+        // interned callsigns
+        const CInternedCallsigns::Handle handle = CInternedCallsigns::handle(CCallsign("DLH123"));
+        QCOMPARE(compact.callsign, handle);
+        QCOMPARE(CInternedCallsigns::find(CCallsign("dlh123")), handle);
+        QCOMPARE(CInternedCallsigns::find(CCallsign()), CInternedCallsigns::InvalidHandle);
+        QCOMPARE(CInternedCallsigns::find(CCallsign("NEVERSEEN")), CInternedCallsigns::InvalidHandle);
+        QCOMPARE(CInternedCallsigns::callsign(handle), CCallsign("DLH123"));
+
+        // list
+        const CAircraftSituationList situations = testSituations();
+        const CCompactAircraftSituationList compactSituations(situations);
+        QCOMPARE(compactSituations.size(), situations.sizeInt());
+        QCOMPARE(compactSituations.toList(), situations);
+        QVERIFY(compactSituations.isSortedAdjustedLatestFirstWithoutNullPositions());
+        const qint64 middle = situations[4].getAdjustedMSecsSinceEpoch();
+        QCOMPARE(compactSituations.findObjectBeforeAdjustedOrDefault(middle), situations.findObjectBeforeAdjustedOrDefault(middle));
+    }
+
+    void CTestAircraftSituation::benchmarkCompactCopy_data()
+    {
+        QTest::addColumn<bool>("useCompact");
+        QTest::newRow("value objects") << false;
+        QTest::newRow("compact") << true;
+    }
+
+    void CTestAircraftSituation::benchmarkCompactCopy()
+    {
+        QFETCH(bool, useCompact);
+        constexpr int Aircraft = 500;
+        constexpr int Capacity = 50; // like IRemoteAircraftProvider::MaxSituationsPerCallsign
+
+        // histories of all aircraft, like in the remote aircraft provider
+        QVector<CAircraftSituationList> lists;
+        QVector<CCompactAircraftSituationList> compactLists;
+        for (int a = 0; a < Aircraft; ++a)
+        {
+            CAircraftSituation situation = testSituations().front();
+            situation.setCallsign(CCallsign(QStringLiteral("SWIFT%1").arg(a)));
+            CAircraftSituationList list;
+            list.prefillLatestAdjustedFirst(situation, Capacity);
+            lists.push_back(list);
+            compactLists.push_back(CCompactAircraftSituationList(list));
+        }
+        qDebug() << "Bytes per situation, value object (without heap):" << sizeof(CAircraftSituation) << "compact:" << sizeof(CCompactAircraftSituation);
+        qDebug() << "Bytes of" << Aircraft << "x" << Capacity << "compact situations:" << Aircraft * Capacity * sizeof(CCompactAircraftSituation);
+
+        // deep copies, like taking a snapshot of the histories for the interpolators
+        int copied = 0;
+        QBENCHMARK
+        {
+            copied = 0;
+            for (int a = 0; a < Aircraft; ++a)
+            {
+                if (useCompact)
+                {
+                    CCompactAircraftSituationList copy;
+                    copy.reserve(Capacity);
+                    for (const CCompactAircraftSituation &situation : compactLists[a]) { copy.push_back(situation); }
+                    copied += copy.size();
+                }
+                else
+                {
+                    CAircraftSituationList copy;
+                    for (const CAircraftSituation &situation : lists[a]) { copy.push_back(situation); }
+                    copied += copy.size();
+                }
+            }
+        }
+        QCOMPARE(copied, Aircraft * Capacity);
+    }
+
     CAircraftSituationList CTestAircraftSituation::testSituations()
     {
         // "Kugaaruk Airport","Pelly Bay","Canada","YBB","CYBB",68.534401,-89.808098,56,-7,"A","America/Edmonton","airport","OurAirports"
@@ -17,10 +17,13 @@
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/callsign.h"
 #include "blackmisc/aviation/callsignset.h"
+#include "blackmisc/aviation/callsigntimeouts.h"
 #include "blackmisc/aviation/comsystem.h"
+#include "blackmisc/aviation/internedcallsigns.h"
 #include "blackmisc/aviation/heading.h"
 #include "blackmisc/aviation/informationmessage.h"
 #include "blackmisc/aviation/navsystem.h"
+#include "blackmisc/aviation/percallsign.h"
 #include "blackmisc/aviation/transponder.h"
 #include "blackmisc/mixin/mixincompare.h"
 #include "blackmisc/geo/coordinategeodetic.h"
@@ -35,7 +38,10 @@
 #include "blackmisc/pq/units.h"
 #include "test.h"
 
+#include <QByteArray>
+#include <QDataStream>
 #include <QDateTime>
+#include <QHash>
 #include <QString>
 #include <QTest>
 
@@ -67,6 +73,21 @@ namespace BlackMiscTest
         //! Callsigns and callsign containers
         void callsignWithContainers();
 
+        //! Interned callsign handles
+        void callsignHandles();
+
+        //! Values per callsign
+        void perCallsign();
+
+        //! Callsign timeouts
+        void callsignTimeouts();
+
+        //! Watchdog like access to timestamps per callsign, QHash vs. CPerCallsign vs. CCallsignTimeouts
+        void benchmarkWatchdog_data();
+
+        //! Watchdog like access to timestamps per callsign, QHash vs. CPerCallsign vs. CCallsignTimeouts
+        void benchmarkWatchdog();
+
         //! Testing copying and equality of objects
         void copyAndEqual();
 
@@ -212,6 +233,218 @@ namespace BlackMiscTest
         QVERIFY2(set.size() == 0, "Last should be gone");
     }
 
+    void CTestAviation::callsignHandles()
+    {
+        const CCallsign cs1("DLH123");
+        const CCallsign cs2("dlh123");
+        const CCallsign cs3("DLH124");
+        QVERIFY(cs1.getHandle() != CInternedCallsigns::InvalidHandle);
+        QCOMPARE(cs1.getHandle(), cs2.getHandle());
+        QVERIFY(cs1.getHandle() != cs3.getHandle());
+        QCOMPARE(CCallsign().getHandle(), CInternedCallsigns::InvalidHandle);
+        QCOMPARE(CInternedCallsigns::callsign(cs1.getHandle()), cs1);
+        QCOMPARE(CInternedCallsigns::callsign(cs1.getHandle()).getHandle(), cs1.getHandle());
+
+        // handle follows the callsign string
+        CCallsign changed(cs1);
+        changed.setPropertyByIndex(BlackMisc::CPropertyIndexRef(CCallsign::IndexCallsignString), QVariant("DLH124"));
+        QCOMPARE(changed.getHandle(), cs3.getHandle());
+        changed.markAsBroadcastCallsign();
+        QCOMPARE(changed.getHandle(), CCallsign("BROADCAST").getHandle());
+        changed.clear();
+        QCOMPARE(changed.getHandle(), CInternedCallsigns::InvalidHandle);
+
+        // handle is not marshalled, but assigned when unmarshalling
+        CCallsign fromJson(cs3);
+        fromJson.convertFromJson(cs1.toJson());
+        QCOMPARE(fromJson.getHandle(), cs1.getHandle());
+
+        QByteArray bytes;
+        {
+            QDataStream out(&bytes, QIODevice::WriteOnly);
+            out << cs1;
+        }
+        CCallsign fromStream(cs3);
+        QDataStream in(bytes);
+        in >> fromStream;
+        QCOMPARE(fromStream, cs1);
+        QCOMPARE(fromStream.getHandle(), cs1.getHandle());
+    }
+
+    void CTestAviation::perCallsign()
+    {
+        const CCallsign cs1("DLH123");
+        const CCallsign cs2("DLH124");
+        const CCallsign cs3("DLH125");
+
+        CTimestampPerCallsign timestamps;
+        QVERIFY(timestamps.isEmpty());
+        QVERIFY(!timestamps.contains(cs1));
+        QVERIFY(timestamps.value(cs1, -1) == -1);
+
+        timestamps.insert(cs1, 1);
+        timestamps[cs2] = 2;
+        timestamps.insert(cs3, 3);
+        timestamps.insert(CCallsign("dlh123"), 10); // same callsign
+        QCOMPARE(timestamps.size(), 3);
+        QVERIFY(timestamps.value(cs1) == 10);
+        QVERIFY(timestamps.value(cs2) == 2);
+
+        // removing moves the last element, the others must still be found
+        QCOMPARE(timestamps.remove(cs1), 1);
+        QCOMPARE(timestamps.remove(cs1), 0);
+        QCOMPARE(timestamps.size(), 2);
+        QVERIFY(!timestamps.contains(cs1));
+        QVERIFY(timestamps.value(cs2) == 2);
+        QVERIFY(timestamps.value(cs3) == 3);
+
+        // implicitly shared copy, const operator[] does not insert
+        const CTimestampPerCallsign copy = timestamps;
+        timestamps[cs2] = 20;
+        QVERIFY(copy[cs2] == 2);
+        QVERIFY(copy[cs1] == 0);
+        QCOMPARE(copy.size(), 2);
+
+        qint64 sum = 0;
+        CCallsignSet keys;
+        for (auto it = timestamps.cbegin(); it != timestamps.cend(); ++it)
+        {
+            keys.insert(it.key());
+            sum += it.value();
+        }
+        QVERIFY(sum == 23);
+        QCOMPARE(keys.size(), 2);
+        const QList<CCallsign> allKeys = timestamps.keys();
+        for (const CCallsign &cs : allKeys) { QVERIFY(keys.contains(cs)); }
+
+        // empty callsign is a valid key like in QHash
+        timestamps.insert(CCallsign(), 5);
+        QVERIFY(timestamps.contains(CCallsign()));
+        QCOMPARE(timestamps.size(), 3);
+
+        timestamps.clear();
+        QVERIFY(timestamps.isEmpty());
+        QVERIFY(!timestamps.contains(cs2));
+    }
+
+    void CTestAviation::callsignTimeouts()
+    {
+        const CCallsign cs1("DLH123");
+        const CCallsign cs2("DLH124");
+        const CCallsign cs3("DLH125");
+
+        CCallsignTimeouts timeouts;
+        timeouts.touch(cs1, 1000);
+        timeouts.touch(cs2, 2000);
+        timeouts.touch(cs3, 3000);
+        timeouts.touch(cs1, 4000); // superseded activity at 1000
+        timeouts.touch(cs1, 4000); // same activity, not queued again
+        QCOMPARE(timeouts.size(), 3);
+        QCOMPARE(timeouts.queuedActivities(), 4);
+        QVERIFY(timeouts.lastActivity(cs1) == 4000);
+
+        QVERIFY(timeouts.takeTimedOut(999).isEmpty());
+        QVERIFY(timeouts.takeTimedOut(1500).isEmpty()); // cs1 still active
+        QCOMPARE(timeouts.queuedActivities(), 3);
+
+        QCOMPARE(timeouts.remove(cs3), 1);
+        QCOMPARE(timeouts.takeTimedOut(3500), QList<CCallsign>({ cs2 })); // cs3 removed
+        QCOMPARE(timeouts.size(), 1);
+        QVERIFY(!timeouts.contains(cs2));
+        QVERIFY(timeouts.lastActivity(cs2) == -1);
+
+        // touched again after time out
+        timeouts.touch(cs2, 5000);
+        QList<qint64> lastActivities;
+        QCOMPARE(timeouts.takeTimedOut(5000, &lastActivities), QList<CCallsign>({ cs1, cs2 }));
+        QCOMPARE(lastActivities, QList<qint64>({ 4000, 5000 }));
+        QCOMPARE(timeouts.size(), 0);
+        QCOMPARE(timeouts.queuedActivities(), 0);
+
+        timeouts.touch(cs1, 6000);
+        timeouts.clear();
+        QVERIFY(timeouts.takeTimedOut(7000).isEmpty());
+    }
+
+    void CTestAviation::benchmarkWatchdog_data()
+    {
+        QTest::addColumn<QString>("container");
+        QTest::addColumn<int>("callsigns");
+        for (int callsigns : { 100, 1000 })
+        {
+            for (const QString &container : { QStringLiteral("QHash"), QStringLiteral("CPerCallsign"), QStringLiteral("CCallsignTimeouts") })
+            {
+                QTest::newRow(qPrintable(QStringLiteral("%1, %2 callsigns").arg(container).arg(callsigns))) << container << callsigns;
+            }
+        }
+    }
+
+    //! Like the former CAirspaceAnalyzer::watchdogCheckTimeouts, visiting all callsigns
+    template <class Timestamps>
+    static int watchdogCheckTimeouts(Timestamps &timestamps, qint64 timeoutEpochMs)
+    {
+        int timedOut = 0;
+        const QList<CCallsign> callsigns = timestamps.keys();
+        for (const CCallsign &callsign : callsigns)
+        {
+            const qint64 tsv = timestamps.value(callsign);
+            if (tsv > timeoutEpochMs) { continue; }
+            timestamps.remove(callsign);
+            timedOut++;
+        }
+        return timedOut;
+    }
+
+    //! Like CAirspaceAnalyzer::watchdogCheckTimeouts
+    static int watchdogCheckTimeouts(CCallsignTimeouts &timeouts, qint64 timeoutEpochMs)
+    {
+        return timeouts.takeTimedOut(timeoutEpochMs).size();
+    }
+
+    //! Touch
+    //! @{
+    template <class Timestamps>
+    static void watchdogTouch(Timestamps &timestamps, const CCallsign &callsign, qint64 now) { timestamps[callsign] = now; }
+    static void watchdogTouch(CCallsignTimeouts &timeouts, const CCallsign &callsign, qint64 now) { timeouts.touch(callsign, now); }
+    //! @}
+
+    //! Like CAirspaceAnalyzer::watchdogTouchAircraftCallsign for the callsigns, then the watchdog check
+    template <class Timestamps>
+    static int watchdogCycle(Timestamps &timestamps, const QList<CCallsign> &callsigns, int cycle, qint64 now)
+    {
+        for (int i = 0; i < callsigns.size(); ++i)
+        {
+            if ((i + cycle) % 10 == 0) { continue; } // some aircraft do not send updates
+            watchdogTouch(timestamps, callsigns[i], now);
+        }
+        return watchdogCheckTimeouts(timestamps, now - 1);
+    }
+
+    void CTestAviation::benchmarkWatchdog()
+    {
+        QFETCH(QString, container);
+        QFETCH(int, callsigns);
+
+        QList<CCallsign> aircraft;
+        for (int i = 0; i < callsigns; ++i) { aircraft.push_back(CCallsign(QStringLiteral("SWIFT%1").arg(i))); }
+
+        qint64 now = 1425000000000;
+        int cycle = 0;
+        int timedOut = 0;
+        QHash<CCallsign, qint64> hash;
+        CTimestampPerCallsign perCallsign;
+        CCallsignTimeouts timeouts;
+        QBENCHMARK
+        {
+            now += 5000;
+            cycle++;
+            if (container == QStringLiteral("QHash"))             { timedOut += watchdogCycle(hash, aircraft, cycle, now); }
+            else if (container == QStringLiteral("CPerCallsign")) { timedOut += watchdogCycle(perCallsign, aircraft, cycle, now); }
+            else                                                  { timedOut += watchdogCycle(timeouts, aircraft, cycle, now); }
+        }
+        QVERIFY(timedOut > 0);
+    }
+
     void CTestAviation::copyAndEqual()
     {
         const CFrequency f1(123.45, CFrequencyUnit::MHz());
@@ -11,12 +11,15 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/coordinategeodeticindex.h"
+#include "blackmisc/geo/coordinategeodeticlist.h"
 #include "blackmisc/geo/earthangle.h"
 #include "blackmisc/geo/latitude.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/pq/units.h"
 #include "test.h"
 
+#include <QRandomGenerator>
 #include <QTest>
 
 using namespace BlackMisc::Geo;
@@ -36,6 +39,19 @@ namespace BlackMiscTest
 
         //! CCoordinateGeodetic unit tests
         void coordinateGeodetic();
+
+        //! CCoordinateGeodeticIndex results compared to CCoordinateGeodeticList
+        void coordinateGeodeticIndex();
+
+        //! Range queries list vs. index
+        void benchmarkWithinRange_data();
+
+        //! Range queries list vs. index
+        void benchmarkWithinRange();
+
+    private:
+        //! Random coordinates around a center
+        static CCoordinateGeodeticList randomCoordinates(int number, double latDeg, double lngDeg, double spreadDeg, quint32 seed);
     };
 
     void CTestGeo::geoBasics()
@@ -79,6 +95,120 @@ namespace BlackMiscTest
         latValue = testCoordinate.latitude().value(CAngleUnit::deg());
         QCOMPARE(latValue, newLat.value(CAngleUnit::deg()));
     }
+
+    void CTestGeo::coordinateGeodeticIndex()
+    {
+        // around the date line and close to the pole as well
+        CCoordinateGeodeticList coordinates = randomCoordinates(1000, 50.0, 8.5, 0.5, 1);
+        coordinates.push_back(randomCoordinates(500, -33.9, 179.9, 0.3, 2));
+        coordinates.push_back(randomCoordinates(500, 89.5, 0.0, 0.5, 3));
+
+        CCoordinateGeodeticIndex index;
+        CCoordinateGeodeticList list; // newest first, like the elevation cache
+        for (const CCoordinateGeodetic &c : std::as_const(coordinates))
+        {
+            index.push(c);
+            list.push_front(c);
+        }
+        QCOMPARE(index.size(), list.size());
+        QCOMPARE(index.toList(), list);
+        QCOMPARE(index.findMaxHeight(), list.findMaxHeight());
+
+        CCoordinateGeodeticList references = randomCoordinates(50, 50.0, 8.5, 0.5, 4);
+        references.push_back(randomCoordinates(50, -33.9, -179.9, 0.3, 5));
+        references.push_back(randomCoordinates(50, 89.9, 100.0, 0.1, 6));
+        const QList<CLength> ranges({ CLength(1, CLengthUnit::m()), CLength(500, CLengthUnit::m()), CLength(5, CLengthUnit::km()), CLength(100, CLengthUnit::km()) });
+        for (const CCoordinateGeodetic &reference : std::as_const(references))
+        {
+            for (const CLength &range : ranges)
+            {
+                QCOMPARE(index.findWithinRange(reference, range), list.findWithinRange(reference, range));
+                QCOMPARE(index.findFirstWithinRangeOrDefault(reference, range), list.findFirstWithinRangeOrDefault(reference, range));
+                QCOMPARE(index.containsWithinRange(reference, range), !list.findWithinRange(reference, range).isEmpty());
+                const CCoordinateGeodetic closestIndex = index.findClosestWithinRange(reference, range);
+                const CCoordinateGeodetic closestList  = list.findClosestWithinRange(reference, range);
+                QCOMPARE(closestIndex.isNull(), closestList.isNull());
+                if (!closestList.isNull()) { QCOMPARE(calculateGreatCircleDistance(reference, closestIndex), calculateGreatCircleDistance(reference, closestList)); }
+            }
+        }
+
+        // FIFO
+        QCOMPARE(index.truncate(1500), 500);
+        list.truncate(1500);
+        QCOMPARE(index.toList(), list);
+
+        // removal
+        const CCoordinateGeodetic reference(50.0, 8.5);
+        const CLength range(20, CLengthUnit::km());
+        QCOMPARE(index.removeInsideRange(reference, range), list.removeInsideRange(reference, range));
+        QCOMPARE(index.toList(), list);
+        QCOMPARE(index.removeOutsideRange(reference, CLength(60, CLengthUnit::km())), list.removeOutsideRange(reference, CLength(60, CLengthUnit::km())));
+        QCOMPARE(index.toList(), list);
+        QVERIFY(!index.containsWithinRange(reference, range));
+
+        index.clear();
+        QVERIFY(index.isEmpty());
+        QVERIFY(index.findClosestWithinRange(reference, range).isNull());
+    }
+
+    void CTestGeo::benchmarkWithinRange_data()
+    {
+        QTest::addColumn<int>("number");
+        QTest::addColumn<bool>("useIndex");
+        QTest::newRow("list 10000")    << 10000  << false;
+        QTest::newRow("index 10000")   << 10000  << true;
+        QTest::newRow("list 100000")   << 100000 << false;
+        QTest::newRow("index 100000")  << 100000 << true;
+    }
+
+    void CTestGeo::benchmarkWithinRange()
+    {
+        QFETCH(int, number);
+        QFETCH(bool, useIndex);
+
+        const CCoordinateGeodeticList coordinates = randomCoordinates(number, 50.0, 8.5, 2.0, 7);
+        const CCoordinateGeodeticList references  = randomCoordinates(100, 50.0, 8.5, 2.0, 8);
+        const CLength range(100, CLengthUnit::m());
+        CCoordinateGeodeticIndex index;
+        for (const CCoordinateGeodetic &c : coordinates) { index.push(c); }
+
+        QVector<CCoordinateGeodetic> found;
+        QBENCHMARK
+        {
+            found.clear();
+            for (const CCoordinateGeodetic &reference : references)
+            {
+                found.push_back(useIndex ?
+                                index.findClosestWithinRange(reference, range) :
+                                coordinates.findClosestWithinRange(reference, range));
+            }
+        }
+
+        // same closest distances as the linear scan
+        QCOMPARE(found.size(), references.size());
+        for (int i = 0; i < references.size(); ++i)
+        {
+            const CCoordinateGeodetic expected = coordinates.findClosestWithinRange(references[i], range);
+            QCOMPARE(found[i].isNull(), expected.isNull());
+            if (!expected.isNull()) { QCOMPARE(calculateGreatCircleDistance(references[i], found[i]), calculateGreatCircleDistance(references[i], expected)); }
+        }
+    }
+
+    CCoordinateGeodeticList CTestGeo::randomCoordinates(int number, double latDeg, double lngDeg, double spreadDeg, quint32 seed)
+    {
+        QRandomGenerator random(seed);
+        CCoordinateGeodeticList coordinates;
+        coordinates.reserve(number);
+        for (int i = 0; i < number; i++)
+        {
+            const double lat = qBound(-90.0, latDeg + (random.generateDouble() - 0.5) * 2.0 * spreadDeg, 90.0);
+            double lng = lngDeg + (random.generateDouble() - 0.5) * 2.0 * spreadDeg;
+            if (lng > 180.0)  { lng -= 360.0; }
+            if (lng < -180.0) { lng += 360.0; }
+            coordinates.push_back(CCoordinateGeodetic(lat, lng, 300.0 + random.bounded(1000)));
+        }
+        return coordinates;
+    }
 } // ns
 
 //! main
@@ -14,6 +14,7 @@
 #include "blackmisc/pq/acceleration.h"
 #include "blackmisc/pq/angle.h"
 #include "blackmisc/pq/constants.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/pq/frequency.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/literals.h"
@@ -85,6 +86,14 @@ namespace BlackMiscTest
 
         //! Test user-defined literals
         void literalsTest();
+
+        //! Quantities with compile-time units yield the same values as the runtime units
+        void fixedQuantities();
+
+    private:
+        //! Same value converted by the runtime and the compile-time units
+        template <class From, class To>
+        static bool isSameConversion(double value);
     };
 
     void CTestPhysicalQuantities::unitsBasics()
@@ -449,6 +458,57 @@ namespace BlackMiscTest
         QVERIFY2(510_hrmin == CTime(510, CTimeUnit::hrmin()), "Time needs to be the same");
         QVERIFY2(2637_minsec == CTime(2637, CTimeUnit::minsec()), "Time needs to be the same");
     }
+
+    void CTestPhysicalQuantities::fixedQuantities()
+    {
+        // conversions are identical, not only within epsilon
+        for (double v : { -1234.5678, -1.0, 0.0, 0.3048, 1.0, 47.11, 38000.0, 1e7 })
+        {
+            QVERIFY2((isSameConversion<Fixed::m, Fixed::ft>(v)), "m to ft");
+            QVERIFY2((isSameConversion<Fixed::ft, Fixed::m>(v)), "ft to m");
+            QVERIFY2((isSameConversion<Fixed::ft, Fixed::NM>(v)), "ft to NM");
+            QVERIFY2((isSameConversion<Fixed::km, Fixed::ft>(v)), "km to ft");
+            QVERIFY2((isSameConversion<Fixed::rad, Fixed::deg>(v)), "rad to deg");
+            QVERIFY2((isSameConversion<Fixed::deg, Fixed::rad>(v)), "deg to rad");
+            QVERIFY2((isSameConversion<Fixed::kts, Fixed::km_h>(v)), "kts to km/h");
+            QVERIFY2((isSameConversion<Fixed::ft_min, Fixed::m_s>(v)), "ft/min to m/s");
+        }
+
+        // to and from the runtime quantities
+        const CLength length(1234.5, CLengthUnit::m());
+        const CFixedLength<Fixed::ft> lengthFt = CFixedLength<Fixed::ft>::fromQuantity(length);
+        QCOMPARE(lengthFt.value(), length.value(CLengthUnit::ft()));
+        QCOMPARE(lengthFt.toQuantity().getUnit(), CLengthUnit::ft());
+        QCOMPARE(lengthFt.toQuantity().value(), lengthFt.value());
+        QVERIFY(lengthFt.toQuantity() == length);
+        QCOMPARE(CFixedSpeed<Fixed::kts>(250.0).toQuantity(), CSpeed(250.0, CSpeedUnit::kts()));
+        QCOMPARE(CFixedAngle<Fixed::rad>::fromQuantity(CAngle(180.0, CAngleUnit::deg())).value(), CAngle(180.0, CAngleUnit::deg()).value(CAngleUnit::rad()));
+
+        // null
+        const CFixedLength<Fixed::ft> null = CFixedLength<Fixed::ft>::fromQuantity(CLength::null());
+        QVERIFY(null.isNull());
+        QVERIFY(null.toQuantity().isNull());
+        QVERIFY((null + lengthFt).isNull());
+        QVERIFY(!(null < lengthFt) && !(null >= lengthFt));
+
+        // arithmetic and comparisons in the same unit
+        constexpr CFixedLength<Fixed::ft> a(100.0);
+        constexpr CFixedLength<Fixed::ft> b = CFixedLength<Fixed::m>(30.48).to<Fixed::ft>();
+        static_assert(a > b, "compile-time comparison");
+        QCOMPARE(((a - b) * 0.5 + b).value(), 50.0 + b.value() * 0.5);
+        QCOMPARE((-a).abs(), a);
+        QVERIFY((b - a).isNegativeWithEpsilonConsidered());
+        QVERIFY(CFixedLength<Fixed::ft>(1e-10).isZeroEpsilonConsidered());
+    }
+
+    template <class From, class To>
+    bool CTestPhysicalQuantities::isSameConversion(double value)
+    {
+        using Quantity = typename From::QuantityType;
+        const double runtime = Quantity(value, From::unit()).value(To::unit());
+        const double fixed = CFixedQuantity<From>(value).template value<To>();
+        return runtime == fixed;
+    }
 } // namespace
 
 //! main
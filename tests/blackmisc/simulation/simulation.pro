@@ -1,6 +1,8 @@
 TEMPLATE = subdirs
 SUBDIRS += \
+    testaircraftmodelsetindex \
     testinterpolatorlinear \
     testinterpolatormisc \
     testinterpolatorparts \
+    testremoteaircraftprovider \
     testxplane \
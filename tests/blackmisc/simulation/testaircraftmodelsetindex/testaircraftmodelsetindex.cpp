@@ -0,0 +1,327 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/aircraftmodelsetindex.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/aviation/aircrafticaocode.h"
+#include "blackmisc/aviation/airlineicaocode.h"
+#include "blackmisc/aviation/livery.h"
+#include "test.h"
+
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QVector>
+#include <QTest>
+#include <algorithm>
+
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Aircraft model set index tests
+    class CTestAircraftModelSetIndex : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Index finders yield the same models as the list finders
+        void sameAsList();
+
+        //! Reductions chained on ids yield the same models as chained list reductions
+        void chainedReduction();
+
+        //! Unite keeps the order and removes duplicates
+        void unite();
+
+        //! Replace or add moves the replaced ids to the back
+        void replaceOrAdd();
+
+        //! Airline reduction with airline group yields the same models as the list version
+        void airlineGroupReduction();
+
+        //! Stepwise reduction on lists vs. on the index
+        void benchmarkReduction_data();
+
+        //! Stepwise reduction on lists vs. on the index
+        void benchmarkReduction();
+
+    private:
+        //! Synthetic model set
+        static CAircraftModelList syntheticModelSet(int size, quint32 seed);
+
+        //! Aircraft designators used for the synthetic set
+        static const QStringList &aircraftDesignators();
+
+        //! Airline designators used for the synthetic set
+        static const QStringList &airlineDesignators();
+    };
+
+    const QStringList &CTestAircraftModelSetIndex::aircraftDesignators()
+    {
+        static const QStringList designators = []
+        {
+            QStringList d;
+            for (int i = 0; i < 150; ++i) { d.push_back(QStringLiteral("T%1").arg(i, 3, 10, QChar('0'))); }
+            return d;
+        }();
+        return designators;
+    }
+
+    const QStringList &CTestAircraftModelSetIndex::airlineDesignators()
+    {
+        static const QStringList designators = []
+        {
+            QStringList d;
+            for (int i = 0; i < 400; ++i) { d.push_back(QStringLiteral("A%1").arg(i, 2, 36, QChar('0')).toUpper()); }
+            return d;
+        }();
+        return designators;
+    }
+
+    CAircraftModelList CTestAircraftModelSetIndex::syntheticModelSet(int size, quint32 seed)
+    {
+        static const QStringList combinedTypes({ "L2J", "L4J", "L2P", "L1P", "H1T", "L2T" });
+        static const QStringList manufacturers({ "AIRBUS", "BOEING", "EMBRAER", "Bombardier", "CESSNA" });
+
+        QRandomGenerator random(seed);
+        const QStringList &aircraft = aircraftDesignators();
+        const QStringList &airlines = airlineDesignators();
+        CAircraftModelList models;
+        models.reserve(size);
+        for (int i = 0; i < size; ++i)
+        {
+            const int a = random.bounded(aircraft.size());
+            CAircraftIcaoCode icao(aircraft[a], combinedTypes[a % combinedTypes.size()], manufacturers[a % manufacturers.size()], "", "M", true, false, false, 1);
+            if (a % 4 != 0) { icao.setFamily(QStringLiteral("F%1").arg(a / 10)); }
+            if (random.bounded(20) == 0) { icao.setMilitary(true); }
+
+            CLivery livery;
+            if (random.bounded(10) > 0)
+            {
+                const int l = random.bounded(airlines.size());
+                CAirlineIcaoCode airline(airlines[l]);
+                if (l % 3 == 0) { airline.setGroupId(l % 17); }
+                livery = CLivery(CLivery::getStandardCode(airline), airline, "synthetic");
+            }
+            else
+            {
+                livery = CLivery(QStringLiteral("_CC_%1").arg(random.bounded(5)), CAirlineIcaoCode(), "color");
+            }
+
+            CAircraftModel model(QStringLiteral("MODEL_%1").arg(i), CAircraftModel::TypeDatabaseEntry, "synthetic", icao, livery);
+            if (random.bounded(50) > 0) { model.setDbKey(i + 1); }
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    void CTestAircraftModelSetIndex::sameAsList()
+    {
+        const CAircraftModelList models = syntheticModelSet(5000, 42);
+        const CAircraftModelSetIndex index(models);
+        const CAircraftModelSetIndex::ModelIds &all = index.allIds();
+        QCOMPARE(index.size(), models.sizeInt());
+        QCOMPARE(index.toModels(all), models);
+
+        for (const QString &designator : { QStringLiteral("T000"), QStringLiteral("T017"), QStringLiteral("T149"), QStringLiteral("XXXX") })
+        {
+            const CAircraftIcaoCode aircraft(designator);
+            for (const QString &airlineDesignator : { QString(), QStringLiteral("A00"), QStringLiteral("A0F") })
+            {
+                const CAirlineIcaoCode airline(airlineDesignator);
+                QCOMPARE(index.toModels(index.findByIcaoDesignators(all, aircraft, airline)), models.findByIcaoDesignators(aircraft, airline));
+                QCOMPARE(index.toModels(index.findByAircraftDesignatorAndLiveryCombinedCode(all, designator, CLivery::getStandardCode(airline))),
+                         models.findByAircraftDesignatorAndLiveryCombinedCode(designator, CLivery::getStandardCode(airline)));
+            }
+        }
+
+        for (const QString &manufacturer : { QStringLiteral("Airbus"), QStringLiteral("boeing "), QStringLiteral("Bombardier"), QString() })
+        {
+            QCOMPARE(index.toModels(index.findByManufacturer(all, manufacturer)), models.findByManufacturer(manufacturer));
+        }
+
+        for (const QString &family : { QStringLiteral("F3"), QStringLiteral("f10"), QStringLiteral("F99"), QString() })
+        {
+            QCOMPARE(index.toModels(index.findByFamily(all, family)), models.findByFamily(family));
+        }
+
+        for (const QString &combinedType : { QStringLiteral("L2J"), QStringLiteral("l4j"), QStringLiteral("L*J"), QStringLiteral("H-T"), QStringLiteral("L2") })
+        {
+            QCOMPARE(index.toModels(index.findByCombinedType(all, combinedType)), models.findByCombinedType(combinedType));
+        }
+
+        for (int groupId : { 0, 5, 16, -1 })
+        {
+            CAirlineIcaoCode airline("GRP");
+            airline.setGroupId(groupId);
+            QCOMPARE(index.toModels(index.findByAirlineGroup(all, airline)), models.findByAirlineGroup(airline));
+        }
+
+        const CAircraftIcaoCode combinedAndManufacturer("", "L2J", "BOEING", "", "M", true, false, false, 1);
+        QCOMPARE(index.toModels(index.findByCombinedAndManufacturer(all, combinedAndManufacturer)), models.findByCombinedAndManufacturer(combinedAndManufacturer));
+        QCOMPARE(index.toModels(index.findByMilitaryFlag(all, true)), models.findByMilitaryFlag(true));
+        QCOMPARE(index.toModels(index.findByMilitaryFlag(all, false)), models.findByMilitaryFlag(false));
+        QCOMPARE(index.toModels(index.findByVtolFlag(all, true)), models.findByVtolFlag(true));
+        QCOMPARE(index.containsVtol(all), models.containsVtol());
+        QCOMPARE(index.toModels(index.findWithValidDbKey(all)), models.findWithValidDbKey());
+    }
+
+    void CTestAircraftModelSetIndex::chainedReduction()
+    {
+        const CAircraftModelList models = syntheticModelSet(5000, 4711);
+        const CAircraftModelSetIndex index(models);
+
+        // ids in a different order than the set, the order of the ids has to be kept
+        CAircraftModelSetIndex::ModelIds reversed(index.allIds());
+        std::reverse(reversed.begin(), reversed.end());
+        const CAircraftModelList reversedModels = index.toModels(reversed);
+
+        for (int i = 0; i < 50; ++i)
+        {
+            const CAircraftIcaoCode aircraft(aircraftDesignators()[(i * 7) % aircraftDesignators().size()]);
+            const CAirlineIcaoCode airline(airlineDesignators()[(i * 13) % airlineDesignators().size()]);
+
+            const CAircraftModelList byAircraft = models.findByIcaoDesignators(aircraft, CAirlineIcaoCode());
+            const CAircraftModelSetIndex::ModelIds byAircraftIds = index.findByIcaoDesignators(index.allIds(), aircraft, CAirlineIcaoCode());
+            QCOMPARE(index.toModels(byAircraftIds), byAircraft);
+
+            const CAircraftModelList byFamily = byAircraft.findByFamily(aircraft.getDesignator() == "T000" ? "F0" : "F1");
+            QCOMPARE(index.toModels(index.findByFamily(byAircraftIds, aircraft.getDesignator() == "T000" ? "F0" : "F1")), byFamily);
+
+            const CAircraftModelList byCombined = byAircraft.findByCombinedType("L2J");
+            QCOMPARE(index.toModels(index.findByCombinedType(byAircraftIds, "L2J")), byCombined);
+
+            const CAircraftModelList reversedByAirline = reversedModels.findByIcaoDesignators(CAircraftIcaoCode(), airline).findByMilitaryFlag(false);
+            const CAircraftModelSetIndex::ModelIds reversedByAirlineIds = index.findByMilitaryFlag(index.findByIcaoDesignators(reversed, CAircraftIcaoCode(), airline), false);
+            QCOMPARE(index.toModels(reversedByAirlineIds), reversedByAirline);
+            QCOMPARE(index.toIds(reversedByAirline), reversedByAirlineIds);
+        }
+    }
+
+    void CTestAircraftModelSetIndex::unite()
+    {
+        const CAircraftModelSetIndex::ModelIds a({ 5, 1, 3 });
+        const CAircraftModelSetIndex::ModelIds b({ 3, 2, 5, 7 });
+        QCOMPARE(CAircraftModelSetIndex::unite(a, b), CAircraftModelSetIndex::ModelIds({ 5, 1, 3, 2, 7 }));
+        QCOMPARE(CAircraftModelSetIndex::unite(a, {}), a);
+        QCOMPARE(CAircraftModelSetIndex::unite({}, b), b);
+    }
+
+    void CTestAircraftModelSetIndex::replaceOrAdd()
+    {
+        const CAircraftModelSetIndex::ModelIds a({ 5, 1, 3 });
+        const CAircraftModelSetIndex::ModelIds b({ 3, 2, 5, 7 });
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(a, b), CAircraftModelSetIndex::ModelIds({ 1, 3, 2, 5, 7 }));
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd(a, {}), a);
+        QCOMPARE(CAircraftModelSetIndex::replaceOrAdd({}, b), b);
+    }
+
+    void CTestAircraftModelSetIndex::airlineGroupReduction()
+    {
+        const CAircraftModelList models = syntheticModelSet(5000, 815);
+        const CAircraftModelSetIndex index(models);
+
+        // ids in a different order than the set, the order of the ids has to be kept
+        CAircraftModelSetIndex::ModelIds reversed(index.allIds());
+        std::reverse(reversed.begin(), reversed.end());
+        const CAircraftModelList reversedModels = index.toModels(reversed);
+
+        int withGroupModels = 0;
+        for (int l = 0; l < airlineDesignators().size(); l += 3)
+        {
+            // like the synthetic set, the airline of the remote aircraft has a group
+            CAirlineIcaoCode airline(airlineDesignators()[l]);
+            airline.setGroupId(l % 17);
+            airline.setGroupDesignator(QStringLiteral("G%1").arg(l % 17));
+            QVERIFY(airline.hasGroupMembership());
+
+            // same steps as the airline reduction of the matcher, the list version as before the index
+            const CAircraftModelList ownModels = reversedModels.findByIcaoDesignators(CAircraftIcaoCode(), airline);
+            CAircraftModelList byAirline(ownModels);
+            const CAircraftModelList groupModels = reversedModels.findByAirlineGroup(airline);
+            byAirline.replaceOrAddModelsWithString(groupModels, Qt::CaseInsensitive);
+
+            CAircraftModelSetIndex::ModelIds byAirlineIds = index.findByIcaoDesignators(reversed, CAircraftIcaoCode(), airline);
+            const CAircraftModelSetIndex::ModelIds groupIds = index.findByAirlineGroup(reversed, airline);
+            byAirlineIds = CAircraftModelSetIndex::replaceOrAdd(byAirlineIds, groupIds);
+
+            QCOMPARE(index.toModels(byAirlineIds), byAirline);
+            if (!ownModels.isEmpty() && groupModels.size() > ownModels.size()) { withGroupModels++; }
+        }
+
+        // the comparison covers airlines with own models and models of other group members
+        QVERIFY(withGroupModels > 0);
+    }
+
+    void CTestAircraftModelSetIndex::benchmarkReduction_data()
+    {
+        QTest::addColumn<bool>("useIndex");
+        QTest::newRow("list") << false;
+        QTest::newRow("index") << true;
+    }
+
+    void CTestAircraftModelSetIndex::benchmarkReduction()
+    {
+        QFETCH(bool, useIndex);
+        const CAircraftModelList models = syntheticModelSet(50000, 1);
+        const CAircraftModelSetIndex index(models);
+
+        // same steps as the stepwise reduction of the matcher: aircraft, airline, manufacturer, military
+        const auto reduceList = [&](const CAircraftIcaoCode &aircraft, const CAirlineIcaoCode &airline)
+        {
+            CAircraftModelList reduced = models.findByIcaoDesignators(aircraft, CAirlineIcaoCode());
+            if (reduced.isEmpty()) { reduced = models.findByCombinedAndManufacturer(aircraft); }
+            reduced = reduced.findByIcaoDesignators(CAircraftIcaoCode(), airline);
+            reduced = reduced.findByManufacturer(aircraft.getManufacturer());
+            return reduced.findByMilitaryFlag(false);
+        };
+        const auto reduceIndex = [&](const CAircraftIcaoCode &aircraft, const CAirlineIcaoCode &airline)
+        {
+            CAircraftModelSetIndex::ModelIds ids = index.findByIcaoDesignators(index.allIds(), aircraft, CAirlineIcaoCode());
+            if (ids.isEmpty()) { ids = index.findByCombinedAndManufacturer(index.allIds(), aircraft); }
+            ids = index.findByIcaoDesignators(ids, CAircraftIcaoCode(), airline);
+            ids = index.findByManufacturer(ids, aircraft.getManufacturer());
+            return index.findByMilitaryFlag(ids, false);
+        };
+        const auto aircraft = [](int i) { return CAircraftIcaoCode(aircraftDesignators()[(i * 7) % aircraftDesignators().size()], "L2J", "BOEING", "", "M", true, false, false, 1); };
+        const auto airline = [](int i) { return CAirlineIcaoCode(airlineDesignators()[(i * 13) % airlineDesignators().size()]); };
+
+        QVector<CAircraftModelList> foundModels;
+        QVector<CAircraftModelSetIndex::ModelIds> foundIds;
+        QBENCHMARK
+        {
+            foundModels.clear();
+            foundIds.clear();
+            for (int i = 0; i < 100; ++i)
+            {
+                if (useIndex) { foundIds.push_back(reduceIndex(aircraft(i), airline(i))); }
+                else          { foundModels.push_back(reduceList(aircraft(i), airline(i))); }
+            }
+        }
+
+        // the indexed results are the same models in the same order as the linear scan
+        for (int i = 0; i < 100; ++i)
+        {
+            const CAircraftModelList expected = reduceList(aircraft(i), airline(i));
+            QCOMPARE(useIndex ? index.toModels(foundIds.at(i)) : foundModels.at(i), expected);
+            QCOMPARE(index.toModels(reduceIndex(aircraft(i), airline(i))), expected);
+        }
+    }
+} // namespace
+
+//! main
+BLACKTEST_APPLESS_MAIN(BlackMiscTest::CTestAircraftModelSetIndex);
+
+#include "testaircraftmodelsetindex.moc"
+
+//! \endcond
@@ -25,6 +25,7 @@
 #include "blackmisc/geo/latitude.h"
 #include "blackmisc/geo/longitude.h"
 #include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/fixedquantity.h"
 #include "blackmisc/pq/length.h"
 #include "blackmisc/pq/physicalquantity.h"
 #include "blackmisc/pq/speed.h"
@@ -39,6 +40,7 @@
 #include <QTest>
 #include <QTime>
 #include <QtDebug>
+#include <vector>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Aviation;
@@ -60,12 +62,27 @@ namespace BlackMiscTest
         //! Interpolator PBH
         void pbhInterpolatorTest();
 
+        //! Corrected and interpolated altitudes with runtime and compile-time units
+        void fixedAltitude();
+
+        //! Per aircraft altitude interpolation, runtime vs. compile-time units
+        void benchmarkAltitude_data();
+
+        //! Per aircraft altitude interpolation, runtime vs. compile-time units
+        void benchmarkAltitude();
+
     private:
         //! Test situation for testing
         static BlackMisc::Aviation::CAircraftSituation getTestSituation(const BlackMisc::Aviation::CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset);
 
         //! Test parts
         static BlackMisc::Aviation::CAircraftParts getTestParts(int number, qint64 ts, qint64 deltaT);
+
+        //! Interpolated altitude like the linear interpolant before compile-time units
+        static double interpolateAltitudeRuntime(const BlackMisc::Aviation::CAircraftSituation &oldSituation, const BlackMisc::Aviation::CAircraftSituation &newSituation, double tf);
+
+        //! Interpolated altitude like the linear interpolant
+        static double interpolateAltitudeFixed(const BlackMisc::Aviation::CAircraftSituation &oldSituation, const BlackMisc::Aviation::CAircraftSituation &newSituation, double tf);
     };
 
     void CTestInterpolatorLinear::basicInterpolatorTests()
@@ -320,6 +337,105 @@ namespace BlackMiscTest
         }
     }
 
+    void CTestInterpolatorLinear::fixedAltitude()
+    {
+        const CCallsign cs("SWIFT");
+        const CLength cg(2.5, CLengthUnit::m());
+        const CFixedLength<Fixed::ft> cgFt = CFixedLength<Fixed::ft>::fromQuantity(cg);
+        for (int number = 0; number < 20; number++)
+        {
+            // underflow, near ground, dragged to ground and airborne
+            CAircraftSituation s = getTestSituation(cs, number, 0, 0, 0);
+            s.setOnGround(number % 2 == 0 ? CAircraftSituation::OnGround : CAircraftSituation::NotOnGround, CAircraftSituation::InFromNetwork);
+            const double runtimeFt = s.getCorrectedAltitude(cg).value(CLengthUnit::ft());
+            QVERIFY(qAbs(s.getCorrectedAltitudeFt(cgFt).value() - runtimeFt) < 1e-9);
+            if (!s.isOnGround())
+            {
+                QCOMPARE(s.canLikelySkipNearGroundInterpolation(), s.getHeightAboveGround() >= CLength(400, CLengthUnit::m()) || s.getGroundSpeed().value(CSpeedUnit::kts()) > 225.0);
+            }
+
+            const CAircraftSituation next = getTestSituation(cs, number + 5, 0, 0, 0);
+            for (double tf = 0.0; tf <= 1.0; tf += 0.25)
+            {
+                QVERIFY(qAbs(interpolateAltitudeFixed(s, next, tf) - interpolateAltitudeRuntime(s, next, tf)) < 1e-9);
+            }
+        }
+
+        // no ground elevation, AGL, null CG
+        CAircraftSituation s = getTestSituation(cs, 3, 0, 0, 0);
+        s.setGroundElevation(CAltitude::null(), CAircraftSituation::NoElevationInfo);
+        QCOMPARE(s.getCorrectedAltitudeFt(cgFt).value(), s.getAltitude().value(CLengthUnit::ft()));
+        QVERIFY(s.getHeightAboveGroundFt().isNull());
+        s = getTestSituation(cs, 3, 0, 0, 0);
+        QCOMPARE(s.getCorrectedAltitudeFt(CFixedLength<Fixed::ft>()).value(), s.getCorrectedAltitude(CLength::null()).value(CLengthUnit::ft()));
+        QVERIFY(qAbs(s.getHeightAboveGroundFt().value() - s.getHeightAboveGround().value(CLengthUnit::ft())) < 1e-9);
+    }
+
+    void CTestInterpolatorLinear::benchmarkAltitude_data()
+    {
+        QTest::addColumn<bool>("fixed");
+        QTest::newRow("runtime units") << false;
+        QTest::newRow("compile-time units") << true;
+    }
+
+    void CTestInterpolatorLinear::benchmarkAltitude()
+    {
+        QFETCH(bool, fixed);
+        constexpr int Aircraft = 500;
+        const CCallsign cs("SWIFT");
+        std::vector<CAircraftSituation> oldSituations, newSituations;
+        for (int i = 0; i < Aircraft; i++)
+        {
+            oldSituations.push_back(getTestSituation(cs, i % 50, 0, 0, 0));
+            newSituations.push_back(getTestSituation(cs, i % 50 + 1, 0, 0, 0));
+        }
+
+        // each frame: skip check and interpolated corrected altitude of every aircraft
+        std::vector<double> altitudesFt(Aircraft);
+        int skipped = 0;
+        int frames = 0;
+        double tf = 0.0;
+        QBENCHMARK
+        {
+            frames++;
+            tf = tf < 1.0 ? tf + 0.01 : 0.0;
+            for (size_t i = 0; i < oldSituations.size(); i++)
+            {
+                if (oldSituations[i].canLikelySkipNearGroundInterpolation()) { skipped++; }
+                altitudesFt[i] = fixed ?
+                                 interpolateAltitudeFixed(oldSituations[i], newSituations[i], tf) :
+                                 interpolateAltitudeRuntime(oldSituations[i], newSituations[i], tf);
+            }
+        }
+
+        // results of the last frame same as with the other units
+        int skippable = 0;
+        for (size_t i = 0; i < oldSituations.size(); i++)
+        {
+            if (oldSituations[i].canLikelySkipNearGroundInterpolation()) { skippable++; }
+            const double otherFt = fixed ?
+                                   interpolateAltitudeRuntime(oldSituations[i], newSituations[i], tf) :
+                                   interpolateAltitudeFixed(oldSituations[i], newSituations[i], tf);
+            QVERIFY(qAbs(altitudesFt[i] - otherFt) < 1e-9);
+        }
+        QCOMPARE(skipped, frames * skippable);
+    }
+
+    double CTestInterpolatorLinear::interpolateAltitudeRuntime(const CAircraftSituation &oldSituation, const CAircraftSituation &newSituation, double tf)
+    {
+        const CAltitude oldAlt(oldSituation.getCorrectedAltitude());
+        const CAltitude newAlt(newSituation.getCorrectedAltitude());
+        const CAltitude altitude((newAlt - oldAlt) * tf + oldAlt, oldAlt.getReferenceDatum());
+        return altitude.value(CLengthUnit::ft());
+    }
+
+    double CTestInterpolatorLinear::interpolateAltitudeFixed(const CAircraftSituation &oldSituation, const CAircraftSituation &newSituation, double tf)
+    {
+        const CFixedLength<Fixed::ft> oldAlt = oldSituation.getCorrectedAltitudeFt();
+        const CFixedLength<Fixed::ft> newAlt = newSituation.getCorrectedAltitudeFt();
+        return ((newAlt - oldAlt) * tf + oldAlt).value();
+    }
+
     CAircraftSituation CTestInterpolatorLinear::getTestSituation(const CCallsign &callsign, int number, qint64 ts, qint64 deltaT, qint64 offset)
     {
         const CAltitude alt(number, CAltitude::MeanSeaLevel, CLengthUnit::m());
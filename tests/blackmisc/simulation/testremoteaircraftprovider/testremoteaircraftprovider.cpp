@@ -0,0 +1,284 @@
+/* Copyright (C) 2021
+ * swift project Community / Contributors
+ *
+ * This file is part of swift project. It is subject to the license terms in the LICENSE file found in the top-level
+ * directory of this distribution. No part of swift project, including this file, may be copied, modified, propagated,
+ * or distributed except according to the terms contained in the LICENSE file.
+ */
+
+//! \cond PRIVATE_TESTS
+//! \file
+//! \ingroup testblackmisc
+
+#include "blackmisc/simulation/remoteaircraftproviderdummy.h"
+#include "blackmisc/aviation/aircraftengine.h"
+#include "blackmisc/aviation/aircraftenginelist.h"
+#include "blackmisc/aviation/aircraftlights.h"
+#include "blackmisc/aviation/aircraftpartslist.h"
+#include "blackmisc/aviation/aircraftsituationlist.h"
+#include "blackmisc/aviation/altitude.h"
+#include "blackmisc/aviation/callsign.h"
+#include "blackmisc/aviation/heading.h"
+#include "blackmisc/geo/coordinategeodetic.h"
+#include "blackmisc/geo/latitude.h"
+#include "blackmisc/geo/longitude.h"
+#include "blackmisc/pq/angle.h"
+#include "blackmisc/pq/speed.h"
+#include "blackmisc/pq/units.h"
+#include "test.h"
+
+#include <QTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace BlackMisc;
+using namespace BlackMisc::Aviation;
+using namespace BlackMisc::Geo;
+using namespace BlackMisc::PhysicalQuantities;
+using namespace BlackMisc::Simulation;
+
+namespace BlackMiscTest
+{
+    //! Remote aircraft provider tests
+    class CTestRemoteAircraftProvider : public QObject
+    {
+        Q_OBJECT
+
+    private slots:
+        //! Situations and parts are kept per callsign
+        void storeAndRead();
+
+        //! Readers always see a consistent history while writers store
+        void concurrentReadWrite();
+
+        //! Writers storing situations while readers read
+        void benchmarkContention_data();
+
+        //! Writers storing situations while readers read
+        void benchmarkContention();
+
+        //! Reading the situations of all aircraft, as done by the interpolators
+        void benchmarkSituationLookup_data();
+
+        //! Reading the situations of all aircraft, as done by the interpolators
+        void benchmarkSituationLookup();
+
+    private:
+        //! Test situation
+        static CAircraftSituation getTestSituation(const CCallsign &callsign, int number, qint64 ts);
+
+        //! Test callsigns
+        static QList<CCallsign> getTestCallsigns(int count);
+    };
+
+    void CTestRemoteAircraftProvider::storeAndRead()
+    {
+        CRemoteAircraftProviderDummy provider;
+        const QList<CCallsign> callsigns = getTestCallsigns(5);
+        const qint64 ts = 1425000000000;
+        constexpr int count = IRemoteAircraftProvider::MaxSituationsPerCallsign + 10;
+        for (int i = 0; i < count; i++)
+        {
+            for (const CCallsign &cs : callsigns)
+            {
+                provider.insertNewSituation(getTestSituation(cs, i, ts));
+            }
+        }
+
+        const CAircraftParts parts(CAircraftLights(true, false, true, false, true, false), true, 20, true, CAircraftEngineList({ CAircraftEngine(1, true) }), false);
+        provider.insertNewAircraftParts(callsigns.front(), parts, false);
+
+        for (const CCallsign &cs : callsigns)
+        {
+            const CAircraftSituationList situations = provider.remoteAircraftSituations(cs);
+            QCOMPARE(situations.size(), IRemoteAircraftProvider::MaxSituationsPerCallsign);
+            QCOMPARE(provider.remoteAircraftSituationsCount(cs), IRemoteAircraftProvider::MaxSituationsPerCallsign);
+            QVERIFY2(situations.isSortedLatestFirst(), "Wrong sort order");
+            QCOMPARE(situations.front().getMSecsSinceEpoch(), getTestSituation(cs, count - 1, ts).getMSecsSinceEpoch());
+            QCOMPARE(provider.remoteAircraftSituation(cs, 0).getMSecsSinceEpoch(), situations.front().getMSecsSinceEpoch());
+            QVERIFY(provider.remoteAircraftSituation(cs, situations.size()).isNull());
+            QVERIFY(provider.remoteAircraftSituationChangesCount(cs) > 0);
+            QVERIFY(provider.situationsLastModified(cs) > 0);
+        }
+
+        QCOMPARE(provider.latestRemoteAircraftSituations().size(), callsigns.size());
+        QCOMPARE(provider.aircraftSituationsAdded(), count * callsigns.size());
+        QCOMPARE(provider.aircraftPartsAdded(), 1);
+        QCOMPARE(provider.remoteAircraftPartsCount(callsigns.front()), 1);
+        QCOMPARE(provider.remoteAircraftPartsCount(callsigns.back()), -1);
+        QVERIFY(provider.isRemoteAircraftSupportingParts(callsigns.front()));
+        QVERIFY(!provider.isRemoteAircraftSupportingParts(callsigns.back()));
+        QCOMPARE(provider.remoteAircraftSupportingParts(), CCallsignSet(callsigns.front()));
+
+        const CCallsign unknown("UNKNOWN");
+        QVERIFY(provider.remoteAircraftSituations(unknown).isEmpty());
+        QCOMPARE(provider.remoteAircraftSituationsCount(unknown), -1);
+        QCOMPARE(provider.situationsLastModified(unknown), -1);
+
+        provider.clear();
+        QVERIFY(provider.latestRemoteAircraftSituations().isEmpty());
+        QVERIFY(provider.remoteAircraftSupportingParts().isEmpty());
+        QCOMPARE(provider.remoteAircraftSituationsCount(callsigns.front()), -1);
+    }
+
+    void CTestRemoteAircraftProvider::concurrentReadWrite()
+    {
+        CRemoteAircraftProviderDummy provider;
+        const QList<CCallsign> callsigns = getTestCallsigns(4);
+        const qint64 ts = 1425000000000;
+        constexpr int count = 200;
+
+        std::atomic_bool stop { false };
+        std::atomic_int inconsistent { 0 };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; r++)
+        {
+            readers.emplace_back([&, r]
+            {
+                while (!stop)
+                {
+                    const CAircraftSituationList situations = provider.remoteAircraftSituations(callsigns[r % callsigns.size()]);
+                    if (situations.size() > IRemoteAircraftProvider::MaxSituationsPerCallsign || !situations.isSortedLatestFirst()) { inconsistent++; }
+                    provider.latestRemoteAircraftSituations();
+                }
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for (const CCallsign &cs : callsigns)
+        {
+            writers.emplace_back([&, cs]
+            {
+                for (int i = 0; i < count; i++) { provider.insertNewSituation(getTestSituation(cs, i, ts)); }
+            });
+        }
+
+        for (std::thread &writer : writers) { writer.join(); }
+        stop = true;
+        for (std::thread &reader : readers) { reader.join(); }
+
+        QCOMPARE(inconsistent.load(), 0);
+        QCOMPARE(provider.aircraftSituationsAdded(), count * callsigns.size());
+        for (const CCallsign &cs : callsigns)
+        {
+            QCOMPARE(provider.remoteAircraftSituationsCount(cs), IRemoteAircraftProvider::MaxSituationsPerCallsign);
+        }
+    }
+
+    void CTestRemoteAircraftProvider::benchmarkContention_data()
+    {
+        QTest::addColumn<int>("readerThreads");
+        QTest::newRow("no readers") << 0;
+        QTest::newRow("2 readers")  << 2;
+        QTest::newRow("8 readers")  << 8;
+        QTest::newRow("16 readers") << 16;
+    }
+
+    void CTestRemoteAircraftProvider::benchmarkContention()
+    {
+        QFETCH(int, readerThreads);
+        CRemoteAircraftProviderDummy provider;
+        const QList<CCallsign> callsigns = getTestCallsigns(100);
+        const qint64 ts = 1425000000000;
+
+        // readers like the interpolators and views, reading all callsigns over and over
+        std::atomic_bool stop { false };
+        std::vector<std::thread> readers;
+        for (int r = 0; r < readerThreads; r++)
+        {
+            readers.emplace_back([&]
+            {
+                while (!stop)
+                {
+                    for (const CCallsign &cs : callsigns)
+                    {
+                        if (stop) { break; }
+                        provider.remoteAircraftSituations(cs);
+                        provider.remoteAircraftSituationChanges(cs);
+                    }
+                }
+            });
+        }
+
+        // writer like the network thread, one situation for every callsign
+        int number = 0;
+        QBENCHMARK
+        {
+            for (const CCallsign &cs : callsigns)
+            {
+                provider.insertNewSituation(getTestSituation(cs, number, ts));
+            }
+            number++;
+        }
+
+        stop = true;
+        for (std::thread &reader : readers) { reader.join(); }
+        QVERIFY(provider.aircraftSituationsAdded() > 0);
+    }
+
+    void CTestRemoteAircraftProvider::benchmarkSituationLookup_data()
+    {
+        QTest::addColumn<int>("aircraft");
+        QTest::newRow("10 aircraft")  << 10;
+        QTest::newRow("100 aircraft") << 100;
+        QTest::newRow("500 aircraft") << 500;
+    }
+
+    void CTestRemoteAircraftProvider::benchmarkSituationLookup()
+    {
+        QFETCH(int, aircraft);
+        CRemoteAircraftProviderDummy provider;
+        const QList<CCallsign> callsigns = getTestCallsigns(aircraft);
+        const qint64 ts = 1425000000000;
+        for (int i = 0; i < 3; i++)
+        {
+            for (const CCallsign &cs : callsigns) { provider.insertNewSituation(getTestSituation(cs, i, ts)); }
+        }
+
+        // situations are cached per aircraft, so this is mostly the lookup of the aircraft
+        int situations = 0;
+        QBENCHMARK
+        {
+            for (const CCallsign &cs : callsigns)
+            {
+                situations += provider.remoteAircraftSituations(cs).size();
+                situations += provider.remoteAircraftSituationsCount(cs);
+            }
+        }
+        QVERIFY(situations > 0);
+    }
+
+    CAircraftSituation CTestRemoteAircraftProvider::getTestSituation(const CCallsign &callsign, int number, qint64 ts)
+    {
+        const CAltitude alt(1000 + number, CAltitude::MeanSeaLevel, CLengthUnit::m());
+        const CLatitude lat(10.0 + number * 0.001, CAngleUnit::deg());
+        const CLongitude lng(20.0 + number * 0.001, CAngleUnit::deg());
+        const CHeading heading(45, CHeading::True, CAngleUnit::deg());
+        const CAngle bank(0, CAngleUnit::deg());
+        const CAngle pitch(0, CAngleUnit::deg());
+        const CSpeed gs(250, CSpeedUnit::kts());
+        const CCoordinateGeodetic c(lat, lng, alt);
+        CAircraftSituation s(callsign, c, heading, pitch, bank, gs);
+        s.setMSecsSinceEpoch(ts + number * 5000);
+        s.setTimeOffsetMs(5000);
+        return s;
+    }
+
+    QList<CCallsign> CTestRemoteAircraftProvider::getTestCallsigns(int count)
+    {
+        QList<CCallsign> callsigns;
+        for (int i = 0; i < count; i++)
+        {
+            callsigns.push_back(CCallsign(QStringLiteral("SWIFT%1").arg(i)));
+        }
+        return callsigns;
+    }
+} // namespace
+
+//! main
+BLACKTEST_MAIN(BlackMiscTest::CTestRemoteAircraftProvider);
+
+#include "testremoteaircraftprovider.moc"
+
+//! \endcond
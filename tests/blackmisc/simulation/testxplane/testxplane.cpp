@@ -11,6 +11,7 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/simulation/xplane/qtfreeutils.h"
+#include "blackmisc/simulation/xplane/trafficsharedmemory.h"
 #include "blackmisc/simulation/settings/xswiftbussettings.h"
 #include "blackmisc/simulation/settings/xswiftbussettingsqtfree.inc"
 #include "blackmisc/swiftdirectories.h"
@@ -18,9 +19,11 @@
 #include "test.h"
 
 #include <QTest>
+#include <memory>
 
 using namespace BlackMisc;
 using namespace BlackMisc::Simulation::XPlane::QtFreeUtils;
+using namespace BlackMisc::Simulation::XPlane::TrafficSharedMemory;
 using namespace BlackMisc::Simulation::Settings;
 
 namespace BlackMiscTest
@@ -38,6 +41,7 @@ namespace BlackMiscTest
         void acfPropertiesTest();
         void xSwiftBusSettingsTest();
         void qtFreeUtils();
+        void trafficSharedMemoryTest();
     };
 
     void CTestXPlane::getFileNameTest()
@@ -178,6 +182,81 @@ namespace BlackMiscTest
         vOut = normalizeValue(-190, -180.0, 180.0);
         QVERIFY2(qFuzzyCompare(170, vOut), "Wrong normalize +-180");
     }
+
+    void CTestXPlane::trafficSharedMemoryTest()
+    {
+#if defined(_WIN32)
+        QSKIP("No POSIX shared memory");
+#else
+        // loopback, writer and reader in the same process
+        const std::string name = segmentName() + "-test";
+        CWriter writer;
+        CReader reader;
+        QVERIFY2(!reader.open(name), "Segment does not exist yet");
+        QVERIFY(writer.create(name));
+        QVERIFY(reader.open(name));
+
+        std::unique_ptr<FrameData> frame(new FrameData());
+        QVERIFY2(!reader.readLatest(*frame), "Nothing published yet");
+
+        const int slot1 = writer.slot("DLH123");
+        const int slot2 = writer.slot("BAW9");
+        QCOMPARE(slot1, 0);
+        QCOMPARE(slot2, 1);
+        QCOMPARE(writer.slot("DLH123"), slot1);
+        QCOMPARE(writer.slot("CALLSIGNTOOLONGFORSLOT"), -1);
+
+        writer.setPosition(slot1, 48.35, 11.78, 1487.0, 2.5, -1.0, 260.0, true);
+        writer.setSurfaces(slot2, 1.0, 0.5, 0.0, 0.0, 0.5, 0.0, 0.75, 0.0, 0.0, 0.0, true, false, true, true, true, 0);
+        writer.setTransponder(slot2, 7000, true, false);
+        writer.publish();
+
+        QVERIFY(reader.readLatest(*frame));
+        QCOMPARE(frame->slots, 2U);
+        QCOMPARE(QString::fromStdString(frame->callsign(slot1)), QString("DLH123"));
+        QCOMPARE(QString::fromStdString(frame->callsign(slot2)), QString("BAW9"));
+        QCOMPARE(frame->positionSerials[slot1], 1U);
+        QCOMPARE(frame->positionSerials[slot2], 0U);
+        QCOMPARE(frame->latitudesDeg[slot1], 48.35);
+        QCOMPARE(frame->headingsDeg[slot1], 260.0);
+        QVERIFY(frame->onGrounds[slot1]);
+        QCOMPARE(frame->surfacesSerials[slot2], 1U);
+        QCOMPARE(frame->thrusts[slot2], 0.75);
+        QVERIFY(frame->landLights[slot2]);
+        QVERIFY(!frame->taxiLights[slot2]);
+        QCOMPARE(frame->codes[slot2], 7000);
+        QVERIFY(frame->modeCs[slot2]);
+        QVERIFY2(!reader.readLatest(*frame), "No new frame");
+
+        // more frames than the ring holds, only the latest is read
+        for (int i = 0; i < 3 * RingFrames; ++i)
+        {
+            writer.setPosition(slot1, 48.0 + i, 11.0, 1000.0, 0.0, 0.0, 90.0, false);
+            writer.publish();
+        }
+        QVERIFY(reader.readLatest(*frame));
+        QCOMPARE(frame->latitudesDeg[slot1], 48.0 + 3 * RingFrames - 1);
+        QCOMPARE(frame->positionSerials[slot1], 1U + 3 * RingFrames);
+
+        // a freed slot is reused, serials are kept so the new plane never looks unchanged
+        writer.removePlane("DLH123");
+        writer.publish();
+        QVERIFY(reader.readLatest(*frame));
+        QVERIFY(frame->callsign(slot1).empty());
+        QCOMPARE(writer.slot("EZY42"), slot1);
+        writer.setPosition(slot1, 50.0, 8.0, 2000.0, 0.0, 0.0, 0.0, false);
+        writer.publish();
+        QVERIFY(reader.readLatest(*frame));
+        QCOMPARE(QString::fromStdString(frame->callsign(slot1)), QString("EZY42"));
+        QCOMPARE(frame->positionSerials[slot1], 2U + 3 * RingFrames);
+
+        // segment is removed with the writer, XSwiftBus falls back to DBus then
+        reader.close();
+        writer.close();
+        QVERIFY(!writer.isOpen());
+        QVERIFY(!reader.open(name));
+#endif
+    }
 }
 
 //! main
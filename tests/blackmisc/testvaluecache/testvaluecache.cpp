@@ -11,11 +11,15 @@
 //! \ingroup testblackmisc
 
 #include "blackmisc/valuecache.h"
+#include "blackmisc/valuecachebinaryfile.h"
 #include "blackmisc/aviation/atcstation.h"
 #include "blackmisc/aviation/atcstationlist.h"
+#include "blackmisc/aviation/livery.h"
 #include "blackmisc/dictionary.h"
 #include "blackmisc/identifier.h"
 #include "blackmisc/registermetadata.h"
+#include "blackmisc/simulation/aircraftmodellist.h"
+#include "blackmisc/simulation/distributor.h"
 #include "blackmisc/simulation/simulatedaircraft.h"
 #include "blackmisc/simulation/simulatedaircraftlist.h"
 #include "blackmisc/statusmessage.h"
@@ -27,6 +31,8 @@
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QFileInfo>
 #include <QFlags>
 #include <QJsonObject>
@@ -78,6 +84,19 @@ namespace BlackMiscTest
 
         //! Test saving to and loading from files.
         void saveAndLoad();
+
+        //! Test binary files alongside the Json files.
+        void binaryFiles();
+
+        //! Loading a large model set from Json or binary files, first (cold) and repeated (warm) loading.
+        void benchmarkLoad_data();
+
+        //! Loading a large model set from Json or binary files, first (cold) and repeated (warm) loading.
+        void benchmarkLoad();
+
+    private:
+        //! Models sharing ICAO codes, liveries and distributors
+        static CAircraftModelList testModels(int number);
     };
 
     //! Simple class which uses CCached, for testing.
@@ -313,6 +332,132 @@ namespace BlackMiscTest
         QCOMPARE(test2Values, testData);
     }
 
+    CAircraftModelList CTestValueCache::testModels(int number)
+    {
+        static const QStringList icaos({ "B738", "A320", "A319", "C172", "B744", "E190" });
+        static const QStringList airlines({ "DLH", "BAW", "AFR", "UAE", "KLM" });
+        static const QStringList distributors({ "FSX", "PMDG", "AEROSOFT", "WOAI" });
+        CAircraftModelList models;
+        for (int i = 0; i < number; ++i)
+        {
+            const QString airline = airlines[i % airlines.size()];
+            CAircraftModel model(QStringLiteral("Swift Model %1").arg(i), CAircraftModel::TypeDatabaseEntry, QStringLiteral("Description %1").arg(i),
+                                 CAircraftIcaoCode(icaos[i % icaos.size()]), CLivery(airline + ".STD", CAirlineIcaoCode(airline), airline + " standard"));
+            model.setDistributor(CDistributor(distributors[i % distributors.size()]));
+            model.setFileName(QStringLiteral("c:/simulator/aircraft/model%1/aircraft.cfg").arg(i));
+            models.push_back(model);
+        }
+        return models;
+    }
+
+    void CTestValueCache::binaryFiles()
+    {
+        const CAircraftModelList models = testModels(100);
+        const CVariantMap testData
+        {
+            { "namespace1/value1", CVariant::from(1) },
+            { "namespace1/value2", CVariant::from(2) },
+            { "namespace2/models", CVariant::from(models) },
+            { "namespace2/atcstations", CVariant::from(CAtcStationList({ CAtcStation("EGLL_TWR") })) }
+        };
+        CValueCache cache(1);
+        cache.setBinaryFilesEnabled(true);
+        cache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+
+        QDir dir(QDir::currentPath() + "/testbinarycache");
+        if (dir.exists()) { dir.removeRecursively(); }
+        QVERIFY(cache.saveToFiles(dir.absolutePath()).isSuccess());
+        QVERIFY(QFile::exists(dir.filePath("namespace1.bin")));
+        QVERIFY(QFile::exists(dir.filePath("namespace2.bin")));
+
+        // keys without values, values only when asked for
+        {
+            CValueCacheBinaryFile binaryFile(dir.filePath("namespace2.bin"));
+            QVERIFY2(binaryFile.open(QFileInfo(dir.filePath("namespace2.json"))), qPrintable(binaryFile.getErrorString()));
+            QCOMPARE(binaryFile.keys(), QStringList({ "namespace2/atcstations", "namespace2/models" }));
+            CVariant value;
+            QVERIFY(binaryFile.value("namespace2/models", value));
+            QCOMPARE(value.value<CAircraftModelList>(), models);
+        }
+
+        CValueCache cache2(1);
+        cache2.setBinaryFilesEnabled(true);
+        QVERIFY(cache2.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache2.getAllValues(), testData);
+
+        // Json file changed without binary file, the outdated binary file is not used, but created again
+        const CVariantMap changedData { { "namespace1/value1", CVariant::from(500) } };
+        CValueCache cache3(1);
+        cache3.insertValues({ changedData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(cache3.saveToFiles(dir.absolutePath()).isSuccess());
+        {
+            CValueCacheBinaryFile binaryFile(dir.filePath("namespace1.bin"));
+            QVERIFY(!binaryFile.open(QFileInfo(dir.filePath("namespace1.json"))));
+        }
+        CValueCache cache4(1);
+        cache4.setBinaryFilesEnabled(true);
+        QVERIFY(cache4.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache4.getAllValues().value("namespace1/value1"), CVariant::from(500));
+        QCOMPARE(cache4.getAllValues().value("namespace1/value2"), CVariant::from(2));
+        {
+            CValueCacheBinaryFile binaryFile(dir.filePath("namespace1.bin"));
+            QVERIFY(binaryFile.open(QFileInfo(dir.filePath("namespace1.json"))));
+        }
+
+        // corrupt binary file, the Json file is used
+        {
+            QFile binary(dir.filePath("namespace2.bin"));
+            QVERIFY(binary.open(QIODevice::ReadWrite));
+            QVERIFY(binary.seek(binary.size() - 1));
+            const char last = binary.peek(1).at(0);
+            QCOMPARE(binary.write(QByteArray(1, static_cast<char>(~last))), 1);
+        }
+        CValueCache cache5(1);
+        cache5.setBinaryFilesEnabled(true);
+        QVERIFY(cache5.loadFromFiles(dir.absolutePath()).isSuccess());
+        QCOMPARE(cache5.getAllValues().value("namespace2/models"), CVariant::from(models));
+    }
+
+    void CTestValueCache::benchmarkLoad_data()
+    {
+        QTest::addColumn<bool>("binary");
+        QTest::newRow("json") << false;
+        QTest::newRow("binary") << true;
+    }
+
+    void CTestValueCache::benchmarkLoad()
+    {
+        QFETCH(bool, binary);
+
+        static const CAircraftModelList models = testModels(20000);
+        QDir dir(QDir::currentPath() + "/testbenchmarkcache");
+        if (dir.exists()) { dir.removeRecursively(); }
+        const CVariantMap testData { { "modelset/models", CVariant::from(models) } };
+        CValueCache cache(1);
+        cache.setBinaryFilesEnabled(binary);
+        cache.insertValues({ testData, QDateTime::currentMSecsSinceEpoch() });
+        QVERIFY(cache.saveToFiles(dir.absolutePath()).isSuccess());
+
+        // cold: first load, like at startup
+        QElapsedTimer timer;
+        timer.start();
+        {
+            CValueCache loaded(1);
+            loaded.setBinaryFilesEnabled(binary);
+            loaded.loadFromFiles(dir.absolutePath());
+            QCOMPARE(loaded.getAllValues().value("modelset/models").value<CAircraftModelList>().size(), models.size());
+        }
+        qInfo("%s: cold load %lldms", QTest::currentDataTag(), timer.elapsed());
+
+        // warm: files in the OS cache
+        QBENCHMARK
+        {
+            CValueCache loaded(1);
+            loaded.setBinaryFilesEnabled(binary);
+            loaded.loadFromFiles(dir.absolutePath());
+        }
+    }
+
     //! Is value between 0 - 100?
     bool validator(int value, QString &)
     {